@@ -0,0 +1,505 @@
+#include "pch.h"
+
+#include "3dgs/AsyncFileReader.h"
+
+#include "3dgs/math/BatchMath.h"
+#include "3dgs/scene/Gaussian.h"
+#include "3dgs/scene/GaussianGenerator.h"
+#include "3dgs/scene/SpatialReorder.h"
+#include "3dgs/scene/SplatSorter.h"
+
+namespace iiixrlab::benchmark
+{
+	struct Options final
+	{
+		uint32_t MaxPointsCount;
+		double MinSeconds;						// per benchmark, iterations repeat until it is reached
+		std::string Filter;						// runs only the benchmarks whose name contains it
+		std::filesystem::path SpzPath;			// decoded by the SPZ benchmark when set
+		std::filesystem::path ReadPath;			// read by the file read benchmark when set, larger than the page cache to measure the drive
+		std::filesystem::path ReportPath;		// JSON file receiving the results when set
+	};
+
+	struct Result final
+	{
+		std::string Name;
+		uint64_t ItemsCount;
+		uint64_t BytesCount;
+		double Seconds;							// best iteration
+		uint32_t IterationsCount;
+	};
+
+	// folds results in so the optimizer cannot drop the measured work
+	static volatile uint64_t sSink = 0;
+
+	static void Consume(const void* data, const size_t size) noexcept
+	{
+		uint64_t value = 0;
+		memcpy(&value, data, std::min(size, sizeof(value)));
+		sSink = sSink + value;
+	}
+
+	// Reports the best iteration, which is the least disturbed by the rest of the system.
+	// itemsCount and bytesCount are per iteration, bytes are the ones read and written by the measured code.
+	template<typename Function>
+	static void Run(const Options& options, std::vector<Result>& outResults, const std::string& name, const uint64_t itemsCount, const uint64_t bytesCount, Function&& function)
+	{
+		if (options.Filter.empty() == false && name.find(options.Filter) == std::string::npos)
+		{
+			return;
+		}
+
+		// warms the caches and faults the pages in
+		function();
+
+		double bestSeconds = std::numeric_limits<double>::max();
+		double totalSeconds = 0.0;
+		uint32_t iterationsCount = 0;
+		while (iterationsCount < 3 || totalSeconds < options.MinSeconds)
+		{
+			const std::chrono::steady_clock::time_point startingTime = std::chrono::steady_clock::now();
+			function();
+			const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startingTime).count();
+
+			bestSeconds = std::min(bestSeconds, seconds);
+			totalSeconds += seconds;
+			++iterationsCount;
+		}
+
+		const Result& result = outResults.emplace_back(Result{ .Name = name, .ItemsCount = itemsCount, .BytesCount = bytesCount, .Seconds = bestSeconds, .IterationsCount = iterationsCount });
+
+		const std::ios_base::fmtflags flags = std::cout.flags();
+		const std::streamsize precision = std::cout.precision(3);
+		std::cout << std::fixed << result.Name << ": " << result.Seconds * 1.0e9 / static_cast<double>(result.ItemsCount) << " ns/item";
+		if (result.BytesCount > 0)
+		{
+			std::cout << ", " << static_cast<double>(result.BytesCount) / result.Seconds * 1.0e-9 << " GB/s";
+		}
+		std::cout << " (" << result.IterationsCount << " iterations)\n";
+		std::cout.precision(precision);
+		std::cout.flags(flags);
+	}
+
+	static void RunMathBenchmarks(const Options& options, std::vector<Result>& outResults)
+	{
+		constexpr const uint32_t ITEMS_COUNT = 1 << 16;
+
+		std::vector<iiixrlab::math::Vector3f> vectors3(ITEMS_COUNT);
+		std::vector<iiixrlab::math::Vector4f> vectors4(ITEMS_COUNT);
+		std::vector<iiixrlab::math::Matrix4x4f> matrices(ITEMS_COUNT);
+		for (uint32_t itemIndex = 0; itemIndex < ITEMS_COUNT; ++itemIndex)
+		{
+			const float value = static_cast<float>(itemIndex % 97) * 0.25f + 1.0f;
+			vectors3[itemIndex] = iiixrlab::math::Vector3f{ value, -value, 0.5f * value };
+			vectors4[itemIndex] = iiixrlab::math::Vector4f{ value, -value, 0.5f * value, 2.0f };
+			matrices[itemIndex] *= value;
+		}
+
+		Run(options, outResults, "Vector3f::Dot", ITEMS_COUNT, ITEMS_COUNT * sizeof(iiixrlab::math::Vector3f), [&vectors3]()
+		{
+			float sum = 0.0f;
+			for (uint32_t itemIndex = 1; itemIndex < ITEMS_COUNT; ++itemIndex)
+			{
+				sum += iiixrlab::math::Vector3f::Dot(vectors3[itemIndex - 1], vectors3[itemIndex]);
+			}
+			Consume(&sum, sizeof(sum));
+		});
+
+		Run(options, outResults, "Vector3f::Normalize", ITEMS_COUNT, 2 * ITEMS_COUNT * sizeof(iiixrlab::math::Vector3f), [&vectors3]()
+		{
+			for (iiixrlab::math::Vector3f& vector : vectors3)
+			{
+				vector = iiixrlab::math::Vector3f::Normalize(vector);
+			}
+			Consume(vectors3.data(), sizeof(iiixrlab::math::Vector3f));
+		});
+
+		Run(options, outResults, "Vector4f::operator+", ITEMS_COUNT, 3 * ITEMS_COUNT * sizeof(iiixrlab::math::Vector4f), [&vectors4]()
+		{
+			for (uint32_t itemIndex = 1; itemIndex < ITEMS_COUNT; ++itemIndex)
+			{
+				vectors4[itemIndex] = vectors4[itemIndex - 1] + vectors4[itemIndex];
+			}
+			Consume(vectors4.data() + ITEMS_COUNT - 1, sizeof(iiixrlab::math::Vector4f));
+		});
+
+		Run(options, outResults, "Matrix4x4f::Transpose", ITEMS_COUNT, 2 * ITEMS_COUNT * sizeof(iiixrlab::math::Matrix4x4f), [&matrices]()
+		{
+			for (iiixrlab::math::Matrix4x4f& matrix : matrices)
+			{
+				matrix = iiixrlab::math::Matrix4x4f::Transpose(matrix);
+			}
+			Consume(matrices.data(), sizeof(iiixrlab::math::Matrix4x4f));
+		});
+
+		Run(options, outResults, "Matrix4x4f::operator*(scalar)", ITEMS_COUNT, 2 * ITEMS_COUNT * sizeof(iiixrlab::math::Matrix4x4f), [&matrices]()
+		{
+			for (iiixrlab::math::Matrix4x4f& matrix : matrices)
+			{
+				matrix = matrix * 1.0f;
+			}
+			Consume(matrices.data(), sizeof(iiixrlab::math::Matrix4x4f));
+		});
+
+		Run(options, outResults, "Matrix4x4f::operator*(Matrix4x4f)", ITEMS_COUNT, 3 * ITEMS_COUNT * sizeof(iiixrlab::math::Matrix4x4f), [&matrices]()
+		{
+			for (uint32_t itemIndex = 1; itemIndex < ITEMS_COUNT; ++itemIndex)
+			{
+				matrices[itemIndex - 1] = matrices[itemIndex - 1] * matrices[itemIndex];
+			}
+			Consume(matrices.data(), sizeof(iiixrlab::math::Matrix4x4f));
+		});
+
+		Run(options, outResults, "Vector4f::operator*(Matrix4x4f)", ITEMS_COUNT, ITEMS_COUNT * (2 * sizeof(iiixrlab::math::Vector4f) + sizeof(iiixrlab::math::Matrix4x4f)), [&vectors4, &matrices]()
+		{
+			for (uint32_t itemIndex = 0; itemIndex < ITEMS_COUNT; ++itemIndex)
+			{
+				vectors4[itemIndex] = vectors4[itemIndex] * matrices[itemIndex];
+			}
+			Consume(vectors4.data(), sizeof(iiixrlab::math::Vector4f));
+		});
+
+		Run(options, outResults, "Matrix4x4f::Inverse", ITEMS_COUNT, 2 * ITEMS_COUNT * sizeof(iiixrlab::math::Matrix4x4f), [&matrices]()
+		{
+			for (iiixrlab::math::Matrix4x4f& matrix : matrices)
+			{
+				matrix = iiixrlab::math::Matrix4x4f::Inverse(matrix);
+			}
+			Consume(matrices.data(), sizeof(iiixrlab::math::Matrix4x4f));
+		});
+
+		Run(options, outResults, "Matrix4x4f::InverseRigid", ITEMS_COUNT, 2 * ITEMS_COUNT * sizeof(iiixrlab::math::Matrix4x4f), [&matrices]()
+		{
+			for (iiixrlab::math::Matrix4x4f& matrix : matrices)
+			{
+				matrix = iiixrlab::math::Matrix4x4f::InverseRigid(matrix);
+			}
+			Consume(matrices.data(), sizeof(iiixrlab::math::Matrix4x4f));
+		});
+
+		Run(options, outResults, "Matrix4x4f::Matrix()", ITEMS_COUNT, ITEMS_COUNT * sizeof(iiixrlab::math::Matrix4x4f), [&matrices]()
+		{
+			for (iiixrlab::math::Matrix4x4f& matrix : matrices)
+			{
+				matrix = iiixrlab::math::Matrix4x4f();
+			}
+			Consume(matrices.data(), sizeof(iiixrlab::math::Matrix4x4f));
+		});
+	}
+
+	static void RunSphereBenchmarks(const Options& options, std::vector<Result>& outResults)
+	{
+		for (const uint32_t subdivisionsCount : { 4u, 16u, 64u })
+		{
+			const uint64_t verticesCount = scene::Gaussian::GenerateSphereVertices(1.0f, subdivisionsCount, subdivisionsCount).size();
+			Run(options, outResults, "GenerateSphereVertices/" + std::to_string(subdivisionsCount), verticesCount, verticesCount * sizeof(iiixrlab::math::Vector3f), [subdivisionsCount]()
+			{
+				const std::vector<iiixrlab::math::Vector3f> vertices = scene::Gaussian::GenerateSphereVertices(1.0f, subdivisionsCount, subdivisionsCount);
+				Consume(vertices.data(), sizeof(iiixrlab::math::Vector3f));
+			});
+		}
+	}
+
+	static void RunSplatBenchmarks(const Options& options, std::vector<Result>& outResults)
+	{
+		for (uint32_t pointsCount = 1024; pointsCount <= options.MaxPointsCount; pointsCount *= 4)
+		{
+			const std::string suffix = "/" + std::to_string(pointsCount);
+			const scene::GaussianInfo gaussianInfo = scene::GenerateGaussians({ .PointsCount = pointsCount, .Distribution = scene::eGaussianDistribution::CLUSTERED, .Seed = 1 });
+
+			// positions, scales, rotations, colors and opacities in, one instance out
+			std::vector<scene::Gaussian::InstanceInfo> instanceInfos(pointsCount);
+			Run(options, outResults, "PackInstanceInfos" + suffix, pointsCount, pointsCount * (14 * sizeof(float) + sizeof(scene::Gaussian::InstanceInfo)), [&gaussianInfo, &instanceInfos]()
+			{
+				scene::Gaussian::PackInstanceInfos(gaussianInfo, 0, gaussianInfo.NumPoints, instanceInfos.data());
+				Consume(instanceInfos.data(), sizeof(scene::Gaussian::InstanceInfo));
+			});
+
+			// looks down +z from behind the scene
+			iiixrlab::math::Matrix4x4f view;
+			view(3, 2) = 20.0f;
+
+			scene::SplatSorter splatSorter;
+			Run(options, outResults, "SplatSorter::ComputeDepthKeys" + suffix, pointsCount, pointsCount * (3 * sizeof(float) + sizeof(uint32_t)), [&gaussianInfo, &view, &splatSorter]()
+			{
+				splatSorter.ComputeDepthKeys(gaussianInfo, view);
+				Consume(splatSorter.GetKeys().data(), sizeof(uint32_t));
+			});
+
+			// sorting consumes the keys, so it is measured along with computing them, std::sort is the baseline
+			splatSorter.ComputeDepthKeys(gaussianInfo, view);
+			const std::vector<uint32_t> keys = splatSorter.GetKeys();
+			std::vector<uint32_t> sortedKeys(keys.size());
+			Run(options, outResults, "SplatSorter::ComputeDepthKeys+Sort" + suffix, pointsCount, pointsCount * (3 * sizeof(float) + 3 * sizeof(uint32_t)), [&gaussianInfo, &view, &splatSorter]()
+			{
+				splatSorter.ComputeDepthKeys(gaussianInfo, view);
+				splatSorter.Sort();
+				Consume(splatSorter.GetSortedIndices().data(), sizeof(uint32_t));
+			});
+			Run(options, outResults, "std::sort" + suffix, pointsCount, pointsCount * sizeof(uint32_t), [&keys, &sortedKeys]()
+			{
+				std::copy(keys.begin(), keys.end(), sortedKeys.begin());
+				std::sort(sortedKeys.begin(), sortedKeys.end());
+				Consume(sortedKeys.data(), sizeof(uint32_t));
+			});
+		}
+	}
+
+	// the depth sorted gather of the instances reads the attributes in a view dependent order, which only hits the cache
+	// when splats close in space are close in memory, so it is measured on the generated order and on both curves
+	static void RunReorderBenchmarks(const Options& options, std::vector<Result>& outResults)
+	{
+		for (uint32_t pointsCount = 1024; pointsCount <= options.MaxPointsCount; pointsCount *= 4)
+		{
+			const std::string suffix = "/" + std::to_string(pointsCount);
+			const scene::GaussianInfo gaussianInfo = scene::GenerateGaussians({ .PointsCount = pointsCount, .Distribution = scene::eGaussianDistribution::CLUSTERED, .Seed = 1 });
+
+			iiixrlab::math::Matrix4x4f view;
+			view(3, 2) = 20.0f;
+
+			std::vector<scene::Gaussian::InstanceInfo> instanceInfos(pointsCount);
+			scene::SplatSorter splatSorter;
+			const auto runSortedGather = [&options, &outResults, &suffix, pointsCount, &view, &instanceInfos, &splatSorter](const char* layoutName, const scene::GaussianInfo& layoutGaussianInfo)
+			{
+				Run(options, outResults, std::string("SortedGather/") + layoutName + suffix, pointsCount, pointsCount * (15 * sizeof(float) + 3 * sizeof(uint32_t) + sizeof(scene::Gaussian::InstanceInfo)), [&layoutGaussianInfo, &view, &instanceInfos, &splatSorter]()
+				{
+					splatSorter.ComputeDepthKeys(layoutGaussianInfo, view);
+					splatSorter.Sort();
+					const std::vector<uint32_t>& sortedIndices = splatSorter.GetSortedIndices();
+					for (uint32_t instanceIndex = 0; instanceIndex < sortedIndices.size(); ++instanceIndex)
+					{
+						scene::Gaussian::PackInstanceInfos(layoutGaussianInfo, sortedIndices[instanceIndex], 1, &instanceInfos[instanceIndex]);
+					}
+					Consume(instanceInfos.data(), sizeof(scene::Gaussian::InstanceInfo));
+				});
+			};
+			runSortedGather("generated", gaussianInfo);
+
+			for (const scene::eSpaceFillingCurve curve : { scene::eSpaceFillingCurve::MORTON, scene::eSpaceFillingCurve::HILBERT })
+			{
+				const char* curveName = scene::GetSpaceFillingCurveName(curve);
+				Run(options, outResults, std::string("ComputeSpatialOrder/") + curveName + suffix, pointsCount, pointsCount * (3 * sizeof(float) + sizeof(uint64_t) + sizeof(uint32_t)), [&gaussianInfo, curve]()
+				{
+					const std::vector<uint32_t> order = scene::ComputeSpatialOrder(gaussianInfo, { .Curve = curve });
+					Consume(order.data(), sizeof(uint32_t));
+				});
+
+				scene::GaussianInfo reorderedGaussianInfo = gaussianInfo;
+				scene::ReorderGaussians(reorderedGaussianInfo, { .Curve = curve });
+				runSortedGather(curveName, reorderedGaussianInfo);
+			}
+		}
+	}
+
+	// every batch function at every level the CPU supports, named e.g. ApplySigmoid/avx2/1048576
+	static void RunBatchMathBenchmarks(const Options& options, std::vector<Result>& outResults)
+	{
+		const uint32_t pointsCount = options.MaxPointsCount;
+		const scene::GaussianInfo gaussianInfo = scene::GenerateGaussians({ .PointsCount = pointsCount, .Distribution = scene::eGaussianDistribution::CLUSTERED, .Seed = 1 });
+
+		iiixrlab::math::Matrix4x4f view;
+		view(3, 2) = 20.0f;
+
+		std::vector<float> outputs(static_cast<size_t>(pointsCount) * 9);
+		const iiixrlab::math::eCpuFeatureLevel supportedLevel = iiixrlab::math::GetSupportedCpuFeatureLevel();
+		for (uint8_t level = 0; level <= static_cast<uint8_t>(supportedLevel); ++level)
+		{
+			const iiixrlab::math::eCpuFeatureLevel cpuFeatureLevel = iiixrlab::math::SetCpuFeatureLevel(static_cast<iiixrlab::math::eCpuFeatureLevel>(level));
+			const std::string suffix = std::string("/") + iiixrlab::math::GetCpuFeatureLevelName(cpuFeatureLevel) + "/" + std::to_string(pointsCount);
+
+			Run(options, outResults, "TransformPoints" + suffix, pointsCount, 6 * pointsCount * sizeof(float), [&gaussianInfo, &view, &outputs]()
+			{
+				iiixrlab::math::TransformPoints(gaussianInfo.Positions, view, outputs);
+				Consume(outputs.data(), sizeof(float));
+			});
+			Run(options, outResults, "ComputeViewDepths" + suffix, pointsCount, 4 * pointsCount * sizeof(float), [&gaussianInfo, &view, &outputs]()
+			{
+				iiixrlab::math::ComputeViewDepths(gaussianInfo.Positions, view, outputs);
+				Consume(outputs.data(), sizeof(float));
+			});
+			Run(options, outResults, "ComputeRotationMatrices" + suffix, pointsCount, 13 * pointsCount * sizeof(float), [&gaussianInfo, &outputs]()
+			{
+				iiixrlab::math::ComputeRotationMatrices(gaussianInfo.Rotations, outputs);
+				Consume(outputs.data(), sizeof(float));
+			});
+			Run(options, outResults, "Exponentiate" + suffix, 3 * pointsCount, 6 * pointsCount * sizeof(float), [&gaussianInfo, &outputs]()
+			{
+				iiixrlab::math::Exponentiate(gaussianInfo.Scales, outputs);
+				Consume(outputs.data(), sizeof(float));
+			});
+			Run(options, outResults, "ApplySigmoid" + suffix, pointsCount, 2 * pointsCount * sizeof(float), [&gaussianInfo, &outputs]()
+			{
+				iiixrlab::math::ApplySigmoid(gaussianInfo.Alphas, outputs);
+				Consume(outputs.data(), sizeof(float));
+			});
+		}
+		iiixrlab::math::SetCpuFeatureLevel(supportedLevel);
+	}
+
+	static void RunSpzBenchmarks(const Options& options, std::vector<Result>& outResults)
+	{
+		if (options.SpzPath.empty() == true)
+		{
+			return;
+		}
+
+		std::ifstream spzFile(options.SpzPath, std::ios::binary);
+		if (spzFile.is_open() == false)
+		{
+			std::cerr << "Unable to open " << options.SpzPath << ".\n";
+			return;
+		}
+		const std::vector<uint8_t> spzData((std::istreambuf_iterator<char>(spzFile)), std::istreambuf_iterator<char>());
+
+		const uint64_t pointsCount = spz::loadSpz(spzData).numPoints;
+		if (pointsCount == 0)
+		{
+			std::cerr << options.SpzPath << " has no points.\n";
+			return;
+		}
+
+		Run(options, outResults, "spz::loadSpz", pointsCount, spzData.size(), [&spzData]()
+		{
+			const spz::GaussianCloud gaussianCloud = spz::loadSpz(spzData);
+			Consume(gaussianCloud.positions.data(), sizeof(float));
+		});
+	}
+
+	static void RunFileReadBenchmarks(const Options& options, std::vector<Result>& outResults)
+	{
+		if (options.ReadPath.empty() == true)
+		{
+			return;
+		}
+
+		std::error_code errorCode;
+		const uint64_t fileSize = std::filesystem::file_size(options.ReadPath, errorCode);
+		if (errorCode || fileSize == 0)
+		{
+			std::cerr << "Unable to read " << options.ReadPath << ".\n";
+			return;
+		}
+		std::vector<uint8_t> data(fileSize);
+		const uint64_t blocksCount = (fileSize + (1 << 20) - 1) >> 20;
+
+		Run(options, outResults, "std::ifstream::read", blocksCount, fileSize, [&options, &data]()
+		{
+			std::ifstream file(options.ReadPath, std::ios::binary);
+			file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+			Consume(data.data(), data.size());
+		});
+
+		const FileReadRange range = { .Offset = 0, .Size = fileSize, .Destination = data.data() };
+		for (const bool bIsDirect : { false, true })
+		{
+			for (const eFileReadBackend backend : { eFileReadBackend::IO_URING, eFileReadBackend::THREAD_POOL })
+			{
+				// only io_uring honors O_DIRECT, and it falls back to the thread pool where it is not available
+				if (bIsDirect == true && backend != eFileReadBackend::IO_URING)
+				{
+					continue;
+				}
+				AsyncFileReader reader(options.ReadPath, { .Backend = backend, .bIsDirect = bIsDirect });
+				if (reader.GetBackend() != backend)
+				{
+					continue;
+				}
+
+				Run(options, outResults, std::string("AsyncFileReader/") + GetFileReadBackendName(backend) + (bIsDirect == true ? "/direct" : ""), blocksCount, fileSize, [&reader, &range, &data]()
+				{
+					reader.Read(std::span<const FileReadRange>(&range, 1));
+					Consume(data.data(), data.size());
+				});
+			}
+		}
+	}
+
+	static void WriteReport(const std::filesystem::path& path, const std::vector<Result>& results)
+	{
+		std::ofstream file(path);
+		if (file.is_open() == false)
+		{
+			std::cerr << "Failed to open " << path << " for the benchmark report.\n";
+			return;
+		}
+
+		// names are chosen by the code, they need no escaping
+		file << "[";
+		for (size_t resultIndex = 0; resultIndex < results.size(); ++resultIndex)
+		{
+			const Result& result = results[resultIndex];
+			file << (resultIndex == 0 ? "\n" : ",\n")
+				<< "\t{ \"name\": \"" << result.Name
+				<< "\", \"items\": " << result.ItemsCount
+				<< ", \"bytes\": " << result.BytesCount
+				<< ", \"seconds\": " << result.Seconds
+				<< ", \"ns_per_item\": " << result.Seconds * 1.0e9 / static_cast<double>(result.ItemsCount)
+				<< ", \"gb_per_s\": " << static_cast<double>(result.BytesCount) / result.Seconds * 1.0e-9
+				<< ", \"iterations\": " << result.IterationsCount << " }";
+		}
+		file << "\n]\n";
+	}
+} // namespace iiixrlab::benchmark
+
+int main(int argc, char** argv)
+{
+	iiixrlab::benchmark::Options options =
+	{
+		.MaxPointsCount = 1 << 20,
+		.MinSeconds = 0.25,
+		.Filter = {},
+		.SpzPath = {},
+		.ReadPath = {},
+		.ReportPath = {},
+	};
+
+	for (int argumentIndex = 1; argumentIndex < argc; ++argumentIndex)
+	{
+		const char* argument = argv[argumentIndex];
+		if (strcmp(argument, "-max-points") == 0 && argumentIndex + 1 < argc)
+		{
+			options.MaxPointsCount = std::atoi(argv[++argumentIndex]);
+		}
+		else if (strcmp(argument, "-min-time") == 0 && argumentIndex + 1 < argc)
+		{
+			options.MinSeconds = std::atof(argv[++argumentIndex]);
+		}
+		else if (strcmp(argument, "-filter") == 0 && argumentIndex + 1 < argc)
+		{
+			options.Filter = argv[++argumentIndex];
+		}
+		else if (strcmp(argument, "-spz") == 0 && argumentIndex + 1 < argc)
+		{
+			options.SpzPath = argv[++argumentIndex];
+		}
+		else if (strcmp(argument, "-read") == 0 && argumentIndex + 1 < argc)
+		{
+			options.ReadPath = argv[++argumentIndex];
+		}
+		else if (strcmp(argument, "-json") == 0 && argumentIndex + 1 < argc)
+		{
+			options.ReportPath = argv[++argumentIndex];
+		}
+		else
+		{
+			std::cerr << "Usage: " << argv[0] << " [-max-points <count>] [-min-time <seconds>] [-filter <name>] [-spz <file>] [-read <file>] [-json <file>]\n";
+			return -1;
+		}
+	}
+
+	std::vector<iiixrlab::benchmark::Result> results;
+	iiixrlab::benchmark::RunMathBenchmarks(options, results);
+	iiixrlab::benchmark::RunSphereBenchmarks(options, results);
+	iiixrlab::benchmark::RunSplatBenchmarks(options, results);
+	iiixrlab::benchmark::RunReorderBenchmarks(options, results);
+	iiixrlab::benchmark::RunBatchMathBenchmarks(options, results);
+	iiixrlab::benchmark::RunSpzBenchmarks(options, results);
+	iiixrlab::benchmark::RunFileReadBenchmarks(options, results);
+
+	if (options.ReportPath.empty() == false)
+	{
+		iiixrlab::benchmark::WriteReport(options.ReportPath, results);
+	}
+
+	return 0;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/CommonDefines.h"
+
+namespace iiixrlab
+{
+	class ThreadPool;
+
+	enum class eFileReadBackend : uint8_t
+	{
+		AUTO,			// io_uring where the kernel offers it, the thread pool otherwise
+		IO_URING,
+		THREAD_POOL,
+	};
+
+	struct FileReadInfo final
+	{
+		eFileReadBackend Backend = eFileReadBackend::AUTO;
+		uint32_t BlockSize = 1 << 20;	// bytes per read, ranges are split into blocks
+		uint32_t QueueDepth = 32;		// reads in flight, each with a registered buffer of BlockSize with O_DIRECT
+		uint32_t ThreadsCount = 0;		// of the thread pool, 0 picks one per hardware thread
+		bool bIsDirect = false;			// bypasses the page cache with O_DIRECT, only honored by io_uring
+	};
+
+	struct FileReadRange final
+	{
+		uint64_t Offset;
+		uint64_t Size;
+		void* Destination;
+	};
+
+	// Reads ranges of one file with many reads in flight, so fast drives are bound by their bandwidth rather than by
+	// the latency of each read. Reads land straight in the destinations, except for O_DIRECT which asks for aligned
+	// offsets and buffers: io_uring then reads into registered, page aligned buffers which are copied out as they complete.
+	class AsyncFileReader final
+	{
+	public:
+		AsyncFileReader() = delete;
+		// Failing to open the file leaves the reader closed.
+		AsyncFileReader(const std::filesystem::path& path, const FileReadInfo& fileReadInfo = {}) noexcept;
+
+		AsyncFileReader(const AsyncFileReader&) = delete;
+		AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+		~AsyncFileReader() noexcept;
+
+		IIIXRLAB_INLINE bool IsOpen() const noexcept { return mFileSize != UINT64_MAX; }
+		IIIXRLAB_INLINE constexpr uint64_t GetFileSize() const noexcept { return mFileSize; }
+		IIIXRLAB_INLINE constexpr eFileReadBackend GetBackend() const noexcept { return mBackend; }
+
+		// Blocks until every range is read. onRangeRead is called on the calling thread with the index of each range
+		// as soon as all of it has landed, e.g. to decode it while the other ranges are still being read.
+		// Ranges past the end of the file fail the whole read.
+		bool Read(const std::span<const FileReadRange> ranges, const std::function<void(size_t rangeIndex)>& onRangeReadOrNull = nullptr) noexcept;
+		// The whole file.
+		bool ReadAll(std::vector<uint8_t>& outData) noexcept;
+
+	private:
+		bool readWithThreadPool(const std::span<const FileReadRange> ranges, const std::function<void(size_t rangeIndex)>& onRangeReadOrNull) noexcept;
+		bool readWithIoUring(const std::span<const FileReadRange> ranges, const std::function<void(size_t rangeIndex)>& onRangeReadOrNull) noexcept;
+
+	private:
+		struct IoUring;
+
+	private:
+		// Only defined where io_uring is, failing leaves the thread pool to read.
+		bool setupIoUring(IoUring& outIoUring) const noexcept;
+
+	private:
+		std::filesystem::path mPath;
+		FileReadInfo mFileReadInfo;
+		eFileReadBackend mBackend;
+		uint64_t mFileSize;
+		std::unique_ptr<IoUring> mIoUringOrNull;
+		std::unique_ptr<ThreadPool> mThreadPoolOrNull;
+	};
+
+	bool ParseFileReadBackend(const char* name, eFileReadBackend& outBackend) noexcept;
+	const char* GetFileReadBackendName(const eFileReadBackend backend) noexcept;
+} // namespace iiixrlab
@@ -2,8 +2,16 @@
 
 #include "pch.h"
 
+#include "3dgs/AsyncFileReader.h"
 #include "3dgs/CommonDefines.h"
 
+#include "3dgs/scene/GaussianGenerator.h"
+#include "3dgs/scene/ProgressiveLoader.h"
+#include "3dgs/scene/Pruning.h"
+#include "3dgs/scene/ShCodebook.h"
+#include "3dgs/scene/SpatialReorder.h"
+#include "3dgs/scene/SpzWriter.h"
+
 namespace iiixrlab
 {
     struct ProjectInfo final
@@ -11,6 +19,20 @@ namespace iiixrlab
         std::string Name;
         uint32_t    Version;
     };
+
+	// Another model drawn along with the scene, e.g. one of many captures composed into an environment.
+	struct PlacedModelInfo final
+	{
+		std::filesystem::path	Path;
+		math::Matrix4x4f		Transform;	// model to world
+	};
+
+	// Axis aligned box in model space, e.g. selecting floaters to clean up.
+	struct BoxInfo final
+	{
+		std::array<float, 3>	Min;
+		std::array<float, 3>	Max;
+	};
     
 	struct ApplicationInfo
 	{
@@ -18,5 +40,33 @@ namespace iiixrlab
 		uint32_t				Width;
 		uint32_t				Height;
 		std::filesystem::path	ModelPath;
+		scene::GaussianGeneratorInfo	SyntheticSceneInfo;	// generates the scene instead of loading the model when it has points
+		bool					bIsProgressivelyLoaded;	// draws a preview of the scene while the rest of it loads in chunks
+		uint32_t				PreviewStride;			// points per preview point, of progressive loading and of the scene cache
+		uint64_t				StreamingBudget;		// bytes of video memory for the chunks of a streamed scene cache, 0 loads the whole scene
+		iiixrlab::FileReadInfo	FileReadInfo;			// of the model, the scene cache and the streamed chunks
+		std::vector<PlacedModelInfo>	PlacedModels;	// loaded whole once per file and sorted together with the scene
+		std::vector<BoxInfo>	DeletedBoxes;			// gaussians of the scene within them are deleted once it is drawn
+		scene::PruneInfo		PruneInfo;				// prunes the gaussians after loading when it has a threshold
+		std::filesystem::path	PruneViewsPath;			// transforms.json whose views measure the contributions and the PSNR when set
+		bool					bIsSpatiallyReordered;	// stores the gaussians along the curve of SpatialReorderInfo after loading
+		scene::SpatialReorderInfo	SpatialReorderInfo;
+		scene::ShCodebookInfo	ShCodebookInfo;			// quantizes the spherical harmonics after loading when it has entries
+		std::filesystem::path	SceneCachePath;			// scene cache written after loading and quantizing when set
+		scene::SpzWriteInfo		SpzWriteInfo;
+		std::filesystem::path	SpzExportPath;			// .spz written after loading and quantizing when set
+		bool					bIsHeadless;			// renders offscreen without a window or a surface
+		uint32_t				HeadlessFramesCount;	// frames rendered before a headless run exits
+		std::filesystem::path	TrajectoryPath;			// renders every view of the trajectory offline when set
+		std::filesystem::path	OutputPath;				// directory receiving the rendered views
+		uint32_t				IoThreadsCount;			// image encoders, 0 picks one per hardware thread
+		uint32_t				GpuProfileInterval;		// prints the GPU timings every that many frames, 0 never prints them
+		std::filesystem::path	GpuProfilePath;			// JSON file receiving the GPU timings on exit when set
+		std::filesystem::path	TracePath;				// Chrome trace of the CPU zones and GPU scopes written on exit when set
+		std::string				BenchmarkCameraPath;	// orbit, flythrough or a file of recorded poses, runs the benchmark when set
+		uint32_t				BenchmarkFramesCount;	// measured frames, the generated paths have one pose per frame
+		uint32_t				BenchmarkWarmupFramesCount;	// frames rendered before measuring
+		std::filesystem::path	BenchmarkReportPath;	// JSON file receiving the results, printed to stdout when empty
+		std::filesystem::path	RecordedCameraPath;		// file receiving the camera pose of every frame on exit when set
 	};
 }
\ No newline at end of file
@@ -18,8 +18,15 @@ namespace iiixrlab
 {
     namespace graphics
     {
-        static constexpr const uint32_t DEFAULT_FRAMES_COUNT = 3;
+        static constexpr const uint32_t DEFAULT_FRAMES_COUNT = 3;		// frames in flight
+        static constexpr const uint32_t DEFAULT_BACK_BUFFERS_COUNT = 3;	// swap chain images
         static constexpr const uint32_t MINIMUM_VK_API_VERSION = VK_API_VERSION_1_3;
+
+        // Every pipeline layout starts with the bindless set followed by the pipeline's own set,
+        // and shares one push constant range so the bindless set stays bound across pipeline changes.
+        static constexpr const uint32_t BINDLESS_DESCRIPTOR_SET_INDEX = 0;
+        static constexpr const uint32_t PIPELINE_DESCRIPTOR_SET_INDEX = 1;
+        static constexpr const uint32_t PUSH_CONSTANTS_SIZE = 128;
     }   // namespace graphics
 
     namespace math
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "pch.h"
+
+namespace iiixrlab
+{
+	// Writes tightly packed 8-bit RGBA rows as a PNG, favoring encoding speed over file size.
+	// Safe to call from several threads at once.
+	bool WritePng(const std::filesystem::path& filePath, const uint32_t width, const uint32_t height, const uint8_t* pixels) noexcept;
+} // namespace iiixrlab
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/CommonDefines.h"
+
+// Zones compile to nothing unless the build defines IIIXRLAB_PROFILER (cmake -DIIIXRLAB_ENABLE_PROFILER=ON).
+// Names have to outlive the profiler, e.g. string literals or __func__.
+#define IIIXRLAB_PROFILE_CONCAT_INNER(a, b) a##b
+#define IIIXRLAB_PROFILE_CONCAT(a, b) IIIXRLAB_PROFILE_CONCAT_INNER(a, b)
+
+#if defined(IIIXRLAB_PROFILER)
+	#define IIIXRLAB_PROFILE_ZONE(name) const ::iiixrlab::ProfileZone IIIXRLAB_PROFILE_CONCAT(profileZone, __LINE__)(name)
+	#define IIIXRLAB_PROFILE_FUNCTION() IIIXRLAB_PROFILE_ZONE(__func__)
+	#define IIIXRLAB_PROFILE_THREAD(name) ::iiixrlab::Profiler::GetInstance().SetThreadName(name)
+#else	// NOT defined(IIIXRLAB_PROFILER)
+	#define IIIXRLAB_PROFILE_ZONE(name) ((void)0)
+	#define IIIXRLAB_PROFILE_FUNCTION() ((void)0)
+	#define IIIXRLAB_PROFILE_THREAD(name) ((void)0)
+#endif	// NOT defined(IIIXRLAB_PROFILER)
+
+namespace iiixrlab
+{
+	// Writes the string as a JSON string, quoted with quotes and backslashes escaped.
+	void WriteJsonString(std::ostream& os, const std::string_view string) noexcept;
+
+	// Collects timed zones of every thread into per thread ring buffers and exports them as Chrome trace events,
+	// which chrome://tracing and Perfetto display on one timeline.
+	// Recording a zone takes no lock: every thread only ever writes its own buffer, the oldest zones are overwritten
+	// once it is full. The exporter copies a buffer while its thread keeps writing, the fields of the events are
+	// atomics and the count of written events tells which copied events were overwritten meanwhile.
+	// Timestamps are nanoseconds of std::chrono::steady_clock.
+	class Profiler final
+	{
+	public:
+		static constexpr uint32_t EVENTS_COUNT_PER_THREAD = 1 << 15;	// power of two
+
+	public:
+		static Profiler& GetInstance() noexcept;
+
+		static IIIXRLAB_INLINE int64_t GetTimestamp() noexcept
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+	public:
+		Profiler(const Profiler&) = delete;
+		Profiler(Profiler&&) = delete;
+
+		~Profiler() noexcept;
+
+		Profiler& operator=(const Profiler&) = delete;
+		Profiler& operator=(Profiler&&) = delete;
+
+		IIIXRLAB_INLINE bool IsRecording() const noexcept { return mbIsRecording.load(std::memory_order_relaxed); }
+
+		void Start() noexcept;
+		void Stop() noexcept;
+
+		// Records a zone on the calling thread, or on the named track (e.g. a GPU queue) when trackNameOrNull is set.
+		void AddZone(const char* name, const int64_t beginTimestamp, const int64_t endTimestamp, const char* trackNameOrNull = nullptr) noexcept;
+		void SetThreadName(const char* name) noexcept;
+
+		// Meant to be called once the zones of interest are recorded, zones overwritten meanwhile are skipped.
+		void WriteChromeTrace(std::ostream& os) const noexcept;
+		bool WriteChromeTrace(const std::filesystem::path& path) const noexcept;
+
+	private:
+		struct Event final
+		{
+			const char* Name;
+			const char* TrackNameOrNull;
+			int64_t BeginTimestamp;
+			int64_t EndTimestamp;
+		};
+
+		struct EventSlot final
+		{
+			std::atomic<const char*> Name;
+			std::atomic<const char*> TrackNameOrNull;
+			std::atomic<int64_t> BeginTimestamp;
+			std::atomic<int64_t> EndTimestamp;
+		};
+
+		struct ThreadBuffer final
+		{
+			std::string Name;
+			uint32_t ThreadIndex;
+			std::unique_ptr<EventSlot[]> Events;
+			std::atomic<uint64_t> WrittenEventsCount;
+		};
+
+	private:
+		Profiler() noexcept;
+
+		ThreadBuffer& getThreadBuffer() noexcept;
+
+	private:
+		std::atomic<bool> mbIsRecording;
+		int64_t mStartingTimestamp;
+
+		// only registration locks, every buffer is written by its own thread alone
+		mutable std::mutex mThreadBuffersMutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> mThreadBuffers;
+	};
+
+	class ProfileZone final
+	{
+	public:
+		ProfileZone() = delete;
+		ProfileZone(const ProfileZone&) = delete;
+		ProfileZone(ProfileZone&&) = delete;
+
+		IIIXRLAB_INLINE explicit ProfileZone(const char* name) noexcept
+			: mName(name)
+			, mBeginTimestamp(Profiler::GetInstance().IsRecording() == true ? Profiler::GetTimestamp() : -1)
+		{
+		}
+
+		IIIXRLAB_INLINE ~ProfileZone() noexcept
+		{
+			if (mBeginTimestamp >= 0)
+			{
+				Profiler::GetInstance().AddZone(mName, mBeginTimestamp, Profiler::GetTimestamp());
+			}
+		}
+
+		ProfileZone& operator=(const ProfileZone&) = delete;
+		ProfileZone& operator=(ProfileZone&&) = delete;
+
+	private:
+		const char* mName;
+		int64_t mBeginTimestamp;
+	};
+} // namespace iiixrlab
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/CommonDefines.h"
+
+namespace iiixrlab
+{
+	// SplitMix64, small and identical on every standard library unlike the <random> distributions
+	struct Random final
+	{
+		uint64_t State;
+
+		IIIXRLAB_INLINE uint64_t Next() noexcept
+		{
+			uint64_t value = (State += 0x9e3779b97f4a7c15ull);
+			value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+			value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+			return value ^ (value >> 31);
+		}
+
+		// [0, 1)
+		IIIXRLAB_INLINE float NextFloat() noexcept
+		{
+			return static_cast<float>(Next() >> 40) * (1.0f / 16777216.0f);
+		}
+
+		IIIXRLAB_INLINE float NextFloat(const float min, const float max) noexcept
+		{
+			return min + (max - min) * NextFloat();
+		}
+
+		// standard normal, Box-Muller
+		IIIXRLAB_INLINE float NextNormal() noexcept
+		{
+			const float u = 1.0f - NextFloat();
+			const float v = NextFloat();
+			return std::sqrt(-2.0f * std::log(u)) * std::cos(2.0f * std::numbers::pi_v<float> * v);
+		}
+	};
+} // namespace iiixrlab
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/CommonDefines.h"
+
+namespace iiixrlab
+{
+	// Fixed set of worker threads draining a FIFO of tasks, keeps blocking work such as file I/O off the render loop.
+	// Submit() blocks while MaxPendingTasksCount tasks are queued, so a slow consumer bounds the memory held by the queue.
+	class ThreadPool final
+	{
+	public:
+		struct CreateInfo final
+		{
+			uint32_t ThreadsCount;
+			uint32_t MaxPendingTasksCount = UINT32_MAX;
+		};
+
+	public:
+		ThreadPool() = delete;
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool(ThreadPool&&) = delete;
+
+		ThreadPool(const CreateInfo& createInfo) noexcept;
+
+		// Finishes every submitted task before joining the workers.
+		~ThreadPool() noexcept;
+
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		ThreadPool& operator=(ThreadPool&&) = delete;
+
+		IIIXRLAB_INLINE uint32_t GetThreadsCount() const noexcept { return static_cast<uint32_t>(mThreads.size()); }
+
+		void Submit(std::function<void()>&& task) noexcept;
+		// Blocks until the queue is empty and no task is running.
+		void Wait() noexcept;
+
+	private:
+		void work() noexcept;
+
+	private:
+		std::vector<std::thread>			mThreads;
+		std::deque<std::function<void()>>	mTasks;
+		uint32_t							mMaxPendingTasksCount;
+		uint32_t							mRunningTasksCount;
+		bool								mbIsStopping;
+
+		std::mutex					mMutex;
+		std::condition_variable		mTaskSubmitted;
+		std::condition_variable		mTaskTaken;
+		std::condition_variable		mTasksDone;
+	};
+} // namespace iiixrlab
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "pch.h"
+
+namespace iiixrlab::graphics
+{
+	class Buffer;
+	class DescriptorPool;
+	class Device;
+	class Texture;
+
+	// One update-after-bind descriptor set shared by every pipeline at set BINDLESS_DESCRIPTOR_SET_INDEX.
+	// Resources register once and are addressed from shaders by the returned index (usually through push constants).
+	class BindlessDescriptorSet final
+	{
+	public:
+		friend class CommandBuffer;
+		friend class Device;
+
+	public:
+		enum class eType : uint8_t
+		{
+			STORAGE_BUFFER,
+			SAMPLED_IMAGE,
+			STORAGE_IMAGE,
+			COUNT,
+		};
+
+		static constexpr const uint32_t INVALID_INDEX = UINT32_MAX;
+		// Clamped to the update-after-bind limits of the device, see GetDescriptorsCount().
+		static constexpr const uint32_t MAX_DESCRIPTORS_COUNTS[static_cast<uint8_t>(eType::COUNT)] = { 16384, 4096, 4096 };
+
+		struct CreateInfo final
+		{
+			Device& Device;
+			std::unique_ptr<DescriptorPool> DescriptorPool;
+			VkDescriptorSetLayout DescriptorSetLayout;
+			VkPipelineLayout PipelineLayout;
+			VkDescriptorSet DescriptorSet;
+			std::array<uint32_t, static_cast<uint8_t>(eType::COUNT)> DescriptorsCounts;
+		};
+
+	public:
+		BindlessDescriptorSet() = delete;
+
+		BindlessDescriptorSet(const BindlessDescriptorSet&) = delete;
+		BindlessDescriptorSet& operator=(const BindlessDescriptorSet&) = delete;
+
+		~BindlessDescriptorSet() noexcept;
+
+		BindlessDescriptorSet(BindlessDescriptorSet&& other) noexcept;
+		BindlessDescriptorSet& operator=(BindlessDescriptorSet&&) = delete;
+
+		IIIXRLAB_INLINE constexpr VkDescriptorSetLayout GetDescriptorSetLayout() const noexcept { return mDescriptorSetLayout; }
+		IIIXRLAB_INLINE constexpr VkPipelineLayout GetPipelineLayout() const noexcept { return mPipelineLayout; }
+		IIIXRLAB_INLINE constexpr VkDescriptorSet GetDescriptorSet() const noexcept { return mDescriptorSet; }
+		IIIXRLAB_INLINE constexpr uint32_t GetDescriptorsCount(const eType type) const noexcept { return mDescriptorsCounts[static_cast<uint8_t>(type)]; }
+
+		// The buffer must be created with VK_BUFFER_USAGE_STORAGE_BUFFER_BIT.
+		uint32_t Register(const Buffer& buffer) noexcept;
+		// type must be SAMPLED_IMAGE or STORAGE_IMAGE and the texture must own the matching view.
+		uint32_t Register(const Texture& texture, const eType type) noexcept;
+		// The caller guarantees that no submitted work still reads the index.
+		void Unregister(const eType type, uint32_t& inoutIndex) noexcept;
+
+	protected:
+		BindlessDescriptorSet(CreateInfo& createInfo) noexcept;
+
+		uint32_t allocateIndex(const eType type) noexcept;
+
+	protected:
+		Device& mDevice;
+		std::unique_ptr<DescriptorPool> mDescriptorPool;
+		VkDescriptorSetLayout mDescriptorSetLayout;
+		VkPipelineLayout mPipelineLayout;
+		VkDescriptorSet mDescriptorSet;
+		std::array<uint32_t, static_cast<uint8_t>(eType::COUNT)> mDescriptorsCounts;
+
+		uint32_t mNextIndices[static_cast<uint8_t>(eType::COUNT)];
+		std::vector<uint32_t> mFreeIndices[static_cast<uint8_t>(eType::COUNT)];
+	};
+} // namespace iiixrlab::graphics
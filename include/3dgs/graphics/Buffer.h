@@ -20,6 +20,7 @@ namespace iiixrlab::graphics
 			GpuResource::CreateInfo GpuResourceCreateInfo;
 			VkBuffer Buffer;
 			VkDeviceMemory BufferMemory;
+			bool bIsConcurrent = false;
 		};
 
 	public:
@@ -35,16 +36,20 @@ namespace iiixrlab::graphics
 			, mBuffer(other.mBuffer)
 			, mBufferMemory(other.mBufferMemory)
 			, mDescriptorBufferInfo(other.mDescriptorBufferInfo)
+			, mbIsConcurrent(other.mbIsConcurrent)
 		{
 			other.mBuffer = VK_NULL_HANDLE;
 			other.mBufferMemory = VK_NULL_HANDLE;
 		}
 		Buffer& operator=(Buffer&&) = delete;
 
+		IIIXRLAB_INLINE constexpr VkBuffer GetBuffer() const noexcept { return mBuffer; }
 		IIIXRLAB_INLINE constexpr const VkDescriptorBufferInfo& GetDescriptorBufferInfo() const noexcept { return mDescriptorBufferInfo; }
+		// Concurrent buffers are accessed by every queue family without ownership transfers.
+		IIIXRLAB_INLINE constexpr bool IsConcurrent() const noexcept { return mbIsConcurrent; }
 
 	protected:
-		static void create(VkDevice device, CreateInfo& inoutCreateInfo, const PhysicalDevice& physicalDevice, const VkBufferUsageFlags usage, const VkMemoryPropertyFlags& memoryPropertyFlag) noexcept;
+		static void create(VkDevice device, CreateInfo& inoutCreateInfo, const PhysicalDevice& physicalDevice, const VkBufferUsageFlags usage, const VkMemoryPropertyFlags& memoryPropertyFlag, const bool bIsShared = false) noexcept;
 
 	protected:
 		IIIXRLAB_INLINE constexpr Buffer(const CreateInfo& createInfo) noexcept
@@ -52,6 +57,7 @@ namespace iiixrlab::graphics
 			, mBuffer(createInfo.Buffer)
 			, mBufferMemory(createInfo.BufferMemory)
 			, mDescriptorBufferInfo({ .buffer = mBuffer, .offset = 0, .range = GetTotalSize() })
+			, mbIsConcurrent(createInfo.bIsConcurrent)
 		{
 		}
 
@@ -59,5 +65,6 @@ namespace iiixrlab::graphics
 		VkBuffer mBuffer;
 		VkDeviceMemory mBufferMemory;
 		VkDescriptorBufferInfo mDescriptorBufferInfo;
+		bool mbIsConcurrent;
 	};
 }
\ No newline at end of file
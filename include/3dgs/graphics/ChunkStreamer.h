@@ -0,0 +1,106 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/scene/ChunkLoader.h"
+
+namespace iiixrlab::scene
+{
+	class Camera;
+	class Gaussian;
+}   // namespace iiixrlab::scene
+
+namespace iiixrlab::graphics
+{
+	class Device;
+	class VertexBuffer;
+
+	// Keeps the chunks of a scene cache worth drawing from the camera in video memory, within a budget. Chunks are read
+	// by a ChunkLoader and uploaded as they arrive. Once the budget is reached, the chunks the camera stopped wanting
+	// the longest ago are evicted first. The preview chunk of a progressive scene cache is always kept as a coarse
+	// stand-in for the chunks which are not resident.
+	class ChunkStreamer final
+	{
+	public:
+		struct CreateInfo final
+		{
+			Device& Device;
+			std::filesystem::path Path;
+			uint64_t Budget;				// bytes of vertex buffers, exceeded only by evicted chunks frames in flight still draw
+			iiixrlab::FileReadInfo FileReadInfo;
+		};
+
+		struct ResidentChunk final
+		{
+			uint32_t ChunkIndex;
+			std::unique_ptr<iiixrlab::scene::GaussianInfo> GaussianInfo;
+			std::unique_ptr<iiixrlab::scene::Gaussian> Gaussian;
+			std::unique_ptr<iiixrlab::graphics::VertexBuffer> VertexBuffer;
+			uint32_t VertexBufferBindlessIndex;
+			uint64_t Size;
+			uint64_t WantedUpdateIndex;		// last update which selected the chunk
+		};
+
+	public:
+		ChunkStreamer() = delete;
+		// Failing to open the scene cache or finding no chunks in it leaves the streamer closed.
+		ChunkStreamer(CreateInfo& createInfo) noexcept;
+
+		ChunkStreamer(const ChunkStreamer&) = delete;
+		ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+		ChunkStreamer(ChunkStreamer&&) = delete;
+		ChunkStreamer& operator=(ChunkStreamer&&) = delete;
+
+		~ChunkStreamer() noexcept;
+
+		IIIXRLAB_INLINE bool IsOpen() const noexcept { return mLoader.IsOpen() == true && mLoader.GetReader().GetChunks().empty() == false; }
+		IIIXRLAB_INLINE constexpr const std::vector<ResidentChunk>& GetResidentChunks() const noexcept { return mResidentChunks; }
+		IIIXRLAB_INLINE constexpr uint64_t GetBudget() const noexcept { return mBudget; }
+		IIIXRLAB_INLINE constexpr uint64_t GetResidentSize() const noexcept { return mResidentSize; }
+		IIIXRLAB_INLINE constexpr uint64_t GetPeakResidentSize() const noexcept { return mPeakResidentSize; }
+		IIIXRLAB_INLINE constexpr uint64_t GetUploadedChunksCount() const noexcept { return mUploadedChunksCount; }
+		IIIXRLAB_INLINE constexpr uint64_t GetEvictedChunksCount() const noexcept { return mEvictedChunksCount; }
+
+		// Once per frame ahead of recording it: uploads the chunks read since the last update, requests the ones the
+		// camera wants next and releases the evicted chunks none of the framesCount frames in flight draws anymore.
+		void Update(const iiixrlab::scene::Camera& camera, const uint32_t framesCount) noexcept;
+
+	private:
+		// Evicts unwanted chunks, least recently wanted first, until size fits into the budget.
+		bool makeRoom(const uint64_t size, const std::vector<uint8_t>& bAreChunksWanted) noexcept;
+
+	private:
+		struct EvictedChunk final
+		{
+			ResidentChunk Chunk;
+			uint64_t UpdateIndex;
+		};
+
+		// Read, but waiting for chunks still uploading to become evictable before it fits into the budget.
+		struct PendingChunk final
+		{
+			uint32_t ChunkIndex;
+			std::unique_ptr<iiixrlab::scene::GaussianInfo> GaussianInfo;
+			std::unique_ptr<iiixrlab::scene::Gaussian> Gaussian;
+			uint32_t Size;
+		};
+
+	private:
+		Device& mDevice;
+		iiixrlab::scene::ChunkLoader mLoader;
+		uint64_t mBudget;
+		uint32_t mPinnedChunksCount;
+		std::vector<uint64_t> mChunkSizes;			// estimated until the chunk is first uploaded
+		std::vector<uint8_t> mbAreChunksResident;
+		std::vector<uint8_t> mbAreChunksPending;
+		std::vector<ResidentChunk> mResidentChunks;
+		std::vector<PendingChunk> mPendingChunks;	// tried again every update instead of being read again
+		std::deque<EvictedChunk> mEvictedChunks;	// released once no frame in flight draws them
+		uint64_t mUpdateIndex;
+		uint64_t mResidentSize;
+		uint64_t mPeakResidentSize;
+		uint64_t mUploadedChunksCount;
+		uint64_t mEvictedChunksCount;
+	};
+} // namespace iiixrlab::graphics
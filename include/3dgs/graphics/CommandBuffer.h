@@ -8,6 +8,7 @@ namespace iiixrlab::graphics
 	class Device;
 	class FrameResource;
 	class Pipeline;
+	class Texture;
 	class VertexBuffer;
 
 	class CommandBuffer final
@@ -19,7 +20,9 @@ namespace iiixrlab::graphics
 		struct CreateInfo final
 		{
 			Device& Device;
+			VkCommandPool CommandPool;
 			VkCommandBuffer CommandBuffer;
+			uint32_t QueueFamilyIndex;
 		};
 
 		struct VertexBindingInfo final
@@ -45,24 +48,41 @@ namespace iiixrlab::graphics
 		IIIXRLAB_INLINE constexpr const FrameResource& GetFrameResource() const noexcept { return *mFrameResourceOrNull; }
 
 		IIIXRLAB_INLINE constexpr const Pipeline& GetPipeline() const noexcept { return *mPipelineOrNull; }
+		IIIXRLAB_INLINE constexpr uint32_t GetQueueFamilyIndex() const noexcept { return mQueueFamilyIndex; }
+		IIIXRLAB_INLINE constexpr bool IsRendering() const noexcept { return mbIsRendering; }
 
 		void Barrier(const VkPipelineStageFlags srcStageMask, const VkPipelineStageFlags dstStageMask, const VkImageMemoryBarrier& imageMemoryBarriers) noexcept;
+		void Barrier(const VkPipelineStageFlags srcStageMask, const VkPipelineStageFlags dstStageMask, const VkBufferMemoryBarrier& bufferMemoryBarrier) noexcept;
+		// Begins recording outside of a frame, e.g. for transfer work.
+		void Begin() noexcept;
 		void Begin(FrameResource& frameResource) noexcept;
+		// Begins the frame's compute recording, no back buffer is touched.
+		void BeginCompute(FrameResource& frameResource) noexcept;
 		void BeginRender() noexcept;
 		void BindDescriptorSets(const VkPipelineLayout pipelineLayout, const VkDescriptorSet& descriptorSet) noexcept;
 		void Bind(const Pipeline& pipeline) noexcept;
-		void Bind(const VertexBuffer& vertexBuffer, const std::vector<VertexBindingInfo>& vertexBindingInfos) noexcept;
+		void Bind(const VertexBuffer& vertexBuffer, const std::vector<VertexBindingInfo>& vertexBindingInfos, const VkDeviceSize baseOffset = 0) noexcept;
 		void CopyBuffer(const Buffer& srcBuffer, Buffer& dstBuffer, const VkBufferCopy& bufferCopy) noexcept;
+		// Copies the whole color image, which has to be in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, as tightly packed rows.
+		void CopyTextureToBuffer(const Texture& srcTexture, Buffer& dstBuffer) noexcept;
+		void Dispatch(const uint32_t groupCountX, const uint32_t groupCountY, const uint32_t groupCountZ) noexcept;
 		void Draw(const uint32_t vertexCount, const uint32_t instanceCount, const uint32_t firstVertex, const uint32_t firstInstance) noexcept;
 		void DrawIndexed(const uint32_t indexCount, const uint32_t instanceCount, const uint32_t firstIndex, const int32_t vertexOffset, const uint32_t firstInstance) noexcept;
 		void End() noexcept;
+		void PushConstants(const void* data, const uint32_t size, const uint32_t offset = 0) noexcept;
 		void Reset() noexcept;
+		// Outside of rendering only, Device::ResetQueryPool() resets from the host instead when hostQueryReset is enabled.
+		void ResetQueryPool(const VkQueryPool queryPool, const uint32_t firstQuery, const uint32_t queriesCount) noexcept;
+		void WriteTimestamp(const VkQueryPool queryPool, const uint32_t query) noexcept;
 	
 	private:
 		Device& mDevice;
+		VkCommandPool mCommandPool;
 		VkCommandBuffer mCommandBuffer;
+		uint32_t mQueueFamilyIndex;
 
 		FrameResource* mFrameResourceOrNull;
 		const Pipeline* mPipelineOrNull;
+		bool mbIsRendering;
 	};
 } // namespace iiixrlab::graphics
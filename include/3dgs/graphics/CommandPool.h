@@ -14,6 +14,7 @@ namespace iiixrlab::graphics
         {
             Device& Device;
             VkCommandPool CommandPool;
+            uint32_t QueueFamilyIndex;
         };
 
     public:
@@ -32,6 +33,7 @@ namespace iiixrlab::graphics
         IIIXRLAB_INLINE CommandBuffer& GetCommandBuffer(const uint32_t index) noexcept { return *mCommandBuffers[index]; }
         IIIXRLAB_INLINE const CommandBuffer& GetCommandBuffer(const uint32_t index) const noexcept { return *mCommandBuffers[index]; }
         IIIXRLAB_INLINE constexpr VkCommandPool GetCommandPool() const noexcept { return mCommandPool; }
+        IIIXRLAB_INLINE constexpr uint32_t GetQueueFamilyIndex() const noexcept { return mQueueFamilyIndex; }
 
         void AllocateCommandBuffers(const char* name, const uint32_t commandBuffersCount) noexcept;
         void FreeCommandBuffers() noexcept;
@@ -39,6 +41,7 @@ namespace iiixrlab::graphics
     private:
         Device& mDevice;
         VkCommandPool mCommandPool;
+        uint32_t mQueueFamilyIndex;
 
         std::vector<std::unique_ptr<CommandBuffer>> mCommandBuffers;
     };
@@ -25,7 +25,12 @@ namespace iiixrlab::graphics
 		IIIXRLAB_INLINE constexpr ConstantBuffer(ConstantBuffer&& other) noexcept = default;
 		ConstantBuffer& operator=(ConstantBuffer&&) = delete;
 
-		bool SetData(const void* data, const size_t size) noexcept;
+		// The buffer holds one aligned slot per frame in flight (GetSize() slots of GetStride() bytes).
+		// Writing the slot of the recording frame never touches memory the GPU may still be reading.
+		bool SetData(const void* data, const size_t size, const uint32_t frameIndex) noexcept;
+
+		IIIXRLAB_INLINE constexpr uint32_t GetDynamicOffset(const uint32_t frameIndex) const noexcept { return frameIndex * mStride; }
+		IIIXRLAB_INLINE constexpr uint8_t* GetMappedDataOrNull(const uint32_t frameIndex) const noexcept { return mMappedData != nullptr ? mMappedData + GetDynamicOffset(frameIndex) : nullptr; }
 
 	protected:
 		ConstantBuffer(const CreateInfo& createInfo) noexcept;
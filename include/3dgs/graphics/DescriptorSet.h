@@ -30,22 +30,29 @@ namespace iiixrlab::graphics
         IIIXRLAB_INLINE constexpr DescriptorSet(DescriptorSet&& other) noexcept
             : mDevice(other.mDevice)
             , mDescriptorSet(other.mDescriptorSet)
+            , mDynamicOffsetStride(other.mDynamicOffsetStride)
         {
             other.mDescriptorSet = VK_NULL_HANDLE;
+            other.mDynamicOffsetStride = 0;
         }
         DescriptorSet& operator=(DescriptorSet&&) = delete;
 
         void Bind(const ConstantBuffer& descriptorBufferInfos) noexcept;
+
+        IIIXRLAB_INLINE constexpr bool HasDynamicOffset() const noexcept { return mDynamicOffsetStride != 0; }
+        IIIXRLAB_INLINE constexpr uint32_t GetDynamicOffset(const uint32_t frameIndex) const noexcept { return frameIndex * mDynamicOffsetStride; }
     
     protected:
         IIIXRLAB_INLINE constexpr DescriptorSet(const CreateInfo& createInfo) noexcept
             : mDevice(createInfo.Device)
             , mDescriptorSet(createInfo.DescriptorSet)
+            , mDynamicOffsetStride(0)
         {
         }
     
     protected:
         Device& mDevice;
         VkDescriptorSet mDescriptorSet;
+        uint32_t mDynamicOffsetStride;
     };
 } // namespace iiixrlab::graphics
@@ -6,17 +6,22 @@ namespace iiixrlab::graphics
 {
 #undef CreateSemaphore
 
+	class BindlessDescriptorSet;
 	class Buffer;
 	class CommandPool;
 	class ConstantBuffer;
 	class DescriptorPool;
 	class DescriptorSet;
+	class GpuProfiler;
 	class Pipeline;
 	class PhysicalDevice;
 	class Queue;
+	class ReadbackBuffer;
 	class StagingBuffer;
+	class StorageBuffer;
 	class SwapChain;
 	class Texture;
+	class Uploader;
 	class VertexBuffer;
 
 	struct PipelineCreateInfo final
@@ -27,8 +32,15 @@ namespace iiixrlab::graphics
 		std::vector<VkDescriptorSetLayoutBinding> DescriptorSetLayoutBindings;
 		std::vector<std::string> ShaderNames;
 		VkPipelineLayout PipelineLayout;
-		Texture& ColorAttachment;
-		Texture& DepthAttachment;
+		const Texture& ColorAttachment;
+		const Texture& DepthAttachment;
+	};
+
+	struct ComputePipelineCreateInfo final
+	{
+		const char* Name;
+		std::vector<VkDescriptorSetLayoutBinding> DescriptorSetLayoutBindings;
+		std::string ShaderName;
 	};
 
 	struct TextureCreateInfo final
@@ -68,26 +80,46 @@ namespace iiixrlab::graphics
 
 		IIIXRLAB_INLINE Queue& GetQueue(const uint32_t index = 0) noexcept { return *mQueues[index]; }
 		IIIXRLAB_INLINE const Queue& GetQueue(const uint32_t index = 0) const noexcept { return *mQueues[index]; }
+		// Falls back to the last main family queue when the device exposes no separate transfer family.
+		IIIXRLAB_INLINE Queue& GetTransferQueue() noexcept { return mTransferQueues.empty() ? *mQueues.back() : *mTransferQueues[0]; }
+		// Falls back to the graphics queue, compute work is then simply serialized with rasterization.
+		IIIXRLAB_INLINE Queue& GetComputeQueue() noexcept { return mComputeQueues.empty() ? *mQueues[0] : *mComputeQueues[0]; }
 		IIIXRLAB_INLINE const PhysicalDevice& GetPhysicalDevice() const noexcept { return mPhysicalDevice; }
 		IIIXRLAB_INLINE DescriptorPool& GetDescriptorPool() noexcept { return *mDescriptorPool; }
 		IIIXRLAB_INLINE const DescriptorPool& GetDescriptorPool() const noexcept { return *mDescriptorPool; }
+		IIIXRLAB_INLINE BindlessDescriptorSet& GetBindlessDescriptorSet() noexcept { return *mBindlessDescriptorSet; }
+		IIIXRLAB_INLINE const BindlessDescriptorSet& GetBindlessDescriptorSet() const noexcept { return *mBindlessDescriptorSet; }
+		IIIXRLAB_INLINE Uploader& GetUploader() noexcept { return *mUploader; }
+		IIIXRLAB_INLINE const Uploader& GetUploader() const noexcept { return *mUploader; }
 
 		uint32_t AcquireNextImage(const SwapChain& swapChain, const VkSemaphore semaphore, const VkFence fence) noexcept;
-		VkCommandBuffer AllocateCommandBuffer(const char* name) noexcept;
+		VkCommandBuffer AllocateCommandBuffer(const char* name, const VkCommandPool commandPool) noexcept;
 		void AllocateDescriptorSets(DescriptorPool& inoutDescriptorPool, std::vector<std::unique_ptr<DescriptorSet>>& inoutDescriptorSets, const VkDescriptorSetLayout descriptorSetLayout, const std::vector<std::string>& names) noexcept;
 		void BindDescriptorSet(DescriptorSet& descriptorSet, const ConstantBuffer& constantBuffer) noexcept;
-		std::unique_ptr<ConstantBuffer> CreateConstantBuffer(const char* name, const uint32_t bufferSize) noexcept;
-		std::unique_ptr<DescriptorPool> CreateDescriptorPool(const char* name, const uint32_t maxSets, const std::vector<VkDescriptorPoolSize>& poolSizes) noexcept;
+		void BindDescriptorSet(BindlessDescriptorSet& bindlessDescriptorSet, const uint32_t index, const Buffer& buffer) noexcept;
+		void BindDescriptorSet(BindlessDescriptorSet& bindlessDescriptorSet, const uint32_t index, const Texture& texture, const uint8_t type) noexcept;
+		std::unique_ptr<BindlessDescriptorSet> CreateBindlessDescriptorSet(const char* name) noexcept;
+		std::unique_ptr<CommandPool> CreateCommandPool(const char* name, const uint32_t queueFamilyIndex) noexcept;
+		std::unique_ptr<Pipeline> CreateComputePipeline(const ComputePipelineCreateInfo& computePipelineCreateInfo) noexcept;
+		std::unique_ptr<ConstantBuffer> CreateConstantBuffer(const char* name, const uint32_t bufferSize, const uint32_t framesCount = DEFAULT_FRAMES_COUNT) noexcept;
+		std::unique_ptr<DescriptorPool> CreateDescriptorPool(const char* name, const uint32_t maxSets, const std::vector<VkDescriptorPoolSize>& poolSizes, const VkDescriptorPoolCreateFlags flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT) noexcept;
 		VkImageView CreateImageView(const char* name, const VkImage image, const VkFormat format, const uint8_t usage) noexcept;
 		VkFence CreateFence(const char* name) noexcept;
+		// slotsCount ranges of maxScopesCount begin/end timestamp pairs, e.g. one slot per frame in flight.
+		std::unique_ptr<GpuProfiler> CreateGpuProfiler(const char* name, const uint32_t slotsCount, const uint32_t maxScopesCount = 32) noexcept;
 		std::unique_ptr<Pipeline> CreatePipeline(const PipelineCreateInfo& pipelineCreateInfo) noexcept;
+		// Host visible copy destination, e.g. for reading rendered images back.
+		std::unique_ptr<ReadbackBuffer> CreateReadbackBuffer(const char* name, const uint32_t readbackBufferSize) noexcept;
 		VkShaderModule CreateShaderModule(const char* name, const std::filesystem::path& path) noexcept;
 		VkSemaphore CreateSemaphore(const char* name) noexcept;
 		std::unique_ptr<StagingBuffer> CreateStagingBuffer(const char* name, const uint32_t stagingBufferSize) noexcept;
+		// Shared by every queue family, count elements of stride bytes (e.g. one per frame in flight).
+		std::unique_ptr<StorageBuffer> CreateStorageBuffer(const char* name, const uint32_t stride, const uint32_t count = 1) noexcept;
 		std::unique_ptr<Texture> CreateTexture(const TextureCreateInfo& textureCreateInfo) noexcept;
+		VkSemaphore CreateTimelineSemaphore(const char* name, const uint64_t initialValue = 0) noexcept;
 		std::unique_ptr<VertexBuffer> CreateVertexBuffer(const char* name, const uint32_t vertexBufferSize) noexcept;
 		void DeallocateDescriptorSets(DescriptorPool& inoutDescriptorPool, std::vector<std::unique_ptr<DescriptorSet>>& inoutDescriptorSets) noexcept;
-		void DestroyCommandBuffer(VkCommandBuffer& commandBuffer) noexcept;
+		void DestroyCommandBuffer(const VkCommandPool commandPool, VkCommandBuffer& commandBuffer) noexcept;
 		void DestroyCommandPool(VkCommandPool& commandPool) noexcept;
 		void DestroyDescriptorPool(VkDescriptorPool& descriptorPool) noexcept;
 		void DestroyDescriptorSetLayout(VkDescriptorSetLayout& descriptorSetLayout) noexcept;
@@ -96,21 +128,35 @@ namespace iiixrlab::graphics
 		void DestroyImageView(VkImageView& imageView) noexcept;
 		void DestroyPipeline(VkPipeline& pipeline) noexcept;
 		void DestroyPipelineLayout(VkPipelineLayout& pipelineLayout) noexcept;
+		void DestroyQueryPool(VkQueryPool& queryPool) noexcept;
 		void DestroySemaphore(VkSemaphore& semaphore) noexcept;
 		void DestroyShaderModule(VkShaderModule& shaderModule) noexcept;
 		void DestroySwapChain(VkSwapchainKHR& swapChain) noexcept;
 		void DestroyBuffer(VkBuffer& vertexBuffer) noexcept;
 		void FreeMemory(VkDeviceMemory& deviceMemory) noexcept;
+		// Samples the device's timestamp counter and std::chrono::steady_clock in nanoseconds at the same moment.
+		// Returns false when the device cannot calibrate its timestamps.
+		bool GetCalibratedTimestamps(uint64_t& outDeviceTimestamp, int64_t& outHostTimestamp) const noexcept;
+		// Never waits, VK_NOT_READY is returned when any of the queries is unavailable.
+		VkResult GetQueryPoolResults(const VkQueryPool queryPool, const uint32_t firstQuery, const uint32_t queriesCount, const size_t dataSize, void* data, const VkDeviceSize stride, const VkQueryResultFlags flags) const noexcept;
+		uint64_t GetSemaphoreCounterValue(const VkSemaphore timelineSemaphore) const noexcept;
 		CommandPool& InitializeCommandPool() noexcept;
+		// Makes device writes to non-coherent host visible memory visible to the host.
+		void InvalidateMappedMemory(const Buffer& buffer) noexcept;
 		void MapMemory(Buffer& buffer, void** data) noexcept;
 		void ResetFence(VkFence& fence) noexcept;
+		void ResetQueryPool(const VkQueryPool queryPool, const uint32_t firstQuery, const uint32_t queriesCount) noexcept;
 		void WaitForFence(VkFence& fence) noexcept;
+		void WaitForSemaphore(const VkSemaphore timelineSemaphore, const uint64_t value) noexcept;
 
 #if defined(_DEBUG)
 		void SetDebugName(const char* name, const VkObjectType objectType, const void* object) noexcept;
 #endif	// defined(_DEBUG)
 		
 	private:
+		VkPipelineLayout createPipelineLayout(const char* name, const std::vector<VkDescriptorSetLayoutBinding>& descriptorSetLayoutBindings, std::vector<VkDescriptorSetLayout>& outDescriptorSetLayouts, std::vector<std::unique_ptr<DescriptorSet>>& outDescriptorSets) noexcept;
+		void initializeQueues(std::vector<std::unique_ptr<Queue>>& outQueues, const uint32_t queueFamilyIndex) noexcept;
+
 		static void getQueues(std::vector<VkQueue>& outQueues, const VkDevice device, const uint32_t apiVersion, const uint32_t mainQueueFamilyPropertyIndex, const VkQueueFamilyProperties2& queueFamilyProperties) noexcept;
 
 #if defined(_DEBUG)
@@ -122,7 +168,11 @@ namespace iiixrlab::graphics
 		VkDevice mDevice;
 
 		std::vector<std::unique_ptr<Queue>> mQueues;
+		std::vector<std::unique_ptr<Queue>> mTransferQueues;
+		std::vector<std::unique_ptr<Queue>> mComputeQueues;
 		std::unique_ptr<CommandPool> mCommandPool;
 		std::unique_ptr<DescriptorPool> mDescriptorPool;
+		std::unique_ptr<BindlessDescriptorSet> mBindlessDescriptorSet;
+		std::unique_ptr<Uploader> mUploader;
 	};
 } // namespace iiixrlab::graphics
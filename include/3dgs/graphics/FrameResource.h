@@ -6,19 +6,25 @@ namespace iiixrlab::graphics
 {
 	class CommandBuffer;
 	class Device;
+	class ReadbackBuffer;
 	class SwapChain;
 	class Texture;
 
+	// Resources of one frame in flight. The frame is recycled once the renderer's timeline semaphore
+	// reaches the value signaled by its last submission, independently of the swap chain image it rendered to.
+	// Without a swap chain the frame renders into its own offscreen textures, which are left ready for readback.
 	class FrameResource final
 	{
 	public:
 		struct CreateInfo final
 		{
 			Device&			Device;
-			SwapChain&		SwapChain;
+			SwapChain*		SwapChainOrNull;
+			std::unique_ptr<Texture>	OffscreenColorOrNull;	// required when SwapChainOrNull is nullptr
+			std::unique_ptr<Texture>	OffscreenDepthOrNull;
 			CommandBuffer&	CommandBuffer;
-			Texture&		BackBuffer;
-			Texture&		DepthBuffer;
+			CommandBuffer&	ComputeCommandBuffer;
+			VkSemaphore		TimelineSemaphore;
 			uint32_t        FrameIndex;
 			uint32_t 	  	FramesCount;
 		};
@@ -28,40 +34,58 @@ namespace iiixrlab::graphics
 		FrameResource(const FrameResource&) = delete;
 		FrameResource(FrameResource&& other) noexcept;
 
-		FrameResource(const CreateInfo& createInfo) noexcept;
+		FrameResource(CreateInfo& createInfo) noexcept;
 
 		~FrameResource() noexcept;
 
 		FrameResource& operator=(const FrameResource&) = delete;
 		FrameResource& operator=(FrameResource&&) = delete;
 
-		void Begin() noexcept;
+		// The semaphore is waited on by this frame's next submission only.
+		void AddWaitSemaphore(const VkSemaphore semaphore, const uint64_t value, const VkPipelineStageFlags2 stageMask) noexcept;
+		void Begin(const uint32_t backBufferIndex) noexcept;
+		void BeginCompute() noexcept;
 		void End() noexcept;
+		void EndCompute() noexcept;
 		void Wait() noexcept;
 
-		IIIXRLAB_INLINE constexpr const SwapChain& GetSwapChain() const noexcept { return mSwapChain; }
+		IIIXRLAB_INLINE constexpr bool IsHeadless() const noexcept { return mSwapChainOrNull == nullptr; }
 		IIIXRLAB_INLINE constexpr CommandBuffer& GetCommandBuffer() noexcept { return mCommandBuffer; }
 		IIIXRLAB_INLINE constexpr const CommandBuffer& GetCommandBuffer() const noexcept { return mCommandBuffer; }
+		IIIXRLAB_INLINE constexpr CommandBuffer& GetComputeCommandBuffer() noexcept { return mComputeCommandBuffer; }
+		IIIXRLAB_INLINE constexpr const CommandBuffer& GetComputeCommandBuffer() const noexcept { return mComputeCommandBuffer; }
 		IIIXRLAB_INLINE constexpr VkSemaphore GetPresentCompleteSemaphore() const noexcept { return mPresentCompleteSemaphore; }
-		IIIXRLAB_INLINE constexpr VkSemaphore GetRenderFinishedSemaphore() const noexcept { return mRenderFinishedSemaphore; }
-		IIIXRLAB_INLINE constexpr VkFence GetWaitFence() const noexcept { return mWaitFence; }
+		VkSemaphore GetRenderFinishedSemaphore() const noexcept;
+		IIIXRLAB_INLINE constexpr VkSemaphore GetTimelineSemaphore() const noexcept { return mTimelineSemaphore; }
+		IIIXRLAB_INLINE constexpr uint64_t GetTimelineValue() const noexcept { return mTimelineValue; }
+		IIIXRLAB_INLINE constexpr void SetTimelineValue(const uint64_t timelineValue) noexcept { mTimelineValue = timelineValue; }
 		IIIXRLAB_INLINE constexpr uint32_t GetFrameIndex() const noexcept { return mFrameIndex; }
 		IIIXRLAB_INLINE constexpr uint32_t GetFramesCount() const noexcept { return mFramesCount; }
-		IIIXRLAB_INLINE constexpr Texture& GetBackBuffer() noexcept { return mBackBuffer; }
-		IIIXRLAB_INLINE constexpr const Texture& GetBackBuffer() const noexcept { return mBackBuffer; }
-		IIIXRLAB_INLINE constexpr Texture& GetDepthBuffer() noexcept { return mDepthBuffer; }
-		IIIXRLAB_INLINE constexpr const Texture& GetDepthBuffer() const noexcept { return mDepthBuffer; }
+		IIIXRLAB_INLINE constexpr uint32_t GetBackBufferIndex() const noexcept { return mBackBufferIndex; }
+		IIIXRLAB_INLINE constexpr const std::vector<VkSemaphoreSubmitInfo>& GetWaitSemaphoreSubmitInfos() const noexcept { return mWaitSemaphoreSubmitInfos; }
+		Texture& GetBackBuffer() noexcept;
+		const Texture& GetBackBuffer() const noexcept;
+		Texture& GetDepthBuffer() noexcept;
+		const Texture& GetDepthBuffer() const noexcept;
+		VkExtent2D GetExtent() const noexcept;
+		// Headless only: the color target is copied into the buffer at the end of the frame being recorded.
+		IIIXRLAB_INLINE constexpr ReadbackBuffer* GetReadbackBufferOrNull() noexcept { return mReadbackBufferOrNull; }
+		IIIXRLAB_INLINE constexpr void SetReadbackBuffer(ReadbackBuffer* readbackBufferOrNull) noexcept { mReadbackBufferOrNull = readbackBufferOrNull; }
 
 	private:
 		Device&			mDevice;
-		SwapChain& 		mSwapChain;
+		SwapChain* 		mSwapChainOrNull;
+		std::unique_ptr<Texture>	mOffscreenColorOrNull;
+		std::unique_ptr<Texture>	mOffscreenDepthOrNull;
 		CommandBuffer&	mCommandBuffer;
-        Texture&		mBackBuffer;
-        Texture&		mDepthBuffer;
+		CommandBuffer&	mComputeCommandBuffer;
 		VkSemaphore     mPresentCompleteSemaphore;
-		VkSemaphore     mRenderFinishedSemaphore;
-		VkFence         mWaitFence;
+		VkSemaphore     mTimelineSemaphore;
+		uint64_t		mTimelineValue;
 		uint32_t        mFrameIndex;
 		uint32_t		mFramesCount;
+		uint32_t		mBackBufferIndex;
+		std::vector<VkSemaphoreSubmitInfo>	mWaitSemaphoreSubmitInfos;
+		ReadbackBuffer*	mReadbackBufferOrNull;
 	};
 } // namespace iiixrlab
@@ -2,12 +2,29 @@
 
 #include "pch.h"
 
+#include "3dgs/graphics/ChunkStreamer.h"
 #include "3dgs/graphics/IRenderScene.h"
+#include "3dgs/graphics/VertexBuffer.h"
 
 #include "3dgs/scene/Gaussian.h"
+#include "3dgs/scene/SplatSorter.h"
+
+namespace iiixrlab
+{
+	class ThreadPool;
+}	// namespace iiixrlab
 
 namespace iiixrlab::graphics
 {
+	class StorageBuffer;
+
+	// Draws the splats of every renderable and resident chunk in one draw, sorted back to front together whatever model
+	// they belong to. A model is a placement of a gaussian at one of its transforms, placements out of the frustum are
+	// culled and the others share the vertex buffer of their gaussian. Splats are sorted on a thread of their own whenever
+	// the view or the models change, frames keep drawing the last sorted order meanwhile. Each frame in flight copies the
+	// models, with their world transforms, and the sorted splats into a draw list of its own, which the vertex shader
+	// pulls the splats through. Edits of a gaussian reach its vertex buffer page by page, and the holes its deleted points
+	// leave are compacted on a worker between updates, no more pages at a time than the next update uploads.
 	class GaussianRenderScene final : public TRenderScene<iiixrlab::scene::Gaussian>
 	{
 	public:
@@ -21,10 +38,146 @@ namespace iiixrlab::graphics
 		GaussianRenderScene& operator=(GaussianRenderScene&&) = delete;
 
 		~GaussianRenderScene() noexcept;
+
+		// Sum of the gaussians of every draw recorded so far.
+		IIIXRLAB_INLINE constexpr uint64_t GetDrawnSplatsCount() const noexcept { return mDrawnSplatsCount; }
+		// Tells whether more renderables are on their way. Once they are not and every renderable is uploaded,
+		// the previews standing in for them are no longer drawn.
+		IIIXRLAB_INLINE constexpr void SetLoadingComplete(const bool bIsLoadingComplete) noexcept { mbIsLoadingComplete = bIsLoadingComplete; }
+		// Draws the resident chunks of the streamer along with the renderables, streaming them in and out every update.
+		IIIXRLAB_INLINE void SetChunkStreamer(std::unique_ptr<ChunkStreamer>&& chunkStreamerOrNull) noexcept { mChunkStreamerOrNull = std::move(chunkStreamerOrNull); }
+		IIIXRLAB_INLINE const ChunkStreamer* GetChunkStreamerOrNull() const noexcept { return mChunkStreamerOrNull.get(); }
+		// Waits for the splats to be sorted for the view of every update rather than drawing the last order, e.g. for offline renders.
+		IIIXRLAB_INLINE constexpr void SetSortWaited(const bool bIsSortWaited) noexcept { mbIsSortWaited = bIsSortWaited; }
+		// The sorting thread reads the positions of the sorted gaussians until it has their depth keys, and compaction
+		// moves their points around until it is done. Every update waits for both first, gaussians read or edited between
+		// updates have to wait as well.
+		void WaitForGaussians() noexcept;
+		// Edits of a renderable or a resident chunk, each waits for the gaussians first. Point indices stay valid until the
+		// next update, which may compact them away.
+		std::vector<uint32_t> SelectInBox(const iiixrlab::scene::Gaussian& gaussian, const std::array<float, 3>& boxMin, const std::array<float, 3>& boxMax) noexcept;
+		// Deleted points are hidden at once and compacted away over the next updates.
+		void Delete(iiixrlab::scene::Gaussian& gaussian, const std::span<const uint32_t> pointIndices) noexcept;
+		// Replaces the DC component of the color, the view dependent spherical harmonics are kept.
+		void Recolor(iiixrlab::scene::Gaussian& gaussian, const std::span<const uint32_t> pointIndices, const std::array<float, 3>& colorAsShDcComponent) noexcept;
+		void Move(iiixrlab::scene::Gaussian& gaussian, const std::span<const uint32_t> pointIndices, const std::array<float, 3>& translation) noexcept;
         
 		void Render(CommandBuffer& commandBuffer) noexcept override;
 	
 	protected:
         void updateInner(iiixrlab::graphics::CommandBuffer& commandBuffer, const float deltaTime) noexcept;
+
+	private:
+		// Copies the dirty pages of the uploaded gaussians into their vertex buffers, the pages compaction filled first.
+		void uploadEdits(CommandBuffer& commandBuffer) noexcept;
+		// Placements drawable this update, each keeping the index of its model in the draw lists while it is drawn and
+		// the stride of the points it sorts for the part of the screen it covers.
+		void gatherModels() noexcept;
+		// Adopts the order of a finished sort, then sorts again if the view or the models moved since the last one.
+		void sort() noexcept;
+		void writeDrawList(CommandBuffer& commandBuffer) noexcept;
+		// Compacts the uploaded gaussians with deleted points and no edits left to upload on the compacting thread.
+		void compact() noexcept;
+
+	private:
+		static constexpr const uint32_t MODEL_INDEX_NONE = UINT32_MAX;
+		// keeps each compaction short, deleted points are hidden meanwhile
+		static constexpr const uint32_t COMPACTED_POINTS_PER_UPDATE = 1 << 16;
+		// keeps the edit staging buffer and its copies bounded, the other dirty pages wait for the next updates. A
+		// compaction fills no more pages, so they are all uploaded by the update which draws the points count it left
+		static constexpr const uint32_t UPLOADED_PAGES_PER_UPDATE = 1 << 6;
+		// a placement covering the whole screen sorts up to this many of its splats, smaller ones proportionally fewer
+		static constexpr const uint64_t SORTED_SPLATS_PER_SCREEN = 1 << 24;
+		// keeps the (placement, splat) pairs well within the 32 bit indices of the sorter, the strides grow to fit
+		static constexpr const uint64_t MAX_SORTED_SPLATS_COUNT = 1 << 28;
+
+		struct Model final
+		{
+			const iiixrlab::scene::Gaussian* Gaussian;
+			uint32_t TransformIndex;
+			uint32_t VertexBufferBindlessIndex;
+			uint32_t ShCoefficientsBindlessIndex;	// vertex buffer of the gaussian whose codebook it shares, else the same
+			uint32_t ModelIndex;
+			uint32_t PointsStride;					// every PointsStride-th point is sorted and drawn
+		};
+
+		struct SortedModel final
+		{
+			uint32_t ModelIndex;
+			iiixrlab::math::Matrix4x4f Transform;
+			uint64_t EditsCount;
+			const iiixrlab::scene::GaussianInfo* GaussianInfo;
+			uint32_t PointsStride;
+		};
+
+		// A model index is reused once the splats drawn are sorted without it.
+		struct RetiredModelIndex final
+		{
+			uint32_t ModelIndex;
+			uint64_t SortIndex;		// of the last sort started before the model went away
+		};
+
+		// The models, then a run of the sorted splats within the range one storage buffer descriptor reaches.
+		struct DrawListRange final
+		{
+			std::unique_ptr<iiixrlab::graphics::StagingBuffer> StagingBuffer;
+			uint8_t* MappedData;
+			std::unique_ptr<iiixrlab::graphics::StorageBuffer> StorageBuffer;
+			uint32_t BindlessIndex;
+			uint32_t SortedSplatsCount;
+		};
+
+		// Its ranges are drawn one after the other, back to front.
+		struct DrawList final
+		{
+			std::vector<DrawListRange> Ranges;
+			uint32_t ModelsCount;
+			uint64_t SortedSplatsVersion;
+		};
+
+		struct EditStagingBuffer final
+		{
+			std::unique_ptr<iiixrlab::graphics::StagingBuffer> StagingBuffer;
+			uint8_t* MappedData;
+		};
+
+	private:
+		uint64_t mDrawnSplatsCount;
+		// renderables added after the first update get a vertex buffer of their own, one per update that finds any
+		std::vector<std::unique_ptr<VertexBuffer>> mVertexBuffers;
+		std::vector<uint32_t> mVertexBufferBindlessIndices;
+		std::vector<uint32_t> mRenderableVertexBufferIndices;	// per renderable, into mVertexBuffers
+		bool mbIsLoadingComplete;
+		bool mbIsCameraBound;
+		bool mbIsSortWaited;
+		std::unique_ptr<ChunkStreamer> mChunkStreamerOrNull;
+
+		std::vector<Model> mModels;
+		std::unordered_map<const iiixrlab::scene::Gaussian*, std::vector<uint32_t>> mModelIndices;	// per transform, MODEL_INDEX_NONE when culled
+		std::vector<uint32_t> mFreeModelIndices;
+		std::vector<RetiredModelIndex> mRetiredModelIndices;
+		uint32_t mModelsCount;					// of the draw lists, models which went away leave a gap until their index is reused
+		uint32_t mSphereVerticesCount;
+
+		// written by the render thread before a sort starts, only the sorting thread writes the sorter and the keys while it runs
+		iiixrlab::scene::SplatSorter mSorter;
+		std::vector<SortedModel> mSortingModels;
+		std::vector<uint32_t> mSortingFirstKeyIndices;
+		std::vector<iiixrlab::scene::Gaussian::SortedSplat> mSortingSplats;
+		std::atomic<bool> mbAreSortKeysDone;
+		std::atomic<bool> mbIsSortDone;
+
+		std::unique_ptr<ThreadPool> mSortThreadPool;
+		bool mbIsSorting;
+		uint64_t mSortIndex;					// of the last sort started
+		uint64_t mSortedIndex;					// of the sort whose order is drawn
+		iiixrlab::math::Matrix4x4f mSortingView;
+		std::vector<iiixrlab::scene::Gaussian::SortedSplat> mSortedSplats;
+		uint64_t mSortedSplatsVersion;
+
+		std::unique_ptr<ThreadPool> mCompactThreadPool;
+
+		std::vector<DrawList> mDrawLists;		// per frame in flight
+		std::vector<EditStagingBuffer> mEditStagingBuffers;	// per frame in flight
 	};
 } // namespace iiixrlab::graphics
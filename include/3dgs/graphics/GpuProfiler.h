@@ -0,0 +1,109 @@
+#pragma once
+
+#include "pch.h"
+
+namespace iiixrlab::graphics
+{
+	class CommandBuffer;
+	class Device;
+
+	// Times regions of command buffer recording with timestamp queries.
+	// Every slot (e.g. a frame in flight) owns a range of the query pool. Its results are read back when the slot is
+	// reused, the caller then already waited for the slot's previous submission, so resolving never stalls the GPU.
+	// Without hostQueryReset, every scope resets its queries in its command buffer instead, so scopes have to begin
+	// outside of rendering.
+	class GpuProfiler final
+	{
+	public:
+		struct CreateInfo final
+		{
+			Device& Device;
+			const char* Name;								// track of the scopes in the CPU profiler's trace
+			VkQueryPool QueryPool;
+			uint32_t SlotsCount;
+			uint32_t MaxScopesCount;						// per slot
+			float TimestampPeriod;							// nanoseconds per tick
+			std::vector<uint64_t> TimestampMasks;			// per queue family, 0 when it cannot write timestamps
+			bool bIsHostQueryResetEnabled;
+		};
+
+		struct Statistics final
+		{
+			std::string Name;
+			double MinMilliseconds;
+			double AvgMilliseconds;
+			double P99Milliseconds;
+			uint32_t SamplesCount;
+		};
+
+		static constexpr uint32_t INVALID_SCOPE_INDEX = UINT32_MAX;
+		static constexpr uint32_t DEFAULT_SAMPLES_COUNT = 256;	// rolling window of every scope
+
+	public:
+		GpuProfiler() = delete;
+
+		GpuProfiler(const CreateInfo& createInfo) noexcept;
+
+		GpuProfiler(const GpuProfiler&) = delete;
+		GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+		~GpuProfiler() noexcept;
+
+		GpuProfiler(GpuProfiler&&) = delete;
+		GpuProfiler& operator=(GpuProfiler&&) = delete;
+
+		IIIXRLAB_INLINE constexpr bool IsEnabled() const noexcept { return mbIsEnabled; }
+		IIIXRLAB_INLINE constexpr void SetEnabled(const bool bIsEnabled) noexcept { mbIsEnabled = bIsEnabled; }
+		// Prints the statistics to stdout every reportInterval resolved slots, 0 disables the report.
+		IIIXRLAB_INLINE constexpr void SetReportInterval(const uint32_t reportInterval) noexcept { mReportInterval = reportInterval; }
+		// Drops every sample so far, e.g. of warm-up frames, statistics then cover the last samplesCount ones of each scope.
+		void ResetStatistics(const uint32_t samplesCount = DEFAULT_SAMPLES_COUNT) noexcept;
+
+		// Resolves the slot's previous timestamps and resets its queries. The slot's last submission has to be complete.
+		void BeginSlot(const uint32_t slotIndex) noexcept;
+		// The name has to outlive the slot, e.g. a string literal. Returns INVALID_SCOPE_INDEX when nothing is written.
+		uint32_t BeginScope(CommandBuffer& commandBuffer, const char* name) noexcept;
+		void EndScope(CommandBuffer& commandBuffer, const uint32_t scopeIndex) noexcept;
+
+		// Ordered by first appearance of the scope.
+		std::vector<Statistics> GetStatistics() const noexcept;
+		void Print(std::ostream& os) const noexcept;
+		void WriteJson(std::ostream& os) const noexcept;
+
+	private:
+		struct History final
+		{
+			std::string Name;
+			std::vector<double> Samples;	// milliseconds, ring of mSamplesCount
+			uint32_t NextSampleIndex;
+		};
+
+		struct Scope final
+		{
+			const char* Name;
+			uint64_t TimestampMask;
+		};
+
+	private:
+		void addSample(const char* name, const double milliseconds) noexcept;
+
+	private:
+		Device& mDevice;
+		const char* mName;
+		VkQueryPool mQueryPool;
+		uint32_t mMaxScopesCount;
+		double mTimestampPeriod;
+		std::vector<uint64_t> mTimestampMasks;
+		bool mbIsHostQueryResetEnabled;
+
+		std::vector<std::vector<Scope>> mSlotScopes;
+		uint32_t mCurrentSlotIndex;
+
+		std::vector<History> mHistories;
+		std::unordered_map<std::string, uint32_t> mHistoryIndices;
+
+		bool mbIsEnabled;
+		uint32_t mReportInterval;
+		uint32_t mResolvedSlotsCount;
+	};
+} // namespace iiixrlab::graphics
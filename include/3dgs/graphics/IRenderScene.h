@@ -5,11 +5,11 @@
 #include "3dgs/graphics/IRenderable.h"
 
 #include "3dgs/graphics/Pipeline.h"
-#include "3dgs/graphics/VertexBuffer.h"
 
 namespace iiixrlab::scene
 {
 	class Camera;
+	class CameraPath;
 }
 
 namespace iiixrlab::graphics
@@ -28,6 +28,7 @@ namespace iiixrlab::graphics
 			std::unordered_map<std::string, std::unique_ptr<Pipeline>>&& Pipelines;
 			float Width;
 			float Height;
+			uint32_t FramesCount;
 		};
 
 	public:
@@ -41,6 +42,16 @@ namespace iiixrlab::graphics
 
 		virtual ~IRenderScene() noexcept;
 
+		IIIXRLAB_INLINE iiixrlab::scene::Camera& GetCamera() noexcept { return *mCamera; }
+		IIIXRLAB_INLINE const iiixrlab::scene::Camera& GetCamera() const noexcept { return *mCamera; }
+		// Replaces the input with the poses of the path, one per Update() starting from its first. The path has to outlive its use.
+		IIIXRLAB_INLINE void SetCameraPath(const iiixrlab::scene::CameraPath* cameraPathOrNull) noexcept { mCameraPathOrNull = cameraPathOrNull; mCameraPathPoseIndex = 0; }
+
+		// Tells whether the frame has compute work for Preprocess(). Without any, the frame neither records nor submits a
+		// compute command buffer.
+		virtual bool HasPreprocess() const noexcept;
+		// Records the frame's compute work (culling, depth keys, sorting, ...) on the compute queue ahead of Render().
+		virtual void Preprocess(CommandBuffer& commandBuffer) noexcept;
 		virtual void Render(CommandBuffer& commandBuffer) noexcept = 0;
 		IIIXRLAB_INLINE void Update(CommandBuffer& commandBuffer, const float deltaTime) noexcept { update(commandBuffer, deltaTime); }
 
@@ -52,8 +63,9 @@ namespace iiixrlab::graphics
 	protected:
 		Device& mDevice;
 		std::unordered_map<std::string, std::unique_ptr<Pipeline>> mPipelines;
-		std::unique_ptr<VertexBuffer> mVertexBuffer;
 		std::unique_ptr<iiixrlab::scene::Camera>	mCamera;
+		const iiixrlab::scene::CameraPath* mCameraPathOrNull;
+		uint32_t mCameraPathPoseIndex;
 	};
 
 	template<Renderable TRenderable>
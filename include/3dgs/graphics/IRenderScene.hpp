@@ -2,7 +2,13 @@
 
 #include "3dgs/graphics/IRenderScene.h"
 
+#include "3dgs/graphics/BindlessDescriptorSet.h"
+#include "3dgs/graphics/CommandBuffer.h"
+#include "3dgs/graphics/Device.h"
+#include "3dgs/graphics/FrameResource.h"
+
 #include "3dgs/scene/Camera.h"
+#include "3dgs/scene/CameraPath.h"
 
 #include "3dgs/InputManager.h"
 
@@ -11,8 +17,9 @@ namespace iiixrlab::graphics
     IIIXRLAB_INLINE IRenderScene::IRenderScene(CreateInfo& createInfo) noexcept
         : mDevice(createInfo.Device)
         , mPipelines(std::move(createInfo.Pipelines))
-        , mVertexBuffer()
 		, mCamera()
+        , mCameraPathOrNull(nullptr)
+        , mCameraPathPoseIndex(0)
     {
         iiixrlab::scene::Camera::CreateInfo cameraCreateInfo =
         {
@@ -20,6 +27,7 @@ namespace iiixrlab::graphics
             .Position = iiixrlab::math::Vector3f{ 0.0f, 0.0f, 0.0f },
             .Width = createInfo.Width,
             .Height = createInfo.Height,
+            .FramesCount = createInfo.FramesCount,
         };
         iiixrlab::scene::Camera camera(cameraCreateInfo);
         mCamera = std::make_unique<iiixrlab::scene::Camera>(std::move(camera));
@@ -32,11 +40,15 @@ namespace iiixrlab::graphics
             pipeline.second.reset();
         }
         mPipelines.clear();
+    }
 
-        if (mVertexBuffer != nullptr)
-        {
-            mVertexBuffer.reset();
-        }
+    IIIXRLAB_INLINE bool IRenderScene::HasPreprocess() const noexcept
+    {
+        return false;
+    }
+
+    IIIXRLAB_INLINE void IRenderScene::Preprocess([[maybe_unused]] CommandBuffer& commandBuffer) noexcept
+    {
     }
 
 	template<Renderable TRenderable>
@@ -59,11 +71,6 @@ namespace iiixrlab::graphics
 	template<Renderable TRenderable>
     IIIXRLAB_INLINE void TRenderScene<TRenderable>::update(CommandBuffer& commandBuffer, const float deltaTime) noexcept
     {
-        for (auto& renderable : mRenderables)
-        {
-            renderable->Update(commandBuffer, deltaTime);
-        }
-
 		iiixrlab::math::Vector3f direction;
         InputManager& inputManager = InputManager::GetInstance();
 		const iiixrlab::InputManager::eKeyState leftKeyState = inputManager.GetKeyState('A');
@@ -109,9 +116,17 @@ namespace iiixrlab::graphics
         }
 
         const iiixrlab::math::Vector2f& ssDeltaPosition = inputManager.GetMouseDeltaPosition();
-        const iiixrlab::math::Vector3f pitchYawRoll = mCamera->GetPitchYawRollFromScreenSpaceDeltaPosition(ssDeltaPosition);
+        iiixrlab::math::Vector3f pitchYawRoll = mCamera->GetPitchYawRollFromScreenSpaceDeltaPosition(ssDeltaPosition);
+
+        if (mCameraPathOrNull != nullptr)
+        {
+            const iiixrlab::scene::CameraPath::Step step = mCameraPathOrNull->GetStep(*mCamera, mCameraPathPoseIndex++, deltaTime);
+            direction = step.Direction;
+            pitchYawRoll = step.PitchYawRoll;
+            mCamera->SetSpeed(step.Speed);
+        }
         
-        mCamera->Update(deltaTime, direction, pitchYawRoll);
+        mCamera->Update(deltaTime, direction, pitchYawRoll, commandBuffer.GetFrameResource().GetFrameIndex());
 
         updateInner(commandBuffer, deltaTime);
     }
@@ -6,9 +6,10 @@
 
 namespace iiixrlab::graphics
 {
-    class CommandBuffer;
+    class Buffer;
     class Device;
     class StagingBuffer;
+    class Uploader;
 
     class IRenderable
     {
@@ -33,14 +34,19 @@ namespace iiixrlab::graphics
         IIIXRLAB_INLINE StagingBuffer& GetStagingBuffer() noexcept { return *mStagingBuffer; }
         IIIXRLAB_INLINE const StagingBuffer& GetStagingBuffer() const noexcept { return *mStagingBuffer; }
 
-        void Update(CommandBuffer& commandBuffer, const float deltaTime) noexcept;
-        void Upload(CommandBuffer& commandBuffer, Buffer& dstBuffer) noexcept;
+        IIIXRLAB_INLINE constexpr bool IsUploading() const noexcept { return mUploadTimelineValue != UINT64_MAX; }
+        IIIXRLAB_INLINE constexpr VkDeviceSize GetDstOffset() const noexcept { return mDstOffset; }
+
+        // Hands the staging buffer over to the uploader, it is released once the copy completes.
+        void Upload(Uploader& uploader, Buffer& dstBuffer, const VkDeviceSize dstOffset) noexcept;
+        bool IsUploaded(const Uploader& uploader) const noexcept;
 
     protected:
         IIIXRLAB_INLINE IRenderable(CreateInfo& createInfo) noexcept
             : mDevice(createInfo.Device)
             , mStagingBuffer(std::move(createInfo.StagingBuffer))
-            , mUploadingFrameIndex(UINT32_MAX)
+            , mUploadTimelineValue(UINT64_MAX)
+            , mDstOffset(0)
         {
         }
 
@@ -48,7 +54,8 @@ namespace iiixrlab::graphics
 
         Device& mDevice;
         std::unique_ptr<StagingBuffer> mStagingBuffer;
-        uint32_t mUploadingFrameIndex;
+        uint64_t mUploadTimelineValue;
+        VkDeviceSize mDstOffset;
     };
 
 	template <typename RenderableType>
@@ -28,6 +28,7 @@ namespace iiixrlab::graphics
 		IIIXRLAB_INLINE const std::vector<const char*>& GetExtensionsToEnable() const noexcept { return mExtensionsToEnable; }
 
 		bool AddExtension(const std::string& extension) noexcept;
+		IIIXRLAB_INLINE bool IsExtensionAvailable(const std::string& extension) const noexcept { return mAvailableExtensions.find(extension) != mAvailableExtensions.end(); }
 
 	protected:
 		IExtensionBuilder() = default;
@@ -45,6 +46,7 @@ namespace iiixrlab::graphics
 		{
 			const iiixrlab::ProjectInfo& ApplicationInfo;
 			const iiixrlab::ProjectInfo& EngineInfo;
+			bool bIsHeadless = false;	// no surface or swap chain, frames are rendered into offscreen textures
 		};
 
 	public:
@@ -64,13 +66,14 @@ namespace iiixrlab::graphics
 		Instance& operator=(Instance&&) = delete;
 
 		IIIXRLAB_INLINE constexpr uint32_t GetApiVersion() const noexcept { return mApiVersion; }
+		IIIXRLAB_INLINE constexpr bool IsHeadless() const noexcept { return mbIsHeadless; }
 		IIIXRLAB_INLINE PhysicalDevice& GetPhysicalDevice() noexcept { return *mPhysicalDevice; }
 		IIIXRLAB_INLINE const PhysicalDevice& GetPhysicalDevice() const noexcept { return *mPhysicalDevice; }
 		IIIXRLAB_INLINE SwapChain& GetSwapChain() noexcept { return *mSwapChain; }
 		IIIXRLAB_INLINE const SwapChain& GetSwapChain() const noexcept { return *mSwapChain; }
 
 		void DestroySurface(VkSurfaceKHR& surface) noexcept;
-		SwapChain& InitializeSwapChain(const uint32_t framesCount, const Window& window) noexcept;
+		SwapChain& InitializeSwapChain(const uint32_t backBuffersCount, const Window& window) noexcept;
 	
 	private:
 		static VkPhysicalDevice selectPhysicalDevice(VkPhysicalDeviceMemoryProperties& outPhysicalDeviceMemoryProperties, const uint32_t apiVersion, VkInstance& instance) noexcept;
@@ -83,6 +86,7 @@ namespace iiixrlab::graphics
 	private:
 		VkInstance mInstance;
 		uint32_t mApiVersion;
+		bool mbIsHeadless;
 
 		std::unique_ptr<PhysicalDevice>	mPhysicalDevice;
 		std::unique_ptr<SwapChain> mSwapChain;
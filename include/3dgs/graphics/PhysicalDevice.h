@@ -27,6 +27,14 @@ namespace iiixrlab::graphics
 		static void LogProperties(const VkPhysicalDeviceProperties2& properties2, const bool bIsSelected = false) noexcept;
 		static constexpr uint32_t Score(const uint32_t apiVersion, const VkPhysicalDeviceProperties2& properties2) noexcept;
 
+	public:
+		// Host clock matching std::chrono::steady_clock, calibrated against the device's timestamps.
+#if defined(_WIN32)
+		static constexpr VkTimeDomainEXT HOST_TIME_DOMAIN = VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT;
+#else	// NOT defined(_WIN32)
+		static constexpr VkTimeDomainEXT HOST_TIME_DOMAIN = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT;
+#endif	// NOT defined(_WIN32)
+
 	public:
 		PhysicalDevice() = delete;
 		PhysicalDevice(const PhysicalDevice&) = delete;
@@ -40,23 +48,45 @@ namespace iiixrlab::graphics
 		PhysicalDevice& operator=(PhysicalDevice&&) = delete;
 
 		IIIXRLAB_INLINE constexpr VkPhysicalDeviceMemoryProperties GetPhysicalDeviceMemoryProperties() const noexcept { return mPhysicalDeviceMemoryProperties; }
+		IIIXRLAB_INLINE constexpr const VkPhysicalDeviceProperties& GetPhysicalDeviceProperties() const noexcept { return mPhysicalDeviceProperties; }
+		// Limits of the bindless descriptor set, see BindlessDescriptorSet.
+		IIIXRLAB_INLINE constexpr const VkPhysicalDeviceDescriptorIndexingProperties& GetDescriptorIndexingProperties() const noexcept { return mDescriptorIndexingProperties; }
 		IIIXRLAB_INLINE constexpr uint32_t GetQueueFamilyIndex() const noexcept { return mQueueFamilyIndex; }
 		IIIXRLAB_INLINE constexpr const VkQueueFamilyProperties2& GetQueueFamilyProperties() const noexcept { return mQueueFamilyProperties; }
+		IIIXRLAB_INLINE const VkQueueFamilyProperties2& GetQueueFamilyProperties(const uint32_t queueFamilyIndex) const noexcept { return mQueueFamilyPropertiesList[queueFamilyIndex]; }
+		IIIXRLAB_INLINE uint32_t GetQueueFamiliesCount() const noexcept { return static_cast<uint32_t>(mQueueFamilyPropertiesList.size()); }
+		IIIXRLAB_INLINE constexpr uint32_t GetTransferQueueFamilyIndex() const noexcept { return mTransferQueueFamilyIndex; }
+		IIIXRLAB_INLINE constexpr uint32_t GetComputeQueueFamilyIndex() const noexcept { return mComputeQueueFamilyIndex; }
 		IIIXRLAB_INLINE Device& GetDevice() noexcept { return *mDevice; }
 		IIIXRLAB_INLINE const Device& GetDevice() const noexcept { return *mDevice; }
 		IIIXRLAB_INLINE const Instance& GetInstance() const noexcept { return mInstance; }
+		IIIXRLAB_INLINE constexpr bool IsCalibratedTimestampsEnabled() const noexcept { return mbIsCalibratedTimestampsEnabled; }
+		// Without it queries are reset by command buffers, see GpuProfiler.
+		IIIXRLAB_INLINE constexpr bool IsHostQueryResetEnabled() const noexcept { return mbIsHostQueryResetEnabled; }
 
 	private:
-		static VkDevice createDevice(const VkPhysicalDevice physicalDevice, const uint32_t apiVersion, const std::vector<VkQueueFamilyProperties2>& queueFamilyPropertiesList) noexcept;
-		static void logQueueFamilyProperties(const VkQueueFamilyProperties2& queueFamilyProperties2, const VkPhysicalDevice physicalDevice, const uint32_t queueFamilyIndex, const bool bIsSelected = false) noexcept;
-		static void selectMainQueueFamilyIndex(std::vector<VkQueueFamilyProperties2>& outQueueFamilyProperties, uint32_t& outMainQueueFamilyPropertyIndex, const VkPhysicalDevice physicalDevice, const uint32_t apiVersion) noexcept;
+		static VkDevice createDevice(const VkPhysicalDevice physicalDevice, const uint32_t apiVersion, const std::vector<VkQueueFamilyProperties2>& queueFamilyPropertiesList, const bool bIsHeadless, bool& outbIsCalibratedTimestampsEnabled, bool& outbIsHostQueryResetEnabled) noexcept;
+		// Reports every feature the device lacks and returns false if any.
+		static bool isDescriptorIndexingSupported(const VkPhysicalDeviceVulkan12Features& supportedFeatures) noexcept;
+		static bool isCalibratedTimestampsSupported(const VkPhysicalDevice physicalDevice) noexcept;
+		static bool isPresentationSupported(const VkPhysicalDevice physicalDevice, const uint32_t queueFamilyIndex) noexcept;
+		static void logQueueFamilyProperties(const VkQueueFamilyProperties2& queueFamilyProperties2, const VkPhysicalDevice physicalDevice, const uint32_t queueFamilyIndex, const bool bIsHeadless, const bool bIsSelected = false) noexcept;
+		static uint32_t selectDedicatedQueueFamilyIndex(const std::vector<VkQueueFamilyProperties2>& queueFamilyPropertiesList, const VkQueueFlags requiredQueueFlags, const uint32_t mainQueueFamilyIndex) noexcept;
+		static void selectMainQueueFamilyIndex(std::vector<VkQueueFamilyProperties2>& outQueueFamilyProperties, uint32_t& outMainQueueFamilyPropertyIndex, const VkPhysicalDevice physicalDevice, const uint32_t apiVersion, const bool bIsHeadless) noexcept;
 
 	private:
 		Instance&           mInstance;
 		VkPhysicalDevice    mPhysicalDevice;
 		VkPhysicalDeviceMemoryProperties mPhysicalDeviceMemoryProperties;
+		VkPhysicalDeviceProperties	mPhysicalDeviceProperties;
+		VkPhysicalDeviceDescriptorIndexingProperties	mDescriptorIndexingProperties;
 		uint32_t                    mQueueFamilyIndex;
 		VkQueueFamilyProperties2    mQueueFamilyProperties;
+		uint32_t                    mTransferQueueFamilyIndex;
+		uint32_t                    mComputeQueueFamilyIndex;
+		std::vector<VkQueueFamilyProperties2>	mQueueFamilyPropertiesList;
+		bool						mbIsCalibratedTimestampsEnabled;
+		bool						mbIsHostQueryResetEnabled;
 		std::unique_ptr<Device>	mDevice;
 	};
 } // namespace iiixrlab
@@ -10,6 +10,9 @@ namespace iiixrlab::graphics
 
 		if (apiVersion >= properties2.properties.apiVersion && MINIMUM_VK_API_VERSION <= properties2.properties.apiVersion)
 		{
+			// Any device meeting the minimum version is usable, software implementations (e.g. lavapipe) included
+			score += 1;
+
 			// Prefer discrete GPUs
 			if (properties2.properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)
 			{
@@ -19,6 +19,7 @@ namespace iiixrlab::graphics
 		{
 			Device& Device;
 			std::string Name;
+			VkPipelineBindPoint BindPoint;
 			VkPipelineLayout PipelineLayout;
 			VkPipeline Pipeline;
 			std::vector<VkDescriptorSetLayout> DescriptorSetLayouts;
@@ -41,6 +42,7 @@ namespace iiixrlab::graphics
 		IIIXRLAB_INLINE constexpr uint32_t GetDescriptorSetCount() const noexcept { return static_cast<uint32_t>(mDescriptorSets.size()); }
 
 		IIIXRLAB_INLINE const std::string& GetName() const noexcept { return mName; }
+		IIIXRLAB_INLINE constexpr VkPipelineBindPoint GetBindPoint() const noexcept { return mBindPoint; }
 
 	protected:
 		explicit Pipeline(CreateInfo& createInfo) noexcept;
@@ -48,6 +50,7 @@ namespace iiixrlab::graphics
 	private:
 		Device& mDevice;
 		std::string mName;
+		VkPipelineBindPoint mBindPoint;
 		VkPipelineLayout mPipelineLayout;
 		VkPipeline mPipeline;
 		std::vector<VkDescriptorSetLayout> mDescriptorSetLayouts;
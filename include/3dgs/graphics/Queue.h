@@ -4,6 +4,7 @@
 
 namespace iiixrlab::graphics
 {
+	class CommandBuffer;
 	class Device;
 	class FrameResource;
 	class SwapChain;
@@ -32,7 +33,10 @@ namespace iiixrlab::graphics
 
 		~Queue() noexcept;
 
+		IIIXRLAB_INLINE constexpr uint32_t GetQueueFamilyIndex() const noexcept { return mQueueFamilyIndex; }
+
 		void Present(SwapChain& swapChain, FrameResource& frameResource) noexcept;
+		void Submit(CommandBuffer& commandBuffer, const std::vector<VkSemaphoreSubmitInfo>& waitSemaphoreSubmitInfos, const std::vector<VkSemaphoreSubmitInfo>& signalSemaphoreSubmitInfos) noexcept;
 		void Submit(FrameResource& frameResource) noexcept;
 		void Wait() noexcept;
 
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/graphics/Buffer.h"
+
+namespace iiixrlab::graphics
+{
+	// Destination of image copies back to the host, mapped for its whole lifetime.
+	// The contents are valid once the submission that recorded the copy has completed.
+	class ReadbackBuffer final : public Buffer
+	{
+	public:
+		friend class Device;
+
+	public:
+		ReadbackBuffer() = delete;
+
+		ReadbackBuffer(const ReadbackBuffer&) = delete;
+		ReadbackBuffer& operator=(const ReadbackBuffer&) = delete;
+
+		~ReadbackBuffer() noexcept = default;
+
+		IIIXRLAB_INLINE constexpr ReadbackBuffer(ReadbackBuffer&& other) noexcept = default;
+		ReadbackBuffer& operator=(ReadbackBuffer&&) = delete;
+
+		IIIXRLAB_INLINE constexpr const uint8_t* GetMappedData() const noexcept { return mMappedData; }
+		// Host cached memory is preferred for fast reads, it may need an invalidation before the host reads it.
+		IIIXRLAB_INLINE constexpr bool IsCoherent() const noexcept { return mbIsCoherent; }
+
+	protected:
+		ReadbackBuffer(const CreateInfo& createInfo, const bool bIsCoherent) noexcept;
+
+	protected:
+		uint8_t* mMappedData;
+		bool mbIsCoherent;
+	};
+} // namespace iiixrlab::graphics
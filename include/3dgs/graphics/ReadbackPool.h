@@ -0,0 +1,117 @@
+#pragma once
+
+#include "pch.h"
+
+namespace iiixrlab::graphics
+{
+	class Device;
+	class ReadbackBuffer;
+	class ReadbackPool;
+
+	// Mapped contents of a completed readback, reading it copies nothing.
+	// The buffer returns to its pool when the view is destroyed, which may happen on any thread,
+	// so a consumer can keep the view e.g. until an I/O thread has encoded the image.
+	class ReadbackView final
+	{
+	public:
+		friend class ReadbackPool;
+
+	public:
+		IIIXRLAB_INLINE ReadbackView() noexcept
+			: mPoolOrNull(nullptr)
+			, mBufferOrNull(nullptr)
+			, mExtent()
+			, mTimelineValue(0)
+		{
+		}
+
+		ReadbackView(const ReadbackView&) = delete;
+		ReadbackView& operator=(const ReadbackView&) = delete;
+
+		ReadbackView(ReadbackView&& other) noexcept;
+		ReadbackView& operator=(ReadbackView&& other) noexcept;
+
+		~ReadbackView() noexcept;
+
+		IIIXRLAB_INLINE constexpr bool IsValid() const noexcept { return mBufferOrNull != nullptr; }
+		const uint8_t* GetData() const noexcept;
+		// Tightly packed rows of 4 byte texels.
+		IIIXRLAB_INLINE constexpr VkExtent2D GetExtent() const noexcept { return mExtent; }
+		IIIXRLAB_INLINE constexpr size_t GetSize() const noexcept { return static_cast<size_t>(mExtent.width) * mExtent.height * 4; }
+		IIIXRLAB_INLINE constexpr uint64_t GetTimelineValue() const noexcept { return mTimelineValue; }
+
+	private:
+		ReadbackView(ReadbackPool& pool, ReadbackBuffer& buffer, const VkExtent2D extent, const uint64_t timelineValue) noexcept;
+
+		void release() noexcept;
+
+	private:
+		ReadbackPool*	mPoolOrNull;
+		ReadbackBuffer*	mBufferOrNull;
+		VkExtent2D		mExtent;
+		uint64_t		mTimelineValue;
+	};
+
+	// Host cached buffers receiving image copies, recycled once their views are released instead of allocated per frame.
+	// A readback completes when its timeline semaphore reaches the value signaled by the submission that recorded the copy,
+	// Pop() hands the completed ones out in recording order and only blocks when asked to.
+	class ReadbackPool final
+	{
+	public:
+		friend class ReadbackView;
+
+	public:
+		struct CreateInfo final
+		{
+			Device&		Device;
+			uint32_t	BufferSize;
+			uint32_t	InitialBuffersCount;
+		};
+
+	public:
+		ReadbackPool() = delete;
+
+		ReadbackPool(const CreateInfo& createInfo) noexcept;
+
+		ReadbackPool(const ReadbackPool&) = delete;
+		ReadbackPool& operator=(const ReadbackPool&) = delete;
+
+		// Every view has to be released before.
+		~ReadbackPool() noexcept;
+
+		ReadbackPool(ReadbackPool&&) = delete;
+		ReadbackPool& operator=(ReadbackPool&&) = delete;
+
+		IIIXRLAB_INLINE constexpr uint32_t GetBufferSize() const noexcept { return mBufferSize; }
+		IIIXRLAB_INLINE bool HasPendingReadbacks() const noexcept { return mPendingReadbacks.empty() == false; }
+
+		// Takes a free buffer for a copy of extent texels completing at timelineValue.
+		// The pool grows when every buffer is still pending or held by a view.
+		ReadbackBuffer& Acquire(const VkSemaphore timelineSemaphore, const uint64_t timelineValue, const VkExtent2D extent) noexcept;
+		// The oldest pending readback, or an invalid view when it has not completed yet and bWait is false.
+		ReadbackView Pop(const bool bWait = false) noexcept;
+
+	protected:
+		void release(ReadbackBuffer& buffer) noexcept;
+
+	protected:
+		struct PendingReadback final
+		{
+			ReadbackBuffer*	Buffer;
+			VkSemaphore		TimelineSemaphore;
+			uint64_t		TimelineValue;
+			VkExtent2D		Extent;
+		};
+
+	protected:
+		Device&		mDevice;
+		uint32_t	mBufferSize;
+
+		// views are released from any thread, the free list and the pool's growth are guarded together
+		std::mutex									mMutex;
+		std::vector<std::unique_ptr<ReadbackBuffer>>	mBuffers;
+		std::vector<ReadbackBuffer*>				mFreeBuffers;
+
+		std::deque<PendingReadback>	mPendingReadbacks;
+	};
+} // namespace iiixrlab::graphics
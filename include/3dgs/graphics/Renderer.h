@@ -6,16 +6,24 @@
 
 namespace iiixrlab
 {
-	class Texture;
 	class Window;
 
 	namespace graphics
 	{
+		class CommandPool;
 		class FrameResource;
+		class GpuProfiler;
 		class Instance;
 		class IRenderScene;
+		class ReadbackPool;
+		class ReadbackView;
+		class Texture;
 
 		struct RendererCreateInfo;
+
+		// Receives a headless frame's color target once the host may read it.
+		// The view may be kept, e.g. by an I/O thread, its buffer is only recycled once the view is destroyed.
+		using ReadbackCallback = std::function<void(ReadbackView&& readbackView)>;
 	
 		class Renderer final
 		{
@@ -38,15 +46,50 @@ namespace iiixrlab
 			IIIXRLAB_INLINE Instance& GetInstance() noexcept { return *mInstance; }
 			IIIXRLAB_INLINE const Instance& GetInstance() const noexcept { return *mInstance; }
 
+			IIIXRLAB_INLINE uint32_t GetFramesCount() const noexcept { return static_cast<uint32_t>(mFrameResources.size()); }
+
+			// Frame, Draw and Preprocess timings, resolved once the frames are recycled.
+			IIIXRLAB_INLINE GpuProfiler& GetGpuProfiler() noexcept { return *mGpuProfiler; }
+			IIIXRLAB_INLINE const GpuProfiler& GetGpuProfiler() const noexcept { return *mGpuProfiler; }
+
+			// Frames are handed over in submission order as soon as they completed, from Update() or from Flush().
+			IIIXRLAB_INLINE void SetReadbackCallback(ReadbackCallback&& readbackCallback) noexcept { mReadbackCallback = std::move(readbackCallback); }
+
+			// Any of the render targets, they all share the formats and the extent the pipelines are created for.
+			const Texture& GetColorAttachment() const noexcept;
+			const Texture& GetDepthAttachment() const noexcept;
+			VkExtent2D GetExtent() const noexcept;
+
+			// Waits for every submitted frame, delivers their pending readbacks and resolves their GPU timings.
+			void Flush() noexcept;
 			void Render() noexcept;
 			void Update(const float deltaTime) noexcept;
 	
+		private:
+			void preprocess(FrameResource& frameResource) noexcept;
+			void readBack() noexcept;
+
 		private:
 			std::unique_ptr<IRenderScene>	mRenderScene;
 			std::unique_ptr<Instance>		mInstance;
 	
 			std::vector<std::unique_ptr<FrameResource>> mFrameResources;
 			uint32_t mCurrentFrameIndex;
+
+			VkSemaphore mFrameTimelineSemaphore;
+			uint64_t	mFrameTimelineValue;
+
+			// compute work of a frame is submitted before its rasterization, which waits on the reached value
+			std::unique_ptr<CommandPool> mComputeCommandPool;
+			VkSemaphore mComputeTimelineSemaphore;
+			uint64_t	mComputeTimelineValue;
+
+			std::unique_ptr<ReadbackPool> mReadbackPoolOrNull;
+			ReadbackCallback mReadbackCallback;
+
+			// one slot per frame resource, the frame scope spans Update() to Render()
+			std::unique_ptr<GpuProfiler> mGpuProfiler;
+			uint32_t mFrameScopeIndex;
 		};
 	
 		
@@ -54,8 +97,11 @@ namespace iiixrlab
 		{
 			ProjectInfo ApplicationInfo;
 			ProjectInfo EngineInfo;
-			uint32_t    FramesCount = DEFAULT_FRAMES_COUNT;
-			Window&     Window;
+			uint32_t    FramesCount = DEFAULT_FRAMES_COUNT;				// latency: frames the CPU may record ahead of the GPU
+			uint32_t    BackBuffersCount = DEFAULT_BACK_BUFFERS_COUNT;	// throughput: images in the swap chain
+			Window*     WindowOrNull = nullptr;							// headless when nullptr, each frame then renders into its own offscreen textures
+			VkExtent2D  HeadlessExtent = {};
+			bool        bIsReadbackEnabled = false;						// headless only, every frame copies its color target back to the host
 		};
 	}
 }
\ No newline at end of file
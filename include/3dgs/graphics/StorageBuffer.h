@@ -0,0 +1,35 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/graphics/Buffer.h"
+
+namespace iiixrlab::graphics
+{
+	// Device local buffer shared by every queue family, e.g. the per-frame outputs of compute preprocessing.
+	class StorageBuffer final : public Buffer
+	{
+	public:
+		friend class CommandBuffer;
+		friend class Device;
+
+	public:
+		StorageBuffer() = delete;
+
+		StorageBuffer(const StorageBuffer&) = delete;
+		StorageBuffer& operator=(const StorageBuffer&) = delete;
+
+		~StorageBuffer() noexcept = default;
+
+		IIIXRLAB_INLINE constexpr StorageBuffer(StorageBuffer&& other) noexcept = default;
+		StorageBuffer& operator=(StorageBuffer&&) = delete;
+
+		IIIXRLAB_INLINE constexpr VkDeviceSize GetOffset(const uint32_t index) const noexcept { return static_cast<VkDeviceSize>(index) * mStride; }
+
+	protected:
+		IIIXRLAB_INLINE constexpr StorageBuffer(const CreateInfo& createInfo) noexcept
+			: Buffer(createInfo)
+		{
+		}
+	};
+} // namespace iiixrlab::graphics
@@ -11,6 +11,9 @@ namespace iiixrlab::graphics
 	{
 		std::unique_ptr<Texture>	Color;
 		std::unique_ptr<Texture>	Depth;
+		// signaled by the frame rendering into this image and waited by its presentation,
+		// owned per image since an image may be reacquired before the frame that presented it is recycled
+		VkSemaphore					RenderFinishedSemaphore;
 	};
 	
 	class SwapChain final
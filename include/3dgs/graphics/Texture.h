@@ -16,6 +16,7 @@ namespace iiixrlab::graphics
 			STORAGE         	= 0x2,
 			COLOR_ATTACHMENT	= 0x4,
 			DEPTH_STENCIL		= 0x8,
+			TRANSFER_SRC		= 0x10,
 		};
 
 		struct CreateInfo final
@@ -23,6 +24,7 @@ namespace iiixrlab::graphics
 			Device& Device;
 			VkImage Image;
 			VkFormat Format;
+			VkExtent3D Extent;
 			VkDeviceMemory DeviceMemory;
 
 			VkImageView SampledViewOrNull;
@@ -47,6 +49,7 @@ namespace iiixrlab::graphics
 
 		IIIXRLAB_INLINE constexpr VkImage GetImage() const noexcept { return mImage; }
 		IIIXRLAB_INLINE constexpr VkFormat GetFormat() const noexcept { return mFormat; }
+		IIIXRLAB_INLINE constexpr VkExtent2D GetExtent() const noexcept { return VkExtent2D{ .width = mExtent.width, .height = mExtent.height }; }
 		IIIXRLAB_INLINE constexpr VkDeviceMemory GetDeviceMemory() const noexcept { return mDeviceMemory; }
 
 		IIIXRLAB_INLINE constexpr VkImageView GetSampledViewOrNull() const noexcept { return mSampledViewOrNull; }
@@ -58,6 +61,7 @@ namespace iiixrlab::graphics
 		Device& mDevice;
 		VkImage mImage;
 		VkFormat mFormat;
+		VkExtent3D mExtent;
 		VkDeviceMemory mDeviceMemory;
 
 		VkImageView mSampledViewOrNull;
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "pch.h"
+
+namespace iiixrlab::graphics
+{
+	class Buffer;
+	class CommandPool;
+	class Device;
+	class FrameResource;
+	class GpuProfiler;
+	class Queue;
+	class StagingBuffer;
+
+	// Records staging copies on the transfer queue and hands the destination buffers over to the graphics queue.
+	// Uploads are tracked by the value the upload timeline semaphore reaches once their copy is done:
+	// Flush() submits the pending copies and Acquire() adopts the finished ones into a frame without stalling it.
+	class Uploader final
+	{
+	public:
+		friend class Device;
+
+	public:
+		struct CreateInfo final
+		{
+			Device&	Device;
+			Queue&	Queue;
+			std::unique_ptr<CommandPool> CommandPool;
+			std::unique_ptr<GpuProfiler> GpuProfiler;			// one slot per upload command buffer
+			VkSemaphore TimelineSemaphore;
+			uint32_t SrcQueueFamilyIndex;
+			uint32_t DstQueueFamilyIndex;
+		};
+
+	public:
+		Uploader() = delete;
+
+		Uploader(const Uploader&) = delete;
+		Uploader& operator=(const Uploader&) = delete;
+
+		~Uploader() noexcept;
+
+		Uploader(Uploader&& other) noexcept;
+		Uploader& operator=(Uploader&&) = delete;
+
+		IIIXRLAB_INLINE GpuProfiler& GetGpuProfiler() noexcept { return *mGpuProfiler; }
+		IIIXRLAB_INLINE const GpuProfiler& GetGpuProfiler() const noexcept { return *mGpuProfiler; }
+		IIIXRLAB_INLINE constexpr VkSemaphore GetTimelineSemaphore() const noexcept { return mTimelineSemaphore; }
+		IIIXRLAB_INLINE constexpr uint64_t GetAcquiredTimelineValue() const noexcept { return mAcquiredTimelineValue; }
+		// Sum of the sizes of every flushed upload.
+		IIIXRLAB_INLINE constexpr uint64_t GetUploadedBytesCount() const noexcept { return mUploadedBytesCount; }
+		IIIXRLAB_INLINE constexpr bool IsAcquired(const uint64_t timelineValue) const noexcept { return timelineValue <= mAcquiredTimelineValue; }
+
+		// The staging buffer is kept alive until the copy completes. Returns the timeline value of the upload.
+		uint64_t Upload(std::unique_ptr<StagingBuffer>&& stagingBuffer, Buffer& dstBuffer, const VkDeviceSize dstOffset) noexcept;
+		void Flush() noexcept;
+		void Acquire(FrameResource& frameResource) noexcept;
+		void Wait() noexcept;
+
+	protected:
+		Uploader(CreateInfo& createInfo) noexcept;
+
+	protected:
+		struct Request final
+		{
+			std::unique_ptr<StagingBuffer> StagingBuffer;
+			Buffer* DstBuffer;
+			VkDeviceSize DstOffset;
+			uint64_t TimelineValue;
+		};
+
+	protected:
+		Device& mDevice;
+		Queue& mQueue;
+		std::unique_ptr<CommandPool> mCommandPool;
+		std::unique_ptr<GpuProfiler> mGpuProfiler;
+		VkSemaphore mTimelineSemaphore;
+		uint32_t mSrcQueueFamilyIndex;
+		uint32_t mDstQueueFamilyIndex;
+
+		std::vector<uint64_t> mCommandBufferTimelineValues;
+		uint32_t mCommandBufferIndex;
+
+		std::vector<Request> mPendingRequests;
+		std::deque<Request> mSubmittedRequests;
+		uint64_t mSubmittedTimelineValue;
+		uint64_t mAcquiredTimelineValue;
+		uint64_t mUploadedBytesCount;
+	};
+} // namespace iiixrlab::graphics
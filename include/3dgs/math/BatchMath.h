@@ -0,0 +1,37 @@
+#pragma once
+
+#include "pch.h"
+
+namespace iiixrlab::math
+{
+	// Instruction sets the batch functions dispatch between at run time.
+	enum class eCpuFeatureLevel : uint8_t
+	{
+		SCALAR,
+		SSE4_2,
+		AVX2,		// with FMA
+		AVX512,		// AVX-512F
+	};
+
+	// Highest level both the CPU and the OS support, detected once.
+	eCpuFeatureLevel GetSupportedCpuFeatureLevel() noexcept;
+	eCpuFeatureLevel GetCpuFeatureLevel() noexcept;
+	// Lowers the level the batch functions use, e.g. to compare levels in the benchmarks. The level is clamped to the
+	// supported one, which is returned.
+	eCpuFeatureLevel SetCpuFeatureLevel(const eCpuFeatureLevel level) noexcept;
+	const char* GetCpuFeatureLevelName(const eCpuFeatureLevel level) noexcept;
+
+	// Batch functions over the flat arrays GaussianInfo stores, i.e. one attribute per array with (x, y, z) positions
+	// and (x, y, z, w) rotations packed per splat. Outputs may alias their input when both have the same stride.
+
+	// Transforms positions as row vectors with w = 1 by the affine matrix.
+	void TransformPoints(const std::span<const float> positions, const Matrix4x4f& matrix, const std::span<float> outPositions) noexcept;
+	// The depth along the view direction, i.e. the z of TransformPoints with a view matrix.
+	void ComputeViewDepths(const std::span<const float> positions, const Matrix4x4f& view, const std::span<float> outDepths) noexcept;
+	// Normalizes the quaternions and writes one row major 3x3 rotation matrix per quaternion.
+	void ComputeRotationMatrices(const std::span<const float> rotations, const std::span<float> outMatrices) noexcept;
+	// exp, e.g. to turn log scales into scales.
+	void Exponentiate(const std::span<const float> values, const std::span<float> outValues) noexcept;
+	// 1 / (1 + exp(-x)), e.g. to turn alphas into opacities.
+	void ApplySigmoid(const std::span<const float> values, const std::span<float> outValues) noexcept;
+} // namespace iiixrlab::math
@@ -11,6 +11,10 @@ namespace iiixrlab::math
 		static constexpr ElementType Dot(const Matrix& lhs, const Matrix& rhs) noexcept;
 		static constexpr Matrix Transpose(const Matrix& matrix) noexcept;
 		static constexpr Matrix Normalize(const Matrix& matrix) noexcept;
+		// The matrix must not be singular.
+		static constexpr Matrix Inverse(const Matrix& matrix) noexcept requires(RowSize == ColumnSize && std::is_floating_point_v<ElementType>);
+		// Only for rotations followed by a translation, e.g. camera to world, which are inverted without any division.
+		static constexpr Matrix InverseRigid(const Matrix& matrix) noexcept requires(RowSize == 4 && ColumnSize == 4 && std::is_floating_point_v<ElementType>);
 
 	public:
 		static const Matrix IDENTITY;
@@ -77,6 +81,10 @@ namespace iiixrlab::math
 	template<uint8_t RowSize, uint8_t ColumnSize, Arithmetic ElementType>
 	constexpr Matrix<RowSize, ColumnSize, ElementType> operator*(const ElementType& lhs, const Matrix<RowSize, ColumnSize, ElementType>& scalar) noexcept;
 
+	// Row vectors multiply on the left, e.g. position * view.
+	template<uint8_t RowSize, uint8_t InnerSize, uint8_t ColumnSize, Arithmetic ElementType>
+	constexpr Matrix<RowSize, ColumnSize, ElementType> operator*(const Matrix<RowSize, InnerSize, ElementType>& lhs, const Matrix<InnerSize, ColumnSize, ElementType>& rhs) noexcept;
+
 	template<uint8_t RowSize, uint8_t ColumnSize, Arithmetic ElementType>
 	constexpr Matrix<RowSize, ColumnSize, ElementType> operator+(const Matrix<RowSize, ColumnSize, ElementType>& lhs, const Matrix<RowSize, ColumnSize, ElementType>& rhs) noexcept;
 
@@ -2,12 +2,19 @@
 
 #include "3dgs/math/Matrix.h"
 
-
 namespace iiixrlab::math
 {
 	template<uint8_t RowSize, uint8_t ColumnSize, Arithmetic ElementType>
 	IIIXRLAB_INLINE constexpr ElementType Matrix<RowSize, ColumnSize, ElementType>::Dot(const Matrix& lhs, const Matrix& rhs) noexcept
 	{
+		if constexpr(simd::IS_SIMD_SHAPE<RowSize, ColumnSize, ElementType>)
+		{
+			if(std::is_constant_evaluated() == false)
+			{
+				return simd::Dot<RowSize * ColumnSize>(lhs.GetElements(), rhs.GetElements());
+			}
+		}
+
 		ElementType result = 0;
 
 		if constexpr(RowSize == 1 && ColumnSize == 1)
@@ -52,6 +59,14 @@ namespace iiixrlab::math
 			result.mElements[0][0] = matrix.mElements[0][0];
 			return result;
 		}
+		else if constexpr(simd::IS_SIMD_SHAPE<RowSize, ColumnSize, ElementType> && RowSize == 4)
+		{
+			if(std::is_constant_evaluated() == false)
+			{
+				simd::Transpose4x4(matrix.GetElements(), result.GetElements());
+				return result;
+			}
+		}
 
 		for(uint8_t rowIndex = 0; rowIndex < RowSize; ++rowIndex)
 		{
@@ -82,6 +97,15 @@ namespace iiixrlab::math
 			return result;
 		}
 
+		if constexpr(simd::IS_SIMD_SHAPE<RowSize, ColumnSize, ElementType>)
+		{
+			if(std::is_constant_evaluated() == false)
+			{
+				simd::Apply<RowSize * ColumnSize>(matrix.GetElements(), length, result.GetElements(), simd::Divide);
+				return result;
+			}
+		}
+
 		for(uint8_t rowIndex = 0; rowIndex < RowSize; ++rowIndex)
 		{
 			for(uint8_t columnIndex = 0; columnIndex < ColumnSize; ++columnIndex)
@@ -93,6 +117,101 @@ namespace iiixrlab::math
 		return result;
 	}
 
+	template<uint8_t RowSize, uint8_t ColumnSize, Arithmetic ElementType>
+	IIIXRLAB_INLINE constexpr Matrix<RowSize, ColumnSize, ElementType> Matrix<RowSize, ColumnSize, ElementType>::Inverse(const Matrix& matrix) noexcept requires(RowSize == ColumnSize && std::is_floating_point_v<ElementType>)
+	{
+		Matrix result;
+
+#if defined(IIIXRLAB_SIMD_SSE)
+		if constexpr(simd::IS_SIMD_SHAPE<RowSize, ColumnSize, ElementType>)
+		{
+			if(std::is_constant_evaluated() == false)
+			{
+				[[maybe_unused]] const float determinant = simd::Inverse4x4(matrix.GetElements(), result.GetElements());
+				assert(determinant != 0.0f);
+				return result;
+			}
+		}
+#endif	// defined(IIIXRLAB_SIMD_SSE)
+
+		// Gauss-Jordan elimination with partial pivoting, applying the same row operations to the identity
+		Matrix source(matrix);
+		for(uint8_t pivotIndex = 0; pivotIndex < RowSize; ++pivotIndex)
+		{
+			uint8_t maxRowIndex = pivotIndex;
+			for(uint8_t rowIndex = pivotIndex + 1; rowIndex < RowSize; ++rowIndex)
+			{
+				if(std::abs(source.mElements[rowIndex][pivotIndex]) > std::abs(source.mElements[maxRowIndex][pivotIndex]))
+				{
+					maxRowIndex = rowIndex;
+				}
+			}
+
+			assert(source.mElements[maxRowIndex][pivotIndex] != 0);
+			if(source.mElements[maxRowIndex][pivotIndex] == 0)
+			{
+				return Matrix();
+			}
+
+			if(maxRowIndex != pivotIndex)
+			{
+				for(uint8_t columnIndex = 0; columnIndex < ColumnSize; ++columnIndex)
+				{
+					std::swap(source.mElements[pivotIndex][columnIndex], source.mElements[maxRowIndex][columnIndex]);
+					std::swap(result.mElements[pivotIndex][columnIndex], result.mElements[maxRowIndex][columnIndex]);
+				}
+			}
+
+			const ElementType pivot = source.mElements[pivotIndex][pivotIndex];
+			for(uint8_t columnIndex = 0; columnIndex < ColumnSize; ++columnIndex)
+			{
+				source.mElements[pivotIndex][columnIndex] /= pivot;
+				result.mElements[pivotIndex][columnIndex] /= pivot;
+			}
+
+			for(uint8_t rowIndex = 0; rowIndex < RowSize; ++rowIndex)
+			{
+				const ElementType factor = source.mElements[rowIndex][pivotIndex];
+				if(rowIndex == pivotIndex || factor == 0)
+				{
+					continue;
+				}
+
+				for(uint8_t columnIndex = 0; columnIndex < ColumnSize; ++columnIndex)
+				{
+					source.mElements[rowIndex][columnIndex] -= factor * source.mElements[pivotIndex][columnIndex];
+					result.mElements[rowIndex][columnIndex] -= factor * result.mElements[pivotIndex][columnIndex];
+				}
+			}
+		}
+
+		return result;
+	}
+
+	template<uint8_t RowSize, uint8_t ColumnSize, Arithmetic ElementType>
+	IIIXRLAB_INLINE constexpr Matrix<RowSize, ColumnSize, ElementType> Matrix<RowSize, ColumnSize, ElementType>::InverseRigid(const Matrix& matrix) noexcept requires(RowSize == 4 && ColumnSize == 4 && std::is_floating_point_v<ElementType>)
+	{
+		// | R 0 |^-1   | R^T      0 |
+		// | t 1 |    = | -t * R^T 1 |
+		Matrix result;
+		for(uint8_t rowIndex = 0; rowIndex < 3; ++rowIndex)
+		{
+			for(uint8_t columnIndex = 0; columnIndex < 3; ++columnIndex)
+			{
+				result.mElements[rowIndex][columnIndex] = matrix.mElements[columnIndex][rowIndex];
+			}
+		}
+
+		for(uint8_t columnIndex = 0; columnIndex < 3; ++columnIndex)
+		{
+			result.mElements[3][columnIndex] = -(matrix.mElements[3][0] * result.mElements[0][columnIndex]
+				+ matrix.mElements[3][1] * result.mElements[1][columnIndex]
+				+ matrix.mElements[3][2] * result.mElements[2][columnIndex]);
+		}
+
+		return result;
+	}
+
 	template<uint8_t RowSize, uint8_t ColumnSize, Arithmetic ElementType>
 	const Matrix<RowSize, ColumnSize, ElementType> Matrix<RowSize, ColumnSize, ElementType>::IDENTITY;
 
@@ -100,19 +219,11 @@ namespace iiixrlab::math
 	IIIXRLAB_INLINE constexpr Matrix<RowSize, ColumnSize, ElementType>::Matrix() noexcept
 		: mElements()
 	{
-		std::memset(mElements, 0, sizeof(mElements));
-
 		if constexpr(RowSize > 1 && ColumnSize > 1)
 		{
-			for(uint8_t rowIndex = 0; rowIndex < RowSize; ++rowIndex)
+			for(uint8_t diagonalIndex = 0; diagonalIndex < std::min(RowSize, ColumnSize); ++diagonalIndex)
 			{
-				for(uint8_t columnIndex = 0; columnIndex < ColumnSize; ++columnIndex)
-				{
-					if(rowIndex == columnIndex)
-					{
-						mElements[rowIndex][columnIndex] = 1;
-					}
-				}
+				mElements[diagonalIndex][diagonalIndex] = 1;
 			}
 		}
 	}
@@ -121,26 +232,47 @@ namespace iiixrlab::math
 	IIIXRLAB_INLINE constexpr Matrix<RowSize, ColumnSize, ElementType>::Matrix(const ElementType* elements) noexcept
 		: mElements()
 	{
-		std::memcpy(mElements, elements, sizeof(mElements));
+		*this = elements;
 	}
 	
 	template<uint8_t RowSize, uint8_t ColumnSize, Arithmetic ElementType>
 	IIIXRLAB_INLINE constexpr Matrix<RowSize, ColumnSize, ElementType>::Matrix(std::initializer_list<ElementType> elements) noexcept
 		: mElements()
 	{
-		std::memcpy(mElements, elements.begin(), sizeof(mElements));
+		*this = elements.begin();
 	}
 	
 	template<uint8_t RowSize, uint8_t ColumnSize, Arithmetic ElementType>
 	IIIXRLAB_INLINE constexpr Matrix<RowSize, ColumnSize, ElementType>& Matrix<RowSize, ColumnSize, ElementType>::operator=(const ElementType* elements) noexcept
 	{
-		std::memcpy(mElements, elements, sizeof(mElements));
+		if(std::is_constant_evaluated() == false)
+		{
+			std::memcpy(mElements, elements, sizeof(mElements));
+			return *this;
+		}
+
+		for(uint8_t rowIndex = 0; rowIndex < RowSize; ++rowIndex)
+		{
+			for(uint8_t columnIndex = 0; columnIndex < ColumnSize; ++columnIndex)
+			{
+				mElements[rowIndex][columnIndex] = elements[rowIndex * ColumnSize + columnIndex];
+			}
+		}
 		return *this;
 	}
 
 	template<uint8_t RowSize, uint8_t ColumnSize, Arithmetic ElementType>
 	IIIXRLAB_INLINE constexpr Matrix<RowSize, ColumnSize, ElementType>& Matrix<RowSize, ColumnSize, ElementType>::operator*=(const ElementType& scalar) noexcept
 	{
+		if constexpr(simd::IS_SIMD_SHAPE<RowSize, ColumnSize, ElementType>)
+		{
+			if(std::is_constant_evaluated() == false)
+			{
+				simd::Apply<RowSize * ColumnSize>(GetElements(), scalar, GetElements(), simd::Multiply);
+				return *this;
+			}
+		}
+
 		if constexpr(RowSize == 1 && ColumnSize == 1)
 		{
 			mElements[0][0] *= scalar;
@@ -178,6 +310,15 @@ namespace iiixrlab::math
 	template<uint8_t RowSize, uint8_t ColumnSize, Arithmetic ElementType>
 	IIIXRLAB_INLINE constexpr Matrix<RowSize, ColumnSize, ElementType>& Matrix<RowSize, ColumnSize, ElementType>::operator/=(const ElementType& scalar) noexcept
 	{
+		if constexpr(simd::IS_SIMD_SHAPE<RowSize, ColumnSize, ElementType>)
+		{
+			if(std::is_constant_evaluated() == false)
+			{
+				simd::Apply<RowSize * ColumnSize>(GetElements(), scalar, GetElements(), simd::Divide);
+				return *this;
+			}
+		}
+
 		if constexpr(RowSize == 1 && ColumnSize == 1)
 		{
 			mElements[0][0] /= scalar;
@@ -215,6 +356,15 @@ namespace iiixrlab::math
 	template<uint8_t RowSize, uint8_t ColumnSize, Arithmetic ElementType>
 	IIIXRLAB_INLINE constexpr Matrix<RowSize, ColumnSize, ElementType>& Matrix<RowSize, ColumnSize, ElementType>::operator+=(const Matrix& other) noexcept
 	{
+		if constexpr(simd::IS_SIMD_SHAPE<RowSize, ColumnSize, ElementType>)
+		{
+			if(std::is_constant_evaluated() == false)
+			{
+				simd::Apply<RowSize * ColumnSize>(GetElements(), other.GetElements(), GetElements(), simd::Add);
+				return *this;
+			}
+		}
+
 		if constexpr(RowSize == 1 && ColumnSize == 1)
 		{
 			mElements[0][0] += other.mElements[0][0];
@@ -252,6 +402,15 @@ namespace iiixrlab::math
 	template<uint8_t RowSize, uint8_t ColumnSize, Arithmetic ElementType>
 	IIIXRLAB_INLINE constexpr Matrix<RowSize, ColumnSize, ElementType>& Matrix<RowSize, ColumnSize, ElementType>::operator-=(const Matrix& other) noexcept
 	{
+		if constexpr(simd::IS_SIMD_SHAPE<RowSize, ColumnSize, ElementType>)
+		{
+			if(std::is_constant_evaluated() == false)
+			{
+				simd::Apply<RowSize * ColumnSize>(GetElements(), other.GetElements(), GetElements(), simd::Subtract);
+				return *this;
+			}
+		}
+
 		if constexpr(RowSize == 1 && ColumnSize == 1)
 		{
 			mElements[0][0] -= other.mElements[0][0];
@@ -347,6 +506,43 @@ namespace iiixrlab::math
 		return result;
 	}
 
+	template<uint8_t RowSize, uint8_t InnerSize, uint8_t ColumnSize, Arithmetic ElementType>
+	IIIXRLAB_INLINE constexpr Matrix<RowSize, ColumnSize, ElementType> operator*(const Matrix<RowSize, InnerSize, ElementType>& lhs, const Matrix<InnerSize, ColumnSize, ElementType>& rhs) noexcept
+	{
+		Matrix<RowSize, ColumnSize, ElementType> result;
+
+		if constexpr(simd::IS_SIMD_SHAPE<RowSize, ColumnSize, ElementType> && InnerSize == 4 && ColumnSize == 4)
+		{
+			if(std::is_constant_evaluated() == false)
+			{
+				if constexpr(RowSize == 4)
+				{
+					simd::Multiply4x4(lhs.GetElements(), rhs.GetElements(), result.GetElements());
+				}
+				else
+				{
+					simd::Store4(result.GetElements(), simd::TransformRow(simd::Load4(lhs.GetElements()), rhs.GetElements()));
+				}
+				return result;
+			}
+		}
+
+		for(uint8_t rowIndex = 0; rowIndex < RowSize; ++rowIndex)
+		{
+			for(uint8_t columnIndex = 0; columnIndex < ColumnSize; ++columnIndex)
+			{
+				ElementType element = 0;
+				for(uint8_t innerIndex = 0; innerIndex < InnerSize; ++innerIndex)
+				{
+					element += lhs(rowIndex, innerIndex) * rhs(innerIndex, columnIndex);
+				}
+				result(rowIndex, columnIndex) = element;
+			}
+		}
+
+		return result;
+	}
+
 	template<uint8_t RowSize, uint8_t ColumnSize, Arithmetic ElementType>
 	IIIXRLAB_INLINE constexpr Matrix<RowSize, ColumnSize, ElementType> operator+(const Matrix<RowSize, ColumnSize, ElementType>& lhs, const Matrix<RowSize, ColumnSize, ElementType>& rhs) noexcept
 	{
@@ -0,0 +1,291 @@
+#pragma once
+
+#include "pch.h"
+
+// The instruction set is picked at compile time: SSE2 is part of every x86-64 target, FMA is used once the build
+// enables it (e.g. cmake -DIIIXRLAB_ENABLE_AVX2=ON) and NEON is part of every AArch64 target.
+// Defining IIIXRLAB_NO_SIMD keeps the scalar loops, e.g. to compare both in the benchmarks.
+#if !defined(IIIXRLAB_NO_SIMD)
+	#if defined(__aarch64__) || defined(_M_ARM64)
+		#define IIIXRLAB_SIMD_NEON
+		#include <arm_neon.h>
+	#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define IIIXRLAB_SIMD_SSE
+		#include <immintrin.h>
+	#endif	// defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#endif	// !defined(IIIXRLAB_NO_SIMD)
+
+namespace iiixrlab::math::simd
+{
+#if defined(IIIXRLAB_SIMD_SSE) || defined(IIIXRLAB_SIMD_NEON)
+	static constexpr const bool IS_ENABLED = true;
+#else	// NOT (defined(IIIXRLAB_SIMD_SSE) || defined(IIIXRLAB_SIMD_NEON))
+	static constexpr const bool IS_ENABLED = false;
+#endif	// NOT (defined(IIIXRLAB_SIMD_SSE) || defined(IIIXRLAB_SIMD_NEON))
+
+	// Vector3f, Vector4f and Matrix4x4f, the shapes every splat and camera goes through.
+	template<uint8_t RowSize, uint8_t ColumnSize, typename ElementType>
+	inline constexpr bool IS_SIMD_SHAPE = IS_ENABLED && std::is_same_v<ElementType, float>
+		&& ((RowSize == 1 && (ColumnSize == 3 || ColumnSize == 4)) || (RowSize == 4 && ColumnSize == 4));
+
+#if defined(IIIXRLAB_SIMD_SSE)
+	using Float4 = __m128;
+
+	IIIXRLAB_INLINE Float4 Load4(const float* elements) noexcept { return _mm_loadu_ps(elements); }
+	IIIXRLAB_INLINE void Store4(float* outElements, const Float4 value) noexcept { _mm_storeu_ps(outElements, value); }
+	// the fourth lane is zero, nothing past the third element is read or written
+	IIIXRLAB_INLINE Float4 Load3(const float* elements) noexcept { return _mm_movelh_ps(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(elements))), _mm_load_ss(elements + 2)); }
+	IIIXRLAB_INLINE void Store3(float* outElements, const Float4 value) noexcept { _mm_storel_pi(reinterpret_cast<__m64*>(outElements), value); _mm_store_ss(outElements + 2, _mm_movehl_ps(value, value)); }
+	IIIXRLAB_INLINE Float4 Set1(const float value) noexcept { return _mm_set1_ps(value); }
+
+	IIIXRLAB_INLINE Float4 Add(const Float4 lhs, const Float4 rhs) noexcept { return _mm_add_ps(lhs, rhs); }
+	IIIXRLAB_INLINE Float4 Subtract(const Float4 lhs, const Float4 rhs) noexcept { return _mm_sub_ps(lhs, rhs); }
+	IIIXRLAB_INLINE Float4 Multiply(const Float4 lhs, const Float4 rhs) noexcept { return _mm_mul_ps(lhs, rhs); }
+	IIIXRLAB_INLINE Float4 Divide(const Float4 lhs, const Float4 rhs) noexcept { return _mm_div_ps(lhs, rhs); }
+	// lhs * rhs + addend
+	IIIXRLAB_INLINE Float4 MultiplyAdd(const Float4 lhs, const Float4 rhs, const Float4 addend) noexcept
+	{
+#if defined(__FMA__) || defined(__AVX2__)
+		return _mm_fmadd_ps(lhs, rhs, addend);
+#else	// NOT (defined(__FMA__) || defined(__AVX2__))
+		return _mm_add_ps(_mm_mul_ps(lhs, rhs), addend);
+#endif	// NOT (defined(__FMA__) || defined(__AVX2__))
+	}
+
+	template<uint8_t LaneIndex>
+	IIIXRLAB_INLINE Float4 Broadcast(const Float4 value) noexcept { return _mm_shuffle_ps(value, value, _MM_SHUFFLE(LaneIndex, LaneIndex, LaneIndex, LaneIndex)); }
+
+	IIIXRLAB_INLINE float HorizontalSum(const Float4 value) noexcept
+	{
+		const Float4 pairSums = _mm_add_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtss_f32(_mm_add_ss(pairSums, _mm_movehl_ps(pairSums, pairSums)));
+	}
+
+	IIIXRLAB_INLINE void Transpose4x4(const float* elements, float* outElements) noexcept
+	{
+		Float4 row0 = Load4(elements);
+		Float4 row1 = Load4(elements + 4);
+		Float4 row2 = Load4(elements + 8);
+		Float4 row3 = Load4(elements + 12);
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+		Store4(outElements, row0);
+		Store4(outElements + 4, row1);
+		Store4(outElements + 8, row2);
+		Store4(outElements + 12, row3);
+	}
+#elif defined(IIIXRLAB_SIMD_NEON)
+	using Float4 = float32x4_t;
+
+	IIIXRLAB_INLINE Float4 Load4(const float* elements) noexcept { return vld1q_f32(elements); }
+	IIIXRLAB_INLINE void Store4(float* outElements, const Float4 value) noexcept { vst1q_f32(outElements, value); }
+	IIIXRLAB_INLINE Float4 Load3(const float* elements) noexcept { return vcombine_f32(vld1_f32(elements), vld1_lane_f32(elements + 2, vdup_n_f32(0.0f), 0)); }
+	IIIXRLAB_INLINE void Store3(float* outElements, const Float4 value) noexcept { vst1_f32(outElements, vget_low_f32(value)); vst1q_lane_f32(outElements + 2, value, 2); }
+	IIIXRLAB_INLINE Float4 Set1(const float value) noexcept { return vdupq_n_f32(value); }
+
+	IIIXRLAB_INLINE Float4 Add(const Float4 lhs, const Float4 rhs) noexcept { return vaddq_f32(lhs, rhs); }
+	IIIXRLAB_INLINE Float4 Subtract(const Float4 lhs, const Float4 rhs) noexcept { return vsubq_f32(lhs, rhs); }
+	IIIXRLAB_INLINE Float4 Multiply(const Float4 lhs, const Float4 rhs) noexcept { return vmulq_f32(lhs, rhs); }
+	IIIXRLAB_INLINE Float4 Divide(const Float4 lhs, const Float4 rhs) noexcept { return vdivq_f32(lhs, rhs); }
+	IIIXRLAB_INLINE Float4 MultiplyAdd(const Float4 lhs, const Float4 rhs, const Float4 addend) noexcept { return vfmaq_f32(addend, lhs, rhs); }
+
+	template<uint8_t LaneIndex>
+	IIIXRLAB_INLINE Float4 Broadcast(const Float4 value) noexcept { return vdupq_laneq_f32(value, LaneIndex); }
+
+	IIIXRLAB_INLINE float HorizontalSum(const Float4 value) noexcept { return vaddvq_f32(value); }
+
+	IIIXRLAB_INLINE void Transpose4x4(const float* elements, float* outElements) noexcept
+	{
+		// de-interleaving loads gather every fourth element, i.e. the columns
+		const float32x4x4_t columns = vld4q_f32(elements);
+		Store4(outElements, columns.val[0]);
+		Store4(outElements + 4, columns.val[1]);
+		Store4(outElements + 8, columns.val[2]);
+		Store4(outElements + 12, columns.val[3]);
+	}
+#else	// NOT defined(IIIXRLAB_SIMD_NEON)
+	// Lets the shared kernels below compile without SIMD, IS_ENABLED keeps the Matrix loops in use.
+	struct Float4 final
+	{
+		float Lanes[4];
+	};
+
+	template<typename Operation>
+	IIIXRLAB_INLINE Float4 Map(const Float4 lhs, const Float4 rhs, Operation&& operation) noexcept
+	{
+		return { operation(lhs.Lanes[0], rhs.Lanes[0]), operation(lhs.Lanes[1], rhs.Lanes[1]), operation(lhs.Lanes[2], rhs.Lanes[2]), operation(lhs.Lanes[3], rhs.Lanes[3]) };
+	}
+
+	IIIXRLAB_INLINE Float4 Load4(const float* elements) noexcept { return { elements[0], elements[1], elements[2], elements[3] }; }
+	IIIXRLAB_INLINE void Store4(float* outElements, const Float4 value) noexcept { std::memcpy(outElements, value.Lanes, sizeof(value.Lanes)); }
+	IIIXRLAB_INLINE Float4 Load3(const float* elements) noexcept { return { elements[0], elements[1], elements[2], 0.0f }; }
+	IIIXRLAB_INLINE void Store3(float* outElements, const Float4 value) noexcept { std::memcpy(outElements, value.Lanes, 3 * sizeof(float)); }
+	IIIXRLAB_INLINE Float4 Set1(const float value) noexcept { return { value, value, value, value }; }
+
+	IIIXRLAB_INLINE Float4 Add(const Float4 lhs, const Float4 rhs) noexcept { return Map(lhs, rhs, std::plus<float>()); }
+	IIIXRLAB_INLINE Float4 Subtract(const Float4 lhs, const Float4 rhs) noexcept { return Map(lhs, rhs, std::minus<float>()); }
+	IIIXRLAB_INLINE Float4 Multiply(const Float4 lhs, const Float4 rhs) noexcept { return Map(lhs, rhs, std::multiplies<float>()); }
+	IIIXRLAB_INLINE Float4 Divide(const Float4 lhs, const Float4 rhs) noexcept { return Map(lhs, rhs, std::divides<float>()); }
+	IIIXRLAB_INLINE Float4 MultiplyAdd(const Float4 lhs, const Float4 rhs, const Float4 addend) noexcept { return Add(Multiply(lhs, rhs), addend); }
+
+	template<uint8_t LaneIndex>
+	IIIXRLAB_INLINE Float4 Broadcast(const Float4 value) noexcept { return Set1(value.Lanes[LaneIndex]); }
+
+	IIIXRLAB_INLINE float HorizontalSum(const Float4 value) noexcept { return (value.Lanes[0] + value.Lanes[1]) + (value.Lanes[2] + value.Lanes[3]); }
+
+	IIIXRLAB_INLINE void Transpose4x4(const float* elements, float* outElements) noexcept
+	{
+		for (uint32_t rowIndex = 0; rowIndex < 4; ++rowIndex)
+		{
+			for (uint32_t columnIndex = 0; columnIndex < 4; ++columnIndex)
+			{
+				outElements[columnIndex * 4 + rowIndex] = elements[rowIndex * 4 + columnIndex];
+			}
+		}
+	}
+#endif	// NOT defined(IIIXRLAB_SIMD_NEON)
+
+	// Applies the operation lane-wise to ElementsCount elements, which is 3 or a multiple of 4.
+	template<uint32_t ElementsCount, typename Operation>
+	IIIXRLAB_INLINE void Apply(const float* lhs, const float* rhs, float* outElements, Operation&& operation) noexcept
+	{
+		if constexpr (ElementsCount == 3)
+		{
+			Store3(outElements, operation(Load3(lhs), Load3(rhs)));
+		}
+		else
+		{
+			static_assert(ElementsCount % 4 == 0);
+			for (uint32_t offset = 0; offset < ElementsCount; offset += 4)
+			{
+				Store4(outElements + offset, operation(Load4(lhs + offset), Load4(rhs + offset)));
+			}
+		}
+	}
+
+	template<uint32_t ElementsCount, typename Operation>
+	IIIXRLAB_INLINE void Apply(const float* elements, const float scalar, float* outElements, Operation&& operation) noexcept
+	{
+		const Float4 scalars = Set1(scalar);
+		if constexpr (ElementsCount == 3)
+		{
+			Store3(outElements, operation(Load3(elements), scalars));
+		}
+		else
+		{
+			static_assert(ElementsCount % 4 == 0);
+			for (uint32_t offset = 0; offset < ElementsCount; offset += 4)
+			{
+				Store4(outElements + offset, operation(Load4(elements + offset), scalars));
+			}
+		}
+	}
+
+	template<uint32_t ElementsCount>
+	IIIXRLAB_INLINE float Dot(const float* lhs, const float* rhs) noexcept
+	{
+		if constexpr (ElementsCount == 3)
+		{
+			return HorizontalSum(Multiply(Load3(lhs), Load3(rhs)));
+		}
+		else
+		{
+			static_assert(ElementsCount % 4 == 0);
+			Float4 sums = Multiply(Load4(lhs), Load4(rhs));
+			for (uint32_t offset = 4; offset < ElementsCount; offset += 4)
+			{
+				sums = MultiplyAdd(Load4(lhs + offset), Load4(rhs + offset), sums);
+			}
+			return HorizontalSum(sums);
+		}
+	}
+
+	// outRow = row * matrix, row vectors like the rest of the renderer.
+	IIIXRLAB_INLINE Float4 TransformRow(const Float4 row, const float* matrix) noexcept
+	{
+		Float4 result = Multiply(Broadcast<0>(row), Load4(matrix));
+		result = MultiplyAdd(Broadcast<1>(row), Load4(matrix + 4), result);
+		result = MultiplyAdd(Broadcast<2>(row), Load4(matrix + 8), result);
+		return MultiplyAdd(Broadcast<3>(row), Load4(matrix + 12), result);
+	}
+
+	// Row major, outElements may alias either operand.
+	IIIXRLAB_INLINE void Multiply4x4(const float* lhs, const float* rhs, float* outElements) noexcept
+	{
+		const Float4 row0 = TransformRow(Load4(lhs), rhs);
+		const Float4 row1 = TransformRow(Load4(lhs + 4), rhs);
+		const Float4 row2 = TransformRow(Load4(lhs + 8), rhs);
+		const Float4 row3 = TransformRow(Load4(lhs + 12), rhs);
+		Store4(outElements, row0);
+		Store4(outElements + 4, row1);
+		Store4(outElements + 8, row2);
+		Store4(outElements + 12, row3);
+	}
+
+#if defined(IIIXRLAB_SIMD_SSE)
+	// 2x2 blocks of a row major matrix packed as (m00, m01, m10, m11)
+	IIIXRLAB_INLINE Float4 Multiply2x2(const Float4 lhs, const Float4 rhs) noexcept
+	{
+		return _mm_add_ps(_mm_mul_ps(lhs, _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 0, 3, 0))), _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 2, 1, 2))));
+	}
+
+	// adjugate(lhs) * rhs
+	IIIXRLAB_INLINE Float4 AdjugateMultiply2x2(const Float4 lhs, const Float4 rhs) noexcept
+	{
+		return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(0, 0, 3, 3)), rhs), _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 0, 3, 2))));
+	}
+
+	// lhs * adjugate(rhs)
+	IIIXRLAB_INLINE Float4 MultiplyAdjugate2x2(const Float4 lhs, const Float4 rhs) noexcept
+	{
+		return _mm_sub_ps(_mm_mul_ps(lhs, _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(0, 3, 0, 3))), _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 2, 1, 2))));
+	}
+
+	// Blockwise inversion of | A B ; C D | with 2x2 adjugates. Returns the determinant, the result is only valid when it is not zero.
+	IIIXRLAB_INLINE float Inverse4x4(const float* elements, float* outElements) noexcept
+	{
+		const Float4 row0 = Load4(elements);
+		const Float4 row1 = Load4(elements + 4);
+		const Float4 row2 = Load4(elements + 8);
+		const Float4 row3 = Load4(elements + 12);
+
+		const Float4 a = _mm_movelh_ps(row0, row1);
+		const Float4 b = _mm_movehl_ps(row1, row0);
+		const Float4 c = _mm_movelh_ps(row2, row3);
+		const Float4 d = _mm_movehl_ps(row3, row2);
+
+		// (|A|, |B|, |C|, |D|)
+		const Float4 subDeterminants = _mm_sub_ps(
+			_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+			_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0))));
+		const Float4 determinantA = Broadcast<0>(subDeterminants);
+		const Float4 determinantB = Broadcast<1>(subDeterminants);
+		const Float4 determinantC = Broadcast<2>(subDeterminants);
+		const Float4 determinantD = Broadcast<3>(subDeterminants);
+
+		const Float4 adjugateDC = AdjugateMultiply2x2(d, c);
+		const Float4 adjugateAB = AdjugateMultiply2x2(a, b);
+		Float4 x = _mm_sub_ps(_mm_mul_ps(determinantD, a), Multiply2x2(b, adjugateDC));
+		Float4 w = _mm_sub_ps(_mm_mul_ps(determinantA, d), Multiply2x2(c, adjugateAB));
+		Float4 y = _mm_sub_ps(_mm_mul_ps(determinantB, c), MultiplyAdjugate2x2(d, adjugateAB));
+		Float4 z = _mm_sub_ps(_mm_mul_ps(determinantC, b), MultiplyAdjugate2x2(a, adjugateDC));
+
+		// |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+		const Float4 trace = Set1(HorizontalSum(_mm_mul_ps(adjugateAB, _mm_shuffle_ps(adjugateDC, adjugateDC, _MM_SHUFFLE(3, 1, 2, 0)))));
+		const Float4 determinant = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(determinantA, determinantD), _mm_mul_ps(determinantB, determinantC)), trace);
+
+		const Float4 reciprocalDeterminant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+		x = _mm_mul_ps(x, reciprocalDeterminant);
+		y = _mm_mul_ps(y, reciprocalDeterminant);
+		z = _mm_mul_ps(z, reciprocalDeterminant);
+		w = _mm_mul_ps(w, reciprocalDeterminant);
+
+		// the shuffles apply the remaining adjugate and scatter the blocks back into rows
+		Store4(outElements, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+		Store4(outElements + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+		Store4(outElements + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+		Store4(outElements + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+
+		return _mm_cvtss_f32(determinant);
+	}
+#endif	// defined(IIIXRLAB_SIMD_SSE)
+} // namespace iiixrlab::math::simd
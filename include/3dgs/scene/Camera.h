@@ -23,6 +23,7 @@ namespace iiixrlab::scene
 			iiixrlab::math::Vector3f Position;
 			float Width;
 			float Height;
+			uint32_t FramesCount;
 		};
 
 		struct Info final
@@ -46,10 +47,14 @@ namespace iiixrlab::scene
 		IIIXRLAB_INLINE constexpr const iiixrlab::math::Vector3f& GetPosition() const noexcept { return mPosition; }
 		IIIXRLAB_INLINE constexpr const iiixrlab::math::Vector3f& GetPitchYawRoll() const noexcept { return mPitchYawRoll; }
 		IIIXRLAB_INLINE constexpr float GetSpeed() const noexcept { return mSpeed; }
+		IIIXRLAB_INLINE constexpr void SetSpeed(const float speed) noexcept { mSpeed = speed; }
 		IIIXRLAB_INLINE iiixrlab::graphics::ConstantBuffer& GetConstantBuffer() noexcept { return *mConstantBuffer; }
 		IIIXRLAB_INLINE const iiixrlab::graphics::ConstantBuffer& GetConstantBuffer() const noexcept { return *mConstantBuffer; }
 
-		void Update(const float deltaTime, const iiixrlab::math::Vector3f& direction, const iiixrlab::math::Vector3f& pitchYawRoll) noexcept;
+		// Places the camera with explicit matrices, e.g. a pose and intrinsics from a trajectory file.
+		// The matrices are written to the frame slots by the following Update() calls like any input-driven change.
+		void SetInfo(const Info& info) noexcept;
+		void Update(const float deltaTime, const iiixrlab::math::Vector3f& direction, const iiixrlab::math::Vector3f& pitchYawRoll, const uint32_t frameIndex) noexcept;
 		iiixrlab::math::Vector3f GetPitchYawRollFromScreenSpaceDeltaPosition(const iiixrlab::math::Vector2f& deltaPosition) const noexcept;
 
 	protected:
@@ -64,6 +69,7 @@ namespace iiixrlab::scene
 
 		Info		mInfo;
 		float		mSpeed;
+		uint32_t	mDirtyFramesCount;
 
 		std::unique_ptr<iiixrlab::graphics::ConstantBuffer> mConstantBuffer;
 	};
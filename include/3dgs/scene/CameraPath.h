@@ -0,0 +1,53 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/scene/DataTypes.h"
+
+namespace iiixrlab::scene
+{
+	class Camera;
+
+	// Camera poses replayed one per frame, e.g. for benchmarks which have to render the same views on every run.
+	// Poses are reached through Camera::Update() like any input, so replaying exercises the interactive code path.
+	class CameraPath final
+	{
+	public:
+		struct Pose final
+		{
+			iiixrlab::math::Vector3f Position;
+			iiixrlab::math::Vector3f PitchYawRoll;	// radians, accumulated like the camera's
+		};
+
+		// Arguments of the Camera::Update() call moving the camera onto a pose.
+		struct Step final
+		{
+			iiixrlab::math::Vector3f Direction;
+			iiixrlab::math::Vector3f PitchYawRoll;
+			float Speed;
+		};
+
+	public:
+		// Circles the scene at twice the RMS distance of its gaussians from their mean, looking at the mean.
+		static CameraPath CreateOrbit(const GaussianInfo& gaussianInfo, const uint32_t posesCount) noexcept;
+		// Flies straight through the scene along +z while panning left and right.
+		static CameraPath CreateFlyThrough(const GaussianInfo& gaussianInfo, const uint32_t posesCount) noexcept;
+
+	public:
+		CameraPath() = delete;
+		CameraPath(std::vector<Pose>&& poses) noexcept;
+		// One pose per line as "x y z pitch yaw roll", as written by Save(). Failing leaves the path without poses.
+		CameraPath(const std::filesystem::path& path) noexcept;
+		IIIXRLAB_INLINE ~CameraPath() noexcept = default;
+
+		IIIXRLAB_INLINE constexpr const std::vector<Pose>& GetPoses() const noexcept { return mPoses; }
+
+		bool Save(const std::filesystem::path& path) const noexcept;
+
+		// The pose index wraps around, so a path can be replayed for any number of frames.
+		Step GetStep(const Camera& camera, const uint32_t poseIndex, const float deltaTime) const noexcept;
+
+	private:
+		std::vector<Pose> mPoses;
+	};
+} // namespace iiixrlab::scene
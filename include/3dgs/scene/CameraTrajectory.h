@@ -0,0 +1,36 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/scene/Camera.h"
+
+namespace iiixrlab::scene
+{
+	// Camera poses and intrinsics of a transforms.json file (NeRF synthetic / nerfstudio layout).
+	// Shared intrinsics (fl_x, fl_y, cx, cy, w, h or camera_angle_x) may be overridden per frame,
+	// transform_matrix is the camera-to-world matrix with OpenGL axes (x right, y up, looking down -z).
+	class CameraTrajectory final
+	{
+	public:
+		struct View final
+		{
+			Camera::Info			Info;
+			std::filesystem::path	FilePath;	// file_path of the frame, names the rendered image
+		};
+
+	public:
+		CameraTrajectory() = delete;
+		// The extent is taken from the file when it has w and h, all frames have to share it.
+		CameraTrajectory(const std::filesystem::path& trajectoryPath, const uint32_t defaultWidth, const uint32_t defaultHeight) noexcept;
+		IIIXRLAB_INLINE ~CameraTrajectory() noexcept = default;
+
+		IIIXRLAB_INLINE constexpr const std::vector<View>& GetViews() const noexcept { return mViews; }
+		IIIXRLAB_INLINE constexpr uint32_t GetWidth() const noexcept { return mWidth; }
+		IIIXRLAB_INLINE constexpr uint32_t GetHeight() const noexcept { return mHeight; }
+
+	private:
+		std::vector<View>	mViews;
+		uint32_t			mWidth;
+		uint32_t			mHeight;
+	};
+} // namespace iiixrlab::scene
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/scene/Camera.h"
+#include "3dgs/scene/DataTypes.h"
+#include "3dgs/scene/SceneCache.h"
+
+namespace iiixrlab::scene
+{
+	// Reads the chunks of a scene cache on a thread of its own, in the order they are requested.
+	class ChunkLoader final
+	{
+	public:
+		struct Chunk final
+		{
+			uint32_t ChunkIndex;
+			std::unique_ptr<iiixrlab::scene::GaussianInfo> GaussianInfo;
+		};
+
+	public:
+		ChunkLoader() = delete;
+		// Failing leaves the loader closed, see SceneCacheReader.
+		ChunkLoader(const std::filesystem::path& path, const FileReadInfo& fileReadInfo = {}) noexcept;
+
+		ChunkLoader(const ChunkLoader&) = delete;
+		ChunkLoader& operator=(const ChunkLoader&) = delete;
+
+		// Stops after the chunk being read.
+		~ChunkLoader() noexcept;
+
+		IIIXRLAB_INLINE bool IsOpen() const noexcept { return mReader.IsOpen(); }
+		IIIXRLAB_INLINE constexpr const SceneCacheReader& GetReader() const noexcept { return mReader; }
+
+		// Replaces the chunks waiting to be read. Chunks being read, read but not popped yet or failing to be read are skipped.
+		void SetRequests(std::vector<uint32_t>&& chunkIndices) noexcept;
+		// Moves the oldest read chunk out, returns false when none is ready yet.
+		bool TryPop(Chunk& outChunk) noexcept;
+
+	private:
+		void load() noexcept;
+
+	private:
+		SceneCacheReader mReader;	// only read from the loading thread once it is started
+		std::mutex mMutex;
+		std::condition_variable mRequestsCondition;
+		std::deque<uint32_t> mRequests;
+		uint32_t mLoadingChunkIndex;
+		std::deque<Chunk> mChunks;
+		std::unordered_set<uint32_t> mFailedChunkIndices;
+		bool mbIsStopping;
+		std::thread mThread;
+	};
+
+	// Chunks worth keeping resident for the view, in the order they should be loaded: the first pinnedChunksCount ones,
+	// then the ones in the frustum and then the others, each from the nearest to the camera. Chunks which do not fit into
+	// the budget anymore are left out.
+	std::vector<uint32_t> SelectResidentChunks(const std::vector<SceneChunk>& chunks, const std::vector<uint64_t>& chunkSizes, const Camera::Info& view, const iiixrlab::math::Vector3f& position, const uint64_t budget, const uint32_t pinnedChunksCount) noexcept;
+	// Whether any part of the box may be seen, testing its corners against the clip space planes.
+	bool IsInFrustum(const std::array<float, 3>& boundsMin, const std::array<float, 3>& boundsMax, const iiixrlab::math::Matrix4x4f& viewProjection) noexcept;
+	IIIXRLAB_INLINE bool IsInFrustum(const SceneChunk& chunk, const iiixrlab::math::Matrix4x4f& viewProjection) noexcept { return IsInFrustum(chunk.BoundsMin, chunk.BoundsMax, viewProjection); }
+	// Fraction of the screen the rectangle around the projected box covers, the whole screen once the box reaches behind
+	// the camera.
+	float GetScreenCoverage(const std::array<float, 3>& boundsMin, const std::array<float, 3>& boundsMax, const iiixrlab::math::Matrix4x4f& viewProjection) noexcept;
+} // namespace iiixrlab::scene
@@ -28,5 +28,17 @@ namespace iiixrlab::scene
         // (slower varying) axis, i.e. for degree 1, the order of the 9 values is:
         //   sh1n1_r, sh1n1_g, sh1n1_b, sh10_r, sh10_g, sh10_b, sh1p1_r, sh1p1_g, sh1p1_b
         std::vector<float> SphericalHarmonics;
+
+        // Vector quantized spherical harmonics, see QuantizeSphericalHarmonics(). When the codebook is not empty it replaces
+        // SphericalHarmonics: each entry holds the coefficients of one point in the layout above, and ShIndices picks the
+        // entry of every point.
+        std::vector<float> ShCodebook;
+        std::vector<uint16_t> ShIndices;
     };
+
+    // Spherical harmonics floats per point, i.e. without the DC term which lives in Colors.
+    IIIXRLAB_INLINE constexpr uint32_t GetShCoefficientsCount(const uint32_t shDegree) noexcept
+    {
+        return ((shDegree + 1) * (shDegree + 1) - 1) * 3;
+    }
 } // namespace iiixrlab::scene
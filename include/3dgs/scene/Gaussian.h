@@ -4,19 +4,29 @@
 
 #include "3dgs/scene/DataTypes.h"
 
+namespace iiixrlab::graphics
+{
+    class CommandBuffer;
+    class Device;
+    class GaussianRenderScene;
+}   // namespace iiixrlab::graphics
+
 namespace iiixrlab::scene
 {
-    class iiixrlab::graphics::Device;
-    class iiixrlab::graphics::CommandBuffer;
-    
     class Gaussian final : public iiixrlab::graphics::IRenderable
     {
+    public:
+        friend class iiixrlab::graphics::GaussianRenderScene;
+
     public:
         struct CreateInfo final
         {
             iiixrlab::graphics::Device& Device;
-            const GaussianInfo& GaussianInfo;
+            GaussianInfo& GaussianInfo;     // edited in place, see GaussianRenderScene::Delete(), Recolor() and Move()
             std::vector<iiixrlab::math::Vector3f> SphereVertices;
+            bool bIsPreview = false;    // stands in for the scene until the rest of it is uploaded, see ProgressiveLoader
+            iiixrlab::math::Matrix4x4f Transform;  // model to world of the first placement, may scale, identity by default
+            const Gaussian* ShCodebookGaussianOrNull = nullptr;  // indexes the codebook uploaded by that gaussian, GaussianInfo has none
         };
 
         struct InstanceInfo final
@@ -32,8 +42,54 @@ namespace iiixrlab::scene
             std::array<float, 45>    SphericalHarmonicsCoefficients;
         };
 
+        // One per placement of a gaussian in the draw list of GaussianRenderScene, where Gaussian.slang finds its instances
+        // and spherical harmonics. Placements of the same gaussian share their offsets, which are in bytes into the bindless
+        // vertex buffer.
+        struct ModelInfo final
+        {
+            iiixrlab::math::Matrix4x4f World;
+            iiixrlab::math::Vector3f CameraPosition;    // in model space, where the spherical harmonics are evaluated
+            uint32_t PointsCount;                       // 0 once the model is gone, its splats are then skipped
+            uint32_t VertexBufferIndex;
+            uint32_t SphereVerticesOffset;
+            uint32_t InstancesOffset;
+            uint32_t ShIndicesOffset;       // SH_INDICES_NONE when every instance has coefficients of its own
+            uint32_t ShCoefficientsOffset;  // codebook entries or per instance coefficients
+            uint32_t ShDegree;
+            uint32_t ShCoefficientsBufferIndex; // VertexBufferIndex unless the codebook is shared with another gaussian
+            uint32_t Padding;
+        };
+
+        // Entry of the back to front order every model is drawn in.
+        struct SortedSplat final
+        {
+            uint32_t ModelIndex;
+            uint32_t PointIndex;
+        };
+
+        // The draw list holds the models, then the sorted splats.
+        struct PushConstants final
+        {
+            uint32_t DrawListIndex;
+            uint32_t SortedSplatsOffset;
+        };
+
+        // Edits are tracked and uploaded per page of points. Even, so that the 16 bit spherical harmonics indices of a
+        // page start at a pair.
+        static constexpr const uint32_t POINTS_PER_PAGE = 1024;
+        static constexpr const uint32_t SH_INDICES_NONE = UINT32_MAX;
+        // Log scale of deleted points until compaction moves another point over them, their sphere collapses to a point.
+        static constexpr const float DELETED_SCALE_IN_LOG_SCALE = std::numeric_limits<float>::lowest();
+
     public:
+        // Returns nullptr when the vertex buffer of the gaussian is out of the range a storage buffer descriptor reaches.
         static std::unique_ptr<Gaussian> Create(CreateInfo& createInfo) noexcept;
+        // Triangle list of a UV sphere, the mesh every gaussian is instanced on.
+        static std::vector<iiixrlab::math::Vector3f> GenerateSphereVertices(const float radius, const uint32_t slicesCount, const uint32_t stacksCount) noexcept;
+        // Bytes of the vertex buffer of pointsCount gaussians, whose spherical harmonics index a codebook when it has entries.
+        static uint64_t GetVertexBufferSize(const uint32_t pointsCount, const uint32_t shDegree, const uint32_t shCodebookEntriesCount) noexcept;
+        // Interleaves the per point attributes of [firstPointIndex, firstPointIndex + pointsCount) into vertex buffer instances.
+        static void PackInstanceInfos(const GaussianInfo& gaussianInfo, const uint32_t firstPointIndex, const uint32_t pointsCount, InstanceInfo* outInstanceInfos) noexcept;
 
     public:
         Gaussian() = delete;
@@ -48,12 +104,91 @@ namespace iiixrlab::scene
 
         IIIXRLAB_INLINE const GaussianInfo& GetGaussianInfo() const noexcept { return mGaussianInfo; }
         IIIXRLAB_INLINE const std::vector<iiixrlab::math::Vector3f>& GetSphereVertices() const noexcept { return mSphereVertices; }
+        IIIXRLAB_INLINE constexpr bool IsPreview() const noexcept { return mbIsPreview; }
+        // Bounds of the instances in model space, 3 standard deviations around each.
+        IIIXRLAB_INLINE constexpr const std::array<float, 3>& GetBoundsMin() const noexcept { return mBoundsMin; }
+        IIIXRLAB_INLINE constexpr const std::array<float, 3>& GetBoundsMax() const noexcept { return mBoundsMax; }
+
+        // The gaussian is drawn once per transform, every placement shares the instances uploaded once.
+        // Changes take effect with the next update of the render scene, which sorts the splats again.
+        IIIXRLAB_INLINE constexpr const std::vector<iiixrlab::math::Matrix4x4f>& GetTransforms() const noexcept { return mTransforms; }
+        IIIXRLAB_INLINE void SetTransform(const uint32_t transformIndex, const iiixrlab::math::Matrix4x4f& transform) noexcept { mTransforms[transformIndex] = transform; }
+        // Returns the index of the transform.
+        uint32_t AddTransform(const iiixrlab::math::Matrix4x4f& transform) noexcept;
+        // The transforms after it move down by one.
+        void RemoveTransform(const uint32_t transformIndex) noexcept;
+        // Offsets into the staging buffer, which holds the sphere vertices, the instances, then the spherical harmonics.
+        IIIXRLAB_INLINE uint32_t GetInstancesOffset() const noexcept { return static_cast<uint32_t>(mSphereVertices.size() * sizeof(iiixrlab::math::Vector3f)); }
+        IIIXRLAB_INLINE constexpr uint32_t GetShIndicesOffset() const noexcept { return mShIndicesOffset; }
+        IIIXRLAB_INLINE constexpr uint32_t GetShCoefficientsOffset() const noexcept { return mShCoefficientsOffset; }
+        // The gaussian whose codebook the spherical harmonics indices pick from instead of one of its own.
+        IIIXRLAB_INLINE constexpr const Gaussian* GetShCodebookGaussianOrNull() const noexcept { return mShCodebookGaussianOrNull; }
+
+        // Counts the edits, which the render scene makes through GaussianRenderScene::Delete(), Recolor() and Move().
+        IIIXRLAB_INLINE constexpr uint64_t GetEditsCount() const noexcept { return mEditsCount; }
+        IIIXRLAB_INLINE constexpr bool IsPointDeleted(const uint32_t pointIndex) const noexcept { return mbArePointsDeleted[pointIndex] != 0; }
+        // Deleted points still among the NumPoints drawn, until Compact() removes them.
+        IIIXRLAB_INLINE constexpr uint32_t GetDeletedPointsCount() const noexcept { return mDeletedPointsCount; }
+
+        // Pages changed and not cleared yet, each points [pageIndex * POINTS_PER_PAGE, + POINTS_PER_PAGE).
+        IIIXRLAB_INLINE constexpr const std::vector<uint32_t>& GetDirtyPageIndices() const noexcept { return mDirtyPageIndices; }
+        // Leading dirty pages up to the last one Compact() filled. NumPoints already left the moved points out, so these
+        // have to be uploaded by the time it is drawn.
+        IIIXRLAB_INLINE constexpr uint32_t GetCompactedPagesCount() const noexcept { return mCompactedPagesCount; }
+        // Clears the first pagesCount of GetDirtyPageIndices(), the others stay dirty in the same order.
+        void ClearDirtyPages(const uint32_t pagesCount) noexcept;
 
     protected:
-        Gaussian(iiixrlab::graphics::IRenderable::CreateInfo& createInfo, const GaussianInfo& gaussianInfo, std::vector<iiixrlab::math::Vector3f>&& sphereVertices) noexcept;
+        Gaussian(iiixrlab::graphics::IRenderable::CreateInfo& createInfo, GaussianInfo& gaussianInfo, std::vector<iiixrlab::math::Vector3f>&& sphereVertices, const bool bIsPreview, const iiixrlab::math::Matrix4x4f& transform, const Gaussian* shCodebookGaussianOrNull) noexcept;
+
+    private:
+        // Edits change the points in model space right away and mark the pages they touch dirty, the render scene copies
+        // dirty pages into the vertex buffer and sorts the splats again. Points are addressed by index, which stays valid
+        // until the next call to Compact(). The sorting and compacting threads of the render scene read and move the points,
+        // so only the render scene edits them once it waited for both.
+        // Live points whose position lies within the box, pages out of the box are skipped as a whole.
+        std::vector<uint32_t> SelectInBox(const std::array<float, 3>& boxMin, const std::array<float, 3>& boxMax) const noexcept;
+        // Deleted points are hidden at once and removed from the points by Compact().
+        void Delete(const std::span<const uint32_t> pointIndices) noexcept;
+        // Replaces the DC component of the color, the view dependent spherical harmonics are kept.
+        void Recolor(const std::span<const uint32_t> pointIndices, const std::array<float, 3>& colorAsShDcComponent) noexcept;
+        void Move(const std::span<const uint32_t> pointIndices, const std::array<float, 3>& translation) noexcept;
+        // Fills the holes of deleted points with the last points, moving at most maxMovedPointsCount of them into at most
+        // maxDirtiedPagesCount pages which were not dirty yet, so that compaction is spread over updates. Returns the
+        // points still deleted.
+        uint32_t Compact(const uint32_t maxMovedPointsCount, const uint32_t maxDirtiedPagesCount) noexcept;
+
+        IIIXRLAB_INLINE bool isShQuantized() const noexcept { return mGaussianInfo.ShCodebook.empty() == false || mShCodebookGaussianOrNull != nullptr; }
+        // Computes the bounds of the pages from their live points again, then the overall bounds.
+        void updateBounds(const std::vector<uint32_t>& pageIndices) noexcept;
+        // Updates the bounds of the pages an edit touched, marks them dirty and counts the edit.
+        void updatePages(std::vector<uint32_t>& pageIndices) noexcept;
+
+    private:
+        struct PageBounds final
+        {
+            std::array<float, 3> Min;
+            std::array<float, 3> Max;
+        };
 
     private:
-        const GaussianInfo& mGaussianInfo;
+        GaussianInfo& mGaussianInfo;
         std::vector<iiixrlab::math::Vector3f> mSphereVertices;
+        uint32_t mShIndicesOffset;
+        uint32_t mShCoefficientsOffset;
+        const Gaussian* mShCodebookGaussianOrNull;
+        bool mbIsPreview;
+        std::array<float, 3> mBoundsMin;
+        std::array<float, 3> mBoundsMax;
+        std::vector<iiixrlab::math::Matrix4x4f> mTransforms;
+
+        std::vector<PageBounds> mPageBounds;        // the overall bounds are their union
+        std::vector<uint8_t> mbArePagesDirty;
+        std::vector<uint32_t> mDirtyPageIndices;
+        uint32_t mCompactedPagesCount;
+        std::vector<uint8_t> mbArePointsDeleted;
+        std::vector<uint32_t> mFreePointIndices;    // deleted points, not necessarily below NumPoints anymore
+        uint32_t mDeletedPointsCount;
+        uint64_t mEditsCount;
     };
 } // namespace iiixrlab::scene
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/scene/DataTypes.h"
+
+namespace iiixrlab::scene
+{
+	enum class eGaussianDistribution : uint8_t
+	{
+		UNIFORM,	// fills a cube
+		CLUSTERED,	// normally distributed around centers spread over the cube
+		SURFACE,	// flat gaussians lying on a sphere, like a captured surface
+	};
+
+	struct GaussianGeneratorInfo final
+	{
+		uint32_t PointsCount;
+		uint32_t ShDegree = 0;
+		eGaussianDistribution Distribution = eGaussianDistribution::UNIFORM;
+		float Extent = 10.0f;					// half size of the cube, radius of the sphere
+		uint32_t ClustersCount = 64;
+		float MeanScale = 0.05f;				// scales are log-normal around it
+		float ScaleLogDeviation = 0.5f;
+		float MinOpacity = 0.1f;				// opacities are uniform in between
+		float MaxOpacity = 1.0f;
+		uint64_t Seed = 0;
+		uint32_t ThreadsCount = 0;				// 0 picks one per hardware thread
+	};
+
+	// Fills a scene procedurally to benchmark every stage across data sizes without capture data.
+	// Values follow the spz conventions: log scales, (x, y, z, w) rotations, opacities before the sigmoid and colors as
+	// SH DC coefficients. Points are generated in fixed chunks with their own random streams, so the same seed yields
+	// the same scene whatever the threads count.
+	GaussianInfo GenerateGaussians(const GaussianGeneratorInfo& generatorInfo) noexcept;
+
+	// Parses uniform, clustered or surface.
+	bool ParseGaussianDistribution(const char* name, eGaussianDistribution& outDistribution) noexcept;
+	const char* GetGaussianDistributionName(const eGaussianDistribution distribution) noexcept;
+} // namespace iiixrlab::scene
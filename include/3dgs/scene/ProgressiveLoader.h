@@ -0,0 +1,76 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/scene/DataTypes.h"
+#include "3dgs/scene/GaussianGenerator.h"
+#include "3dgs/scene/SpatialReorder.h"
+
+#include "3dgs/AsyncFileReader.h"
+
+namespace iiixrlab::scene
+{
+	static constexpr const uint32_t DEFAULT_MAX_PREVIEW_POINTS_COUNT = 1 << 16;
+
+	// Loads a scene on a thread of its own and hands it out in batches: first a preview made of every stride-th point
+	// along a space filling curve, with grown scales so the sparse points still cover the scene, then every point in chunks.
+	// A scene cache written with a preview reads the preview straight from the front of the file, so the first batch
+	// takes the same time whatever the size of the scene. Other models are loaded whole and reordered first.
+	class ProgressiveLoader final
+	{
+	public:
+		struct CreateInfo final
+		{
+			std::filesystem::path ModelPath;
+			GaussianGeneratorInfo SyntheticSceneInfo;	// generates the scene instead of loading the model when it has points
+			uint32_t PreviewStride = 64;
+			uint32_t MaxPreviewPointsCount = DEFAULT_MAX_PREVIEW_POINTS_COUNT;	// larger scenes get a larger stride
+			uint32_t ChunkPointsCount = 1 << 20;
+			eSpaceFillingCurve Curve = eSpaceFillingCurve::MORTON;	// order of the points a model is loaded in
+			uint32_t ThreadsCount = 0;					// of the reordering, 0 picks one per hardware thread
+			iiixrlab::FileReadInfo FileReadInfo;
+		};
+
+		struct Batch final
+		{
+			std::unique_ptr<iiixrlab::scene::GaussianInfo> GaussianInfo;
+			bool bIsPreview;							// drawn until the chunks of every point have landed
+			bool bSharesShCodebook;						// indexes the codebook of an earlier batch, it has none of its own
+		};
+
+	public:
+		ProgressiveLoader() = delete;
+		ProgressiveLoader(const CreateInfo& createInfo) noexcept;
+
+		ProgressiveLoader(const ProgressiveLoader&) = delete;
+		ProgressiveLoader& operator=(const ProgressiveLoader&) = delete;
+
+		// Stops loading after the batch in progress.
+		~ProgressiveLoader() noexcept;
+
+		// False once every batch has been handed out.
+		bool IsLoading() const noexcept;
+		// Moves the oldest loaded batch out, returns false when none is ready yet.
+		bool TryPop(Batch& outBatch) noexcept;
+
+	private:
+		void load() noexcept;
+		void push(std::unique_ptr<GaussianInfo>&& gaussianInfo, const bool bIsPreview) noexcept;
+
+	private:
+		CreateInfo mCreateInfo;
+		mutable std::mutex mMutex;
+		std::deque<Batch> mBatches;
+		std::atomic<bool> mbIsStopping;
+		std::atomic<bool> mbIsLoaded;
+		std::thread mThread;
+	};
+
+	// Stride of the preview points, at least previewStride and large enough to keep the preview under maxPreviewPointsCount.
+	uint32_t GetPreviewStride(const uint32_t pointsCount, const uint32_t previewStride, const uint32_t maxPreviewPointsCount) noexcept;
+	// Points along the curve of reorderInfo with every stride-th one moved to the front, i.e. order[newIndex] = oldIndex.
+	// The first ceil(pointsCount / stride) points then sample the whole scene evenly, see PermuteGaussians().
+	std::vector<uint32_t> ComputeProgressiveOrder(const GaussianInfo& gaussianInfo, const uint32_t previewStride, const SpatialReorderInfo& reorderInfo) noexcept;
+	// Grows every axis by the cube root of the stride, so each preview point covers the block of points it stands for.
+	void GrowPreviewScales(GaussianInfo& inoutGaussianInfo, const float previewStride) noexcept;
+} // namespace iiixrlab::scene
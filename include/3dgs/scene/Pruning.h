@@ -0,0 +1,37 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/scene/Camera.h"
+#include "3dgs/scene/DataTypes.h"
+
+namespace iiixrlab::scene
+{
+	struct PruneInfo final
+	{
+		float MinOpacity = 0.0f;				// after the sigmoid, 1/255 is invisible once blended
+		float MinExtent = 0.0f;					// largest world space standard deviation of the axes
+		float MinContribution = 0.0f;			// blending weight summed over the pixels of a view, averaged over the views
+		uint32_t MaxRenderExtent = 512;			// views are rasterized at most that wide and high, contributions are scaled back
+		uint32_t ThreadsCount = 0;				// 0 picks one per hardware thread
+	};
+
+	struct PruneStatistics final
+	{
+		uint32_t PointsCount;					// before pruning
+		uint32_t OpacityPrunedCount;
+		uint32_t ExtentPrunedCount;
+		uint32_t ContributionPrunedCount;		// of the points the other tests kept
+		float RemovedContributionFraction;		// of the contributions of every point, 0 without views
+		float Psnr;								// dB of the pruned views against the unpruned ones, infinite without views
+	};
+
+	// Blending weight every gaussian adds to the views, alpha times the transmittance in front of it summed over the pixels
+	// and averaged over the views, in pixels of the views' width and height. The views are rasterized on the CPU with the
+	// EWA splatting of the reference implementation at a reduced extent, front to back in bands of rows.
+	std::vector<float> ComputeContributions(const GaussianInfo& gaussianInfo, const std::vector<Camera::Info>& views, const uint32_t width, const uint32_t height, const PruneInfo& pruneInfo) noexcept;
+
+	// Drops the gaussians below any of the thresholds, the contribution test runs only with views. With views the pruned
+	// and unpruned gaussians are rasterized again to measure what pruning costs. Returns false when nothing was pruned.
+	bool PruneGaussians(GaussianInfo& inoutGaussianInfo, const PruneInfo& pruneInfo, const std::vector<Camera::Info>& views, const uint32_t width, const uint32_t height, PruneStatistics& outStatistics) noexcept;
+} // namespace iiixrlab::scene
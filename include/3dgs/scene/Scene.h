@@ -4,15 +4,21 @@
 
 #include "3dgs/scene/DataTypes.h"
 
+#include "3dgs/AsyncFileReader.h"
+
 namespace iiixrlab::scene
 {
     class Scene final
     {
     public:
         Scene() = delete;
-        Scene(const std::filesystem::path& modelPath) noexcept;
+        // .spz or a scene cache written by SaveSceneCache()
+        Scene(const std::filesystem::path& modelPath, const FileReadInfo& fileReadInfo = {}) noexcept;
+        // e.g. generated by GenerateGaussians()
+        Scene(GaussianInfo&& gaussianInfo) noexcept;
         IIIXRLAB_INLINE constexpr ~Scene() noexcept = default;
 
+        IIIXRLAB_INLINE constexpr GaussianInfo& GetGaussianInfo() noexcept { return mGaussianInfo; }
         IIIXRLAB_INLINE constexpr const GaussianInfo& GetGaussianInfo() const noexcept { return mGaussianInfo; }
 
     private:
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/scene/DataTypes.h"
+
+#include "3dgs/AsyncFileReader.h"
+
+namespace iiixrlab::scene
+{
+	static constexpr const char* SCENE_CACHE_EXTENSION = ".3dgs";
+	static constexpr const uint32_t DEFAULT_CHUNK_POINTS_COUNT = 1 << 18;
+
+	// Range of points which lie close together, with the bounds of their extents, so a streamer can page it in and out.
+	struct SceneChunk final
+	{
+		uint32_t FirstPointIndex;
+		uint32_t PointsCount;
+		std::array<float, 3> BoundsMin;
+		std::array<float, 3> BoundsMax;
+	};
+
+	// Reads ranges of the points of a scene cache, e.g. a preview first and the rest in chunks, with the range of every
+	// array in flight at once.
+	class SceneCacheReader final
+	{
+	public:
+		SceneCacheReader() = delete;
+		// Validates the header and the size of every array. Failing leaves the reader closed.
+		SceneCacheReader(const std::filesystem::path& path, const FileReadInfo& fileReadInfo = {}) noexcept;
+
+		SceneCacheReader(const SceneCacheReader&) = delete;
+		SceneCacheReader& operator=(const SceneCacheReader&) = delete;
+
+		IIIXRLAB_INLINE ~SceneCacheReader() noexcept = default;
+
+		IIIXRLAB_INLINE constexpr bool IsOpen() const noexcept { return mbIsOpen; }
+		IIIXRLAB_INLINE constexpr uint32_t GetPointsCount() const noexcept { return mPointsCount; }
+		IIIXRLAB_INLINE constexpr uint32_t GetShDegree() const noexcept { return mShDegree; }
+		// Points at the front which sample the whole scene evenly, 0 when the cache was not written for progressive loading.
+		IIIXRLAB_INLINE constexpr uint32_t GetPreviewPointsCount() const noexcept { return mPreviewPointsCount; }
+		IIIXRLAB_INLINE constexpr uint32_t GetShCodebookEntriesCount() const noexcept { return mShCodebookEntriesCount; }
+		// The preview is the first chunk when there is one, the chunks cover every point once.
+		IIIXRLAB_INLINE constexpr const std::vector<SceneChunk>& GetChunks() const noexcept { return mChunks; }
+
+		// Points [firstPointIndex, firstPointIndex + pointsCount) along with the whole codebook when quantized, unless
+		// bReadsShCodebook is false because the range shares the codebook read with another. Failing leaves the gaussians untouched.
+		bool Read(const uint32_t firstPointIndex, const uint32_t pointsCount, GaussianInfo& outGaussianInfo, const bool bReadsShCodebook = true) noexcept;
+
+	private:
+		enum eArray : uint8_t
+		{
+			POSITIONS,
+			SCALES,
+			ROTATIONS,
+			ALPHAS,
+			COLORS,
+			SPHERICAL_HARMONICS,
+			SH_CODEBOOK,
+			SH_INDICES,
+			CHUNKS,
+			COUNT,
+		};
+
+	private:
+		std::filesystem::path mPath;
+		AsyncFileReader mFile;
+		bool mbIsOpen;
+		uint32_t mPointsCount;
+		uint32_t mShDegree;
+		uint32_t mShCodebookEntriesCount;
+		uint32_t mPreviewPointsCount;
+		bool mbIsAntialiased;
+		std::array<uint64_t, eArray::COUNT> mArrayOffsets;	// in bytes, of the first element
+		std::vector<SceneChunk> mChunks;
+	};
+
+	// Binary snapshot of the gaussians as they are held in memory, including a quantized spherical harmonics codebook,
+	// so a scene loads without decompressing or quantizing it again. Values are stored in the native byte order.
+	// previewPointsCount tells a progressive loader how many points at the front make a preview of the scene.
+	// The points after the preview are split into chunks of chunkPointsCount, which should already lie close together.
+	bool SaveSceneCache(const std::filesystem::path& path, const GaussianInfo& gaussianInfo, const uint32_t previewPointsCount = 0, const uint32_t chunkPointsCount = DEFAULT_CHUNK_POINTS_COUNT) noexcept;
+	// Preview chunk first when previewPointsCount > 0, each chunk bounded by three standard deviations of its points.
+	std::vector<SceneChunk> ComputeSceneChunks(const GaussianInfo& gaussianInfo, const uint32_t previewPointsCount, const uint32_t chunkPointsCount) noexcept;
+	// Failing leaves the gaussians untouched.
+	bool LoadSceneCache(const std::filesystem::path& path, GaussianInfo& outGaussianInfo, const FileReadInfo& fileReadInfo = {}) noexcept;
+} // namespace iiixrlab::scene
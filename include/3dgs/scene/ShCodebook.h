@@ -0,0 +1,33 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/scene/DataTypes.h"
+
+namespace iiixrlab::scene
+{
+	struct ShCodebookInfo final
+	{
+		uint32_t EntriesCount = 4096;			// at most 65536, the indices are 16 bits
+		uint32_t IterationsCount = 8;			// Lloyd iterations of each k-means level
+		uint32_t TrainingPointsPerEntry = 64;	// k-means runs on a random subset of about that many points per centroid
+		uint64_t Seed = 0;
+		uint32_t ThreadsCount = 0;				// 0 picks one per hardware thread
+	};
+
+	// Replaces the spherical harmonics by a codebook and one 16 bit index per point, 45 floats per point at degree 3 shrink
+	// to 2 bytes plus the codebook. k-means runs in two levels: a coarse one over the whole scene, then one per coarse
+	// cluster, each with its own random stream so the codebook does not depend on the threads count.
+	// Returns false and leaves the gaussians untouched when there are no coefficients or they are already quantized.
+	bool QuantizeSphericalHarmonics(GaussianInfo& inoutGaussianInfo, const ShCodebookInfo& codebookInfo) noexcept;
+
+	// Coefficients of every point in the layout of GaussianInfo::SphericalHarmonics, quantized or not.
+	std::vector<float> DecodeSphericalHarmonics(const GaussianInfo& gaussianInfo) noexcept;
+
+	// Bytes taken by the spherical harmonics of the gaussians, codebook and indices when quantized.
+	size_t GetShMemorySize(const GaussianInfo& gaussianInfo) noexcept;
+
+	// PSNR in dB of the colors the gaussians show from a fixed set of view directions against the ones of the reference
+	// coefficients, the difference quantization makes to the rendered splats before blending. Infinite when identical.
+	float ComputeShColorPsnr(const GaussianInfo& gaussianInfo, const std::vector<float>& referenceSphericalHarmonics) noexcept;
+} // namespace iiixrlab::scene
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/scene/DataTypes.h"
+
+namespace iiixrlab::scene
+{
+	enum class eSpaceFillingCurve : uint8_t
+	{
+		MORTON,		// interleaved coordinate bits, cheapest
+		HILBERT,	// never jumps between distant cells, a little more local
+	};
+
+	struct SpatialReorderInfo final
+	{
+		eSpaceFillingCurve Curve = eSpaceFillingCurve::MORTON;
+		uint32_t ThreadsCount = 0;				// 0 picks one per hardware thread
+	};
+
+	// Point indices along the curve through the positions, quantized to 21 bits per axis over the bounds of the scene,
+	// i.e. order[newIndex] = oldIndex. The 63-bit codes are sorted by a parallel stable LSD radix sort.
+	std::vector<uint32_t> ComputeSpatialOrder(const GaussianInfo& gaussianInfo, const SpatialReorderInfo& reorderInfo) noexcept;
+
+	// Keeps the points listed in order, in that order, moving every attribute along so they stay consistent.
+	// The order may list fewer points than the gaussians have, the others are dropped.
+	void PermuteGaussians(GaussianInfo& inoutGaussianInfo, const std::vector<uint32_t>& order, const uint32_t threadsCount) noexcept;
+
+	// Stores the gaussians along a space filling curve instead of the trainer's order, so neighboring splats are close in
+	// memory for every per splat pass, the vertex fetch and chunked culling.
+	void ReorderGaussians(GaussianInfo& inoutGaussianInfo, const SpatialReorderInfo& reorderInfo) noexcept;
+
+	// Parses morton or hilbert.
+	bool ParseSpaceFillingCurve(const char* name, eSpaceFillingCurve& outCurve) noexcept;
+	const char* GetSpaceFillingCurveName(const eSpaceFillingCurve curve) noexcept;
+} // namespace iiixrlab::scene
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/scene/DataTypes.h"
+
+namespace iiixrlab::scene
+{
+	// Orders splats back to front for alpha blending on the CPU.
+	// Depths are turned into 32-bit keys which a stable LSD radix sort orders along with the splat indices,
+	// the buffers are kept between frames so sorting every frame does not allocate.
+	class SplatSorter final
+	{
+	public:
+		// Maps a view depth to a key whose ascending order is back to front, i.e. descending depth.
+		static IIIXRLAB_INLINE constexpr uint32_t GetDepthKey(const float depth) noexcept
+		{
+			const uint32_t bits = std::bit_cast<uint32_t>(depth);
+			const uint32_t ascendingBits = (bits & 0x80000000u) != 0 ? ~bits : (bits | 0x80000000u);
+			return ~ascendingBits;
+		}
+
+	public:
+		IIIXRLAB_INLINE SplatSorter() noexcept = default;
+
+		SplatSorter(const SplatSorter&) = delete;
+		SplatSorter& operator=(const SplatSorter&) = delete;
+
+		IIIXRLAB_INLINE ~SplatSorter() noexcept = default;
+
+		IIIXRLAB_INLINE SplatSorter(SplatSorter&&) noexcept = default;
+		IIIXRLAB_INLINE SplatSorter& operator=(SplatSorter&&) noexcept = default;
+
+		IIIXRLAB_INLINE constexpr const std::vector<uint32_t>& GetKeys() const noexcept { return mKeys; }
+		// Splat indices back to front once sorted.
+		IIIXRLAB_INLINE constexpr const std::vector<uint32_t>& GetSortedIndices() const noexcept { return mIndices; }
+
+		// The view matrix transforms row vectors, so the view depth is the dot product with its third column.
+		void ComputeDepthKeys(const GaussianInfo& gaussianInfo, const iiixrlab::math::Matrix4x4f& view) noexcept;
+		// Adds the keys of another set of splats after the current ones, so several models sort together. Their view is
+		// e.g. world * view, the sorted indices of the appended splats start at the count of keys before the call.
+		// Only every pointsStride-th point gets a key, the point of an appended key is its index times pointsStride.
+		void AppendDepthKeys(const GaussianInfo& gaussianInfo, const iiixrlab::math::Matrix4x4f& view, const uint32_t pointsStride = 1) noexcept;
+		IIIXRLAB_INLINE void Clear() noexcept { mKeys.clear(); }
+		// Sorts the keys in place along with the indices.
+		void Sort() noexcept;
+
+	private:
+		std::vector<float> mDepths;
+		std::vector<uint32_t> mKeys;
+		std::vector<uint32_t> mIndices;
+		std::vector<uint32_t> mScratchKeys;
+		std::vector<uint32_t> mScratchIndices;
+	};
+} // namespace iiixrlab::scene
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "pch.h"
+
+#include "3dgs/scene/DataTypes.h"
+
+namespace iiixrlab::scene
+{
+	struct SpzWriteInfo final
+	{
+		uint32_t PositionFractionalBits = 12;	// of the 24 bit fixed point positions, 12 is a quarter millimeter over +-2 km
+		uint32_t Sh1Bits = 5;					// bits kept of the 8 bit coefficients of the first band
+		uint32_t ShRestBits = 4;				// of the higher bands
+		uint32_t MaxShDegree = 3;				// higher bands are dropped
+		int32_t CompressionLevel = 6;			// zlib level, 0 stores and 9 compresses best
+		uint32_t ThreadsCount = 0;				// 0 picks one per hardware thread
+	};
+
+	// Writes the gaussians as a version 2 .spz, which spz::loadSpz reads back, so the scene is written as it is in memory
+	// after pruning, reordering or quantizing and those are not redone on every load. A codebook is decoded since spz
+	// has no room for it. Points are quantized in parallel and the gzip stream is deflated in parallel blocks, each one
+	// primed with the end of the previous block so the ratio stays close to a single stream.
+	bool WriteSpz(const std::filesystem::path& path, const GaussianInfo& gaussianInfo, const SpzWriteInfo& writeInfo) noexcept;
+} // namespace iiixrlab::scene
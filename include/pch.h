@@ -4,20 +4,35 @@
 #define NOMINMAX
 #define UNICODE
 #include <windows.h>
-#else
-#error 0
-#endif
+#endif	// defined(_WIN32)
 
 // CRT
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <chrono>
+#include <cmath>
 #include <concepts>
+#include <condition_variable>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <numbers>
+#include <numeric>
+#include <optional>
+#include <span>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -34,5 +49,6 @@
 // Common
 #include "3dgs/CommonDefines.h"
 
+#include "3dgs/math/Simd.h"
 #include "3dgs/math/Matrix.hpp"
 #include "3dgs/math/Vector.h"
\ No newline at end of file
@@ -0,0 +1,590 @@
+#include "3dgs/AsyncFileReader.h"
+
+#include "3dgs/Profiler.h"
+#include "3dgs/ThreadPool.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define IIIXRLAB_IO_URING
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif	// defined(__linux__) && __has_include(<linux/io_uring.h>)
+
+namespace iiixrlab
+{
+	static constexpr const uint64_t DIRECT_ALIGNMENT = 4096;
+
+	// Splits a range into blocks which each fit a buffer of blockSize, even when aligning the read widens it.
+	static uint64_t GetBlockPayloadSize(const uint64_t blockSize, const uint64_t alignment) noexcept
+	{
+		return alignment > 1 ? blockSize - alignment : blockSize;
+	}
+
+	static uint64_t GetBlocksCount(const uint64_t size, const uint64_t payloadSize) noexcept
+	{
+		return (size + payloadSize - 1) / payloadSize;
+	}
+
+	static bool AreRangesValid(const std::span<const FileReadRange> ranges, const uint64_t fileSize) noexcept
+	{
+		for (const FileReadRange& range : ranges)
+		{
+			// empty ranges read nothing wherever they start
+			if (range.Size > 0 && (range.Offset > fileSize || range.Size > fileSize - range.Offset || range.Destination == nullptr))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+#if defined(IIIXRLAB_IO_URING)
+	// Submission and completion rings shared with the kernel, driven through the raw system calls so no library is needed.
+	struct AsyncFileReader::IoUring final
+	{
+		int RingFd = -1;
+		int FileFd = -1;
+		uint64_t Alignment = 1;				// of offsets, sizes and buffers, DIRECT_ALIGNMENT with O_DIRECT
+		// bounce buffers of BlockSize per slot with O_DIRECT
+		uint32_t SlotsCount = 0;			// reads in flight, each with its own buffer
+		uint64_t BlockSize = 0;
+		bool bAreBuffersRegistered = false;
+
+		void* SqRing = MAP_FAILED;
+		size_t SqRingSize = 0;
+		void* CqRing = MAP_FAILED;
+		size_t CqRingSize = 0;
+		io_uring_sqe* Sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+		size_t SqesSize = 0;
+		void* Buffers = MAP_FAILED;
+		size_t BuffersSize = 0;
+
+		uint32_t* SqHead = nullptr;
+		uint32_t* SqTail = nullptr;
+		uint32_t* SqArray = nullptr;
+		uint32_t SqMask = 0;
+		uint32_t* CqHead = nullptr;
+		uint32_t* CqTail = nullptr;
+		uint32_t CqMask = 0;
+		io_uring_cqe* Cqes = nullptr;
+
+		~IoUring() noexcept
+		{
+			if (Buffers != MAP_FAILED)
+			{
+				munmap(Buffers, BuffersSize);
+			}
+			if (Sqes != MAP_FAILED)
+			{
+				munmap(Sqes, SqesSize);
+			}
+			if (CqRing != MAP_FAILED && CqRing != SqRing)
+			{
+				munmap(CqRing, CqRingSize);
+			}
+			if (SqRing != MAP_FAILED)
+			{
+				munmap(SqRing, SqRingSize);
+			}
+			if (RingFd >= 0)
+			{
+				close(RingFd);
+			}
+			if (FileFd >= 0)
+			{
+				close(FileFd);
+			}
+		}
+	};
+#else
+	struct AsyncFileReader::IoUring final
+	{
+	};
+#endif	// defined(IIIXRLAB_IO_URING)
+
+	AsyncFileReader::AsyncFileReader(const std::filesystem::path& path, const FileReadInfo& fileReadInfo) noexcept
+		: mPath(path)
+		, mFileReadInfo(fileReadInfo)
+		, mBackend(eFileReadBackend::THREAD_POOL)
+		, mFileSize(UINT64_MAX)
+		, mIoUringOrNull()
+		, mThreadPoolOrNull()
+	{
+		std::error_code errorCode;
+		const uint64_t fileSize = std::filesystem::file_size(path, errorCode);
+		if (errorCode)
+		{
+			std::cerr << "Unable to open " << path << ".\n";
+			return;
+		}
+
+		// whole pages per block, so O_DIRECT reads stay aligned
+		mFileReadInfo.BlockSize = static_cast<uint32_t>(std::max<uint64_t>((fileReadInfo.BlockSize + DIRECT_ALIGNMENT - 1) / DIRECT_ALIGNMENT, 2) * DIRECT_ALIGNMENT);
+		mFileReadInfo.QueueDepth = std::clamp(fileReadInfo.QueueDepth, 1u, 4096u);
+
+#if defined(IIIXRLAB_IO_URING)
+		if (mFileReadInfo.Backend != eFileReadBackend::THREAD_POOL)
+		{
+			std::unique_ptr<IoUring> ioUring = std::make_unique<IoUring>();
+			if (setupIoUring(*ioUring) == true)
+			{
+				mIoUringOrNull = std::move(ioUring);
+				mBackend = eFileReadBackend::IO_URING;
+			}
+		}
+#endif	// defined(IIIXRLAB_IO_URING)
+		if (mFileReadInfo.Backend == eFileReadBackend::IO_URING && mBackend != eFileReadBackend::IO_URING)
+		{
+			std::cerr << "io_uring is not available, reading " << path << " with a thread pool instead.\n";
+		}
+		if (mFileReadInfo.bIsDirect == true && mBackend != eFileReadBackend::IO_URING)
+		{
+			std::cerr << "O_DIRECT is only honored by io_uring, reading " << path << " through the page cache.\n";
+		}
+
+		if (mBackend == eFileReadBackend::THREAD_POOL)
+		{
+			if (std::ifstream(path, std::ios::binary).is_open() == false)
+			{
+				std::cerr << "Unable to open " << path << ".\n";
+				return;
+			}
+			const uint32_t threadsCount = mFileReadInfo.ThreadsCount > 0 ? mFileReadInfo.ThreadsCount : std::max(std::thread::hardware_concurrency(), 1u);
+			mThreadPoolOrNull = std::make_unique<ThreadPool>(ThreadPool::CreateInfo{ .ThreadsCount = std::min(threadsCount, mFileReadInfo.QueueDepth) });
+		}
+
+		mFileSize = fileSize;
+	}
+
+	AsyncFileReader::~AsyncFileReader() noexcept = default;
+
+	bool AsyncFileReader::Read(const std::span<const FileReadRange> ranges, const std::function<void(size_t rangeIndex)>& onRangeReadOrNull) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		if (IsOpen() == false || AreRangesValid(ranges, mFileSize) == false)
+		{
+			std::cerr << "Reading past the end of " << mPath << ".\n";
+			IIIXRLAB_DEBUG_BREAK();
+			return false;
+		}
+
+		switch (mBackend)
+		{
+		case eFileReadBackend::IO_URING:
+			return readWithIoUring(ranges, onRangeReadOrNull);
+		case eFileReadBackend::THREAD_POOL:
+			return readWithThreadPool(ranges, onRangeReadOrNull);
+		default:
+			assert(false);
+			return false;
+		}
+	}
+
+	bool AsyncFileReader::ReadAll(std::vector<uint8_t>& outData) noexcept
+	{
+		if (IsOpen() == false)
+		{
+			return false;
+		}
+
+		std::vector<uint8_t> data(mFileSize);
+		const FileReadRange range = { .Offset = 0, .Size = mFileSize, .Destination = data.data() };
+		if (Read(std::span<const FileReadRange>(&range, 1)) == false)
+		{
+			return false;
+		}
+
+		outData = std::move(data);
+		return true;
+	}
+
+	bool AsyncFileReader::readWithThreadPool(const std::span<const FileReadRange> ranges, const std::function<void(size_t rangeIndex)>& onRangeReadOrNull) noexcept
+	{
+		struct Block final
+		{
+			size_t RangeIndex;
+			uint64_t Offset;		// in the range
+			uint64_t Size;
+		};
+
+		// workers read straight into the destinations and queue the ranges they complete for the calling thread
+		const uint64_t payloadSize = mFileReadInfo.BlockSize;
+		std::vector<Block> blocks;
+		std::mutex mutex;
+		std::condition_variable rangeRead;
+		std::deque<size_t> readRangeIndices;
+		std::vector<uint64_t> remainingBlocksCounts(ranges.size());
+		uint64_t pendingBlocksCount = 0;
+		bool bHasFailed = false;
+
+		for (size_t rangeIndex = 0; rangeIndex < ranges.size(); ++rangeIndex)
+		{
+			remainingBlocksCounts[rangeIndex] = GetBlocksCount(ranges[rangeIndex].Size, payloadSize);
+			pendingBlocksCount += remainingBlocksCounts[rangeIndex];
+			if (remainingBlocksCounts[rangeIndex] == 0)
+			{
+				readRangeIndices.push_back(rangeIndex);
+			}
+		}
+
+		blocks.reserve(static_cast<size_t>(pendingBlocksCount));
+		for (size_t rangeIndex = 0; rangeIndex < ranges.size(); ++rangeIndex)
+		{
+			for (uint64_t offset = 0; offset < ranges[rangeIndex].Size; offset += payloadSize)
+			{
+				blocks.push_back({ .RangeIndex = rangeIndex, .Offset = offset, .Size = std::min(payloadSize, ranges[rangeIndex].Size - offset) });
+			}
+		}
+
+		// every worker opens the file once and takes the next block until none is left, in the order of the ranges
+		std::atomic<size_t> nextBlockIndex = 0;
+		const uint32_t workersCount = static_cast<uint32_t>(std::min<size_t>(mThreadPoolOrNull->GetThreadsCount(), blocks.size()));
+		for (uint32_t workerIndex = 0; workerIndex < workersCount; ++workerIndex)
+		{
+			mThreadPoolOrNull->Submit([&]()
+				{
+					std::ifstream file(mPath, std::ios::binary);
+					for (size_t blockIndex = nextBlockIndex++; blockIndex < blocks.size(); blockIndex = nextBlockIndex++)
+					{
+						IIIXRLAB_PROFILE_ZONE("AsyncFileReader::readBlock");
+
+						const Block& block = blocks[blockIndex];
+						file.seekg(static_cast<std::streamoff>(ranges[block.RangeIndex].Offset + block.Offset));
+						file.read(static_cast<char*>(ranges[block.RangeIndex].Destination) + block.Offset, static_cast<std::streamsize>(block.Size));
+						const bool bIsRead = file.good();
+
+						std::lock_guard<std::mutex> lock(mutex);
+						--pendingBlocksCount;
+						bHasFailed = bHasFailed == true || bIsRead == false;
+						if (bIsRead == true && --remainingBlocksCounts[block.RangeIndex] == 0)
+						{
+							readRangeIndices.push_back(block.RangeIndex);
+						}
+						rangeRead.notify_one();
+					}
+				});
+		}
+
+		while (true)
+		{
+			size_t rangeIndex = 0;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				rangeRead.wait(lock, [&]() { return readRangeIndices.empty() == false || pendingBlocksCount == 0; });
+				if (readRangeIndices.empty() == true)
+				{
+					break;
+				}
+				rangeIndex = readRangeIndices.front();
+				readRangeIndices.pop_front();
+			}
+
+			if (onRangeReadOrNull != nullptr)
+			{
+				onRangeReadOrNull(rangeIndex);
+			}
+		}
+		// the last worker may still hold the lock after the count reached 0
+		mThreadPoolOrNull->Wait();
+
+		if (bHasFailed == true)
+		{
+			std::cerr << "Failed to read " << mPath << ".\n";
+			return false;
+		}
+		return true;
+	}
+
+#if defined(IIIXRLAB_IO_URING)
+	bool AsyncFileReader::setupIoUring(IoUring& outIoUring) const noexcept
+	{
+		const std::filesystem::path& path = mPath;
+		const FileReadInfo& fileReadInfo = mFileReadInfo;
+		io_uring_params params = {};
+		outIoUring.RingFd = static_cast<int>(syscall(__NR_io_uring_setup, fileReadInfo.QueueDepth, &params));
+		if (outIoUring.RingFd < 0)
+		{
+			return false;
+		}
+
+		outIoUring.SqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+		outIoUring.CqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		const bool bIsSingleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+		if (bIsSingleMmap == true)
+		{
+			outIoUring.SqRingSize = std::max(outIoUring.SqRingSize, outIoUring.CqRingSize);
+			outIoUring.CqRingSize = outIoUring.SqRingSize;
+		}
+		outIoUring.SqRing = mmap(nullptr, outIoUring.SqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, outIoUring.RingFd, IORING_OFF_SQ_RING);
+		if (outIoUring.SqRing == MAP_FAILED)
+		{
+			return false;
+		}
+		outIoUring.CqRing = bIsSingleMmap == true ? outIoUring.SqRing : mmap(nullptr, outIoUring.CqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, outIoUring.RingFd, IORING_OFF_CQ_RING);
+		outIoUring.SqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		outIoUring.Sqes = static_cast<io_uring_sqe*>(mmap(nullptr, outIoUring.SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, outIoUring.RingFd, IORING_OFF_SQES));
+		if (outIoUring.CqRing == MAP_FAILED || outIoUring.Sqes == MAP_FAILED)
+		{
+			return false;
+		}
+
+		uint8_t* const sqRing = static_cast<uint8_t*>(outIoUring.SqRing);
+		uint8_t* const cqRing = static_cast<uint8_t*>(outIoUring.CqRing);
+		outIoUring.SqHead = reinterpret_cast<uint32_t*>(sqRing + params.sq_off.head);
+		outIoUring.SqTail = reinterpret_cast<uint32_t*>(sqRing + params.sq_off.tail);
+		outIoUring.SqArray = reinterpret_cast<uint32_t*>(sqRing + params.sq_off.array);
+		outIoUring.SqMask = *reinterpret_cast<uint32_t*>(sqRing + params.sq_off.ring_mask);
+		outIoUring.CqHead = reinterpret_cast<uint32_t*>(cqRing + params.cq_off.head);
+		outIoUring.CqTail = reinterpret_cast<uint32_t*>(cqRing + params.cq_off.tail);
+		outIoUring.CqMask = *reinterpret_cast<uint32_t*>(cqRing + params.cq_off.ring_mask);
+		outIoUring.Cqes = reinterpret_cast<io_uring_cqe*>(cqRing + params.cq_off.cqes);
+
+		// filesystems without O_DIRECT, e.g. tmpfs, refuse it when opening
+		outIoUring.FileFd = -1;
+		if (fileReadInfo.bIsDirect == true)
+		{
+			outIoUring.FileFd = open(path.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+			outIoUring.Alignment = outIoUring.FileFd >= 0 ? DIRECT_ALIGNMENT : 1;
+			if (outIoUring.FileFd < 0)
+			{
+				std::cerr << "O_DIRECT is refused by the file system of " << path << ", reading it through the page cache.\n";
+			}
+		}
+		if (outIoUring.FileFd < 0)
+		{
+			outIoUring.FileFd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		}
+		if (outIoUring.FileFd < 0)
+		{
+			return false;
+		}
+
+		outIoUring.SlotsCount = std::min(fileReadInfo.QueueDepth, params.sq_entries);
+		outIoUring.BlockSize = fileReadInfo.BlockSize;
+		if (outIoUring.Alignment == 1)
+		{
+			// reads through the page cache land in the destinations directly
+			return true;
+		}
+
+		// O_DIRECT reads go through bounce buffers, anonymous mappings are page aligned as it wants them to be
+		outIoUring.BuffersSize = outIoUring.SlotsCount * outIoUring.BlockSize;
+		outIoUring.Buffers = mmap(nullptr, outIoUring.BuffersSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (outIoUring.Buffers == MAP_FAILED)
+		{
+			return false;
+		}
+
+		// registering pins the buffers once instead of on every read, plain reads are used past the memlock limit
+		std::vector<iovec> iovecs(outIoUring.SlotsCount);
+		for (uint32_t slotIndex = 0; slotIndex < outIoUring.SlotsCount; ++slotIndex)
+		{
+			iovecs[slotIndex] = { .iov_base = static_cast<uint8_t*>(outIoUring.Buffers) + slotIndex * outIoUring.BlockSize, .iov_len = outIoUring.BlockSize };
+		}
+		outIoUring.bAreBuffersRegistered = syscall(__NR_io_uring_register, outIoUring.RingFd, IORING_REGISTER_BUFFERS, iovecs.data(), outIoUring.SlotsCount) == 0;
+
+		return true;
+	}
+
+	bool AsyncFileReader::readWithIoUring(const std::span<const FileReadRange> ranges, const std::function<void(size_t rangeIndex)>& onRangeReadOrNull) noexcept
+	{
+		struct Block final
+		{
+			size_t RangeIndex;
+			uint64_t ReadOffset;	// aligned, of the first byte read into the buffer
+			uint64_t ReadSize;		// aligned, past the end of the file when that is not
+			uint8_t* Buffer;		// the bounce buffer of the slot, or the destination when nothing needs to be aligned
+			uint64_t CopyOffset;	// of the wanted bytes in the buffer
+			uint64_t CopySize;
+			uint8_t* Destination;
+			uint64_t ReadBytesCount;
+		};
+
+		IoUring& ioUring = *mIoUringOrNull;
+		const uint64_t alignment = ioUring.Alignment;
+		const uint64_t payloadSize = GetBlockPayloadSize(ioUring.BlockSize, alignment);
+		std::vector<uint64_t> remainingBlocksCounts(ranges.size());
+		for (size_t rangeIndex = 0; rangeIndex < ranges.size(); ++rangeIndex)
+		{
+			remainingBlocksCounts[rangeIndex] = GetBlocksCount(ranges[rangeIndex].Size, payloadSize);
+			if (remainingBlocksCounts[rangeIndex] == 0 && onRangeReadOrNull != nullptr)
+			{
+				onRangeReadOrNull(rangeIndex);
+			}
+		}
+
+		std::vector<Block> slots(ioUring.SlotsCount);
+		std::vector<uint32_t> freeSlotIndices(ioUring.SlotsCount);
+		std::iota(freeSlotIndices.rbegin(), freeSlotIndices.rend(), 0u);
+		uint32_t sqTail = *ioUring.SqTail;
+		size_t nextRangeIndex = 0;
+		uint64_t nextRangeOffset = 0;
+		bool bHasFailed = false;
+
+		const auto queue = [&ioUring, &sqTail](const uint32_t slotIndex, const Block& block)
+		{
+			const uint32_t sqeIndex = sqTail & ioUring.SqMask;
+			io_uring_sqe& sqe = ioUring.Sqes[sqeIndex];
+			memset(&sqe, 0, sizeof(sqe));
+			sqe.opcode = ioUring.bAreBuffersRegistered == true ? IORING_OP_READ_FIXED : IORING_OP_READ;
+			sqe.fd = ioUring.FileFd;
+			sqe.off = block.ReadOffset + block.ReadBytesCount;
+			sqe.addr = reinterpret_cast<uint64_t>(block.Buffer + block.ReadBytesCount);
+			sqe.len = static_cast<uint32_t>(block.ReadSize - block.ReadBytesCount);
+			sqe.buf_index = static_cast<uint16_t>(ioUring.bAreBuffersRegistered == true ? slotIndex : 0);
+			sqe.user_data = slotIndex;
+			ioUring.SqArray[sqeIndex] = sqeIndex;
+			++sqTail;
+		};
+
+		while (true)
+		{
+			// fill every free buffer with the next block
+			while (bHasFailed == false && freeSlotIndices.empty() == false && nextRangeIndex < ranges.size())
+			{
+				const FileReadRange& range = ranges[nextRangeIndex];
+				if (nextRangeOffset >= range.Size)
+				{
+					++nextRangeIndex;
+					nextRangeOffset = 0;
+					continue;
+				}
+
+				const uint64_t offset = range.Offset + nextRangeOffset;
+				const uint64_t size = std::min(payloadSize, range.Size - nextRangeOffset);
+				const uint64_t readOffset = offset / alignment * alignment;
+				const uint32_t slotIndex = freeSlotIndices.back();
+				freeSlotIndices.pop_back();
+				slots[slotIndex] =
+				{
+					.RangeIndex = nextRangeIndex,
+					.ReadOffset = readOffset,
+					.ReadSize = (offset + size - readOffset + alignment - 1) / alignment * alignment,
+					.Buffer = alignment > 1 ? static_cast<uint8_t*>(ioUring.Buffers) + slotIndex * ioUring.BlockSize : static_cast<uint8_t*>(range.Destination) + nextRangeOffset,
+					.CopyOffset = offset - readOffset,
+					.CopySize = size,
+					.Destination = static_cast<uint8_t*>(range.Destination) + nextRangeOffset,
+					.ReadBytesCount = 0,
+				};
+				queue(slotIndex, slots[slotIndex]);
+				nextRangeOffset += size;
+			}
+
+			// every buffer is back once nothing is in flight anymore
+			if (freeSlotIndices.size() == ioUring.SlotsCount)
+			{
+				break;
+			}
+
+			// one call submits the queued reads and waits for at least one to complete, reads the kernel did not take
+			// because of an interruption stay queued for the next call
+			__atomic_store_n(ioUring.SqTail, sqTail, __ATOMIC_RELEASE);
+			const uint32_t queuedCount = sqTail - __atomic_load_n(ioUring.SqHead, __ATOMIC_ACQUIRE);
+			if (syscall(__NR_io_uring_enter, ioUring.RingFd, queuedCount, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0
+				&& errno != EINTR && errno != EAGAIN && errno != EBUSY)
+			{
+				std::cerr << "io_uring_enter failed with " << errno << " while reading " << mPath << ".\n";
+				IIIXRLAB_DEBUG_BREAK();
+				// the buffers may still be read into, so the ring is torn down along with them and the reader is closed
+				mIoUringOrNull.reset();
+				mFileSize = UINT64_MAX;
+				return false;
+			}
+
+			uint32_t cqHead = *ioUring.CqHead;
+			const uint32_t cqTail = __atomic_load_n(ioUring.CqTail, __ATOMIC_ACQUIRE);
+			for (; cqHead != cqTail; ++cqHead)
+			{
+				const io_uring_cqe& cqe = ioUring.Cqes[cqHead & ioUring.CqMask];
+				const uint32_t slotIndex = static_cast<uint32_t>(cqe.user_data);
+				Block& block = slots[slotIndex];
+				if (cqe.res > 0)
+				{
+					block.ReadBytesCount += static_cast<uint64_t>(cqe.res);
+				}
+				else if (cqe.res != -EINTR && cqe.res != -EAGAIN)
+				{
+					// 0 is the end of the file before the wanted bytes
+					std::cerr << "Failed to read " << mPath << " at " << block.ReadOffset + block.ReadBytesCount << " with error " << -cqe.res << ".\n";
+					bHasFailed = true;
+					freeSlotIndices.push_back(slotIndex);
+					continue;
+				}
+
+				// short reads only stop at the end of the file, which the aligned size may reach past
+				if (block.ReadBytesCount < block.CopyOffset + block.CopySize)
+				{
+					if (bHasFailed == false)
+					{
+						queue(slotIndex, block);
+					}
+					else
+					{
+						freeSlotIndices.push_back(slotIndex);
+					}
+					continue;
+				}
+
+				if (block.Buffer != block.Destination)
+				{
+					memcpy(block.Destination, block.Buffer + block.CopyOffset, block.CopySize);
+				}
+				freeSlotIndices.push_back(slotIndex);
+				if (--remainingBlocksCounts[block.RangeIndex] == 0 && bHasFailed == false && onRangeReadOrNull != nullptr)
+				{
+					onRangeReadOrNull(block.RangeIndex);
+				}
+			}
+			__atomic_store_n(ioUring.CqHead, cqHead, __ATOMIC_RELEASE);
+		}
+
+		return bHasFailed == false;
+	}
+#else
+	bool AsyncFileReader::readWithIoUring(const std::span<const FileReadRange> ranges, const std::function<void(size_t rangeIndex)>& onRangeReadOrNull) noexcept
+	{
+		return readWithThreadPool(ranges, onRangeReadOrNull);
+	}
+#endif	// defined(IIIXRLAB_IO_URING)
+
+	bool ParseFileReadBackend(const char* name, eFileReadBackend& outBackend) noexcept
+	{
+		if (strcmp(name, "auto") == 0)
+		{
+			outBackend = eFileReadBackend::AUTO;
+		}
+		else if (strcmp(name, "io_uring") == 0)
+		{
+			outBackend = eFileReadBackend::IO_URING;
+		}
+		else if (strcmp(name, "threads") == 0)
+		{
+			outBackend = eFileReadBackend::THREAD_POOL;
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	}
+
+	const char* GetFileReadBackendName(const eFileReadBackend backend) noexcept
+	{
+		switch (backend)
+		{
+		case eFileReadBackend::AUTO:
+			return "auto";
+		case eFileReadBackend::IO_URING:
+			return "io_uring";
+		case eFileReadBackend::THREAD_POOL:
+			return "threads";
+		default:
+			assert(false);
+			return "unknown";
+		}
+	}
+} // namespace iiixrlab
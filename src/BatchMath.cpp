@@ -0,0 +1,231 @@
+#include "3dgs/math/BatchMath.h"
+
+#include "BatchMathKernels.hpp"
+
+#if defined(IIIXRLAB_BATCH_MATH_X86) && defined(_MSC_VER)
+	#include <intrin.h>
+#elif defined(IIIXRLAB_BATCH_MATH_X86)
+	#include <cpuid.h>
+#endif	// defined(IIIXRLAB_BATCH_MATH_X86)
+
+namespace iiixrlab::math
+{
+	namespace
+	{
+		// One element at a time, for CPUs without any of the x86 levels. Compilers still vectorize most of it.
+		struct ScalarLanes final
+		{
+			using Float = float;
+			static constexpr const size_t WIDTH = 1;
+
+			static IIIXRLAB_INLINE Float Load(const float* elements) noexcept { return *elements; }
+			static IIIXRLAB_INLINE void Store(float* outElements, const Float value) noexcept { *outElements = value; }
+			static IIIXRLAB_INLINE Float Set1(const float value) noexcept { return value; }
+
+			static IIIXRLAB_INLINE Float Add(const Float lhs, const Float rhs) noexcept { return lhs + rhs; }
+			static IIIXRLAB_INLINE Float Subtract(const Float lhs, const Float rhs) noexcept { return lhs - rhs; }
+			static IIIXRLAB_INLINE Float Multiply(const Float lhs, const Float rhs) noexcept { return lhs * rhs; }
+			static IIIXRLAB_INLINE Float MultiplyAdd(const Float lhs, const Float rhs, const Float addend) noexcept { return lhs * rhs + addend; }
+			static IIIXRLAB_INLINE Float Divide(const Float lhs, const Float rhs) noexcept { return lhs / rhs; }
+			static IIIXRLAB_INLINE Float Min(const Float lhs, const Float rhs) noexcept { return std::min(lhs, rhs); }
+			static IIIXRLAB_INLINE Float Max(const Float lhs, const Float rhs) noexcept { return std::max(lhs, rhs); }
+
+			static IIIXRLAB_INLINE void RoundPow2(const Float value, Float& outRounded, Float& outPow2) noexcept
+			{
+				outRounded = std::nearbyint(value);
+				outPow2 = std::bit_cast<float>(static_cast<uint32_t>(static_cast<int32_t>(outRounded) + 127) << 23);
+			}
+
+			static IIIXRLAB_INLINE void LoadPoints(const float* positions, Float& outX, Float& outY, Float& outZ) noexcept
+			{
+				outX = positions[0];
+				outY = positions[1];
+				outZ = positions[2];
+			}
+
+			static IIIXRLAB_INLINE void StorePoints(float* outPositions, const Float x, const Float y, const Float z) noexcept
+			{
+				outPositions[0] = x;
+				outPositions[1] = y;
+				outPositions[2] = z;
+			}
+
+			static IIIXRLAB_INLINE void LoadQuaternions(const float* rotations, Float& outX, Float& outY, Float& outZ, Float& outW) noexcept
+			{
+				outX = rotations[0];
+				outY = rotations[1];
+				outZ = rotations[2];
+				outW = rotations[3];
+			}
+		};
+	} // namespace
+
+	const BatchMathKernels& GetScalarBatchMathKernels() noexcept
+	{
+		return GetBatchMathKernels<ScalarLanes>();
+	}
+
+#if defined(IIIXRLAB_BATCH_MATH_X86)
+	static void GetCpuId(const uint32_t leaf, const uint32_t subleaf, uint32_t outRegisters[4]) noexcept
+	{
+#if defined(_MSC_VER)
+		int registers[4];
+		__cpuidex(registers, static_cast<int>(leaf), static_cast<int>(subleaf));
+		for (uint32_t registerIndex = 0; registerIndex < 4; ++registerIndex)
+		{
+			outRegisters[registerIndex] = static_cast<uint32_t>(registers[registerIndex]);
+		}
+#else	// NOT defined(_MSC_VER)
+		__cpuid_count(leaf, subleaf, outRegisters[0], outRegisters[1], outRegisters[2], outRegisters[3]);
+#endif	// NOT defined(_MSC_VER)
+	}
+
+	// Register state the OS saves on context switches, a CPU feature is only usable when its registers are.
+	static uint64_t GetEnabledRegisterStates() noexcept
+	{
+#if defined(_MSC_VER)
+		return _xgetbv(0);
+#else	// NOT defined(_MSC_VER)
+		uint32_t low;
+		uint32_t high;
+		__asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+		return (static_cast<uint64_t>(high) << 32) | low;
+#endif	// NOT defined(_MSC_VER)
+	}
+
+	static eCpuFeatureLevel DetectCpuFeatureLevel() noexcept
+	{
+		uint32_t registers[4] = {};
+		GetCpuId(0, 0, registers);
+		const uint32_t maxLeaf = registers[0];
+
+		GetCpuId(1, 0, registers);
+		const uint32_t features = registers[2];
+		const bool bHasSse42 = (features & (1u << 20)) != 0;
+		const bool bHasFma = (features & (1u << 12)) != 0;
+		const bool bHasOsXsave = (features & (1u << 27)) != 0;
+		const bool bHasAvx = (features & (1u << 28)) != 0;
+		if (bHasSse42 == false)
+		{
+			return eCpuFeatureLevel::SCALAR;
+		}
+
+		if (bHasOsXsave == false || bHasAvx == false || maxLeaf < 7)
+		{
+			return eCpuFeatureLevel::SSE4_2;
+		}
+
+		const uint64_t registerStates = GetEnabledRegisterStates();
+		const bool bAreYmmRegistersEnabled = (registerStates & 0x6) == 0x6;				// XMM and YMM
+		const bool bAreZmmRegistersEnabled = (registerStates & 0xE6) == 0xE6;				// and opmask, ZMM0-15, ZMM16-31
+
+		GetCpuId(7, 0, registers);
+		const uint32_t extendedFeatures = registers[1];
+		const bool bHasAvx2 = (extendedFeatures & (1u << 5)) != 0;
+		const bool bHasAvx512F = (extendedFeatures & (1u << 16)) != 0;
+		if (bHasAvx2 == false || bHasFma == false || bAreYmmRegistersEnabled == false)
+		{
+			return eCpuFeatureLevel::SSE4_2;
+		}
+
+		if (bHasAvx512F == false || bAreZmmRegistersEnabled == false)
+		{
+			return eCpuFeatureLevel::AVX2;
+		}
+
+		return eCpuFeatureLevel::AVX512;
+	}
+#endif	// defined(IIIXRLAB_BATCH_MATH_X86)
+
+	eCpuFeatureLevel GetSupportedCpuFeatureLevel() noexcept
+	{
+#if defined(IIIXRLAB_BATCH_MATH_X86)
+		static const eCpuFeatureLevel supportedLevel = DetectCpuFeatureLevel();
+		return supportedLevel;
+#else	// NOT defined(IIIXRLAB_BATCH_MATH_X86)
+		return eCpuFeatureLevel::SCALAR;
+#endif	// NOT defined(IIIXRLAB_BATCH_MATH_X86)
+	}
+
+	static std::atomic<eCpuFeatureLevel>& GetCpuFeatureLevelState() noexcept
+	{
+		static std::atomic<eCpuFeatureLevel> level = GetSupportedCpuFeatureLevel();
+		return level;
+	}
+
+	eCpuFeatureLevel GetCpuFeatureLevel() noexcept
+	{
+		return GetCpuFeatureLevelState().load(std::memory_order_relaxed);
+	}
+
+	eCpuFeatureLevel SetCpuFeatureLevel(const eCpuFeatureLevel level) noexcept
+	{
+		const eCpuFeatureLevel clampedLevel = std::min(level, GetSupportedCpuFeatureLevel());
+		GetCpuFeatureLevelState().store(clampedLevel, std::memory_order_relaxed);
+		return clampedLevel;
+	}
+
+	const char* GetCpuFeatureLevelName(const eCpuFeatureLevel level) noexcept
+	{
+		switch (level)
+		{
+		case eCpuFeatureLevel::SCALAR:
+			return "scalar";
+		case eCpuFeatureLevel::SSE4_2:
+			return "sse4.2";
+		case eCpuFeatureLevel::AVX2:
+			return "avx2";
+		case eCpuFeatureLevel::AVX512:
+			return "avx512";
+		default:
+			return "unknown";
+		}
+	}
+
+	static const BatchMathKernels& GetKernels() noexcept
+	{
+		switch (GetCpuFeatureLevel())
+		{
+#if defined(IIIXRLAB_BATCH_MATH_X86)
+		case eCpuFeatureLevel::SSE4_2:
+			return GetSse42BatchMathKernels();
+		case eCpuFeatureLevel::AVX2:
+			return GetAvx2BatchMathKernels();
+		case eCpuFeatureLevel::AVX512:
+			return GetAvx512BatchMathKernels();
+#endif	// defined(IIIXRLAB_BATCH_MATH_X86)
+		default:
+			return GetScalarBatchMathKernels();
+		}
+	}
+
+	void TransformPoints(const std::span<const float> positions, const Matrix4x4f& matrix, const std::span<float> outPositions) noexcept
+	{
+		assert(outPositions.size() >= positions.size() / 3 * 3);
+		GetKernels().TransformPoints(positions.data(), positions.size() / 3, matrix.GetElements(), outPositions.data());
+	}
+
+	void ComputeViewDepths(const std::span<const float> positions, const Matrix4x4f& view, const std::span<float> outDepths) noexcept
+	{
+		assert(outDepths.size() >= positions.size() / 3);
+		GetKernels().ComputeViewDepths(positions.data(), positions.size() / 3, view.GetElements(), outDepths.data());
+	}
+
+	void ComputeRotationMatrices(const std::span<const float> rotations, const std::span<float> outMatrices) noexcept
+	{
+		assert(outMatrices.size() >= rotations.size() / 4 * 9);
+		GetKernels().ComputeRotationMatrices(rotations.data(), rotations.size() / 4, outMatrices.data());
+	}
+
+	void Exponentiate(const std::span<const float> values, const std::span<float> outValues) noexcept
+	{
+		assert(outValues.size() >= values.size());
+		GetKernels().Exponentiate(values.data(), values.size(), outValues.data());
+	}
+
+	void ApplySigmoid(const std::span<const float> values, const std::span<float> outValues) noexcept
+	{
+		assert(outValues.size() >= values.size());
+		GetKernels().ApplySigmoid(values.data(), values.size(), outValues.data());
+	}
+} // namespace iiixrlab::math
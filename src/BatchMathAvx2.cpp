@@ -0,0 +1,52 @@
+#include "BatchMathKernels.hpp"
+
+// Compiled with AVX2 and FMA enabled, see CMakeLists.txt, and only called once the CPU reports it.
+#if defined(IIIXRLAB_BATCH_MATH_X86)
+namespace iiixrlab::math
+{
+	namespace
+	{
+		struct Avx2Lanes final : X86Interleaving<Avx2Lanes>
+		{
+			using Float = __m256;
+			static constexpr const size_t WIDTH = 8;
+
+			static Float Load(const float* elements) noexcept { return _mm256_loadu_ps(elements); }
+			static void Store(float* outElements, const Float value) noexcept { _mm256_storeu_ps(outElements, value); }
+			// one 128-bit lane per laneStride floats
+			static Float LoadLanes(const float* elements, const size_t laneStride) noexcept { return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(elements)), _mm_loadu_ps(elements + laneStride), 1); }
+			static void StoreLanes(float* outElements, const size_t laneStride, const Float value) noexcept
+			{
+				_mm_storeu_ps(outElements, _mm256_castps256_ps128(value));
+				_mm_storeu_ps(outElements + laneStride, _mm256_extractf128_ps(value, 1));
+			}
+			static Float Set1(const float value) noexcept { return _mm256_set1_ps(value); }
+
+			static Float Add(const Float lhs, const Float rhs) noexcept { return _mm256_add_ps(lhs, rhs); }
+			static Float Subtract(const Float lhs, const Float rhs) noexcept { return _mm256_sub_ps(lhs, rhs); }
+			static Float Multiply(const Float lhs, const Float rhs) noexcept { return _mm256_mul_ps(lhs, rhs); }
+			static Float MultiplyAdd(const Float lhs, const Float rhs, const Float addend) noexcept { return _mm256_fmadd_ps(lhs, rhs, addend); }
+			static Float Divide(const Float lhs, const Float rhs) noexcept { return _mm256_div_ps(lhs, rhs); }
+			static Float Min(const Float lhs, const Float rhs) noexcept { return _mm256_min_ps(lhs, rhs); }
+			static Float Max(const Float lhs, const Float rhs) noexcept { return _mm256_max_ps(lhs, rhs); }
+
+			static void RoundPow2(const Float value, Float& outRounded, Float& outPow2) noexcept
+			{
+				const __m256i rounded = _mm256_cvtps_epi32(value);
+				outRounded = _mm256_cvtepi32_ps(rounded);
+				outPow2 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(rounded, _mm256_set1_epi32(127)), 23));
+			}
+
+			template<int Mask>
+			static Float Shuffle(const Float lhs, const Float rhs) noexcept { return _mm256_shuffle_ps(lhs, rhs, Mask); }
+			static Float UnpackLow(const Float lhs, const Float rhs) noexcept { return _mm256_unpacklo_ps(lhs, rhs); }
+			static Float UnpackHigh(const Float lhs, const Float rhs) noexcept { return _mm256_unpackhi_ps(lhs, rhs); }
+		};
+	} // namespace
+
+	const BatchMathKernels& GetAvx2BatchMathKernels() noexcept
+	{
+		return GetBatchMathKernels<Avx2Lanes>();
+	}
+} // namespace iiixrlab::math
+#endif	// defined(IIIXRLAB_BATCH_MATH_X86)
@@ -0,0 +1,66 @@
+// GCC 12 flags the self initialized _mm512_undefined_ps() its own AVX-512 intrinsics use
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic ignored "-Wuninitialized"
+	#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif	// defined(__GNUC__) && !defined(__clang__)
+
+#include "BatchMathKernels.hpp"
+
+// Compiled with AVX-512F enabled, see CMakeLists.txt, and only called once the CPU reports it.
+#if defined(IIIXRLAB_BATCH_MATH_X86)
+namespace iiixrlab::math
+{
+	namespace
+	{
+		struct Avx512Lanes final : X86Interleaving<Avx512Lanes>
+		{
+			using Float = __m512;
+			static constexpr const size_t WIDTH = 16;
+
+			static Float Load(const float* elements) noexcept { return _mm512_loadu_ps(elements); }
+			static void Store(float* outElements, const Float value) noexcept { _mm512_storeu_ps(outElements, value); }
+			// one 128-bit lane per laneStride floats
+			static Float LoadLanes(const float* elements, const size_t laneStride) noexcept
+			{
+				Float lanes = _mm512_castps128_ps512(_mm_loadu_ps(elements));
+				lanes = _mm512_insertf32x4(lanes, _mm_loadu_ps(elements + laneStride), 1);
+				lanes = _mm512_insertf32x4(lanes, _mm_loadu_ps(elements + 2 * laneStride), 2);
+				return _mm512_insertf32x4(lanes, _mm_loadu_ps(elements + 3 * laneStride), 3);
+			}
+			static void StoreLanes(float* outElements, const size_t laneStride, const Float value) noexcept
+			{
+				_mm_storeu_ps(outElements, _mm512_castps512_ps128(value));
+				_mm_storeu_ps(outElements + laneStride, _mm512_extractf32x4_ps(value, 1));
+				_mm_storeu_ps(outElements + 2 * laneStride, _mm512_extractf32x4_ps(value, 2));
+				_mm_storeu_ps(outElements + 3 * laneStride, _mm512_extractf32x4_ps(value, 3));
+			}
+			static Float Set1(const float value) noexcept { return _mm512_set1_ps(value); }
+
+			static Float Add(const Float lhs, const Float rhs) noexcept { return _mm512_add_ps(lhs, rhs); }
+			static Float Subtract(const Float lhs, const Float rhs) noexcept { return _mm512_sub_ps(lhs, rhs); }
+			static Float Multiply(const Float lhs, const Float rhs) noexcept { return _mm512_mul_ps(lhs, rhs); }
+			static Float MultiplyAdd(const Float lhs, const Float rhs, const Float addend) noexcept { return _mm512_fmadd_ps(lhs, rhs, addend); }
+			static Float Divide(const Float lhs, const Float rhs) noexcept { return _mm512_div_ps(lhs, rhs); }
+			static Float Min(const Float lhs, const Float rhs) noexcept { return _mm512_min_ps(lhs, rhs); }
+			static Float Max(const Float lhs, const Float rhs) noexcept { return _mm512_max_ps(lhs, rhs); }
+
+			static void RoundPow2(const Float value, Float& outRounded, Float& outPow2) noexcept
+			{
+				const __m512i rounded = _mm512_cvtps_epi32(value);
+				outRounded = _mm512_cvtepi32_ps(rounded);
+				outPow2 = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_add_epi32(rounded, _mm512_set1_epi32(127)), 23));
+			}
+
+			template<int Mask>
+			static Float Shuffle(const Float lhs, const Float rhs) noexcept { return _mm512_shuffle_ps(lhs, rhs, Mask); }
+			static Float UnpackLow(const Float lhs, const Float rhs) noexcept { return _mm512_unpacklo_ps(lhs, rhs); }
+			static Float UnpackHigh(const Float lhs, const Float rhs) noexcept { return _mm512_unpackhi_ps(lhs, rhs); }
+		};
+	} // namespace
+
+	const BatchMathKernels& GetAvx512BatchMathKernels() noexcept
+	{
+		return GetBatchMathKernels<Avx512Lanes>();
+	}
+} // namespace iiixrlab::math
+#endif	// defined(IIIXRLAB_BATCH_MATH_X86)
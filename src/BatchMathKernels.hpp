@@ -0,0 +1,289 @@
+#pragma once
+
+// Shared by BatchMath.cpp and the per instruction set translation units, which are compiled with their own target
+// flags and without the precompiled header. Everything instantiated here therefore lives in an anonymous namespace and
+// calls no std templates, so no code built for a newer instruction set can be picked by the linker for another one.
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#define IIIXRLAB_BATCH_MATH_X86
+	#include <immintrin.h>
+#endif	// defined(__x86_64__) || defined(_M_X64)
+
+namespace iiixrlab::math
+{
+	struct BatchMathKernels final
+	{
+		void (*TransformPoints)(const float* positions, const size_t pointsCount, const float* matrix, float* outPositions) noexcept;
+		void (*ComputeViewDepths)(const float* positions, const size_t pointsCount, const float* matrix, float* outDepths) noexcept;
+		void (*ComputeRotationMatrices)(const float* rotations, const size_t rotationsCount, float* outMatrices) noexcept;
+		void (*Exponentiate)(const float* values, const size_t valuesCount, float* outValues) noexcept;
+		void (*ApplySigmoid)(const float* values, const size_t valuesCount, float* outValues) noexcept;
+	};
+
+	const BatchMathKernels& GetScalarBatchMathKernels() noexcept;
+#if defined(IIIXRLAB_BATCH_MATH_X86)
+	const BatchMathKernels& GetSse42BatchMathKernels() noexcept;
+	const BatchMathKernels& GetAvx2BatchMathKernels() noexcept;
+	const BatchMathKernels& GetAvx512BatchMathKernels() noexcept;
+#endif	// defined(IIIXRLAB_BATCH_MATH_X86)
+
+	namespace
+	{
+		// A Lanes type wraps one instruction set: Float holds WIDTH floats, and it provides Load, Store, Set1, Add,
+		// Subtract, Multiply, MultiplyAdd, Divide, Min, Max, RoundPow2, LoadPoints, StorePoints and LoadQuaternions.
+
+		// Calls block(input, output) for every WIDTH elements, the remainder goes through a zero padded copy so the
+		// tail is computed exactly like the rest.
+		template<typename Lanes, size_t INPUT_STRIDE, size_t OUTPUT_STRIDE, typename Block>
+		inline void ForEachBlock(const float* input, const size_t count, float* output, Block&& block) noexcept
+		{
+			size_t index = 0;
+			for (; index + Lanes::WIDTH <= count; index += Lanes::WIDTH)
+			{
+				block(input + index * INPUT_STRIDE, output + index * OUTPUT_STRIDE);
+			}
+
+			if (index < count)
+			{
+				float paddedInput[Lanes::WIDTH * INPUT_STRIDE] = {};
+				float paddedOutput[Lanes::WIDTH * OUTPUT_STRIDE];
+				for (size_t elementIndex = 0; elementIndex < (count - index) * INPUT_STRIDE; ++elementIndex)
+				{
+					paddedInput[elementIndex] = input[index * INPUT_STRIDE + elementIndex];
+				}
+				block(paddedInput, paddedOutput);
+				for (size_t elementIndex = 0; elementIndex < (count - index) * OUTPUT_STRIDE; ++elementIndex)
+				{
+					output[index * OUTPUT_STRIDE + elementIndex] = paddedOutput[elementIndex];
+				}
+			}
+		}
+
+		// Cephes style exp: 2^n * e^r with |r| <= ln(2) / 2 and a degree 5 polynomial for e^r, within a few ulps.
+		template<typename Lanes>
+		inline typename Lanes::Float Exp(typename Lanes::Float value) noexcept
+		{
+			using Float = typename Lanes::Float;
+
+			// keeps 2^n a normal float
+			value = Lanes::Min(Lanes::Max(value, Lanes::Set1(-87.0f)), Lanes::Set1(88.0f));
+
+			Float n;
+			Float pow2n;
+			Lanes::RoundPow2(Lanes::Multiply(value, Lanes::Set1(1.44269504088896341f)), n, pow2n);
+
+			// ln(2) split in two so n * ln(2) is exact enough
+			value = Lanes::MultiplyAdd(n, Lanes::Set1(-0.693359375f), value);
+			value = Lanes::MultiplyAdd(n, Lanes::Set1(2.12194440e-4f), value);
+
+			Float polynomial = Lanes::Set1(1.9875691500e-4f);
+			polynomial = Lanes::MultiplyAdd(polynomial, value, Lanes::Set1(1.3981999507e-3f));
+			polynomial = Lanes::MultiplyAdd(polynomial, value, Lanes::Set1(8.3334519073e-3f));
+			polynomial = Lanes::MultiplyAdd(polynomial, value, Lanes::Set1(4.1665795894e-2f));
+			polynomial = Lanes::MultiplyAdd(polynomial, value, Lanes::Set1(1.6666665459e-1f));
+			polynomial = Lanes::MultiplyAdd(polynomial, value, Lanes::Set1(5.0000001201e-1f));
+			const Float result = Lanes::Add(Lanes::MultiplyAdd(polynomial, Lanes::Multiply(value, value), value), Lanes::Set1(1.0f));
+
+			return Lanes::Multiply(result, pow2n);
+		}
+
+		template<typename Lanes>
+		void TransformPoints(const float* positions, const size_t pointsCount, const float* matrix, float* outPositions) noexcept
+		{
+			using Float = typename Lanes::Float;
+
+			Float columns[4][3];
+			for (uint32_t rowIndex = 0; rowIndex < 4; ++rowIndex)
+			{
+				for (uint32_t columnIndex = 0; columnIndex < 3; ++columnIndex)
+				{
+					columns[rowIndex][columnIndex] = Lanes::Set1(matrix[rowIndex * 4 + columnIndex]);
+				}
+			}
+
+			ForEachBlock<Lanes, 3, 3>(positions, pointsCount, outPositions, [&columns](const float* input, float* output)
+			{
+				Float x;
+				Float y;
+				Float z;
+				Lanes::LoadPoints(input, x, y, z);
+
+				Float transformed[3];
+				for (uint32_t columnIndex = 0; columnIndex < 3; ++columnIndex)
+				{
+					transformed[columnIndex] = Lanes::MultiplyAdd(z, columns[2][columnIndex], Lanes::MultiplyAdd(y, columns[1][columnIndex], Lanes::MultiplyAdd(x, columns[0][columnIndex], columns[3][columnIndex])));
+				}
+				Lanes::StorePoints(output, transformed[0], transformed[1], transformed[2]);
+			});
+		}
+
+		template<typename Lanes>
+		void ComputeViewDepths(const float* positions, const size_t pointsCount, const float* matrix, float* outDepths) noexcept
+		{
+			using Float = typename Lanes::Float;
+
+			const Float viewX = Lanes::Set1(matrix[2]);
+			const Float viewY = Lanes::Set1(matrix[6]);
+			const Float viewZ = Lanes::Set1(matrix[10]);
+			const Float viewW = Lanes::Set1(matrix[14]);
+
+			ForEachBlock<Lanes, 3, 1>(positions, pointsCount, outDepths, [&](const float* input, float* output)
+			{
+				Float x;
+				Float y;
+				Float z;
+				Lanes::LoadPoints(input, x, y, z);
+				Lanes::Store(output, Lanes::MultiplyAdd(z, viewZ, Lanes::MultiplyAdd(y, viewY, Lanes::MultiplyAdd(x, viewX, viewW))));
+			});
+		}
+
+		template<typename Lanes>
+		void ComputeRotationMatrices(const float* rotations, const size_t rotationsCount, float* outMatrices) noexcept
+		{
+			using Float = typename Lanes::Float;
+
+			ForEachBlock<Lanes, 4, 9>(rotations, rotationsCount, outMatrices, [](const float* input, float* output)
+			{
+				Float x;
+				Float y;
+				Float z;
+				Float w;
+				Lanes::LoadQuaternions(input, x, y, z, w);
+
+				// scaling by 2 / |q|^2 normalizes and folds in the factor of 2, zero quaternions turn into the identity
+				const Float lengthSquared = Lanes::MultiplyAdd(w, w, Lanes::MultiplyAdd(z, z, Lanes::MultiplyAdd(y, y, Lanes::Multiply(x, x))));
+				const Float scale = Lanes::Divide(Lanes::Set1(2.0f), Lanes::Max(lengthSquared, Lanes::Set1(1.0e-30f)));
+				const Float xs = Lanes::Multiply(x, scale);
+				const Float ys = Lanes::Multiply(y, scale);
+				const Float zs = Lanes::Multiply(z, scale);
+				const Float one = Lanes::Set1(1.0f);
+
+				const Float xx = Lanes::Multiply(x, xs);
+				const Float yy = Lanes::Multiply(y, ys);
+				const Float zz = Lanes::Multiply(z, zs);
+				const Float xy = Lanes::Multiply(x, ys);
+				const Float xz = Lanes::Multiply(x, zs);
+				const Float yz = Lanes::Multiply(y, zs);
+				const Float wx = Lanes::Multiply(w, xs);
+				const Float wy = Lanes::Multiply(w, ys);
+				const Float wz = Lanes::Multiply(w, zs);
+
+				const Float elements[9] =
+				{
+					Lanes::Subtract(one, Lanes::Add(yy, zz)), Lanes::Subtract(xy, wz), Lanes::Add(xz, wy),
+					Lanes::Add(xy, wz), Lanes::Subtract(one, Lanes::Add(xx, zz)), Lanes::Subtract(yz, wx),
+					Lanes::Subtract(xz, wy), Lanes::Add(yz, wx), Lanes::Subtract(one, Lanes::Add(xx, yy)),
+				};
+
+				// 9 floats per matrix do not map onto lanes, so the matrices are interleaved through the stack
+				float planes[9][Lanes::WIDTH];
+				for (uint32_t elementIndex = 0; elementIndex < 9; ++elementIndex)
+				{
+					Lanes::Store(planes[elementIndex], elements[elementIndex]);
+				}
+				for (size_t laneIndex = 0; laneIndex < Lanes::WIDTH; ++laneIndex)
+				{
+					for (uint32_t elementIndex = 0; elementIndex < 9; ++elementIndex)
+					{
+						output[laneIndex * 9 + elementIndex] = planes[elementIndex][laneIndex];
+					}
+				}
+			});
+		}
+
+		template<typename Lanes>
+		void Exponentiate(const float* values, const size_t valuesCount, float* outValues) noexcept
+		{
+			ForEachBlock<Lanes, 1, 1>(values, valuesCount, outValues, [](const float* input, float* output)
+			{
+				Lanes::Store(output, Exp<Lanes>(Lanes::Load(input)));
+			});
+		}
+
+		template<typename Lanes>
+		void ApplySigmoid(const float* values, const size_t valuesCount, float* outValues) noexcept
+		{
+			ForEachBlock<Lanes, 1, 1>(values, valuesCount, outValues, [](const float* input, float* output)
+			{
+				const typename Lanes::Float one = Lanes::Set1(1.0f);
+				Lanes::Store(output, Lanes::Divide(one, Lanes::Add(one, Exp<Lanes>(Lanes::Subtract(Lanes::Set1(0.0f), Lanes::Load(input))))));
+			});
+		}
+
+		template<typename Lanes>
+		const BatchMathKernels& GetBatchMathKernels() noexcept
+		{
+			static constexpr const BatchMathKernels KERNELS =
+			{
+				.TransformPoints = TransformPoints<Lanes>,
+				.ComputeViewDepths = ComputeViewDepths<Lanes>,
+				.ComputeRotationMatrices = ComputeRotationMatrices<Lanes>,
+				.Exponentiate = Exponentiate<Lanes>,
+				.ApplySigmoid = ApplySigmoid<Lanes>,
+			};
+			return KERNELS;
+		}
+
+#if defined(IIIXRLAB_BATCH_MATH_X86)
+		// x86 registers are made of 128-bit lanes which shuffle independently, so a Lanes type only has to provide
+		// LoadLanes/StoreLanes, Shuffle and UnpackLow/UnpackHigh to share the (de)interleaving below.
+		template<typename Lanes>
+		struct X86Interleaving
+		{
+			// x0y0z0x1 y1z1x2y2 z2x3y3z3 per lane into xxxx yyyy zzzz
+			template<typename Float>
+			static void LoadPoints(const float* positions, Float& outX, Float& outY, Float& outZ) noexcept
+			{
+				const Float xyzx = Lanes::LoadLanes(positions, 12);
+				const Float yzxy = Lanes::LoadLanes(positions + 4, 12);
+				const Float zxyz = Lanes::LoadLanes(positions + 8, 12);
+
+				const Float upperXY = Lanes::template Shuffle<_MM_SHUFFLE(2, 1, 3, 2)>(yzxy, zxyz);
+				const Float lowerYZ = Lanes::template Shuffle<_MM_SHUFFLE(1, 0, 2, 1)>(xyzx, yzxy);
+				outX = Lanes::template Shuffle<_MM_SHUFFLE(2, 0, 3, 0)>(xyzx, upperXY);
+				outY = Lanes::template Shuffle<_MM_SHUFFLE(3, 1, 2, 0)>(lowerYZ, upperXY);
+				outZ = Lanes::template Shuffle<_MM_SHUFFLE(3, 0, 3, 1)>(lowerYZ, zxyz);
+			}
+
+			template<typename Float>
+			static void StorePoints(float* outPositions, const Float x, const Float y, const Float z) noexcept
+			{
+				const Float lowerXY = Lanes::UnpackLow(x, y);
+				const Float upperXY = Lanes::UnpackHigh(x, y);
+
+				const Float z0x1 = Lanes::template Shuffle<_MM_SHUFFLE(1, 1, 0, 0)>(z, x);
+				const Float y1z1 = Lanes::template Shuffle<_MM_SHUFFLE(1, 1, 3, 3)>(lowerXY, z);
+				const Float z2x3 = Lanes::template Shuffle<_MM_SHUFFLE(2, 2, 2, 2)>(z, upperXY);
+				const Float y3z3 = Lanes::template Shuffle<_MM_SHUFFLE(3, 3, 3, 3)>(upperXY, z);
+
+				Lanes::StoreLanes(outPositions, 12, Lanes::template Shuffle<_MM_SHUFFLE(2, 0, 1, 0)>(lowerXY, z0x1));
+				Lanes::StoreLanes(outPositions + 4, 12, Lanes::template Shuffle<_MM_SHUFFLE(1, 0, 2, 0)>(y1z1, upperXY));
+				Lanes::StoreLanes(outPositions + 8, 12, Lanes::template Shuffle<_MM_SHUFFLE(2, 0, 2, 0)>(z2x3, y3z3));
+			}
+
+			// a 4x4 transpose per lane
+			template<typename Float>
+			static void LoadQuaternions(const float* rotations, Float& outX, Float& outY, Float& outZ, Float& outW) noexcept
+			{
+				const Float rotation0 = Lanes::LoadLanes(rotations, 16);
+				const Float rotation1 = Lanes::LoadLanes(rotations + 4, 16);
+				const Float rotation2 = Lanes::LoadLanes(rotations + 8, 16);
+				const Float rotation3 = Lanes::LoadLanes(rotations + 12, 16);
+
+				const Float lowerXY = Lanes::UnpackLow(rotation0, rotation1);
+				const Float upperXY = Lanes::UnpackLow(rotation2, rotation3);
+				const Float lowerZW = Lanes::UnpackHigh(rotation0, rotation1);
+				const Float upperZW = Lanes::UnpackHigh(rotation2, rotation3);
+
+				outX = Lanes::template Shuffle<_MM_SHUFFLE(1, 0, 1, 0)>(lowerXY, upperXY);
+				outY = Lanes::template Shuffle<_MM_SHUFFLE(3, 2, 3, 2)>(lowerXY, upperXY);
+				outZ = Lanes::template Shuffle<_MM_SHUFFLE(1, 0, 1, 0)>(lowerZW, upperZW);
+				outW = Lanes::template Shuffle<_MM_SHUFFLE(3, 2, 3, 2)>(lowerZW, upperZW);
+			}
+		};
+#endif	// defined(IIIXRLAB_BATCH_MATH_X86)
+	} // namespace
+} // namespace iiixrlab::math
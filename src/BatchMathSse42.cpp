@@ -0,0 +1,47 @@
+#include "BatchMathKernels.hpp"
+
+// Compiled with SSE4.2 enabled, see CMakeLists.txt, and only called once the CPU reports it.
+#if defined(IIIXRLAB_BATCH_MATH_X86)
+namespace iiixrlab::math
+{
+	namespace
+	{
+		struct Sse42Lanes final : X86Interleaving<Sse42Lanes>
+		{
+			using Float = __m128;
+			static constexpr const size_t WIDTH = 4;
+
+			static Float Load(const float* elements) noexcept { return _mm_loadu_ps(elements); }
+			static void Store(float* outElements, const Float value) noexcept { _mm_storeu_ps(outElements, value); }
+			static Float LoadLanes(const float* elements, const size_t) noexcept { return _mm_loadu_ps(elements); }
+			static void StoreLanes(float* outElements, const size_t, const Float value) noexcept { _mm_storeu_ps(outElements, value); }
+			static Float Set1(const float value) noexcept { return _mm_set1_ps(value); }
+
+			static Float Add(const Float lhs, const Float rhs) noexcept { return _mm_add_ps(lhs, rhs); }
+			static Float Subtract(const Float lhs, const Float rhs) noexcept { return _mm_sub_ps(lhs, rhs); }
+			static Float Multiply(const Float lhs, const Float rhs) noexcept { return _mm_mul_ps(lhs, rhs); }
+			static Float MultiplyAdd(const Float lhs, const Float rhs, const Float addend) noexcept { return _mm_add_ps(_mm_mul_ps(lhs, rhs), addend); }
+			static Float Divide(const Float lhs, const Float rhs) noexcept { return _mm_div_ps(lhs, rhs); }
+			static Float Min(const Float lhs, const Float rhs) noexcept { return _mm_min_ps(lhs, rhs); }
+			static Float Max(const Float lhs, const Float rhs) noexcept { return _mm_max_ps(lhs, rhs); }
+
+			static void RoundPow2(const Float value, Float& outRounded, Float& outPow2) noexcept
+			{
+				const __m128i rounded = _mm_cvtps_epi32(value);
+				outRounded = _mm_cvtepi32_ps(rounded);
+				outPow2 = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(rounded, _mm_set1_epi32(127)), 23));
+			}
+
+			template<int Mask>
+			static Float Shuffle(const Float lhs, const Float rhs) noexcept { return _mm_shuffle_ps(lhs, rhs, Mask); }
+			static Float UnpackLow(const Float lhs, const Float rhs) noexcept { return _mm_unpacklo_ps(lhs, rhs); }
+			static Float UnpackHigh(const Float lhs, const Float rhs) noexcept { return _mm_unpackhi_ps(lhs, rhs); }
+		};
+	} // namespace
+
+	const BatchMathKernels& GetSse42BatchMathKernels() noexcept
+	{
+		return GetBatchMathKernels<Sse42Lanes>();
+	}
+} // namespace iiixrlab::math
+#endif	// defined(IIIXRLAB_BATCH_MATH_X86)
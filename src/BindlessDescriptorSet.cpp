@@ -0,0 +1,124 @@
+#include "3dgs/graphics/BindlessDescriptorSet.h"
+
+#include "3dgs/graphics/Buffer.h"
+#include "3dgs/graphics/DescriptorPool.h"
+#include "3dgs/graphics/Device.h"
+#include "3dgs/graphics/Texture.h"
+
+namespace iiixrlab::graphics
+{
+	BindlessDescriptorSet::BindlessDescriptorSet(CreateInfo& createInfo) noexcept
+		: mDevice(createInfo.Device)
+		, mDescriptorPool(std::move(createInfo.DescriptorPool))
+		, mDescriptorSetLayout(createInfo.DescriptorSetLayout)
+		, mPipelineLayout(createInfo.PipelineLayout)
+		, mDescriptorSet(createInfo.DescriptorSet)
+		, mDescriptorsCounts(createInfo.DescriptorsCounts)
+		, mNextIndices()
+		, mFreeIndices()
+	{
+		assert(mDescriptorPool != nullptr);
+		assert(mDescriptorSetLayout != VK_NULL_HANDLE);
+		assert(mPipelineLayout != VK_NULL_HANDLE);
+		assert(mDescriptorSet != VK_NULL_HANDLE);
+	}
+
+	BindlessDescriptorSet::BindlessDescriptorSet(BindlessDescriptorSet&& other) noexcept
+		: mDevice(other.mDevice)
+		, mDescriptorPool(std::move(other.mDescriptorPool))
+		, mDescriptorSetLayout(other.mDescriptorSetLayout)
+		, mPipelineLayout(other.mPipelineLayout)
+		, mDescriptorSet(other.mDescriptorSet)
+		, mDescriptorsCounts(other.mDescriptorsCounts)
+		, mNextIndices()
+		, mFreeIndices()
+	{
+		for (uint8_t typeIndex = 0; typeIndex < static_cast<uint8_t>(eType::COUNT); ++typeIndex)
+		{
+			mNextIndices[typeIndex] = other.mNextIndices[typeIndex];
+			mFreeIndices[typeIndex] = std::move(other.mFreeIndices[typeIndex]);
+		}
+
+		other.mDescriptorSetLayout = VK_NULL_HANDLE;
+		other.mPipelineLayout = VK_NULL_HANDLE;
+		other.mDescriptorSet = VK_NULL_HANDLE;
+	}
+
+	BindlessDescriptorSet::~BindlessDescriptorSet() noexcept
+	{
+		// the set itself is released together with its pool
+		mDescriptorSet = VK_NULL_HANDLE;
+		mDescriptorPool.reset();
+		mDevice.DestroyPipelineLayout(mPipelineLayout);
+		mDevice.DestroyDescriptorSetLayout(mDescriptorSetLayout);
+	}
+
+	uint32_t BindlessDescriptorSet::Register(const Buffer& buffer) noexcept
+	{
+		const uint32_t index = allocateIndex(eType::STORAGE_BUFFER);
+		if (index == INVALID_INDEX)
+		{
+			return INVALID_INDEX;
+		}
+
+		mDevice.BindDescriptorSet(*this, index, buffer);
+		return index;
+	}
+
+	uint32_t BindlessDescriptorSet::Register(const Texture& texture, const eType type) noexcept
+	{
+		if (type != eType::SAMPLED_IMAGE && type != eType::STORAGE_IMAGE)
+		{
+			std::cerr << "Only sampled and storage images can be registered from a texture.\n";
+			IIIXRLAB_DEBUG_BREAK();
+			return INVALID_INDEX;
+		}
+
+		const uint32_t index = allocateIndex(type);
+		if (index == INVALID_INDEX)
+		{
+			return INVALID_INDEX;
+		}
+
+		mDevice.BindDescriptorSet(*this, index, texture, static_cast<uint8_t>(type));
+		return index;
+	}
+
+	void BindlessDescriptorSet::Unregister(const eType type, uint32_t& inoutIndex) noexcept
+	{
+		if (inoutIndex == INVALID_INDEX)
+		{
+			return;
+		}
+
+		assert(type < eType::COUNT);
+		assert(inoutIndex < mNextIndices[static_cast<uint8_t>(type)]);
+
+		// PARTIALLY_BOUND lets the stale descriptor stay in place until the index is handed out again
+		mFreeIndices[static_cast<uint8_t>(type)].push_back(inoutIndex);
+		inoutIndex = INVALID_INDEX;
+	}
+
+	uint32_t BindlessDescriptorSet::allocateIndex(const eType type) noexcept
+	{
+		assert(type < eType::COUNT);
+		const uint8_t typeIndex = static_cast<uint8_t>(type);
+
+		std::vector<uint32_t>& freeIndices = mFreeIndices[typeIndex];
+		if (freeIndices.empty() == false)
+		{
+			const uint32_t index = freeIndices.back();
+			freeIndices.pop_back();
+			return index;
+		}
+
+		if (mNextIndices[typeIndex] >= mDescriptorsCounts[typeIndex])
+		{
+			std::cerr << "The bindless descriptor set is full.\n";
+			IIIXRLAB_DEBUG_BREAK();
+			return INVALID_INDEX;
+		}
+
+		return mNextIndices[typeIndex]++;
+	}
+} // namespace iiixrlab::graphics
@@ -5,15 +5,32 @@
 
 namespace iiixrlab::graphics
 {
-	void Buffer::create(VkDevice device, CreateInfo& inoutCreateInfo, const PhysicalDevice& physicalDevice, const VkBufferUsageFlags usage, const VkMemoryPropertyFlags& memoryPropertyFlag) noexcept
+	void Buffer::create(VkDevice device, CreateInfo& inoutCreateInfo, const PhysicalDevice& physicalDevice, const VkBufferUsageFlags usage, const VkMemoryPropertyFlags& memoryPropertyFlag, const bool bIsShared) noexcept
 	{
 		VkResult vr = VK_SUCCESS;
+
+		// shared buffers are read and written by the graphics, compute and transfer queues alike
+		std::vector<uint32_t> queueFamilyIndices;
+		if (bIsShared == true)
+		{
+			for (const uint32_t queueFamilyIndex : { physicalDevice.GetQueueFamilyIndex(), physicalDevice.GetComputeQueueFamilyIndex(), physicalDevice.GetTransferQueueFamilyIndex() })
+			{
+				if (std::find(queueFamilyIndices.begin(), queueFamilyIndices.end(), queueFamilyIndex) == queueFamilyIndices.end())
+				{
+					queueFamilyIndices.push_back(queueFamilyIndex);
+				}
+			}
+		}
+		inoutCreateInfo.bIsConcurrent = queueFamilyIndices.size() > 1;
+
 		VkBufferCreateInfo bufferCreateInfo =
 		{
 			.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
 			.size = inoutCreateInfo.GpuResourceCreateInfo.Size * inoutCreateInfo.GpuResourceCreateInfo.Stride,
 			.usage = usage,
-			.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+			.sharingMode = inoutCreateInfo.bIsConcurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+			.queueFamilyIndexCount = inoutCreateInfo.bIsConcurrent ? static_cast<uint32_t>(queueFamilyIndices.size()) : 0,
+			.pQueueFamilyIndices = inoutCreateInfo.bIsConcurrent ? queueFamilyIndices.data() : nullptr,
 		};
 		vr = vkCreateBuffer(device, &bufferCreateInfo, nullptr, &inoutCreateInfo.Buffer);
 		assert(vr == VK_SUCCESS && inoutCreateInfo.Buffer != VK_NULL_HANDLE);
@@ -12,6 +12,7 @@ namespace iiixrlab::scene
 		, mConstantBuffer()
 		, mInfo()
 		, mSpeed(1.0f)
+		, mDirtyFramesCount(0)
 	{
 		updateViewMatrix(createInfo.Position, 0.0f, 0.0f);
 
@@ -32,8 +33,11 @@ namespace iiixrlab::scene
 			0.0f,									0.0f,								-NearPlane * FarPlane / (FarPlane - NearPlane),	0.0f
 		});
 		
-		mConstantBuffer = createInfo.Device.CreateConstantBuffer("CameraConstantBuffer", sizeof(mInfo));
-		mConstantBuffer->SetData(&mInfo, sizeof(mInfo));
+		mConstantBuffer = createInfo.Device.CreateConstantBuffer("CameraConstantBuffer", sizeof(mInfo), createInfo.FramesCount);
+		for (uint32_t frameIndex = 0; frameIndex < createInfo.FramesCount; ++frameIndex)
+		{
+			mConstantBuffer->SetData(&mInfo, sizeof(mInfo), frameIndex);
+		}
 	}
 
 	Camera::Camera(Camera&& other) noexcept
@@ -43,6 +47,7 @@ namespace iiixrlab::scene
 		, mConstantBuffer(std::move(other.mConstantBuffer))
 		, mInfo(other.mInfo)
 		, mSpeed(other.mSpeed)
+		, mDirtyFramesCount(other.mDirtyFramesCount)
 	{
 	}
 
@@ -51,7 +56,13 @@ namespace iiixrlab::scene
 		mConstantBuffer.reset();
 	}
 
-	void Camera::Update(const float deltaTime, const iiixrlab::math::Vector3f& direction, const iiixrlab::math::Vector3f& pitchYawRoll) noexcept
+	void Camera::SetInfo(const Info& info) noexcept
+	{
+		mInfo = info;
+		mDirtyFramesCount = mConstantBuffer->GetSize();
+	}
+
+	void Camera::Update(const float deltaTime, const iiixrlab::math::Vector3f& direction, const iiixrlab::math::Vector3f& pitchYawRoll, const uint32_t frameIndex) noexcept
 	{
 		bool bNeedsToUpdateCamera = false;
 		if (direction.IsSizeZero() == false)
@@ -71,14 +82,22 @@ namespace iiixrlab::scene
 		if (bNeedsToUpdateCamera)
 		{
 			updateViewMatrix(mPosition, mPitchYawRoll.GetX(), mPitchYawRoll.GetY());
-			mConstantBuffer->SetData(&mInfo, sizeof(mInfo));
+			mDirtyFramesCount = mConstantBuffer->GetSize();
+		}
+
+		// Only the slot of the recording frame is written; the other slots may still be read by frames in flight.
+		// Frames are recorded round-robin, so every slot is refreshed after GetSize() frames.
+		if (mDirtyFramesCount > 0)
+		{
+			mConstantBuffer->SetData(&mInfo, sizeof(mInfo), frameIndex);
+			--mDirtyFramesCount;
 		}
 	}
 
 	iiixrlab::math::Vector3f Camera::GetPitchYawRollFromScreenSpaceDeltaPosition(const iiixrlab::math::Vector2f& deltaPosition) const noexcept
 	{
-		const float pitch = std::atanf(deltaPosition.GetY() / mDistanceToOutput);
-		const float yaw = std::atanf(deltaPosition.GetX() / mDistanceToOutput);
+		const float pitch = std::atan(deltaPosition.GetY() / mDistanceToOutput);
+		const float yaw = std::atan(deltaPosition.GetX() / mDistanceToOutput);
 		return iiixrlab::math::Vector3f{pitch, -yaw, 0.0f};
 	}
 
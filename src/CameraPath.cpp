@@ -0,0 +1,170 @@
+#include "3dgs/scene/CameraPath.h"
+
+#include "3dgs/scene/Camera.h"
+
+namespace iiixrlab::scene
+{
+	// Mean of the gaussians and their RMS distance from it, outliers far out in the background barely move either.
+	static void GetBounds(const GaussianInfo& gaussianInfo, iiixrlab::math::Vector3f& outCenter, float& outRadius) noexcept
+	{
+		const size_t pointsCount = std::min(static_cast<size_t>(gaussianInfo.NumPoints), gaussianInfo.Positions.size() / 3);
+		if (pointsCount == 0)
+		{
+			outCenter = iiixrlab::math::Vector3f{ 0.0f, 0.0f, 0.0f };
+			outRadius = 1.0f;
+			return;
+		}
+
+		double sum[3] = { 0.0, 0.0, 0.0 };
+		for (size_t pointIndex = 0; pointIndex < pointsCount; ++pointIndex)
+		{
+			sum[0] += gaussianInfo.Positions[pointIndex * 3];
+			sum[1] += gaussianInfo.Positions[pointIndex * 3 + 1];
+			sum[2] += gaussianInfo.Positions[pointIndex * 3 + 2];
+		}
+		const double center[3] = { sum[0] / static_cast<double>(pointsCount), sum[1] / static_cast<double>(pointsCount), sum[2] / static_cast<double>(pointsCount) };
+
+		double squaredDistancesSum = 0.0;
+		for (size_t pointIndex = 0; pointIndex < pointsCount; ++pointIndex)
+		{
+			const double x = gaussianInfo.Positions[pointIndex * 3] - center[0];
+			const double y = gaussianInfo.Positions[pointIndex * 3 + 1] - center[1];
+			const double z = gaussianInfo.Positions[pointIndex * 3 + 2] - center[2];
+			squaredDistancesSum += x * x + y * y + z * z;
+		}
+
+		outCenter = iiixrlab::math::Vector3f{ static_cast<float>(center[0]), static_cast<float>(center[1]), static_cast<float>(center[2]) };
+		outRadius = std::max(static_cast<float>(std::sqrt(squaredDistancesSum / static_cast<double>(pointsCount))), 1.0e-3f);
+	}
+
+	CameraPath CameraPath::CreateOrbit(const GaussianInfo& gaussianInfo, const uint32_t posesCount) noexcept
+	{
+		assert(posesCount > 0);
+
+		iiixrlab::math::Vector3f center;
+		float radius = 0.0f;
+		GetBounds(gaussianInfo, center, radius);
+		radius *= 2.0f;
+
+		std::vector<Pose> poses;
+		poses.reserve(posesCount);
+		for (uint32_t poseIndex = 0; poseIndex < posesCount; ++poseIndex)
+		{
+			// a yaw of 0 looks down +z, so the camera starting at -z faces the center, the yaw keeps growing instead of wrapping
+			const float angle = 2.0f * std::numbers::pi_v<float> * static_cast<float>(poseIndex) / static_cast<float>(posesCount);
+			poses.push_back(Pose
+			{
+				.Position = center + iiixrlab::math::Vector3f{ std::sin(angle), 0.0f, -std::cos(angle) } * radius,
+				.PitchYawRoll = iiixrlab::math::Vector3f{ 0.0f, -angle, 0.0f },
+			});
+		}
+
+		return CameraPath(std::move(poses));
+	}
+
+	CameraPath CameraPath::CreateFlyThrough(const GaussianInfo& gaussianInfo, const uint32_t posesCount) noexcept
+	{
+		assert(posesCount > 0);
+
+		iiixrlab::math::Vector3f center;
+		float radius = 0.0f;
+		GetBounds(gaussianInfo, center, radius);
+		radius *= 2.0f;
+
+		constexpr const float MAX_PAN_ANGLE = std::numbers::pi_v<float> / 8.0f;
+
+		std::vector<Pose> poses;
+		poses.reserve(posesCount);
+		for (uint32_t poseIndex = 0; poseIndex < posesCount; ++poseIndex)
+		{
+			const float progress = posesCount > 1 ? static_cast<float>(poseIndex) / static_cast<float>(posesCount - 1) : 0.0f;
+			poses.push_back(Pose
+			{
+				.Position = center + iiixrlab::math::Vector3f{ 0.0f, 0.0f, (2.0f * progress - 1.0f) * radius },
+				.PitchYawRoll = iiixrlab::math::Vector3f{ 0.0f, MAX_PAN_ANGLE * std::sin(2.0f * std::numbers::pi_v<float> * progress), 0.0f },
+			});
+		}
+
+		return CameraPath(std::move(poses));
+	}
+
+	CameraPath::CameraPath(std::vector<Pose>&& poses) noexcept
+		: mPoses(std::move(poses))
+	{
+	}
+
+	CameraPath::CameraPath(const std::filesystem::path& path) noexcept
+		: mPoses()
+	{
+		std::ifstream file(path);
+		if (file.is_open() == false)
+		{
+			std::cerr << "Unable to open camera path " << path << ".\n";
+			IIIXRLAB_DEBUG_BREAK();
+			return;
+		}
+
+		std::string line;
+		uint32_t lineNumber = 0;
+		while (std::getline(file, line))
+		{
+			++lineNumber;
+			if (line.empty() == true || line[0] == '#')
+			{
+				continue;
+			}
+
+			float values[6];
+			if (sscanf(line.c_str(), "%f %f %f %f %f %f", &values[0], &values[1], &values[2], &values[3], &values[4], &values[5]) != 6)
+			{
+				std::cerr << "Camera path " << path << " has an invalid pose on line " << lineNumber << ".\n";
+				IIIXRLAB_DEBUG_BREAK();
+				mPoses.clear();
+				return;
+			}
+
+			mPoses.push_back(Pose
+			{
+				.Position = iiixrlab::math::Vector3f{ values[0], values[1], values[2] },
+				.PitchYawRoll = iiixrlab::math::Vector3f{ values[3], values[4], values[5] },
+			});
+		}
+	}
+
+	bool CameraPath::Save(const std::filesystem::path& path) const noexcept
+	{
+		std::ofstream file(path);
+		if (file.is_open() == false)
+		{
+			std::cerr << "Failed to open " << path << " for the camera path.\n";
+			return false;
+		}
+
+		// enough digits to read back every float exactly
+		file.precision(9);
+		file << "# x y z pitch yaw roll\n";
+		for (const Pose& pose : mPoses)
+		{
+			file << pose.Position.GetX() << ' ' << pose.Position.GetY() << ' ' << pose.Position.GetZ() << ' '
+				<< pose.PitchYawRoll.GetX() << ' ' << pose.PitchYawRoll.GetY() << ' ' << pose.PitchYawRoll.GetZ() << '\n';
+		}
+
+		return file.good();
+	}
+
+	CameraPath::Step CameraPath::GetStep(const Camera& camera, const uint32_t poseIndex, const float deltaTime) const noexcept
+	{
+		assert(mPoses.empty() == false);
+		assert(deltaTime > 0.0f);
+
+		// steps aim at absolute poses, so rounding never accumulates over the frames
+		const Pose& pose = mPoses[poseIndex % mPoses.size()];
+		const iiixrlab::math::Vector3f direction = pose.Position - camera.GetPosition();
+		return Step
+		{
+			.Direction = direction,
+			.PitchYawRoll = pose.PitchYawRoll - camera.GetPitchYawRoll(),
+			.Speed = deltaTime > 0.0f ? direction.GetSize() / deltaTime : 0.0f,
+		};
+	}
+} // namespace iiixrlab::scene
@@ -0,0 +1,465 @@
+#include "3dgs/scene/CameraTrajectory.h"
+
+namespace iiixrlab::scene
+{
+	namespace
+	{
+		// Just enough JSON for trajectory files, numbers are kept as doubles and null parses as NONE.
+		struct JsonValue final
+		{
+			enum class eType : uint8_t
+			{
+				NONE,
+				BOOLEAN,
+				NUMBER,
+				STRING,
+				ARRAY,
+				OBJECT,
+			};
+
+			eType Type = eType::NONE;
+			double Number = 0.0;
+			std::string String;
+			std::vector<JsonValue> Elements;
+			std::vector<std::pair<std::string, JsonValue>> Members;
+		};
+
+		struct Intrinsics final
+		{
+			std::optional<double> Width;
+			std::optional<double> Height;
+			std::optional<double> FocalX;
+			std::optional<double> FocalY;
+			std::optional<double> CenterX;
+			std::optional<double> CenterY;
+			std::optional<double> AngleX;
+			std::optional<double> AngleY;
+		};
+	}
+
+	static constexpr const uint32_t MAX_JSON_DEPTH = 64;
+
+	static void SkipWhitespace(const char*& inoutCursor, const char* end) noexcept
+	{
+		while (inoutCursor < end && (*inoutCursor == ' ' || *inoutCursor == '\t' || *inoutCursor == '\n' || *inoutCursor == '\r'))
+		{
+			++inoutCursor;
+		}
+	}
+
+	static bool ParseJsonString(const char*& inoutCursor, const char* end, std::string& outString) noexcept
+	{
+		if (inoutCursor >= end || *inoutCursor != '"')
+		{
+			return false;
+		}
+		++inoutCursor;
+
+		outString.clear();
+		while (inoutCursor < end && *inoutCursor != '"')
+		{
+			char character = *inoutCursor++;
+			if (character != '\\')
+			{
+				outString.push_back(character);
+				continue;
+			}
+
+			if (inoutCursor >= end)
+			{
+				return false;
+			}
+
+			character = *inoutCursor++;
+			switch (character)
+			{
+			case 'b':
+				outString.push_back('\b');
+				break;
+			case 'f':
+				outString.push_back('\f');
+				break;
+			case 'n':
+				outString.push_back('\n');
+				break;
+			case 'r':
+				outString.push_back('\r');
+				break;
+			case 't':
+				outString.push_back('\t');
+				break;
+			case 'u':
+			{
+				if (end - inoutCursor < 4)
+				{
+					return false;
+				}
+
+				const std::string hexDigits(inoutCursor, 4);
+				const uint32_t codePoint = static_cast<uint32_t>(std::strtoul(hexDigits.c_str(), nullptr, 16));
+				inoutCursor += 4;
+
+				// surrogate pairs are not joined, paths in trajectory files are expected to be plain
+				if (codePoint < 0x80)
+				{
+					outString.push_back(static_cast<char>(codePoint));
+				}
+				else if (codePoint < 0x800)
+				{
+					outString.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+					outString.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+				}
+				else
+				{
+					outString.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+					outString.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+					outString.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+				}
+				break;
+			}
+			default:
+				// '"', '\\' and '/' stand for themselves
+				outString.push_back(character);
+				break;
+			}
+		}
+
+		if (inoutCursor >= end)
+		{
+			return false;
+		}
+		++inoutCursor;
+
+		return true;
+	}
+
+	static bool ParseJsonLiteral(const char*& inoutCursor, const char* end, const char* literal) noexcept
+	{
+		const size_t length = std::strlen(literal);
+		if (static_cast<size_t>(end - inoutCursor) < length || std::strncmp(inoutCursor, literal, length) != 0)
+		{
+			return false;
+		}
+		inoutCursor += length;
+
+		return true;
+	}
+
+	static bool ParseJsonValue(const char*& inoutCursor, const char* end, JsonValue& outValue, const uint32_t depth) noexcept
+	{
+		if (depth > MAX_JSON_DEPTH)
+		{
+			return false;
+		}
+
+		SkipWhitespace(inoutCursor, end);
+		if (inoutCursor >= end)
+		{
+			return false;
+		}
+
+		switch (*inoutCursor)
+		{
+		case '{':
+			outValue.Type = JsonValue::eType::OBJECT;
+			++inoutCursor;
+			SkipWhitespace(inoutCursor, end);
+			if (inoutCursor < end && *inoutCursor == '}')
+			{
+				++inoutCursor;
+				return true;
+			}
+
+			for (;;)
+			{
+				std::pair<std::string, JsonValue> member;
+				SkipWhitespace(inoutCursor, end);
+				if (ParseJsonString(inoutCursor, end, member.first) == false)
+				{
+					return false;
+				}
+
+				SkipWhitespace(inoutCursor, end);
+				if (inoutCursor >= end || *inoutCursor != ':')
+				{
+					return false;
+				}
+				++inoutCursor;
+
+				if (ParseJsonValue(inoutCursor, end, member.second, depth + 1) == false)
+				{
+					return false;
+				}
+				outValue.Members.push_back(std::move(member));
+
+				SkipWhitespace(inoutCursor, end);
+				if (inoutCursor < end && *inoutCursor == ',')
+				{
+					++inoutCursor;
+					continue;
+				}
+
+				if (inoutCursor < end && *inoutCursor == '}')
+				{
+					++inoutCursor;
+					return true;
+				}
+
+				return false;
+			}
+		case '[':
+			outValue.Type = JsonValue::eType::ARRAY;
+			++inoutCursor;
+			SkipWhitespace(inoutCursor, end);
+			if (inoutCursor < end && *inoutCursor == ']')
+			{
+				++inoutCursor;
+				return true;
+			}
+
+			for (;;)
+			{
+				JsonValue element;
+				if (ParseJsonValue(inoutCursor, end, element, depth + 1) == false)
+				{
+					return false;
+				}
+				outValue.Elements.push_back(std::move(element));
+
+				SkipWhitespace(inoutCursor, end);
+				if (inoutCursor < end && *inoutCursor == ',')
+				{
+					++inoutCursor;
+					continue;
+				}
+
+				if (inoutCursor < end && *inoutCursor == ']')
+				{
+					++inoutCursor;
+					return true;
+				}
+
+				return false;
+			}
+		case '"':
+			outValue.Type = JsonValue::eType::STRING;
+			return ParseJsonString(inoutCursor, end, outValue.String);
+		case 't':
+			outValue.Type = JsonValue::eType::BOOLEAN;
+			outValue.Number = 1.0;
+			return ParseJsonLiteral(inoutCursor, end, "true");
+		case 'f':
+			outValue.Type = JsonValue::eType::BOOLEAN;
+			outValue.Number = 0.0;
+			return ParseJsonLiteral(inoutCursor, end, "false");
+		case 'n':
+			outValue.Type = JsonValue::eType::NONE;
+			return ParseJsonLiteral(inoutCursor, end, "null");
+		default:
+		{
+			// the text is null terminated, so strtod never reads past the end
+			char* numberEnd = nullptr;
+			outValue.Type = JsonValue::eType::NUMBER;
+			outValue.Number = std::strtod(inoutCursor, &numberEnd);
+			if (numberEnd == inoutCursor || numberEnd > end)
+			{
+				return false;
+			}
+			inoutCursor = numberEnd;
+
+			return true;
+		}
+		}
+	}
+
+	static const JsonValue* FindJsonMember(const JsonValue& object, const char* key) noexcept
+	{
+		for (const std::pair<std::string, JsonValue>& member : object.Members)
+		{
+			if (member.first == key)
+			{
+				return &member.second;
+			}
+		}
+
+		return nullptr;
+	}
+
+	static void ReadJsonNumber(const JsonValue& object, const char* key, std::optional<double>& inoutNumber) noexcept
+	{
+		const JsonValue* valueOrNull = FindJsonMember(object, key);
+		if (valueOrNull != nullptr && valueOrNull->Type == JsonValue::eType::NUMBER)
+		{
+			inoutNumber = valueOrNull->Number;
+		}
+	}
+
+	static void ReadIntrinsics(const JsonValue& object, Intrinsics& inoutIntrinsics) noexcept
+	{
+		ReadJsonNumber(object, "w", inoutIntrinsics.Width);
+		ReadJsonNumber(object, "h", inoutIntrinsics.Height);
+		ReadJsonNumber(object, "fl_x", inoutIntrinsics.FocalX);
+		ReadJsonNumber(object, "fl_y", inoutIntrinsics.FocalY);
+		ReadJsonNumber(object, "cx", inoutIntrinsics.CenterX);
+		ReadJsonNumber(object, "cy", inoutIntrinsics.CenterY);
+		ReadJsonNumber(object, "camera_angle_x", inoutIntrinsics.AngleX);
+		ReadJsonNumber(object, "camera_angle_y", inoutIntrinsics.AngleY);
+	}
+
+	CameraTrajectory::CameraTrajectory(const std::filesystem::path& trajectoryPath, const uint32_t defaultWidth, const uint32_t defaultHeight) noexcept
+		: mViews()
+		, mWidth(defaultWidth)
+		, mHeight(defaultHeight)
+	{
+		std::ifstream trajectoryFile(trajectoryPath, std::ios::binary);
+		if (trajectoryFile.is_open() == false)
+		{
+			std::cerr << "Unable to open trajectory " << trajectoryPath << ".\n";
+			IIIXRLAB_DEBUG_BREAK();
+			return;
+		}
+
+		const std::string text((std::istreambuf_iterator<char>(trajectoryFile)), std::istreambuf_iterator<char>());
+		const char* cursor = text.c_str();
+		JsonValue root;
+		if (ParseJsonValue(cursor, text.c_str() + text.size(), root, 0) == false || root.Type != JsonValue::eType::OBJECT)
+		{
+			std::cerr << "Trajectory " << trajectoryPath << " is not a valid JSON object.\n";
+			IIIXRLAB_DEBUG_BREAK();
+			return;
+		}
+
+		const JsonValue* framesOrNull = FindJsonMember(root, "frames");
+		if (framesOrNull == nullptr || framesOrNull->Type != JsonValue::eType::ARRAY)
+		{
+			std::cerr << "Trajectory " << trajectoryPath << " has no frames.\n";
+			IIIXRLAB_DEBUG_BREAK();
+			return;
+		}
+
+		Intrinsics sharedIntrinsics;
+		ReadIntrinsics(root, sharedIntrinsics);
+
+		constexpr const float NearPlane = 0.01f;
+		constexpr const float FarPlane = 1000.0f;
+
+		bool bHasExtent = false;
+		mViews.reserve(framesOrNull->Elements.size());
+		for (size_t frameIndex = 0; frameIndex < framesOrNull->Elements.size(); ++frameIndex)
+		{
+			const JsonValue& frame = framesOrNull->Elements[frameIndex];
+			if (frame.Type != JsonValue::eType::OBJECT)
+			{
+				continue;
+			}
+
+			Intrinsics intrinsics = sharedIntrinsics;
+			ReadIntrinsics(frame, intrinsics);
+
+			// every view renders into the same targets, they are sized by the first frame
+			const uint32_t width = static_cast<uint32_t>(intrinsics.Width.value_or(defaultWidth));
+			const uint32_t height = static_cast<uint32_t>(intrinsics.Height.value_or(defaultHeight));
+			if (bHasExtent == false)
+			{
+				mWidth = width;
+				mHeight = height;
+				bHasExtent = true;
+			}
+			else if (width != mWidth || height != mHeight)
+			{
+				std::cerr << "Frame " << frameIndex << " is " << width << "x" << height << " instead of " << mWidth << "x" << mHeight << ", skipped.\n";
+				continue;
+			}
+
+			double focalX = 0.0;
+			if (intrinsics.FocalX.has_value() == true)
+			{
+				focalX = *intrinsics.FocalX;
+			}
+			else if (intrinsics.AngleX.has_value() == true)
+			{
+				focalX = 0.5 * width / std::tan(0.5 * *intrinsics.AngleX);
+			}
+			else
+			{
+				std::cerr << "Frame " << frameIndex << " has neither fl_x nor camera_angle_x, skipped.\n";
+				continue;
+			}
+
+			double focalY = focalX;
+			if (intrinsics.FocalY.has_value() == true)
+			{
+				focalY = *intrinsics.FocalY;
+			}
+			else if (intrinsics.AngleY.has_value() == true)
+			{
+				focalY = 0.5 * height / std::tan(0.5 * *intrinsics.AngleY);
+			}
+
+			const double centerX = intrinsics.CenterX.value_or(0.5 * width);
+			const double centerY = intrinsics.CenterY.value_or(0.5 * height);
+
+			const JsonValue* transformOrNull = FindJsonMember(frame, "transform_matrix");
+			if (transformOrNull == nullptr || transformOrNull->Type != JsonValue::eType::ARRAY || transformOrNull->Elements.size() < 3)
+			{
+				std::cerr << "Frame " << frameIndex << " has no transform_matrix, skipped.\n";
+				continue;
+			}
+
+			float cameraToWorld[3][4] = {};
+			bool bIsValidTransform = true;
+			for (uint32_t row = 0; row < 3 && bIsValidTransform == true; ++row)
+			{
+				const JsonValue& transformRow = transformOrNull->Elements[row];
+				bIsValidTransform = transformRow.Type == JsonValue::eType::ARRAY && transformRow.Elements.size() >= 4;
+				for (uint32_t column = 0; column < 4 && bIsValidTransform == true; ++column)
+				{
+					bIsValidTransform = transformRow.Elements[column].Type == JsonValue::eType::NUMBER;
+					cameraToWorld[row][column] = static_cast<float>(transformRow.Elements[column].Number);
+				}
+			}
+
+			if (bIsValidTransform == false)
+			{
+				std::cerr << "Frame " << frameIndex << " has a malformed transform_matrix, skipped.\n";
+				continue;
+			}
+
+			// OpenGL camera axes to the renderer's: x right, y down, z forward
+			const iiixrlab::math::Vector3f xAxis = iiixrlab::math::Vector3f{ cameraToWorld[0][0], cameraToWorld[1][0], cameraToWorld[2][0] };
+			const iiixrlab::math::Vector3f yAxis = iiixrlab::math::Vector3f{ -cameraToWorld[0][1], -cameraToWorld[1][1], -cameraToWorld[2][1] };
+			const iiixrlab::math::Vector3f zAxis = iiixrlab::math::Vector3f{ -cameraToWorld[0][2], -cameraToWorld[1][2], -cameraToWorld[2][2] };
+			const iiixrlab::math::Vector3f position = iiixrlab::math::Vector3f{ cameraToWorld[0][3], cameraToWorld[1][3], cameraToWorld[2][3] };
+
+			View view;
+			view.Info.View = iiixrlab::math::Matrix4x4f
+			{
+				xAxis.GetX(),   yAxis.GetX(), 	zAxis.GetX(), 	0.0f,
+				xAxis.GetY(),   yAxis.GetY(), 	zAxis.GetY(), 	0.0f,
+				xAxis.GetZ(),   yAxis.GetZ(), 	zAxis.GetZ(), 	0.0f,
+				-iiixrlab::math::Vector3f::Dot(xAxis, position), -iiixrlab::math::Vector3f::Dot(yAxis, position), -iiixrlab::math::Vector3f::Dot(zAxis, position), 1.0f,
+			};
+
+			// pinhole projection of the pixel grid, an off-center principal point shears x and y by depth
+			view.Info.Projection = iiixrlab::math::Matrix4x4f
+			({
+				static_cast<float>(2.0 * focalX / width),			0.0f,												0.0f,											0.0f,
+				0.0f,												static_cast<float>(2.0 * focalY / height),			0.0f,											0.0f,
+				static_cast<float>(2.0 * centerX / width - 1.0),	static_cast<float>(2.0 * centerY / height - 1.0),	FarPlane / (FarPlane - NearPlane),				1.0f,
+				0.0f,												0.0f,												-NearPlane * FarPlane / (FarPlane - NearPlane),	0.0f
+			});
+
+			const JsonValue* filePathOrNull = FindJsonMember(frame, "file_path");
+			if (filePathOrNull != nullptr && filePathOrNull->Type == JsonValue::eType::STRING)
+			{
+				view.FilePath = filePathOrNull->String;
+			}
+			else
+			{
+				view.FilePath = std::to_string(frameIndex);
+			}
+
+			mViews.push_back(std::move(view));
+		}
+	}
+} // namespace iiixrlab::scene
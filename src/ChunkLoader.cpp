@@ -0,0 +1,212 @@
+#include "3dgs/scene/ChunkLoader.h"
+
+#include "3dgs/Profiler.h"
+
+namespace iiixrlab::scene
+{
+	static constexpr const uint32_t LOADING_CHUNK_INDEX_NONE = UINT32_MAX;
+
+	ChunkLoader::ChunkLoader(const std::filesystem::path& path, const FileReadInfo& fileReadInfo) noexcept
+		: mReader(path, fileReadInfo)
+		, mMutex()
+		, mRequestsCondition()
+		, mRequests()
+		, mLoadingChunkIndex(LOADING_CHUNK_INDEX_NONE)
+		, mChunks()
+		, mFailedChunkIndices()
+		, mbIsStopping(false)
+		, mThread()
+	{
+		if (mReader.IsOpen() == true)
+		{
+			mThread = std::thread(&ChunkLoader::load, this);
+		}
+	}
+
+	ChunkLoader::~ChunkLoader() noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mbIsStopping = true;
+		}
+		mRequestsCondition.notify_one();
+		if (mThread.joinable() == true)
+		{
+			mThread.join();
+		}
+	}
+
+	void ChunkLoader::SetRequests(std::vector<uint32_t>&& chunkIndices) noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mRequests.clear();
+			for (const uint32_t chunkIndex : chunkIndices)
+			{
+				const bool bIsRead = chunkIndex == mLoadingChunkIndex || mFailedChunkIndices.contains(chunkIndex) == true
+					|| std::find_if(mChunks.begin(), mChunks.end(), [chunkIndex](const Chunk& chunk) { return chunk.ChunkIndex == chunkIndex; }) != mChunks.end()
+					|| std::find(mRequests.begin(), mRequests.end(), chunkIndex) != mRequests.end();
+				if (chunkIndex < mReader.GetChunks().size() && bIsRead == false)
+				{
+					mRequests.push_back(chunkIndex);
+				}
+			}
+		}
+		mRequestsCondition.notify_one();
+	}
+
+	bool ChunkLoader::TryPop(Chunk& outChunk) noexcept
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mChunks.empty() == true)
+		{
+			return false;
+		}
+
+		outChunk = std::move(mChunks.front());
+		mChunks.pop_front();
+		return true;
+	}
+
+	void ChunkLoader::load() noexcept
+	{
+		IIIXRLAB_PROFILE_THREAD("ChunkLoader");
+
+		while (true)
+		{
+			uint32_t chunkIndex = LOADING_CHUNK_INDEX_NONE;
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mLoadingChunkIndex = LOADING_CHUNK_INDEX_NONE;
+				mRequestsCondition.wait(lock, [this]() { return mbIsStopping == true || mRequests.empty() == false; });
+				if (mbIsStopping == true)
+				{
+					return;
+				}
+
+				chunkIndex = mRequests.front();
+				mRequests.pop_front();
+				mLoadingChunkIndex = chunkIndex;
+			}
+
+			IIIXRLAB_PROFILE_ZONE("ChunkLoader::read");
+			const SceneChunk& chunk = mReader.GetChunks()[chunkIndex];
+			std::unique_ptr<GaussianInfo> gaussianInfo = std::make_unique<GaussianInfo>();
+			const bool bIsRead = mReader.Read(chunk.FirstPointIndex, chunk.PointsCount, *gaussianInfo);
+
+			std::lock_guard<std::mutex> lock(mMutex);
+			if (bIsRead == false)
+			{
+				mFailedChunkIndices.insert(chunkIndex);
+				continue;
+			}
+			mChunks.push_back({ .ChunkIndex = chunkIndex, .GaussianInfo = std::move(gaussianInfo) });
+		}
+	}
+
+	std::vector<uint32_t> SelectResidentChunks(const std::vector<SceneChunk>& chunks, const std::vector<uint64_t>& chunkSizes, const Camera::Info& view, const iiixrlab::math::Vector3f& position, const uint64_t budget, const uint32_t pinnedChunksCount) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		struct Candidate final
+		{
+			uint32_t ChunkIndex;
+			uint32_t Priority;	// 0 when pinned, 1 when in the frustum, 2 otherwise
+			float SquaredDistance;
+		};
+
+		const iiixrlab::math::Matrix4x4f viewProjection = view.View * view.Projection;
+		std::vector<Candidate> candidates(chunks.size());
+		for (uint32_t chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex)
+		{
+			const SceneChunk& chunk = chunks[chunkIndex];
+
+			// distance to the closest point of the box, 0 inside of it
+			const float dx = std::max({ chunk.BoundsMin[0] - position.GetX(), 0.0f, position.GetX() - chunk.BoundsMax[0] });
+			const float dy = std::max({ chunk.BoundsMin[1] - position.GetY(), 0.0f, position.GetY() - chunk.BoundsMax[1] });
+			const float dz = std::max({ chunk.BoundsMin[2] - position.GetZ(), 0.0f, position.GetZ() - chunk.BoundsMax[2] });
+			candidates[chunkIndex] =
+			{
+				.ChunkIndex = chunkIndex,
+				.Priority = chunkIndex < pinnedChunksCount ? 0u : IsInFrustum(chunk, viewProjection) == true ? 1u : 2u,
+				.SquaredDistance = dx * dx + dy * dy + dz * dz,
+			};
+		}
+		std::sort(candidates.begin(), candidates.end(), [](const Candidate& lhs, const Candidate& rhs)
+			{
+				return lhs.Priority != rhs.Priority ? lhs.Priority < rhs.Priority
+					: lhs.SquaredDistance != rhs.SquaredDistance ? lhs.SquaredDistance < rhs.SquaredDistance
+					: lhs.ChunkIndex < rhs.ChunkIndex;
+			});
+
+		std::vector<uint32_t> chunkIndices;
+		uint64_t size = 0;
+		for (const Candidate& candidate : candidates)
+		{
+			if (size + chunkSizes[candidate.ChunkIndex] <= budget)
+			{
+				chunkIndices.push_back(candidate.ChunkIndex);
+				size += chunkSizes[candidate.ChunkIndex];
+			}
+		}
+
+		return chunkIndices;
+	}
+
+	bool IsInFrustum(const std::array<float, 3>& boundsMin, const std::array<float, 3>& boundsMax, const iiixrlab::math::Matrix4x4f& viewProjection) noexcept
+	{
+		// a plane rejects the box when every corner is outside of it: x and y against -w and w, z against 0 and w
+		uint32_t outsideMasks = 0x3F;
+		for (uint32_t cornerIndex = 0; cornerIndex < 8; ++cornerIndex)
+		{
+			const iiixrlab::math::Vector4f corner
+			{
+				(cornerIndex & 1) == 0 ? boundsMin[0] : boundsMax[0],
+				(cornerIndex & 2) == 0 ? boundsMin[1] : boundsMax[1],
+				(cornerIndex & 4) == 0 ? boundsMin[2] : boundsMax[2],
+				1.0f,
+			};
+			const iiixrlab::math::Vector4f clipPosition = corner * viewProjection;
+			const float w = clipPosition.GetW();
+			const uint32_t cornerOutsideMask = (clipPosition.GetX() < -w ? 1u << 0 : 0u)
+				| (clipPosition.GetX() > w ? 1u << 1 : 0u)
+				| (clipPosition.GetY() < -w ? 1u << 2 : 0u)
+				| (clipPosition.GetY() > w ? 1u << 3 : 0u)
+				| (clipPosition.GetZ() < 0.0f ? 1u << 4 : 0u)
+				| (clipPosition.GetZ() > w ? 1u << 5 : 0u);
+			outsideMasks &= cornerOutsideMask;
+		}
+
+		return outsideMasks == 0;
+	}
+
+	float GetScreenCoverage(const std::array<float, 3>& boundsMin, const std::array<float, 3>& boundsMax, const iiixrlab::math::Matrix4x4f& viewProjection) noexcept
+	{
+		std::array<float, 2> screenMin = { 1.0f, 1.0f };
+		std::array<float, 2> screenMax = { -1.0f, -1.0f };
+		for (uint32_t cornerIndex = 0; cornerIndex < 8; ++cornerIndex)
+		{
+			const iiixrlab::math::Vector4f corner
+			{
+				(cornerIndex & 1) == 0 ? boundsMin[0] : boundsMax[0],
+				(cornerIndex & 2) == 0 ? boundsMin[1] : boundsMax[1],
+				(cornerIndex & 4) == 0 ? boundsMin[2] : boundsMax[2],
+				1.0f,
+			};
+			const iiixrlab::math::Vector4f clipPosition = corner * viewProjection;
+			const float w = clipPosition.GetW();
+			if (w <= std::numeric_limits<float>::epsilon())
+			{
+				return 1.0f;
+			}
+
+			screenMin = { std::min(screenMin[0], clipPosition.GetX() / w), std::min(screenMin[1], clipPosition.GetY() / w) };
+			screenMax = { std::max(screenMax[0], clipPosition.GetX() / w), std::max(screenMax[1], clipPosition.GetY() / w) };
+		}
+
+		// normalized device coordinates span 2 along each axis
+		const float width = std::max(std::min(screenMax[0], 1.0f) - std::max(screenMin[0], -1.0f), 0.0f);
+		const float height = std::max(std::min(screenMax[1], 1.0f) - std::max(screenMin[1], -1.0f), 0.0f);
+		return width * height / 4.0f;
+	}
+} // namespace iiixrlab::scene
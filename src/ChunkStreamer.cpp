@@ -0,0 +1,214 @@
+#include "3dgs/graphics/ChunkStreamer.h"
+
+#include "3dgs/graphics/BindlessDescriptorSet.h"
+#include "3dgs/graphics/Device.h"
+#include "3dgs/graphics/StagingBuffer.h"
+#include "3dgs/graphics/Uploader.h"
+#include "3dgs/graphics/VertexBuffer.h"
+
+#include "3dgs/scene/Camera.h"
+#include "3dgs/scene/Gaussian.h"
+
+#include "3dgs/Profiler.h"
+
+namespace iiixrlab::graphics
+{
+	ChunkStreamer::ChunkStreamer(CreateInfo& createInfo) noexcept
+		: mDevice(createInfo.Device)
+		, mLoader(createInfo.Path, createInfo.FileReadInfo)
+		, mBudget(createInfo.Budget)
+		, mPinnedChunksCount(0)
+		, mChunkSizes()
+		, mbAreChunksResident()
+		, mbAreChunksPending()
+		, mResidentChunks()
+		, mPendingChunks()
+		, mEvictedChunks()
+		, mUpdateIndex(0)
+		, mResidentSize(0)
+		, mPeakResidentSize(0)
+		, mUploadedChunksCount(0)
+		, mEvictedChunksCount(0)
+	{
+		if (IsOpen() == false)
+		{
+			std::cerr << "Scene cache " << createInfo.Path << " has no chunks to stream, write it again with -save-cache.\n";
+			return;
+		}
+
+		const iiixrlab::scene::SceneCacheReader& reader = mLoader.GetReader();
+		mPinnedChunksCount = reader.GetPreviewPointsCount() > 0 ? 1 : 0;
+		mChunkSizes.reserve(reader.GetChunks().size());
+		for (const iiixrlab::scene::SceneChunk& chunk : reader.GetChunks())
+		{
+			mChunkSizes.push_back(iiixrlab::scene::Gaussian::GetVertexBufferSize(chunk.PointsCount, reader.GetShDegree(), reader.GetShCodebookEntriesCount()));
+		}
+		mbAreChunksResident.resize(reader.GetChunks().size(), false);
+		mbAreChunksPending.resize(reader.GetChunks().size(), false);
+	}
+
+	ChunkStreamer::~ChunkStreamer() noexcept
+	{
+		BindlessDescriptorSet& bindlessDescriptorSet = mDevice.GetBindlessDescriptorSet();
+		for (ResidentChunk& residentChunk : mResidentChunks)
+		{
+			bindlessDescriptorSet.Unregister(BindlessDescriptorSet::eType::STORAGE_BUFFER, residentChunk.VertexBufferBindlessIndex);
+		}
+		for (EvictedChunk& evictedChunk : mEvictedChunks)
+		{
+			bindlessDescriptorSet.Unregister(BindlessDescriptorSet::eType::STORAGE_BUFFER, evictedChunk.Chunk.VertexBufferBindlessIndex);
+		}
+		mResidentChunks.clear();
+		mEvictedChunks.clear();
+		mPendingChunks.clear();
+	}
+
+	void ChunkStreamer::Update(const iiixrlab::scene::Camera& camera, const uint32_t framesCount) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		if (IsOpen() == false)
+		{
+			return;
+		}
+		++mUpdateIndex;
+
+		// the frame recorded framesCount updates ago is done, and with it the last draw of the chunks evicted back then
+		while (mEvictedChunks.empty() == false && mUpdateIndex - mEvictedChunks.front().UpdateIndex >= framesCount)
+		{
+			mDevice.GetBindlessDescriptorSet().Unregister(BindlessDescriptorSet::eType::STORAGE_BUFFER, mEvictedChunks.front().Chunk.VertexBufferBindlessIndex);
+			mEvictedChunks.pop_front();
+		}
+
+		const std::vector<iiixrlab::scene::SceneChunk>& chunks = mLoader.GetReader().GetChunks();
+		const std::vector<uint32_t> wantedChunkIndices = iiixrlab::scene::SelectResidentChunks(chunks, mChunkSizes, camera.GetInfo(), camera.GetPosition(), mBudget, mPinnedChunksCount);
+		std::vector<uint8_t> bAreChunksWanted(chunks.size(), false);
+		for (const uint32_t chunkIndex : wantedChunkIndices)
+		{
+			bAreChunksWanted[chunkIndex] = true;
+		}
+		for (ResidentChunk& residentChunk : mResidentChunks)
+		{
+			if (bAreChunksWanted[residentChunk.ChunkIndex] == true)
+			{
+				residentChunk.WantedUpdateIndex = mUpdateIndex;
+			}
+		}
+
+		// chunks the camera turned away from while they were read are dropped
+		iiixrlab::scene::ChunkLoader::Chunk chunk;
+		while (mLoader.TryPop(chunk) == true)
+		{
+			if (bAreChunksWanted[chunk.ChunkIndex] == false || mbAreChunksResident[chunk.ChunkIndex] == true || mbAreChunksPending[chunk.ChunkIndex] == true || chunk.GaussianInfo->NumPoints == 0)
+			{
+				continue;
+			}
+
+			iiixrlab::scene::Gaussian::CreateInfo gaussianCreateInfo =
+			{
+				.Device = mDevice,
+				.GaussianInfo = *chunk.GaussianInfo,
+			};
+			std::unique_ptr<iiixrlab::scene::Gaussian> gaussian = iiixrlab::scene::Gaussian::Create(gaussianCreateInfo);
+			if (gaussian == nullptr)
+			{
+				continue;
+			}
+			const uint32_t size = gaussian->GetStagingBuffer().GetTotalSize();
+			mChunkSizes[chunk.ChunkIndex] = size;
+			mbAreChunksPending[chunk.ChunkIndex] = true;
+			mPendingChunks.push_back({ .ChunkIndex = chunk.ChunkIndex, .GaussianInfo = std::move(chunk.GaussianInfo), .Gaussian = std::move(gaussian), .Size = size });
+		}
+
+		// the chunks waiting for room since an earlier update come first, a chunk which still does not fit stays pending
+		Uploader& uploader = mDevice.GetUploader();
+		size_t pendingChunksCount = 0;
+		for (size_t pendingChunkIndex = 0; pendingChunkIndex < mPendingChunks.size(); ++pendingChunkIndex)
+		{
+			PendingChunk& pendingChunk = mPendingChunks[pendingChunkIndex];
+			if (bAreChunksWanted[pendingChunk.ChunkIndex] == false)
+			{
+				mbAreChunksPending[pendingChunk.ChunkIndex] = false;
+				continue;
+			}
+			if (makeRoom(pendingChunk.Size, bAreChunksWanted) == false)
+			{
+				if (pendingChunksCount != pendingChunkIndex)
+				{
+					mPendingChunks[pendingChunksCount] = std::move(pendingChunk);
+				}
+				++pendingChunksCount;
+				continue;
+			}
+
+			mbAreChunksPending[pendingChunk.ChunkIndex] = false;
+			const uint32_t size = pendingChunk.Size;
+			ResidentChunk residentChunk =
+			{
+				.ChunkIndex = pendingChunk.ChunkIndex,
+				.GaussianInfo = std::move(pendingChunk.GaussianInfo),
+				.Gaussian = std::move(pendingChunk.Gaussian),
+				.VertexBuffer = mDevice.CreateVertexBuffer("GaussianChunkVertexBuffer", size),
+				.VertexBufferBindlessIndex = BindlessDescriptorSet::INVALID_INDEX,
+				.Size = size,
+				.WantedUpdateIndex = mUpdateIndex,
+			};
+			residentChunk.VertexBufferBindlessIndex = mDevice.GetBindlessDescriptorSet().Register(*residentChunk.VertexBuffer);
+			residentChunk.Gaussian->Upload(uploader, *residentChunk.VertexBuffer, 0);
+
+			mbAreChunksResident[residentChunk.ChunkIndex] = true;
+			mResidentSize += size;
+			mPeakResidentSize = std::max(mPeakResidentSize, mResidentSize);
+			++mUploadedChunksCount;
+			mResidentChunks.push_back(std::move(residentChunk));
+		}
+		mPendingChunks.resize(pendingChunksCount);
+
+		// the wanted chunks are read in the order of their priority, requests of the last update are replaced
+		std::vector<uint32_t> requestedChunkIndices;
+		for (const uint32_t chunkIndex : wantedChunkIndices)
+		{
+			if (mbAreChunksResident[chunkIndex] == false && mbAreChunksPending[chunkIndex] == false)
+			{
+				requestedChunkIndices.push_back(chunkIndex);
+			}
+		}
+		mLoader.SetRequests(std::move(requestedChunkIndices));
+	}
+
+	bool ChunkStreamer::makeRoom(const uint64_t size, const std::vector<uint8_t>& bAreChunksWanted) noexcept
+	{
+		const Uploader& uploader = mDevice.GetUploader();
+		while (mResidentSize + size > mBudget)
+		{
+			// a chunk still being copied into cannot be released yet
+			size_t evictedChunkIndex = mResidentChunks.size();
+			for (size_t residentChunkIndex = 0; residentChunkIndex < mResidentChunks.size(); ++residentChunkIndex)
+			{
+				const ResidentChunk& residentChunk = mResidentChunks[residentChunkIndex];
+				if (bAreChunksWanted[residentChunk.ChunkIndex] == false && residentChunk.Gaussian->IsUploaded(uploader) == true
+					&& (evictedChunkIndex == mResidentChunks.size() || residentChunk.WantedUpdateIndex < mResidentChunks[evictedChunkIndex].WantedUpdateIndex))
+				{
+					evictedChunkIndex = residentChunkIndex;
+				}
+			}
+			if (evictedChunkIndex == mResidentChunks.size())
+			{
+				return false;
+			}
+
+			ResidentChunk& evictedChunk = mResidentChunks[evictedChunkIndex];
+			mbAreChunksResident[evictedChunk.ChunkIndex] = false;
+			mResidentSize -= evictedChunk.Size;
+			++mEvictedChunksCount;
+			mEvictedChunks.push_back({ .Chunk = std::move(evictedChunk), .UpdateIndex = mUpdateIndex });
+			if (evictedChunkIndex + 1 != mResidentChunks.size())
+			{
+				mResidentChunks[evictedChunkIndex] = std::move(mResidentChunks.back());
+			}
+			mResidentChunks.pop_back();
+		}
+
+		return true;
+	}
+} // namespace iiixrlab::graphics
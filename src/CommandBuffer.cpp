@@ -1,5 +1,6 @@
 #include "3dgs/graphics/CommandBuffer.h"
 
+#include "3dgs/graphics/BindlessDescriptorSet.h"
 #include "3dgs/graphics/Buffer.h"
 #include "3dgs/graphics/DescriptorSet.h"
 #include "3dgs/graphics/Device.h"
@@ -7,6 +8,7 @@
 #include "3dgs/graphics/Instance.h"
 #include "3dgs/graphics/Pipeline.h"
 #include "3dgs/graphics/PhysicalDevice.h"
+#include "3dgs/graphics/ReadbackBuffer.h"
 #include "3dgs/graphics/SwapChain.h"
 #include "3dgs/graphics/Texture.h"
 #include "3dgs/graphics/VertexBuffer.h"
@@ -15,16 +17,20 @@ namespace iiixrlab::graphics
 {
     CommandBuffer::CommandBuffer(const CreateInfo& createInfo) noexcept
         : mDevice(createInfo.Device)
+        , mCommandPool(createInfo.CommandPool)
         , mCommandBuffer(createInfo.CommandBuffer)
+		, mQueueFamilyIndex(createInfo.QueueFamilyIndex)
 		, mFrameResourceOrNull(nullptr)
 		, mPipelineOrNull(nullptr)
+		, mbIsRendering(false)
     {
+        assert(mCommandPool != VK_NULL_HANDLE);
         assert(mCommandBuffer != VK_NULL_HANDLE);
     }
 
     CommandBuffer::~CommandBuffer() noexcept
     {
-        mDevice.DestroyCommandBuffer(mCommandBuffer);
+        mDevice.DestroyCommandBuffer(mCommandPool, mCommandBuffer);
     }
 
     void CommandBuffer::Barrier(const VkPipelineStageFlags srcStageMask, const VkPipelineStageFlags dstStageMask, const VkImageMemoryBarrier& imageMemoryBarriers) noexcept
@@ -32,9 +38,31 @@ namespace iiixrlab::graphics
         vkCmdPipelineBarrier(mCommandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarriers);
     }
 
+    void CommandBuffer::Barrier(const VkPipelineStageFlags srcStageMask, const VkPipelineStageFlags dstStageMask, const VkBufferMemoryBarrier& bufferMemoryBarrier) noexcept
+    {
+        vkCmdPipelineBarrier(mCommandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 1, &bufferMemoryBarrier, 0, nullptr);
+    }
+
+    void CommandBuffer::Begin() noexcept
+    {
+		mFrameResourceOrNull = nullptr;
+		mbIsRendering = false;
+
+        VkCommandBufferBeginInfo commandBufferBeginInfo =
+        {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .pNext = nullptr,
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+            .pInheritanceInfo = nullptr,
+        };
+        VkResult vr = vkBeginCommandBuffer(mCommandBuffer, &commandBufferBeginInfo);
+        assert(vr == VK_SUCCESS);
+    }
+
     void CommandBuffer::Begin(FrameResource& frameResource) noexcept
     {
 		mFrameResourceOrNull = &frameResource;
+		mbIsRendering = true;
         Texture& backBuffer = frameResource.GetBackBuffer();
         Texture& depthBuffer = frameResource.GetDepthBuffer();
 
@@ -48,6 +76,11 @@ namespace iiixrlab::graphics
         VkResult vr = vkBeginCommandBuffer(mCommandBuffer, &commandBufferBeginInfo);
         assert(vr == VK_SUCCESS);
 
+		// bound once per frame, it stays valid across every pipeline since all layouts share set 0 and the push constant range
+		const BindlessDescriptorSet& bindlessDescriptorSet = mDevice.GetBindlessDescriptorSet();
+		vkCmdBindDescriptorSets(mCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, bindlessDescriptorSet.mPipelineLayout, BINDLESS_DESCRIPTOR_SET_INDEX, 1, &bindlessDescriptorSet.mDescriptorSet, 0, nullptr);
+		vkCmdBindDescriptorSets(mCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, bindlessDescriptorSet.mPipelineLayout, BINDLESS_DESCRIPTOR_SET_INDEX, 1, &bindlessDescriptorSet.mDescriptorSet, 0, nullptr);
+
 		VkImageMemoryBarrier backBufferMemoryBarrier = 
 		{
 			.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
@@ -99,6 +132,15 @@ namespace iiixrlab::graphics
 			depthBufferMemoryBarrier);
     }
 
+    void CommandBuffer::BeginCompute(FrameResource& frameResource) noexcept
+    {
+		Begin();
+		mFrameResourceOrNull = &frameResource;
+
+		const BindlessDescriptorSet& bindlessDescriptorSet = mDevice.GetBindlessDescriptorSet();
+		vkCmdBindDescriptorSets(mCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, bindlessDescriptorSet.mPipelineLayout, BINDLESS_DESCRIPTOR_SET_INDEX, 1, &bindlessDescriptorSet.mDescriptorSet, 0, nullptr);
+    }
+
     void CommandBuffer::BeginRender() noexcept
     {
 		if (mFrameResourceOrNull == nullptr)
@@ -133,8 +175,7 @@ namespace iiixrlab::graphics
 			.clearValue = VkClearValue{.depthStencil = {1.0f, 0}},
 		};
 
-        const SwapChain& swapChain = mFrameResourceOrNull->GetSwapChain();
-        const VkExtent2D& extent = swapChain.GetExtent();
+        const VkExtent2D extent = mFrameResourceOrNull->GetExtent();
 
 		VkRenderingInfo renderingInfo =
 		{
@@ -173,23 +214,31 @@ namespace iiixrlab::graphics
 
     void CommandBuffer::BindDescriptorSets(const VkPipelineLayout pipelineLayout, const VkDescriptorSet& descriptorSet) noexcept
     {
-        vkCmdBindDescriptorSets(mCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+        vkCmdBindDescriptorSets(mCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, PIPELINE_DESCRIPTOR_SET_INDEX, 1, &descriptorSet, 0, nullptr);
     }
 	
 	void CommandBuffer::Bind(const Pipeline& pipeline) noexcept
 	{
-		vkCmdBindPipeline(mCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.mPipeline);
+		vkCmdBindPipeline(mCommandBuffer, pipeline.mBindPoint, pipeline.mPipeline);
 		mPipelineOrNull = &pipeline;
 
 		const uint32_t descriptorSetCount = pipeline.GetDescriptorSetCount();
 		for (uint32_t i = 0; i < descriptorSetCount; ++i)
 		{
 			const DescriptorSet& descriptorSet = pipeline.GetDescriptorSet(i);
-			vkCmdBindDescriptorSets(mCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.mPipelineLayout, i, 1, &descriptorSet.mDescriptorSet, 0, nullptr);
+			if (descriptorSet.HasDynamicOffset())
+			{
+				assert(mFrameResourceOrNull != nullptr);
+				const uint32_t dynamicOffset = descriptorSet.GetDynamicOffset(mFrameResourceOrNull->GetFrameIndex());
+				vkCmdBindDescriptorSets(mCommandBuffer, pipeline.mBindPoint, pipeline.mPipelineLayout, PIPELINE_DESCRIPTOR_SET_INDEX + i, 1, &descriptorSet.mDescriptorSet, 1, &dynamicOffset);
+				continue;
+			}
+
+			vkCmdBindDescriptorSets(mCommandBuffer, pipeline.mBindPoint, pipeline.mPipelineLayout, PIPELINE_DESCRIPTOR_SET_INDEX + i, 1, &descriptorSet.mDescriptorSet, 0, nullptr);
 		}
 	}
 
-	void CommandBuffer::Bind(const VertexBuffer& vertexBuffer, const std::vector<VertexBindingInfo>& vertexBindingInfos) noexcept
+	void CommandBuffer::Bind(const VertexBuffer& vertexBuffer, const std::vector<VertexBindingInfo>& vertexBindingInfos, const VkDeviceSize baseOffset) noexcept
 	{
 		const uint32_t buffersCount = static_cast<uint32_t>(vertexBindingInfos.size());
 		if (buffersCount == 0)
@@ -199,7 +248,7 @@ namespace iiixrlab::graphics
 			return;
 		}
 
-		VkDeviceSize offset = 0;
+		VkDeviceSize offset = baseOffset;
 		for (const VertexBindingInfo& vertexBindingInfo : vertexBindingInfos)
 		{
 			vkCmdBindVertexBuffers(mCommandBuffer, vertexBindingInfo.BindingIndex, 1, &vertexBuffer.mBuffer, &offset);
@@ -212,6 +261,32 @@ namespace iiixrlab::graphics
 		vkCmdCopyBuffer(mCommandBuffer, srcBuffer.mBuffer, dstBuffer.mBuffer, 1, &bufferCopy);
 	}
 
+	void CommandBuffer::CopyTextureToBuffer(const Texture& srcTexture, Buffer& dstBuffer) noexcept
+	{
+		const VkExtent2D extent = srcTexture.GetExtent();
+		const VkBufferImageCopy bufferImageCopy =
+		{
+			.bufferOffset = 0,
+			.bufferRowLength = 0,
+			.bufferImageHeight = 0,
+			.imageSubresource =
+			{
+				.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+				.mipLevel = 0,
+				.baseArrayLayer = 0,
+				.layerCount = 1,
+			},
+			.imageOffset = { .x = 0, .y = 0, .z = 0 },
+			.imageExtent = { .width = extent.width, .height = extent.height, .depth = 1 },
+		};
+		vkCmdCopyImageToBuffer(mCommandBuffer, srcTexture.GetImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dstBuffer.mBuffer, 1, &bufferImageCopy);
+	}
+
+	void CommandBuffer::Dispatch(const uint32_t groupCountX, const uint32_t groupCountY, const uint32_t groupCountZ) noexcept
+	{
+		vkCmdDispatch(mCommandBuffer, groupCountX, groupCountY, groupCountZ);
+	}
+
 	void CommandBuffer::Draw(const uint32_t vertexCount, const uint32_t instanceCount, const uint32_t firstVertex, const uint32_t firstInstance) noexcept
 	{
 		vkCmdDraw(mCommandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
@@ -224,21 +299,32 @@ namespace iiixrlab::graphics
 
     void CommandBuffer::End() noexcept
     {
-        Texture& backBuffer = mFrameResourceOrNull->GetBackBuffer();
-		
         VkResult vr = VK_SUCCESS;
+		if (mbIsRendering == false)
+		{
+			vr = vkEndCommandBuffer(mCommandBuffer);
+			assert(vr == VK_SUCCESS);
+
+			mPipelineOrNull = nullptr;
+			mFrameResourceOrNull = nullptr;
+			return;
+		}
+
+        Texture& backBuffer = mFrameResourceOrNull->GetBackBuffer();
+		const bool bIsHeadless = mFrameResourceOrNull->IsHeadless();
 
 		const uint32_t apiVersion = mDevice.GetPhysicalDevice().GetInstance().GetApiVersion();
 		static PFN_vkCmdEndRendering pfnVkCmdEndRendering = (apiVersion > VK_API_VERSION_1_3) ? vkCmdEndRendering : vkCmdEndRenderingKHR;
 		pfnVkCmdEndRendering(mCommandBuffer);
 		
+		// an offscreen target is left for a copy out instead of presentation
 		VkImageMemoryBarrier backBufferMemoryBarrier = 
 		{
 			.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
 			.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-			.dstAccessMask = 0,
+			.dstAccessMask = bIsHeadless ? static_cast<VkAccessFlags>(VK_ACCESS_TRANSFER_READ_BIT) : 0,
 			.oldLayout = VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL,
-			.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+			.newLayout = bIsHeadless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
 			.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
 			.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
 			.image = backBuffer.GetImage(),
@@ -252,18 +338,66 @@ namespace iiixrlab::graphics
 			},
 		};
 
-		Barrier(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_2_NONE, backBufferMemoryBarrier);
+		Barrier(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, bIsHeadless ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_NONE, backBufferMemoryBarrier);
+
+		ReadbackBuffer* readbackBufferOrNull = mFrameResourceOrNull->GetReadbackBufferOrNull();
+		if (bIsHeadless == true && readbackBufferOrNull != nullptr)
+		{
+			CopyTextureToBuffer(backBuffer, *readbackBufferOrNull);
+
+			// makes the copy visible to the host once the frame's timeline value is reached
+			VkBufferMemoryBarrier readbackMemoryBarrier =
+			{
+				.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+				.pNext = nullptr,
+				.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+				.dstAccessMask = VK_ACCESS_HOST_READ_BIT,
+				.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+				.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+				.buffer = readbackBufferOrNull->GetBuffer(),
+				.offset = 0,
+				.size = VK_WHOLE_SIZE,
+			};
+			Barrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, readbackMemoryBarrier);
+		}
 
 		vr = vkEndCommandBuffer(mCommandBuffer);
         assert(vr == VK_SUCCESS);
 
 		mPipelineOrNull = nullptr;
 		mFrameResourceOrNull = nullptr;
+		mbIsRendering = false;
     }
 
+	void CommandBuffer::PushConstants(const void* data, const uint32_t size, const uint32_t offset) noexcept
+	{
+		if (offset + size > PUSH_CONSTANTS_SIZE)
+		{
+			std::cerr << "Push constants exceed " << PUSH_CONSTANTS_SIZE << " bytes." << std::endl;
+			IIIXRLAB_DEBUG_BREAK();
+			return;
+		}
+
+		// every pipeline layout shares the bindless push constant range, so the bindless layout is compatible with all of them
+		const BindlessDescriptorSet& bindlessDescriptorSet = mDevice.GetBindlessDescriptorSet();
+		vkCmdPushConstants(mCommandBuffer, bindlessDescriptorSet.mPipelineLayout, VK_SHADER_STAGE_ALL, offset, size, data);
+	}
+
     void CommandBuffer::Reset() noexcept
     {
         VkResult vr = vkResetCommandBuffer(mCommandBuffer, 0);
         assert(vr == VK_SUCCESS);
     }
+
+	void CommandBuffer::ResetQueryPool(const VkQueryPool queryPool, const uint32_t firstQuery, const uint32_t queriesCount) noexcept
+	{
+		assert(mbIsRendering == false);
+		vkCmdResetQueryPool(mCommandBuffer, queryPool, firstQuery, queriesCount);
+	}
+
+	void CommandBuffer::WriteTimestamp(const VkQueryPool queryPool, const uint32_t query) noexcept
+	{
+		// written once all previously recorded commands completed, so consecutive timestamps bracket the work in between
+		vkCmdWriteTimestamp(mCommandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, query);
+	}
 }   // namespace iiixrlab::graphics
\ No newline at end of file
@@ -8,6 +8,7 @@ namespace iiixrlab::graphics
 	CommandPool::CommandPool(const CreateInfo& createInfo) noexcept
 		: mDevice(createInfo.Device)
 		, mCommandPool(createInfo.CommandPool)
+		, mQueueFamilyIndex(createInfo.QueueFamilyIndex)
 	{
 		assert(mCommandPool != VK_NULL_HANDLE);
 	}
@@ -25,7 +26,9 @@ namespace iiixrlab::graphics
 			CommandBuffer::CreateInfo commandBufferCreateInfo =
 			{
 				.Device = mDevice,
-				.CommandBuffer = mDevice.AllocateCommandBuffer(name),
+				.CommandPool = mCommandPool,
+				.CommandBuffer = mDevice.AllocateCommandBuffer(name, mCommandPool),
+				.QueueFamilyIndex = mQueueFamilyIndex,
 			};
 			mCommandBuffers.push_back(std::make_unique<CommandBuffer>(commandBufferCreateInfo));
 		}
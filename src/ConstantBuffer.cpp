@@ -8,10 +8,11 @@ namespace iiixrlab::graphics
         : Buffer(createInfo)
         , mMappedData(nullptr)
     {
+        mDescriptorBufferInfo.range = mStride;
         mDevice.MapMemory(*this, reinterpret_cast<void**>(&mMappedData));
     }
 
-    bool ConstantBuffer::SetData(const void* data, const size_t size) noexcept
+    bool ConstantBuffer::SetData(const void* data, const size_t size, const uint32_t frameIndex) noexcept
     {
         if (mMappedData == nullptr)
         {
@@ -20,14 +21,21 @@ namespace iiixrlab::graphics
             return false;
         }
 
-        if (GetTotalSize() < size)
+        if (mStride < size)
         {
             std::cerr << "The size of the data is too large.\n";
             IIIXRLAB_DEBUG_BREAK();
             return false;
         }
 
-        std::memcpy(mMappedData, data, size);
+        if (mSize <= frameIndex)
+        {
+            std::cerr << "The frame index is out of range.\n";
+            IIIXRLAB_DEBUG_BREAK();
+            return false;
+        }
+
+        std::memcpy(GetMappedDataOrNull(frameIndex), data, size);
 
         return true;
     }
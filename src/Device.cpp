@@ -1,19 +1,24 @@
 #include "3dgs/graphics/Device.hpp"
 
+#include "3dgs/graphics/BindlessDescriptorSet.h"
 #include "3dgs/graphics/Buffer.h"
 #include "3dgs/graphics/CommandPool.h"
 #include "3dgs/graphics/ConstantBuffer.h"
 #include "3dgs/graphics/DescriptorPool.h"
 #include "3dgs/graphics/DescriptorSet.h"
+#include "3dgs/graphics/GpuProfiler.h"
 #include "3dgs/graphics/Instance.h"
 #include "3dgs/graphics/Pipeline.h"
 #include "3dgs/graphics/PhysicalDevice.h"
 #include "3dgs/graphics/Queue.h"
+#include "3dgs/graphics/ReadbackBuffer.h"
 #include "3dgs/graphics/Shader.h"
 #include "3dgs/graphics/ShaderManager.h"
 #include "3dgs/graphics/StagingBuffer.h"
+#include "3dgs/graphics/StorageBuffer.h"
 #include "3dgs/graphics/SwapChain.h"
 #include "3dgs/graphics/Texture.h"
+#include "3dgs/graphics/Uploader.h"
 #include "3dgs/graphics/VertexBuffer.h"
 
 namespace iiixrlab::graphics
@@ -22,42 +27,73 @@ namespace iiixrlab::graphics
 		: mPhysicalDevice(createInfo.PhysicalDevice)
 		, mDevice(createInfo.Device)
 		, mQueues()
+		, mTransferQueues()
+		, mComputeQueues()
 		, mCommandPool()
 		, mDescriptorPool(VK_NULL_HANDLE)
+		, mBindlessDescriptorSet()
+		, mUploader()
 	{
 		assert(mDevice != VK_NULL_HANDLE);
 
-		std::vector<VkQueue> queues;
-		getQueues(queues, mDevice, mPhysicalDevice.GetInstance().GetApiVersion(), mPhysicalDevice.GetQueueFamilyIndex(), mPhysicalDevice.GetQueueFamilyProperties());
-		const uint32_t queuesCount = static_cast<uint32_t>(queues.size());
-		mQueues.reserve(queuesCount);
-		for (uint32_t queueIndex = 0; queueIndex < queuesCount; ++queueIndex)
+		initializeQueues(mQueues, mPhysicalDevice.GetQueueFamilyIndex());
+
+		// separate families only, otherwise the queues of the main family are shared
+		const uint32_t transferQueueFamilyIndex = mPhysicalDevice.GetTransferQueueFamilyIndex();
+		if (transferQueueFamilyIndex != mPhysicalDevice.GetQueueFamilyIndex())
 		{
-			Queue::CreateInfo queueCreateInfo =
-			{
-				.Device = *this,
-				.Queue = queues[queueIndex],
-				.QueueFamilyIndex = mPhysicalDevice.GetQueueFamilyIndex(),
-				.QueueIndex = queueIndex,
-			};
-			mQueues.push_back(std::make_unique<Queue>(queueCreateInfo));
+			initializeQueues(mTransferQueues, transferQueueFamilyIndex);
+		}
+
+		const uint32_t computeQueueFamilyIndex = mPhysicalDevice.GetComputeQueueFamilyIndex();
+		if (computeQueueFamilyIndex != mPhysicalDevice.GetQueueFamilyIndex())
+		{
+			initializeQueues(mComputeQueues, computeQueueFamilyIndex);
 		}
 	
-		mDescriptorPool = CreateDescriptorPool("DescriptorPool", 1024, { { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1024 }, { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1024 }, { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1024 }, { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1024 }, { VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, 1024 }, { VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, 1024 }, { VK_DESCRIPTOR_TYPE_SAMPLER, 1024 } });
+		mDescriptorPool = CreateDescriptorPool("DescriptorPool", 1024, { { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1024 }, { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1024 }, { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1024 }, { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1024 }, { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1024 }, { VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, 1024 }, { VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, 1024 }, { VK_DESCRIPTOR_TYPE_SAMPLER, 1024 } });
+		mBindlessDescriptorSet = CreateBindlessDescriptorSet("BindlessDescriptorSet");
+
+		Uploader::CreateInfo uploaderCreateInfo =
+		{
+			.Device = *this,
+			.Queue = GetTransferQueue(),
+			.CommandPool = CreateCommandPool("Upload Command Pool", transferQueueFamilyIndex),
+			.GpuProfiler = CreateGpuProfiler("Upload GPU Profiler", DEFAULT_FRAMES_COUNT, 1),
+			.TimelineSemaphore = CreateTimelineSemaphore("Upload Timeline Semaphore"),
+			.SrcQueueFamilyIndex = transferQueueFamilyIndex,
+			.DstQueueFamilyIndex = mPhysicalDevice.GetQueueFamilyIndex(),
+		};
+		Uploader uploader(uploaderCreateInfo);
+		mUploader = std::make_unique<Uploader>(std::move(uploader));
 	}
 
 	Device::~Device() noexcept
 	{
 		vkDeviceWaitIdle(mDevice);
 
+		mUploader.reset();
+		mBindlessDescriptorSet.reset();
 		mDescriptorPool.reset();
 		for (std::unique_ptr<Queue>& queue : mQueues)
 		{
 			queue->Wait();
 		}
 
+		for (std::unique_ptr<Queue>& queue : mTransferQueues)
+		{
+			queue->Wait();
+		}
+
+		for (std::unique_ptr<Queue>& queue : mComputeQueues)
+		{
+			queue->Wait();
+		}
+
 		mCommandPool->FreeCommandBuffers();
 		mCommandPool.reset();
+		mComputeQueues.clear();
+		mTransferQueues.clear();
 		mQueues.clear();
 
 		ShaderManager& shaderManager = ShaderManager::GetInstance();
@@ -87,51 +123,74 @@ namespace iiixrlab::graphics
 		return fence;
 	}
 
-	std::unique_ptr<Pipeline> Device::CreatePipeline(const PipelineCreateInfo& pipelineCreateInfo) noexcept
+	std::unique_ptr<GpuProfiler> Device::CreateGpuProfiler(const char* name, const uint32_t slotsCount, const uint32_t maxScopesCount) noexcept
 	{
-		assert(pipelineCreateInfo.Name != nullptr);
-		assert(pipelineCreateInfo.ShaderNames.size() > 0);
-
 		VkResult vr = VK_SUCCESS;
+		assert(name != nullptr);
+		assert(slotsCount > 0 && maxScopesCount > 0);
 
-		Pipeline::CreateInfo createInfo =
+		GpuProfiler::CreateInfo gpuProfilerCreateInfo =
 		{
 			.Device = *this,
-			.Name = pipelineCreateInfo.Name,
+			.Name = name,
+			.QueryPool = VK_NULL_HANDLE,
+			.SlotsCount = slotsCount,
+			.MaxScopesCount = maxScopesCount,
+			.TimestampPeriod = mPhysicalDevice.GetPhysicalDeviceProperties().limits.timestampPeriod,
+			.TimestampMasks = {},
+			.bIsHostQueryResetEnabled = mPhysicalDevice.IsHostQueryResetEnabled(),
 		};
 
-		createInfo.DescriptorSetLayouts.resize(1, VK_NULL_HANDLE);
-		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo =
+		// a family without valid bits cannot write timestamps, its scopes are skipped
+		const uint32_t queueFamiliesCount = mPhysicalDevice.GetQueueFamiliesCount();
+		gpuProfilerCreateInfo.TimestampMasks.reserve(queueFamiliesCount);
+		for (uint32_t queueFamilyIndex = 0; queueFamilyIndex < queueFamiliesCount; ++queueFamilyIndex)
 		{
-			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+			const uint32_t timestampValidBits = mPhysicalDevice.GetQueueFamilyProperties(queueFamilyIndex).queueFamilyProperties.timestampValidBits;
+			gpuProfilerCreateInfo.TimestampMasks.push_back(timestampValidBits >= 64 ? UINT64_MAX : (uint64_t(1) << timestampValidBits) - 1);
+		}
+
+		const uint32_t queriesCount = slotsCount * maxScopesCount * 2;
+		VkQueryPoolCreateInfo queryPoolCreateInfo =
+		{
+			.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
 			.pNext = nullptr,
 			.flags = 0,
-			.bindingCount = static_cast<uint32_t>(pipelineCreateInfo.DescriptorSetLayoutBindings.size()),
-			.pBindings = pipelineCreateInfo.DescriptorSetLayoutBindings.data(),
+			.queryType = VK_QUERY_TYPE_TIMESTAMP,
+			.queryCount = queriesCount,
+			.pipelineStatistics = 0,
 		};
-		vr = vkCreateDescriptorSetLayout(mDevice, &descriptorSetLayoutCreateInfo, nullptr, &createInfo.DescriptorSetLayouts[0]);
-		assert(vr == VK_SUCCESS && createInfo.DescriptorSetLayouts[0] != VK_NULL_HANDLE);
+		vr = vkCreateQueryPool(mDevice, &queryPoolCreateInfo, nullptr, &gpuProfilerCreateInfo.QueryPool);
+		assert(vr == VK_SUCCESS && gpuProfilerCreateInfo.QueryPool != VK_NULL_HANDLE);
 #if defined(_DEBUG)
-		SetDebugName(createInfo.Name.c_str(), VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, createInfo.DescriptorSetLayouts[0]);
+		SetDebugName(name, VK_OBJECT_TYPE_QUERY_POOL, gpuProfilerCreateInfo.QueryPool);
 #endif	// defined(_DEBUG)
 
-		AllocateDescriptorSets(*mDescriptorPool, createInfo.DescriptorSets, createInfo.DescriptorSetLayouts[0], { createInfo.Name });
+		// queries start in an undefined state and have to be reset before their first write, the profiler resets them in
+		// its command buffers without hostQueryReset
+		if (gpuProfilerCreateInfo.bIsHostQueryResetEnabled == true)
+		{
+			ResetQueryPool(gpuProfilerCreateInfo.QueryPool, 0, queriesCount);
+		}
 
-		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo =
+		return std::make_unique<GpuProfiler>(gpuProfilerCreateInfo);
+	}
+
+	std::unique_ptr<Pipeline> Device::CreatePipeline(const PipelineCreateInfo& pipelineCreateInfo) noexcept
+	{
+		assert(pipelineCreateInfo.Name != nullptr);
+		assert(pipelineCreateInfo.ShaderNames.size() > 0);
+
+		VkResult vr = VK_SUCCESS;
+
+		Pipeline::CreateInfo createInfo =
 		{
-			.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-			.pNext = nullptr,
-			.flags = 0,
-			.setLayoutCount = static_cast<uint32_t>(createInfo.DescriptorSetLayouts.size()),
-			.pSetLayouts = createInfo.DescriptorSetLayouts.data(),
-			.pushConstantRangeCount = 0,
-			.pPushConstantRanges = nullptr,
+			.Device = *this,
+			.Name = pipelineCreateInfo.Name,
+			.BindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
 		};
-		vr = vkCreatePipelineLayout(mDevice, &pipelineLayoutCreateInfo, nullptr, &createInfo.PipelineLayout);
-		assert(vr == VK_SUCCESS && createInfo.PipelineLayout != VK_NULL_HANDLE);
-#if defined(_DEBUG)
-		SetDebugName(createInfo.Name.c_str(), VK_OBJECT_TYPE_PIPELINE_LAYOUT, createInfo.PipelineLayout);
-#endif	// defined(_DEBUG)
+
+		createInfo.PipelineLayout = createPipelineLayout(createInfo.Name.c_str(), pipelineCreateInfo.DescriptorSetLayoutBindings, createInfo.DescriptorSetLayouts, createInfo.DescriptorSets);
 
 		ShaderManager& shaderManager = ShaderManager::GetInstance();
 		std::vector<VkPipelineShaderStageCreateInfo> shaderStageCreateInfos;
@@ -323,6 +382,36 @@ namespace iiixrlab::graphics
 		return std::make_unique<Pipeline>(std::move(pipeline));
 	}
 
+	std::unique_ptr<ReadbackBuffer> Device::CreateReadbackBuffer(const char* name, const uint32_t readbackBufferSize) noexcept
+	{
+		Buffer::CreateInfo createInfo =
+		{
+			.GpuResourceCreateInfo = GpuResource::CreateInfo
+			{
+				.Device = *this,
+				.Name = name,
+				.Size = 1,
+				.Stride = readbackBufferSize,
+			},
+			.Buffer = VK_NULL_HANDLE,
+			.BufferMemory = VK_NULL_HANDLE,
+		};
+
+		// uncached memory makes every host read go over the bus, cached memory is used whenever the device has it
+		const VkPhysicalDeviceMemoryProperties& physicalDeviceMemoryProperties = mPhysicalDevice.GetPhysicalDeviceMemoryProperties();
+		VkMemoryPropertyFlags memoryPropertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+		if (PhysicalDevice::GetMemoryTypeIndex(UINT32_MAX, memoryPropertyFlags, physicalDeviceMemoryProperties) == physicalDeviceMemoryProperties.memoryTypeCount)
+		{
+			memoryPropertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		}
+		// the cached type the buffer ends up in may or may not be coherent, it is invalidated before every read either way
+		const bool bIsCoherent = (memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+		Buffer::create(mDevice, createInfo, mPhysicalDevice, VK_BUFFER_USAGE_TRANSFER_DST_BIT, memoryPropertyFlags);
+		ReadbackBuffer readbackBuffer(createInfo, bIsCoherent);
+		return std::make_unique<ReadbackBuffer>(std::move(readbackBuffer));
+	}
+
 	VkShaderModule Device::CreateShaderModule(const char* name, const std::filesystem::path& path) noexcept
 	{
 		VkResult vr = VK_SUCCESS;
@@ -361,23 +450,24 @@ namespace iiixrlab::graphics
 		uint32_t imageIndex = swapChain.GetFramesCount();
 		while ((vr = vkAcquireNextImageKHR(mDevice, swapChain.mSwapChain, UINT64_MAX, semaphore, fence, &imageIndex)) == VK_NOT_READY)
 		{
-			YieldProcessor();
+			std::this_thread::yield();
 		}
 
 		assert(vr == VK_SUCCESS && imageIndex < swapChain.GetFramesCount());
 		return imageIndex;
 	}
 
-	VkCommandBuffer Device::AllocateCommandBuffer(const char* name) noexcept
+	VkCommandBuffer Device::AllocateCommandBuffer(const char* name, const VkCommandPool commandPool) noexcept
 	{
 		VkResult vr = VK_SUCCESS;
 		assert(name != nullptr);
+		assert(commandPool != VK_NULL_HANDLE);
 		VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
 		VkCommandBufferAllocateInfo commandBufferAllocateInfo =
 		{
 			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
 			.pNext = nullptr,
-			.commandPool = mCommandPool->GetCommandPool(),
+			.commandPool = commandPool,
 			.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
 			.commandBufferCount = 1,
 		};
@@ -431,16 +521,282 @@ namespace iiixrlab::graphics
         }
 	}
 
-	std::unique_ptr<ConstantBuffer> Device::CreateConstantBuffer(const char* name, const uint32_t bufferSize) noexcept
+	void Device::BindDescriptorSet(BindlessDescriptorSet& bindlessDescriptorSet, const uint32_t index, const Buffer& buffer) noexcept
+	{
+		const VkDescriptorBufferInfo& descriptorBufferInfo = buffer.GetDescriptorBufferInfo();
+		VkWriteDescriptorSet writeDescriptorSet =
+		{
+			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+			.pNext = nullptr,
+			.dstSet = bindlessDescriptorSet.mDescriptorSet,
+			.dstBinding = static_cast<uint32_t>(BindlessDescriptorSet::eType::STORAGE_BUFFER),
+			.dstArrayElement = index,
+			.descriptorCount = 1,
+			.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			.pBufferInfo = &descriptorBufferInfo,
+		};
+
+		vkUpdateDescriptorSets(mDevice, 1, &writeDescriptorSet, 0, nullptr);
+	}
+
+	void Device::BindDescriptorSet(BindlessDescriptorSet& bindlessDescriptorSet, const uint32_t index, const Texture& texture, const uint8_t type) noexcept
+	{
+		const bool bIsStorageImage = type == static_cast<uint8_t>(BindlessDescriptorSet::eType::STORAGE_IMAGE);
+		const VkDescriptorImageInfo descriptorImageInfo =
+		{
+			.sampler = VK_NULL_HANDLE,
+			.imageView = bIsStorageImage ? texture.GetStorageViewOrNull() : texture.GetSampledViewOrNull(),
+			.imageLayout = bIsStorageImage ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+		};
+		assert(descriptorImageInfo.imageView != VK_NULL_HANDLE);
+
+		VkWriteDescriptorSet writeDescriptorSet =
+		{
+			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+			.pNext = nullptr,
+			.dstSet = bindlessDescriptorSet.mDescriptorSet,
+			.dstBinding = type,
+			.dstArrayElement = index,
+			.descriptorCount = 1,
+			.descriptorType = bIsStorageImage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+			.pImageInfo = &descriptorImageInfo,
+		};
+
+		vkUpdateDescriptorSets(mDevice, 1, &writeDescriptorSet, 0, nullptr);
+	}
+
+	std::unique_ptr<BindlessDescriptorSet> Device::CreateBindlessDescriptorSet(const char* name) noexcept
+	{
+		VkResult vr = VK_SUCCESS;
+		assert(name != nullptr);
+
+		constexpr const uint8_t TYPES_COUNT = static_cast<uint8_t>(BindlessDescriptorSet::eType::COUNT);
+		constexpr const VkDescriptorType DESCRIPTOR_TYPES[TYPES_COUNT] = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE };
+
+		// every binding is visible to every stage, so the counts of all of them add up against the per stage limit too
+		const VkPhysicalDeviceDescriptorIndexingProperties& descriptorIndexingProperties = mPhysicalDevice.GetDescriptorIndexingProperties();
+		const uint32_t maxDescriptorsCounts[TYPES_COUNT] =
+		{
+			std::min(descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers, descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers),
+			std::min(descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages, descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSampledImages),
+			std::min(descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindStorageImages, descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindStorageImages),
+		};
+		std::array<uint32_t, TYPES_COUNT> descriptorsCounts;
+		uint64_t descriptorsCountsSum = 0;
+		for (uint8_t typeIndex = 0; typeIndex < TYPES_COUNT; ++typeIndex)
+		{
+			descriptorsCounts[typeIndex] = std::min(BindlessDescriptorSet::MAX_DESCRIPTORS_COUNTS[typeIndex], maxDescriptorsCounts[typeIndex]);
+			descriptorsCountsSum += descriptorsCounts[typeIndex];
+		}
+		if (descriptorsCountsSum > descriptorIndexingProperties.maxPerStageUpdateAfterBindResources)
+		{
+			for (uint32_t& descriptorsCount : descriptorsCounts)
+			{
+				descriptorsCount = static_cast<uint32_t>(descriptorsCount * static_cast<uint64_t>(descriptorIndexingProperties.maxPerStageUpdateAfterBindResources) / descriptorsCountsSum);
+			}
+		}
+		for (uint8_t typeIndex = 0; typeIndex < TYPES_COUNT; ++typeIndex)
+		{
+			if (descriptorsCounts[typeIndex] < BindlessDescriptorSet::MAX_DESCRIPTORS_COUNTS[typeIndex])
+			{
+				std::cout << "Bindless descriptors of type " << static_cast<uint32_t>(typeIndex) << " are limited to " << descriptorsCounts[typeIndex] << " by the device.\n";
+			}
+		}
+
+		std::vector<VkDescriptorSetLayoutBinding> descriptorSetLayoutBindings;
+		std::vector<VkDescriptorBindingFlags> descriptorBindingFlags;
+		std::vector<VkDescriptorPoolSize> poolSizes;
+		descriptorSetLayoutBindings.reserve(TYPES_COUNT);
+		descriptorBindingFlags.reserve(TYPES_COUNT);
+		poolSizes.reserve(TYPES_COUNT);
+		for (uint8_t typeIndex = 0; typeIndex < TYPES_COUNT; ++typeIndex)
+		{
+			descriptorSetLayoutBindings.push_back(VkDescriptorSetLayoutBinding
+			{
+				.binding = typeIndex,
+				.descriptorType = DESCRIPTOR_TYPES[typeIndex],
+				.descriptorCount = descriptorsCounts[typeIndex],
+				.stageFlags = VK_SHADER_STAGE_ALL,
+				.pImmutableSamplers = nullptr,
+			});
+			descriptorBindingFlags.push_back(VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT);
+			poolSizes.push_back(VkDescriptorPoolSize
+			{
+				.type = DESCRIPTOR_TYPES[typeIndex],
+				.descriptorCount = descriptorsCounts[typeIndex],
+			});
+		}
+
+		BindlessDescriptorSet::CreateInfo createInfo =
+		{
+			.Device = *this,
+			.DescriptorPool = CreateDescriptorPool(name, 1, poolSizes, VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT),
+			.DescriptorSetLayout = VK_NULL_HANDLE,
+			.PipelineLayout = VK_NULL_HANDLE,
+			.DescriptorSet = VK_NULL_HANDLE,
+			.DescriptorsCounts = descriptorsCounts,
+		};
+
+		VkDescriptorSetLayoutBindingFlagsCreateInfo descriptorSetLayoutBindingFlagsCreateInfo =
+		{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+			.pNext = nullptr,
+			.bindingCount = static_cast<uint32_t>(descriptorBindingFlags.size()),
+			.pBindingFlags = descriptorBindingFlags.data(),
+		};
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo =
+		{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+			.pNext = &descriptorSetLayoutBindingFlagsCreateInfo,
+			.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+			.bindingCount = static_cast<uint32_t>(descriptorSetLayoutBindings.size()),
+			.pBindings = descriptorSetLayoutBindings.data(),
+		};
+		vr = vkCreateDescriptorSetLayout(mDevice, &descriptorSetLayoutCreateInfo, nullptr, &createInfo.DescriptorSetLayout);
+		assert(vr == VK_SUCCESS && createInfo.DescriptorSetLayout != VK_NULL_HANDLE);
+#if defined(_DEBUG)
+		SetDebugName(name, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, createInfo.DescriptorSetLayout);
+#endif	// defined(_DEBUG)
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo =
+		{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+			.pNext = nullptr,
+			.descriptorPool = createInfo.DescriptorPool->mDescriptorPool,
+			.descriptorSetCount = 1,
+			.pSetLayouts = &createInfo.DescriptorSetLayout,
+		};
+		vr = vkAllocateDescriptorSets(mDevice, &descriptorSetAllocateInfo, &createInfo.DescriptorSet);
+		assert(vr == VK_SUCCESS && createInfo.DescriptorSet != VK_NULL_HANDLE);
+#if defined(_DEBUG)
+		SetDebugName(name, VK_OBJECT_TYPE_DESCRIPTOR_SET, createInfo.DescriptorSet);
+#endif	// defined(_DEBUG)
+
+		// layout compatible with every pipeline layout for the bindless set, used to bind it before any pipeline
+		const VkPushConstantRange pushConstantRange =
+		{
+			.stageFlags = VK_SHADER_STAGE_ALL,
+			.offset = 0,
+			.size = PUSH_CONSTANTS_SIZE,
+		};
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo =
+		{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.setLayoutCount = 1,
+			.pSetLayouts = &createInfo.DescriptorSetLayout,
+			.pushConstantRangeCount = 1,
+			.pPushConstantRanges = &pushConstantRange,
+		};
+		vr = vkCreatePipelineLayout(mDevice, &pipelineLayoutCreateInfo, nullptr, &createInfo.PipelineLayout);
+		assert(vr == VK_SUCCESS && createInfo.PipelineLayout != VK_NULL_HANDLE);
+#if defined(_DEBUG)
+		SetDebugName(name, VK_OBJECT_TYPE_PIPELINE_LAYOUT, createInfo.PipelineLayout);
+#endif	// defined(_DEBUG)
+
+		BindlessDescriptorSet bindlessDescriptorSet(createInfo);
+		return std::make_unique<BindlessDescriptorSet>(std::move(bindlessDescriptorSet));
+	}
+
+	std::unique_ptr<CommandPool> Device::CreateCommandPool(const char* name, const uint32_t queueFamilyIndex) noexcept
+	{
+		VkResult vr = VK_SUCCESS;
+		assert(name != nullptr);
+
+		CommandPool::CreateInfo commandPoolCreateInfo =
+		{
+			.Device = *this,
+			.CommandPool = VK_NULL_HANDLE,
+			.QueueFamilyIndex = queueFamilyIndex,
+		};
+
+		VkCommandPoolCreateInfo vkCommandPoolCreateInfo =
+		{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+			.queueFamilyIndex = queueFamilyIndex,
+		};
+		vr = vkCreateCommandPool(mDevice, &vkCommandPoolCreateInfo, nullptr, &commandPoolCreateInfo.CommandPool);
+		assert(vr == VK_SUCCESS && commandPoolCreateInfo.CommandPool != VK_NULL_HANDLE);
+#if defined(_DEBUG)
+		SetDebugName(name, VK_OBJECT_TYPE_COMMAND_POOL, commandPoolCreateInfo.CommandPool);
+#endif	// defined(_DEBUG)
+		return std::make_unique<CommandPool>(commandPoolCreateInfo);
+	}
+
+	std::unique_ptr<Pipeline> Device::CreateComputePipeline(const ComputePipelineCreateInfo& computePipelineCreateInfo) noexcept
 	{
+		assert(computePipelineCreateInfo.Name != nullptr);
+
+		VkResult vr = VK_SUCCESS;
+
+		ShaderManager& shaderManager = ShaderManager::GetInstance();
+		std::unique_ptr<Shader>* ppShader = shaderManager.GetShaderOrNull(computePipelineCreateInfo.ShaderName);
+		if (ppShader == nullptr || (*ppShader)->GetType() != Shader::eType::COMPUTE)
+		{
+			std::cerr << "Compute shader: " << computePipelineCreateInfo.ShaderName << " is not found.\n";
+			IIIXRLAB_DEBUG_BREAK();
+			return nullptr;
+		}
+
+		Pipeline::CreateInfo createInfo =
+		{
+			.Device = *this,
+			.Name = computePipelineCreateInfo.Name,
+			.BindPoint = VK_PIPELINE_BIND_POINT_COMPUTE,
+		};
+
+		createInfo.PipelineLayout = createPipelineLayout(createInfo.Name.c_str(), computePipelineCreateInfo.DescriptorSetLayoutBindings, createInfo.DescriptorSetLayouts, createInfo.DescriptorSets);
+
+		VkComputePipelineCreateInfo vkComputePipelineCreateInfo =
+		{
+			.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.stage = VkPipelineShaderStageCreateInfo
+			{
+				.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+				.pNext = nullptr,
+				.flags = 0,
+				.stage = VK_SHADER_STAGE_COMPUTE_BIT,
+				.module = (*ppShader)->GetShaderModule(),
+				.pName = "main",	// Slang always uses "main"
+			},
+			.layout = createInfo.PipelineLayout,
+			.basePipelineHandle = VK_NULL_HANDLE,
+			.basePipelineIndex = 0,
+		};
+
+		vr = vkCreateComputePipelines(mDevice, VK_NULL_HANDLE, 1, &vkComputePipelineCreateInfo, nullptr, &createInfo.Pipeline);
+		assert(vr == VK_SUCCESS && createInfo.Pipeline != VK_NULL_HANDLE);
+#if defined(_DEBUG)
+		SetDebugName(createInfo.Name.c_str(), VK_OBJECT_TYPE_PIPELINE, createInfo.Pipeline);
+#endif	// defined(_DEBUG)
+
+		Pipeline pipeline(createInfo);
+		return std::make_unique<Pipeline>(std::move(pipeline));
+	}
+
+	std::unique_ptr<ConstantBuffer> Device::CreateConstantBuffer(const char* name, const uint32_t bufferSize, const uint32_t framesCount) noexcept
+	{
+		assert(framesCount > 0);
+
+		// every frame owns one slot of the ring, so each slot has to start at a valid dynamic offset
+		const VkDeviceSize alignment = mPhysicalDevice.GetPhysicalDeviceProperties().limits.minUniformBufferOffsetAlignment;
+		const uint32_t alignedBufferSize = alignment > 0 ? static_cast<uint32_t>((bufferSize + alignment - 1) / alignment * alignment) : bufferSize;
+
 		Buffer::CreateInfo createInfo =
 		{
 			.GpuResourceCreateInfo = GpuResource::CreateInfo
 			{
 				.Device = *this,
 				.Name = name,
-				.Size = 1,
-				.Stride = bufferSize,
+				.Size = framesCount,
+				.Stride = alignedBufferSize,
 			},
 			.Buffer = VK_NULL_HANDLE,
 			.BufferMemory = VK_NULL_HANDLE,
@@ -450,7 +806,7 @@ namespace iiixrlab::graphics
 		return std::make_unique<ConstantBuffer>(std::move(constantBuffer));
 	}
 
-	std::unique_ptr<DescriptorPool> Device::CreateDescriptorPool(const char* name, const uint32_t maxSets, const std::vector<VkDescriptorPoolSize>& poolSizes) noexcept
+	std::unique_ptr<DescriptorPool> Device::CreateDescriptorPool(const char* name, const uint32_t maxSets, const std::vector<VkDescriptorPoolSize>& poolSizes, const VkDescriptorPoolCreateFlags flags) noexcept
 	{
 		VkResult vr = VK_SUCCESS;
 		assert(name != nullptr);
@@ -465,7 +821,7 @@ namespace iiixrlab::graphics
 		{
 			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
 			.pNext = nullptr,
-			.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
+			.flags = flags,
 			.maxSets = maxSets,
 			.poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
 			.pPoolSizes = poolSizes.data(),
@@ -527,6 +883,33 @@ namespace iiixrlab::graphics
 		return imageView;
 	}
 
+	VkSemaphore Device::CreateTimelineSemaphore(const char* name, const uint64_t initialValue) noexcept
+	{
+		VkResult vr = VK_SUCCESS;
+		assert(name != nullptr);
+		VkSemaphore semaphore = VK_NULL_HANDLE;
+		VkSemaphoreTypeCreateInfo semaphoreTypeCreateInfo =
+		{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+			.pNext = nullptr,
+			.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+			.initialValue = initialValue,
+		};
+		VkSemaphoreCreateInfo semaphoreCreateInfo =
+		{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+			.pNext = &semaphoreTypeCreateInfo,
+			.flags = 0,
+		};
+		vr = vkCreateSemaphore(mDevice, &semaphoreCreateInfo, nullptr, &semaphore);
+		assert(vr == VK_SUCCESS && semaphore != VK_NULL_HANDLE);
+#if defined(_DEBUG)
+		SetDebugName(name, VK_OBJECT_TYPE_SEMAPHORE, semaphore);
+#endif	// defined(_DEBUG)
+
+		return semaphore;
+	}
+
 	VkSemaphore Device::CreateSemaphore(const char* name) noexcept
 	{
 		VkResult vr = VK_SUCCESS;
@@ -556,11 +939,12 @@ namespace iiixrlab::graphics
 			.pNext = nullptr,
 			.dstSet = descriptorSet.mDescriptorSet,
 			.descriptorCount = 1,
-			.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+			.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
 			.pBufferInfo = &descriptorBufferInfo,
 		};
 
 		vkUpdateDescriptorSets(mDevice, 1, &writerDescriptorSet, 0, nullptr);
+		descriptorSet.mDynamicOffsetStride = constantBuffer.GetStride();
 	}
 
 	std::unique_ptr<StagingBuffer> Device::CreateStagingBuffer(const char* name, const uint32_t stagingBufferSize) noexcept
@@ -582,6 +966,25 @@ namespace iiixrlab::graphics
 		return std::make_unique<StagingBuffer>(std::move(stagingBuffer));
 	}
 
+	std::unique_ptr<StorageBuffer> Device::CreateStorageBuffer(const char* name, const uint32_t stride, const uint32_t count) noexcept
+	{
+		Buffer::CreateInfo createInfo =
+		{
+			.GpuResourceCreateInfo = GpuResource::CreateInfo
+			{
+				.Device = *this,
+				.Name = name,
+				.Size = count,
+				.Stride = stride,
+			},
+			.Buffer = VK_NULL_HANDLE,
+			.BufferMemory = VK_NULL_HANDLE,
+		};
+		Buffer::create(mDevice, createInfo, mPhysicalDevice, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true);
+		StorageBuffer storageBuffer(createInfo);
+		return std::make_unique<StorageBuffer>(std::move(storageBuffer));
+	}
+
 	std::unique_ptr<Texture> Device::CreateTexture(const TextureCreateInfo& textureCreateInfo) noexcept
 	{
 		VkResult vr = VK_SUCCESS;
@@ -590,6 +993,7 @@ namespace iiixrlab::graphics
 			.Device = *this,
 			.Image = textureCreateInfo.ImageOrNull,
 			.Format = textureCreateInfo.Format,
+			.Extent = textureCreateInfo.Extent,
 			.bIsBackBuffer = textureCreateInfo.ImageOrNull != VK_NULL_HANDLE,
 		};
 
@@ -613,6 +1017,10 @@ namespace iiixrlab::graphics
 			{
 				usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
 			}
+			if (textureCreateInfo.Usage & static_cast<uint8_t>(Texture::eUsageType::TRANSFER_SRC))
+			{
+				usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+			}
 
 			VkImageCreateInfo imageCreateInfo =
 			{
@@ -656,29 +1064,29 @@ namespace iiixrlab::graphics
 #if defined(_DEBUG)
 			SetDebugName(textureCreateInfo.Name, VK_OBJECT_TYPE_IMAGE, createInfo.Image);
 
-			sprintf_s(debugName.data(), debugName.size(), "DeviceMemory[%s]", textureCreateInfo.Name);
+			snprintf(debugName.data(), debugName.size(), "DeviceMemory[%s]", textureCreateInfo.Name);
 			SetDebugName(debugName.data(), VK_OBJECT_TYPE_DEVICE_MEMORY, createInfo.DeviceMemory);
 #endif	// defined(_DEBUG)
 		}
 
 		if (textureCreateInfo.Usage & static_cast<uint8_t>(Texture::eUsageType::SAMPLED))
 		{
-			sprintf_s(debugName.data(), debugName.size(), "Sampled[%s]", textureCreateInfo.Name);
+			snprintf(debugName.data(), debugName.size(), "Sampled[%s]", textureCreateInfo.Name);
 			createInfo.SampledViewOrNull = CreateImageView(debugName.data(), createInfo.Image, createInfo.Format, textureCreateInfo.Usage);
 		}
 		if (textureCreateInfo.Usage & static_cast<uint8_t>(Texture::eUsageType::STORAGE))
 		{
-			sprintf_s(debugName.data(), debugName.size(), "Storage[%s]", textureCreateInfo.Name);
+			snprintf(debugName.data(), debugName.size(), "Storage[%s]", textureCreateInfo.Name);
 			createInfo.StorageViewOrNull = CreateImageView(debugName.data(), createInfo.Image, createInfo.Format, textureCreateInfo.Usage);
 		}
 		if (textureCreateInfo.Usage & static_cast<uint8_t>(Texture::eUsageType::COLOR_ATTACHMENT))
 		{
-			sprintf_s(debugName.data(), debugName.size(), "ColorAttachment[%s]", textureCreateInfo.Name);
+			snprintf(debugName.data(), debugName.size(), "ColorAttachment[%s]", textureCreateInfo.Name);
 			createInfo.ColorAttachmentViewOrNull = CreateImageView(debugName.data(), createInfo.Image, createInfo.Format, textureCreateInfo.Usage);
 		}
 		if (textureCreateInfo.Usage & static_cast<uint8_t>(Texture::eUsageType::DEPTH_STENCIL))
 		{
-			sprintf_s(debugName.data(), debugName.size(), "DepthAttachment[%s]", textureCreateInfo.Name);
+			snprintf(debugName.data(), debugName.size(), "DepthAttachment[%s]", textureCreateInfo.Name);
 			createInfo.DepthAttachmentViewOrNull = CreateImageView(debugName.data(), createInfo.Image, createInfo.Format, textureCreateInfo.Usage);
 		}
 
@@ -699,7 +1107,7 @@ namespace iiixrlab::graphics
 			.Buffer = VK_NULL_HANDLE,
 			.BufferMemory = VK_NULL_HANDLE,
 		};
-		Buffer::create(mDevice, createInfo, mPhysicalDevice, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		Buffer::create(mDevice, createInfo, mPhysicalDevice, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 		VertexBuffer vertexBuffer(createInfo);
 		return std::make_unique<VertexBuffer>(std::move(vertexBuffer));
 	}
@@ -722,11 +1130,11 @@ namespace iiixrlab::graphics
 		descriptorSets.clear();
 	}
 
-	void Device::DestroyCommandBuffer(VkCommandBuffer& commandBuffer) noexcept
+	void Device::DestroyCommandBuffer(const VkCommandPool commandPool, VkCommandBuffer& commandBuffer) noexcept
 	{
 		if (commandBuffer != VK_NULL_HANDLE)
 		{
-			vkFreeCommandBuffers(mDevice, mCommandPool->GetCommandPool(), 1, &commandBuffer);
+			vkFreeCommandBuffers(mDevice, commandPool, 1, &commandBuffer);
 			commandBuffer = VK_NULL_HANDLE;
 		}
 	}
@@ -803,6 +1211,15 @@ namespace iiixrlab::graphics
 		}
 	}
 
+	void Device::DestroyQueryPool(VkQueryPool& queryPool) noexcept
+	{
+		if (queryPool != VK_NULL_HANDLE)
+		{
+			vkDestroyQueryPool(mDevice, queryPool, nullptr);
+			queryPool = VK_NULL_HANDLE;
+		}
+	}
+
 	void Device::DestroySemaphore(VkSemaphore& semaphore) noexcept
 	{
 		if (semaphore != VK_NULL_HANDLE)
@@ -848,31 +1265,81 @@ namespace iiixrlab::graphics
 		}
 	}
 
-	CommandPool& Device::InitializeCommandPool() noexcept
+	bool Device::GetCalibratedTimestamps(uint64_t& outDeviceTimestamp, int64_t& outHostTimestamp) const noexcept
 	{
-		VkResult vr = VK_SUCCESS;
-		assert(mCommandPool == nullptr);
+		if (mPhysicalDevice.IsCalibratedTimestampsEnabled() == false)
+		{
+			return false;
+		}
 
-		CommandPool::CreateInfo commandPoolCreateInfo =
+		const VkCalibratedTimestampInfoEXT calibratedTimestampInfos[2] =
 		{
-			.Device = *this,
-			.CommandPool = VK_NULL_HANDLE,
+			{
+				.sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT,
+				.pNext = nullptr,
+				.timeDomain = VK_TIME_DOMAIN_DEVICE_EXT,
+			},
+			{
+				.sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT,
+				.pNext = nullptr,
+				.timeDomain = PhysicalDevice::HOST_TIME_DOMAIN,
+			},
 		};
+		uint64_t timestamps[2] = { 0, 0 };
+		uint64_t maxDeviation = 0;
+		VkResult vr = vkGetCalibratedTimestampsEXT(mDevice, 2, calibratedTimestampInfos, timestamps, &maxDeviation);
+		assert(vr == VK_SUCCESS);
 
-		VkCommandPoolCreateInfo vkCommandPoolCreateInfo =
+		outDeviceTimestamp = timestamps[0];
+#if defined(_WIN32)
+		// performance counter ticks, converted the way steady_clock does
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency(&frequency);
+		const int64_t ticks = static_cast<int64_t>(timestamps[1]);
+		outHostTimestamp = (ticks / frequency.QuadPart) * 1000000000 + (ticks % frequency.QuadPart) * 1000000000 / frequency.QuadPart;
+#else	// NOT defined(_WIN32)
+		outHostTimestamp = static_cast<int64_t>(timestamps[1]);
+#endif	// NOT defined(_WIN32)
+		return true;
+	}
+
+	VkResult Device::GetQueryPoolResults(const VkQueryPool queryPool, const uint32_t firstQuery, const uint32_t queriesCount, const size_t dataSize, void* data, const VkDeviceSize stride, const VkQueryResultFlags flags) const noexcept
+	{
+		assert(queryPool != VK_NULL_HANDLE);
+		assert((flags & VK_QUERY_RESULT_WAIT_BIT) == 0);
+		VkResult vr = vkGetQueryPoolResults(mDevice, queryPool, firstQuery, queriesCount, dataSize, data, stride, flags);
+		assert(vr == VK_SUCCESS || vr == VK_NOT_READY);
+		return vr;
+	}
+
+	uint64_t Device::GetSemaphoreCounterValue(const VkSemaphore timelineSemaphore) const noexcept
+	{
+		assert(timelineSemaphore != VK_NULL_HANDLE);
+		uint64_t value = 0;
+		VkResult vr = vkGetSemaphoreCounterValue(mDevice, timelineSemaphore, &value);
+		assert(vr == VK_SUCCESS);
+		return value;
+	}
+
+	CommandPool& Device::InitializeCommandPool() noexcept
+	{
+		assert(mCommandPool == nullptr);
+		mCommandPool = CreateCommandPool("Command Pool", mPhysicalDevice.GetQueueFamilyIndex());
+		return *mCommandPool;
+	}
+
+	void Device::InvalidateMappedMemory(const Buffer& buffer) noexcept
+	{
+		const VkMappedMemoryRange mappedMemoryRange =
 		{
-			.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+			.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
 			.pNext = nullptr,
-			.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
-			.queueFamilyIndex = mPhysicalDevice.GetQueueFamilyIndex(),
+			.memory = buffer.mBufferMemory,
+			.offset = 0,
+			.size = VK_WHOLE_SIZE,
 		};
-		vr = vkCreateCommandPool(mDevice, &vkCommandPoolCreateInfo, nullptr, &commandPoolCreateInfo.CommandPool);
-		assert(vr == VK_SUCCESS && commandPoolCreateInfo.CommandPool != VK_NULL_HANDLE);
-#if defined(_DEBUG)
-		SetDebugName("Command Pool", VK_OBJECT_TYPE_COMMAND_POOL, commandPoolCreateInfo.CommandPool);
-#endif	// defined(_DEBUG)
-		mCommandPool = std::make_unique<CommandPool>(commandPoolCreateInfo);
-		return *mCommandPool;
+		VkResult vr = vkInvalidateMappedMemoryRanges(mDevice, 1, &mappedMemoryRange);
+		assert(vr == VK_SUCCESS);
 	}
 
 	void Device::MapMemory(Buffer& buffer, void** data) noexcept
@@ -888,6 +1355,12 @@ namespace iiixrlab::graphics
 		assert(vr == VK_SUCCESS);
 	}
 
+	void Device::ResetQueryPool(const VkQueryPool queryPool, const uint32_t firstQuery, const uint32_t queriesCount) noexcept
+	{
+		assert(queryPool != VK_NULL_HANDLE);
+		vkResetQueryPool(mDevice, queryPool, firstQuery, queriesCount);
+	}
+
 	void Device::WaitForFence(VkFence& fence) noexcept
 	{
 		assert(fence != VK_NULL_HANDLE);
@@ -895,6 +1368,93 @@ namespace iiixrlab::graphics
 		assert(vr == VK_SUCCESS);
 	}
 
+	void Device::WaitForSemaphore(const VkSemaphore timelineSemaphore, const uint64_t value) noexcept
+	{
+		assert(timelineSemaphore != VK_NULL_HANDLE);
+		VkSemaphoreWaitInfo semaphoreWaitInfo =
+		{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.semaphoreCount = 1,
+			.pSemaphores = &timelineSemaphore,
+			.pValues = &value,
+		};
+		VkResult vr = vkWaitSemaphores(mDevice, &semaphoreWaitInfo, UINT64_MAX);
+		assert(vr == VK_SUCCESS);
+	}
+
+	VkPipelineLayout Device::createPipelineLayout(const char* name, const std::vector<VkDescriptorSetLayoutBinding>& descriptorSetLayoutBindings, std::vector<VkDescriptorSetLayout>& outDescriptorSetLayouts, std::vector<std::unique_ptr<DescriptorSet>>& outDescriptorSets) noexcept
+	{
+		VkResult vr = VK_SUCCESS;
+
+		outDescriptorSetLayouts.resize(1, VK_NULL_HANDLE);
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo =
+		{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.bindingCount = static_cast<uint32_t>(descriptorSetLayoutBindings.size()),
+			.pBindings = descriptorSetLayoutBindings.data(),
+		};
+		vr = vkCreateDescriptorSetLayout(mDevice, &descriptorSetLayoutCreateInfo, nullptr, &outDescriptorSetLayouts[0]);
+		assert(vr == VK_SUCCESS && outDescriptorSetLayouts[0] != VK_NULL_HANDLE);
+#if defined(_DEBUG)
+		SetDebugName(name, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, outDescriptorSetLayouts[0]);
+#endif	// defined(_DEBUG)
+
+		AllocateDescriptorSets(*mDescriptorPool, outDescriptorSets, outDescriptorSetLayouts[0], { name });
+
+		// the bindless set layout is owned by the device, so only the pipeline's own layouts are handed to the pipeline
+		std::vector<VkDescriptorSetLayout> descriptorSetLayouts = { mBindlessDescriptorSet->GetDescriptorSetLayout() };
+		descriptorSetLayouts.insert(descriptorSetLayouts.end(), outDescriptorSetLayouts.begin(), outDescriptorSetLayouts.end());
+
+		const VkPushConstantRange pushConstantRange =
+		{
+			.stageFlags = VK_SHADER_STAGE_ALL,
+			.offset = 0,
+			.size = PUSH_CONSTANTS_SIZE,
+		};
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo =
+		{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.setLayoutCount = static_cast<uint32_t>(descriptorSetLayouts.size()),
+			.pSetLayouts = descriptorSetLayouts.data(),
+			.pushConstantRangeCount = 1,
+			.pPushConstantRanges = &pushConstantRange,
+		};
+		VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+		vr = vkCreatePipelineLayout(mDevice, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout);
+		assert(vr == VK_SUCCESS && pipelineLayout != VK_NULL_HANDLE);
+#if defined(_DEBUG)
+		SetDebugName(name, VK_OBJECT_TYPE_PIPELINE_LAYOUT, pipelineLayout);
+#endif	// defined(_DEBUG)
+
+		return pipelineLayout;
+	}
+
+	void Device::initializeQueues(std::vector<std::unique_ptr<Queue>>& outQueues, const uint32_t queueFamilyIndex) noexcept
+	{
+		std::vector<VkQueue> queues;
+		getQueues(queues, mDevice, mPhysicalDevice.GetInstance().GetApiVersion(), queueFamilyIndex, mPhysicalDevice.GetQueueFamilyProperties(queueFamilyIndex));
+		const uint32_t queuesCount = static_cast<uint32_t>(queues.size());
+		outQueues.reserve(queuesCount);
+		for (uint32_t queueIndex = 0; queueIndex < queuesCount; ++queueIndex)
+		{
+			Queue::CreateInfo queueCreateInfo =
+			{
+				.Device = *this,
+				.Queue = queues[queueIndex],
+				.QueueFamilyIndex = queueFamilyIndex,
+				.QueueIndex = queueIndex,
+			};
+			outQueues.push_back(std::make_unique<Queue>(queueCreateInfo));
+		}
+	}
+
 	void Device::getQueues(std::vector<VkQueue>& outQueues, const VkDevice device, const uint32_t apiVersion, const uint32_t mainQueueFamilyPropertyIndex, const VkQueueFamilyProperties2& queueFamilyProperties) noexcept
 	{
 		for (uint32_t queueIndex = 0; queueIndex < queueFamilyProperties.queueFamilyProperties.queueCount; ++queueIndex)
@@ -920,7 +1480,7 @@ namespace iiixrlab::graphics
 			assert(queue != VK_NULL_HANDLE);
 #if defined(_DEBUG)
 			std::vector<char> queueName(32);
-			sprintf_s(queueName.data(), 32, "Queue[%u]", queueIndex);
+			snprintf(queueName.data(), 32, "Queue[%u]", queueIndex);
 			setDebugName(queueName.data(), device, VK_OBJECT_TYPE_QUEUE, queue);
 #endif	// defined(_DEBUG)
 
@@ -8,64 +8,138 @@
 
 namespace iiixrlab::graphics
 {
-	FrameResource::FrameResource(const CreateInfo& createInfo) noexcept
+	FrameResource::FrameResource(CreateInfo& createInfo) noexcept
 		: mDevice(createInfo.Device)
-		, mSwapChain(createInfo.SwapChain)
+		, mSwapChainOrNull(createInfo.SwapChainOrNull)
+		, mOffscreenColorOrNull(std::move(createInfo.OffscreenColorOrNull))
+		, mOffscreenDepthOrNull(std::move(createInfo.OffscreenDepthOrNull))
 		, mCommandBuffer(createInfo.CommandBuffer)
-		, mBackBuffer(createInfo.BackBuffer)
-		, mDepthBuffer(createInfo.DepthBuffer)
-		, mPresentCompleteSemaphore(createInfo.Device.CreateSemaphore("Present Complete Semaphore"))
-		, mRenderFinishedSemaphore(createInfo.Device.CreateSemaphore("Render Finished Semaphore"))
-		, mWaitFence(createInfo.Device.CreateFence("Wait Fence"))
+		, mComputeCommandBuffer(createInfo.ComputeCommandBuffer)
+		, mPresentCompleteSemaphore(createInfo.SwapChainOrNull != nullptr ? createInfo.Device.CreateSemaphore("Present Complete Semaphore") : VK_NULL_HANDLE)
+		, mTimelineSemaphore(createInfo.TimelineSemaphore)
+		, mTimelineValue(0)
 		, mFrameIndex(createInfo.FrameIndex)
 		, mFramesCount(createInfo.FramesCount)
+		, mBackBufferIndex(UINT32_MAX)
+		, mWaitSemaphoreSubmitInfos()
+		, mReadbackBufferOrNull(nullptr)
 	{
-		assert(mPresentCompleteSemaphore != VK_NULL_HANDLE);
-		assert(mRenderFinishedSemaphore != VK_NULL_HANDLE);
-		assert(mWaitFence != VK_NULL_HANDLE);
+		assert(mSwapChainOrNull == nullptr || mPresentCompleteSemaphore != VK_NULL_HANDLE);
+		assert(mSwapChainOrNull != nullptr || (mOffscreenColorOrNull != nullptr && mOffscreenDepthOrNull != nullptr));
+		assert(mTimelineSemaphore != VK_NULL_HANDLE);
 	}
 
 	FrameResource::FrameResource(FrameResource&& other) noexcept
 		: mDevice(other.mDevice)
-		, mSwapChain(other.mSwapChain)
+		, mSwapChainOrNull(other.mSwapChainOrNull)
+		, mOffscreenColorOrNull(std::move(other.mOffscreenColorOrNull))
+		, mOffscreenDepthOrNull(std::move(other.mOffscreenDepthOrNull))
 		, mCommandBuffer(other.mCommandBuffer)
-		, mBackBuffer(other.mBackBuffer)
-		, mDepthBuffer(other.mDepthBuffer)
+		, mComputeCommandBuffer(other.mComputeCommandBuffer)
 		, mPresentCompleteSemaphore(other.mPresentCompleteSemaphore)
-		, mRenderFinishedSemaphore(other.mRenderFinishedSemaphore)
-		, mWaitFence(other.mWaitFence)
+		, mTimelineSemaphore(other.mTimelineSemaphore)
+		, mTimelineValue(other.mTimelineValue)
 		, mFrameIndex(other.mFrameIndex)
 		, mFramesCount(other.mFramesCount)
+		, mBackBufferIndex(other.mBackBufferIndex)
+		, mWaitSemaphoreSubmitInfos(std::move(other.mWaitSemaphoreSubmitInfos))
+		, mReadbackBufferOrNull(other.mReadbackBufferOrNull)
 	{
+		other.mSwapChainOrNull = nullptr;
 		other.mPresentCompleteSemaphore = VK_NULL_HANDLE;
-		other.mRenderFinishedSemaphore = VK_NULL_HANDLE;
-		other.mWaitFence = VK_NULL_HANDLE;
+		other.mTimelineSemaphore = VK_NULL_HANDLE;
+		other.mTimelineValue = 0;
 		other.mFrameIndex = UINT32_MAX;
 		other.mFramesCount = UINT32_MAX - 1;
+		other.mBackBufferIndex = UINT32_MAX;
+		other.mReadbackBufferOrNull = nullptr;
 	}
 
 	FrameResource::~FrameResource() noexcept
 	{
-		Wait();
-		mDevice.DestroyFence(mWaitFence);
-		mDevice.DestroySemaphore(mRenderFinishedSemaphore);
+		if (mTimelineSemaphore != VK_NULL_HANDLE)
+		{
+			Wait();
+		}
 		mDevice.DestroySemaphore(mPresentCompleteSemaphore);
+		mOffscreenColorOrNull.reset();
+		mOffscreenDepthOrNull.reset();
 	}
 
-	void FrameResource::Begin() noexcept
+	void FrameResource::AddWaitSemaphore(const VkSemaphore semaphore, const uint64_t value, const VkPipelineStageFlags2 stageMask) noexcept
 	{
+		assert(semaphore != VK_NULL_HANDLE);
+		mWaitSemaphoreSubmitInfos.push_back(
+		{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+			.pNext = nullptr,
+			.semaphore = semaphore,
+			.value = value,
+			.stageMask = stageMask,
+			.deviceIndex = 0,
+		});
+	}
+
+	void FrameResource::Begin(const uint32_t backBufferIndex) noexcept
+	{
+		assert(mSwapChainOrNull == nullptr || backBufferIndex < mSwapChainOrNull->GetFramesCount());
+		mBackBufferIndex = backBufferIndex;
+		mWaitSemaphoreSubmitInfos.clear();
+
 		mCommandBuffer.Reset();
 		mCommandBuffer.Begin(*this);
 	}
 
+	void FrameResource::BeginCompute() noexcept
+	{
+		mComputeCommandBuffer.Reset();
+		mComputeCommandBuffer.BeginCompute(*this);
+	}
+
 	void FrameResource::End() noexcept
 	{
 		mCommandBuffer.End();
+		mReadbackBufferOrNull = nullptr;
+	}
+
+	void FrameResource::EndCompute() noexcept
+	{
+		mComputeCommandBuffer.End();
 	}
 
 	void FrameResource::Wait() noexcept
 	{
-		mDevice.WaitForFence(mWaitFence);
-		mDevice.ResetFence(mWaitFence);
+		mDevice.WaitForSemaphore(mTimelineSemaphore, mTimelineValue);
+	}
+
+	VkSemaphore FrameResource::GetRenderFinishedSemaphore() const noexcept
+	{
+		assert(mSwapChainOrNull != nullptr);
+		return mSwapChainOrNull->GetBackBuffer(mBackBufferIndex).RenderFinishedSemaphore;
+	}
+
+	Texture& FrameResource::GetBackBuffer() noexcept
+	{
+		return (mSwapChainOrNull == nullptr) ? *mOffscreenColorOrNull : *mSwapChainOrNull->GetBackBuffer(mBackBufferIndex).Color;
+	}
+
+	const Texture& FrameResource::GetBackBuffer() const noexcept
+	{
+		return (mSwapChainOrNull == nullptr) ? *mOffscreenColorOrNull : *mSwapChainOrNull->GetBackBuffer(mBackBufferIndex).Color;
+	}
+
+	Texture& FrameResource::GetDepthBuffer() noexcept
+	{
+		return (mSwapChainOrNull == nullptr) ? *mOffscreenDepthOrNull : *mSwapChainOrNull->GetBackBuffer(mBackBufferIndex).Depth;
+	}
+
+	const Texture& FrameResource::GetDepthBuffer() const noexcept
+	{
+		return (mSwapChainOrNull == nullptr) ? *mOffscreenDepthOrNull : *mSwapChainOrNull->GetBackBuffer(mBackBufferIndex).Depth;
+	}
+
+	VkExtent2D FrameResource::GetExtent() const noexcept
+	{
+		return (mSwapChainOrNull == nullptr) ? mOffscreenColorOrNull->GetExtent() : mSwapChainOrNull->GetExtent();
 	}
 } // namespace iiixrlab
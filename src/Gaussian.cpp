@@ -1,10 +1,14 @@
 #include "3dgs/scene/Gaussian.h"
 
 #include "3dgs/graphics/Device.h"
+#include "3dgs/graphics/PhysicalDevice.h"
 
 namespace iiixrlab::scene
 {
-	static std::vector<iiixrlab::math::Vector3f> GenerateSphereVertices(const float radius, const uint32_t slicesCount, const uint32_t stacksCount)
+	static constexpr const uint32_t SPHERE_SLICES_COUNT = 4;
+	static constexpr const uint32_t SPHERE_STACKS_COUNT = 4;
+
+	std::vector<iiixrlab::math::Vector3f> Gaussian::GenerateSphereVertices(const float radius, const uint32_t slicesCount, const uint32_t stacksCount) noexcept
 	{
 		std::vector<iiixrlab::math::Vector3f> vertices;
 
@@ -18,9 +22,9 @@ namespace iiixrlab::scene
 			for (uint32_t j = 0; j < slicesCount; ++j)
 			{
 				const float theta = static_cast<float>(2.0 * std::numbers::pi_v<double> * static_cast<double>(j) / static_cast<double>(slicesCount));
-				const float x = radius * std::sinf(phi) * std::cosf(theta);
-				const float y = radius * std::cosf(phi);
-				const float z = radius * std::sinf(phi) * std::sinf(theta);
+				const float x = radius * std::sin(phi) * std::cos(theta);
+				const float y = radius * std::cos(phi);
+				const float z = radius * std::sin(phi) * std::sin(theta);
 				vertices.push_back(iiixrlab::math::Vector3f{x, y, z});
 			}
 		}
@@ -72,6 +76,37 @@ namespace iiixrlab::scene
 		return mesh;
 	}
 
+	void Gaussian::PackInstanceInfos(const GaussianInfo& gaussianInfo, const uint32_t firstPointIndex, const uint32_t pointsCount, InstanceInfo* outInstanceInfos) noexcept
+	{
+		for (uint32_t i = firstPointIndex; i < firstPointIndex + pointsCount; ++i)
+		{
+			const uint32_t indexBy3 = i * 3;
+			const uint32_t indexBy4 = i * 4;
+			// const uint32_t indexBy45 = i * 45;
+
+			InstanceInfo instanceInfo =
+			{
+				.Position = iiixrlab::math::Vector3f{gaussianInfo.Positions[indexBy3], gaussianInfo.Positions[indexBy3 + 1], gaussianInfo.Positions[indexBy3 + 2]},
+				.ScaleInLogScale = iiixrlab::math::Vector3f{gaussianInfo.Scales[indexBy3], gaussianInfo.Scales[indexBy3 + 1], gaussianInfo.Scales[indexBy3 + 2]},
+				.Quaternion = iiixrlab::math::Vector4f{gaussianInfo.Rotations[indexBy4], gaussianInfo.Rotations[indexBy4 + 1], gaussianInfo.Rotations[indexBy4 + 2], gaussianInfo.Rotations[indexBy4 + 3]},
+				.ColorAsShDcComponentAndAlphaBeforeSigmoidActivision = iiixrlab::math::Vector4f{gaussianInfo.Colors[indexBy3], gaussianInfo.Colors[indexBy3 + 1], gaussianInfo.Colors[indexBy3 + 2], gaussianInfo.Alphas[i]},
+			};
+			// memcpy(instanceInfo.SphericalHarmonicsCoefficients.data(), &gaussianInfo.SphericalHarmonics[indexBy45], sizeof(float) * 45);
+			// the destination may be mapped memory without the alignment of InstanceInfo
+			memcpy(&outInstanceInfos[i - firstPointIndex], &instanceInfo, sizeof(InstanceInfo));
+		}
+	}
+
+	uint64_t Gaussian::GetVertexBufferSize(const uint32_t pointsCount, const uint32_t shDegree, const uint32_t shCodebookEntriesCount) noexcept
+	{
+		const uint64_t sphereVerticesSize = GenerateSphereVertices(1.0f, SPHERE_SLICES_COUNT, SPHERE_STACKS_COUNT).size() * sizeof(iiixrlab::math::Vector3f);
+		const uint64_t shCoefficientsCount = GetShCoefficientsCount(shDegree);
+		const uint64_t shSize = shCodebookEntriesCount > 0
+			? (pointsCount + 1ull) / 2 * sizeof(uint32_t) + shCodebookEntriesCount * shCoefficientsCount * sizeof(float)
+			: pointsCount * shCoefficientsCount * sizeof(float);
+		return sphereVerticesSize + pointsCount * sizeof(InstanceInfo) + shSize;
+	}
+
 	std::unique_ptr<Gaussian> Gaussian::Create(CreateInfo& createInfo) noexcept
 	{
 		iiixrlab::graphics::IRenderable::CreateInfo renderableCreateInfo =
@@ -79,41 +114,332 @@ namespace iiixrlab::scene
 			.Device = createInfo.Device,
 		};
 
-		std::vector<iiixrlab::math::Vector3f> sphereVertices = GenerateSphereVertices(1.0f, 4, 4);
-		const uint32_t vertexBufferSize = static_cast<uint32_t>(sphereVertices.size() * sizeof(iiixrlab::math::Vector3f) + createInfo.GaussianInfo.NumPoints * sizeof(InstanceInfo));
-		renderableCreateInfo.StagingBuffer = createInfo.Device.CreateStagingBuffer("Gaussian Vertex Buffer", vertexBufferSize);
+		const GaussianInfo& gaussianInfo = createInfo.GaussianInfo;
+		std::vector<iiixrlab::math::Vector3f> sphereVertices = GenerateSphereVertices(1.0f, SPHERE_SLICES_COUNT, SPHERE_STACKS_COUNT);
+		// 16 bit indices are read as pairs, which keeps the coefficients after them 4 byte aligned
+		const size_t shIndicesSize = (gaussianInfo.ShIndices.size() + 1) / 2 * sizeof(uint32_t);
+		// a shared codebook is uploaded once by the gaussian it belongs to
+		const std::vector<float>& shCoefficients = gaussianInfo.ShCodebook.empty() == true ? gaussianInfo.SphericalHarmonics : gaussianInfo.ShCodebook;
+		const size_t shCoefficientsSize = createInfo.ShCodebookGaussianOrNull == nullptr ? shCoefficients.size() * sizeof(float) : 0;
+		const uint64_t vertexBufferSize = sphereVertices.size() * sizeof(iiixrlab::math::Vector3f) + static_cast<uint64_t>(gaussianInfo.NumPoints) * sizeof(InstanceInfo) + shIndicesSize + shCoefficientsSize;
+		// the shader reads the vertex buffer through a storage buffer descriptor
+		const uint64_t maxStorageBufferRange = createInfo.Device.GetPhysicalDevice().GetPhysicalDeviceProperties().limits.maxStorageBufferRange;
+		if (vertexBufferSize > maxStorageBufferRange)
+		{
+			std::cerr << "Gaussian: the vertex buffer of " << gaussianInfo.NumPoints << " gaussians needs " << vertexBufferSize
+				<< " bytes, more than the storage buffer range of " << maxStorageBufferRange << " bytes.\n";
+			IIIXRLAB_DEBUG_BREAK();
+			return nullptr;
+		}
+		renderableCreateInfo.StagingBuffer = createInfo.Device.CreateStagingBuffer("Gaussian Vertex Buffer", static_cast<uint32_t>(vertexBufferSize));
 
-		Gaussian gaussian = Gaussian(renderableCreateInfo, createInfo.GaussianInfo, std::move(sphereVertices));
+		Gaussian gaussian = Gaussian(renderableCreateInfo, createInfo.GaussianInfo, std::move(sphereVertices), createInfo.bIsPreview, createInfo.Transform, createInfo.ShCodebookGaussianOrNull);
 		return std::make_unique<Gaussian>(std::move(gaussian));
 	}
 	
-	Gaussian::Gaussian(iiixrlab::graphics::IRenderable::CreateInfo& createInfo, const GaussianInfo& gaussianInfo, std::vector<iiixrlab::math::Vector3f>&& sphereVertices) noexcept
+	uint32_t Gaussian::AddTransform(const iiixrlab::math::Matrix4x4f& transform) noexcept
+	{
+		mTransforms.push_back(transform);
+		return static_cast<uint32_t>(mTransforms.size() - 1);
+	}
+
+	void Gaussian::RemoveTransform(const uint32_t transformIndex) noexcept
+	{
+		assert(transformIndex < mTransforms.size());
+		mTransforms.erase(mTransforms.begin() + transformIndex);
+	}
+
+	std::vector<uint32_t> Gaussian::SelectInBox(const std::array<float, 3>& boxMin, const std::array<float, 3>& boxMax) const noexcept
+	{
+		std::vector<uint32_t> pointIndices;
+		for (uint32_t pageIndex = 0; pageIndex < mPageBounds.size(); ++pageIndex)
+		{
+			const PageBounds& pageBounds = mPageBounds[pageIndex];
+			bool bIsPageInBox = true;
+			for (uint32_t axis = 0; axis < 3; ++axis)
+			{
+				bIsPageInBox = bIsPageInBox == true && pageBounds.Min[axis] <= boxMax[axis] && pageBounds.Max[axis] >= boxMin[axis];
+			}
+			if (bIsPageInBox == false)
+			{
+				continue;
+			}
+
+			const uint32_t lastPointIndex = std::min((pageIndex + 1) * POINTS_PER_PAGE, mGaussianInfo.NumPoints);
+			for (uint32_t pointIndex = pageIndex * POINTS_PER_PAGE; pointIndex < lastPointIndex; ++pointIndex)
+			{
+				const float* position = &mGaussianInfo.Positions[pointIndex * 3];
+				if (mbArePointsDeleted[pointIndex] == 0
+					&& position[0] >= boxMin[0] && position[0] <= boxMax[0]
+					&& position[1] >= boxMin[1] && position[1] <= boxMax[1]
+					&& position[2] >= boxMin[2] && position[2] <= boxMax[2])
+				{
+					pointIndices.push_back(pointIndex);
+				}
+			}
+		}
+		return pointIndices;
+	}
+
+	void Gaussian::Delete(const std::span<const uint32_t> pointIndices) noexcept
+	{
+		std::vector<uint32_t> pageIndices;
+		for (const uint32_t pointIndex : pointIndices)
+		{
+			assert(pointIndex < mGaussianInfo.NumPoints);
+			if (mbArePointsDeleted[pointIndex] != 0)
+			{
+				continue;
+			}
+
+			mbArePointsDeleted[pointIndex] = 1;
+			mFreePointIndices.push_back(pointIndex);
+			++mDeletedPointsCount;
+			mGaussianInfo.Scales[pointIndex * 3] = DELETED_SCALE_IN_LOG_SCALE;
+			mGaussianInfo.Scales[pointIndex * 3 + 1] = DELETED_SCALE_IN_LOG_SCALE;
+			mGaussianInfo.Scales[pointIndex * 3 + 2] = DELETED_SCALE_IN_LOG_SCALE;
+			pageIndices.push_back(pointIndex / POINTS_PER_PAGE);
+		}
+		updatePages(pageIndices);
+	}
+
+	void Gaussian::Recolor(const std::span<const uint32_t> pointIndices, const std::array<float, 3>& colorAsShDcComponent) noexcept
+	{
+		std::vector<uint32_t> pageIndices;
+		for (const uint32_t pointIndex : pointIndices)
+		{
+			assert(pointIndex < mGaussianInfo.NumPoints);
+			memcpy(&mGaussianInfo.Colors[pointIndex * 3], colorAsShDcComponent.data(), sizeof(float) * 3);
+			pageIndices.push_back(pointIndex / POINTS_PER_PAGE);
+		}
+		updatePages(pageIndices);
+	}
+
+	void Gaussian::Move(const std::span<const uint32_t> pointIndices, const std::array<float, 3>& translation) noexcept
+	{
+		std::vector<uint32_t> pageIndices;
+		for (const uint32_t pointIndex : pointIndices)
+		{
+			assert(pointIndex < mGaussianInfo.NumPoints);
+			for (uint32_t axis = 0; axis < 3; ++axis)
+			{
+				mGaussianInfo.Positions[pointIndex * 3 + axis] += translation[axis];
+			}
+			pageIndices.push_back(pointIndex / POINTS_PER_PAGE);
+		}
+		updatePages(pageIndices);
+	}
+
+	uint32_t Gaussian::Compact(const uint32_t maxMovedPointsCount, const uint32_t maxDirtiedPagesCount) noexcept
+	{
+		if (mDeletedPointsCount == 0)
+		{
+			// what is left are deleted points the end was dropped with
+			mFreePointIndices.clear();
+			return 0;
+		}
+
+		GaussianInfo& gaussianInfo = mGaussianInfo;
+		const uint32_t shCoefficientsCount = isShQuantized() == false ? GetShCoefficientsCount(gaussianInfo.ShDegree) : 0;
+		const uint32_t pointsCount = gaussianInfo.NumPoints;
+		std::vector<uint32_t> pageIndices;
+		uint32_t movedPointsCount = 0;
+		uint32_t dirtiedPagesCount = 0;
+		while (mFreePointIndices.empty() == false && movedPointsCount < maxMovedPointsCount)
+		{
+			// deleted points at the end are dropped without moving any other point, nothing drawn changes but the count
+			while (gaussianInfo.NumPoints > 0 && mbArePointsDeleted[gaussianInfo.NumPoints - 1] != 0)
+			{
+				--gaussianInfo.NumPoints;
+				--mDeletedPointsCount;
+				pageIndices.push_back(gaussianInfo.NumPoints / POINTS_PER_PAGE);
+			}
+
+			const uint32_t holeIndex = mFreePointIndices.back();
+			if (holeIndex >= gaussianInfo.NumPoints)
+			{
+				mFreePointIndices.pop_back();
+				continue;
+			}
+
+			// only the page of the hole has to be uploaded, the last point is past the count afterwards
+			const uint32_t holePageIndex = holeIndex / POINTS_PER_PAGE;
+			if (mbArePagesDirty[holePageIndex] == 0)
+			{
+				if (dirtiedPagesCount == maxDirtiedPagesCount)
+				{
+					break;
+				}
+				mbArePagesDirty[holePageIndex] = 1;
+				mDirtyPageIndices.push_back(holePageIndex);
+				++dirtiedPagesCount;
+			}
+			mFreePointIndices.pop_back();
+
+			// the last point is live, it takes the place of the deleted one
+			const uint32_t lastIndex = gaussianInfo.NumPoints - 1;
+			memcpy(&gaussianInfo.Positions[holeIndex * 3], &gaussianInfo.Positions[lastIndex * 3], sizeof(float) * 3);
+			memcpy(&gaussianInfo.Scales[holeIndex * 3], &gaussianInfo.Scales[lastIndex * 3], sizeof(float) * 3);
+			memcpy(&gaussianInfo.Rotations[holeIndex * 4], &gaussianInfo.Rotations[lastIndex * 4], sizeof(float) * 4);
+			memcpy(&gaussianInfo.Colors[holeIndex * 3], &gaussianInfo.Colors[lastIndex * 3], sizeof(float) * 3);
+			gaussianInfo.Alphas[holeIndex] = gaussianInfo.Alphas[lastIndex];
+			if (isShQuantized() == true)
+			{
+				gaussianInfo.ShIndices[holeIndex] = gaussianInfo.ShIndices[lastIndex];
+			}
+			else if (shCoefficientsCount > 0)
+			{
+				memcpy(&gaussianInfo.SphericalHarmonics[holeIndex * shCoefficientsCount], &gaussianInfo.SphericalHarmonics[lastIndex * shCoefficientsCount], sizeof(float) * shCoefficientsCount);
+			}
+			mbArePointsDeleted[holeIndex] = 0;
+			mbArePointsDeleted[lastIndex] = 1;
+			--gaussianInfo.NumPoints;
+			--mDeletedPointsCount;
+			++movedPointsCount;
+			pageIndices.push_back(holePageIndex);
+			pageIndices.push_back(lastIndex / POINTS_PER_PAGE);
+		}
+
+		// shrinking keeps the capacity, nothing is reallocated
+		gaussianInfo.Positions.resize(gaussianInfo.NumPoints * 3);
+		gaussianInfo.Scales.resize(gaussianInfo.NumPoints * 3);
+		gaussianInfo.Rotations.resize(gaussianInfo.NumPoints * 4);
+		gaussianInfo.Colors.resize(gaussianInfo.NumPoints * 3);
+		gaussianInfo.Alphas.resize(gaussianInfo.NumPoints);
+		if (isShQuantized() == true)
+		{
+			gaussianInfo.ShIndices.resize(gaussianInfo.NumPoints);
+		}
+		else
+		{
+			gaussianInfo.SphericalHarmonics.resize(static_cast<size_t>(gaussianInfo.NumPoints) * shCoefficientsCount);
+		}
+
+		if (gaussianInfo.NumPoints != pointsCount)
+		{
+			std::sort(pageIndices.begin(), pageIndices.end());
+			pageIndices.erase(std::unique(pageIndices.begin(), pageIndices.end()), pageIndices.end());
+			updateBounds(pageIndices);
+			mCompactedPagesCount = static_cast<uint32_t>(mDirtyPageIndices.size());
+			++mEditsCount;
+		}
+		return mDeletedPointsCount;
+	}
+
+	void Gaussian::ClearDirtyPages(const uint32_t pagesCount) noexcept
+	{
+		const size_t clearedPagesCount = std::min(static_cast<size_t>(pagesCount), mDirtyPageIndices.size());
+		for (size_t dirtyIndex = 0; dirtyIndex < clearedPagesCount; ++dirtyIndex)
+		{
+			mbArePagesDirty[mDirtyPageIndices[dirtyIndex]] = 0;
+		}
+		mDirtyPageIndices.erase(mDirtyPageIndices.begin(), mDirtyPageIndices.begin() + clearedPagesCount);
+		mCompactedPagesCount -= std::min(mCompactedPagesCount, static_cast<uint32_t>(clearedPagesCount));
+	}
+
+	void Gaussian::updateBounds(const std::vector<uint32_t>& pageIndices) noexcept
+	{
+		for (const uint32_t pageIndex : pageIndices)
+		{
+			PageBounds& pageBounds = mPageBounds[pageIndex];
+			pageBounds.Min = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+			pageBounds.Max = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+			const uint32_t lastPointIndex = std::min((pageIndex + 1) * POINTS_PER_PAGE, mGaussianInfo.NumPoints);
+			for (uint32_t pointIndex = pageIndex * POINTS_PER_PAGE; pointIndex < lastPointIndex; ++pointIndex)
+			{
+				if (mbArePointsDeleted[pointIndex] != 0)
+				{
+					continue;
+				}
+
+				// scales are stored as logarithms
+				const float radius = 3.0f * std::exp(std::max({ mGaussianInfo.Scales[pointIndex * 3], mGaussianInfo.Scales[pointIndex * 3 + 1], mGaussianInfo.Scales[pointIndex * 3 + 2] }));
+				for (uint32_t axis = 0; axis < 3; ++axis)
+				{
+					pageBounds.Min[axis] = std::min(pageBounds.Min[axis], mGaussianInfo.Positions[pointIndex * 3 + axis] - radius);
+					pageBounds.Max[axis] = std::max(pageBounds.Max[axis], mGaussianInfo.Positions[pointIndex * 3 + axis] + radius);
+				}
+			}
+		}
+
+		mBoundsMin = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+		mBoundsMax = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+		for (const PageBounds& pageBounds : mPageBounds)
+		{
+			for (uint32_t axis = 0; axis < 3; ++axis)
+			{
+				mBoundsMin[axis] = std::min(mBoundsMin[axis], pageBounds.Min[axis]);
+				mBoundsMax[axis] = std::max(mBoundsMax[axis], pageBounds.Max[axis]);
+			}
+		}
+	}
+
+	void Gaussian::updatePages(std::vector<uint32_t>& pageIndices) noexcept
+	{
+		if (pageIndices.empty() == true)
+		{
+			return;
+		}
+
+		std::sort(pageIndices.begin(), pageIndices.end());
+		pageIndices.erase(std::unique(pageIndices.begin(), pageIndices.end()), pageIndices.end());
+		updateBounds(pageIndices);
+		for (const uint32_t pageIndex : pageIndices)
+		{
+			if (mbArePagesDirty[pageIndex] == 0)
+			{
+				mbArePagesDirty[pageIndex] = 1;
+				mDirtyPageIndices.push_back(pageIndex);
+			}
+		}
+		++mEditsCount;
+	}
+
+	Gaussian::Gaussian(iiixrlab::graphics::IRenderable::CreateInfo& createInfo, GaussianInfo& gaussianInfo, std::vector<iiixrlab::math::Vector3f>&& sphereVertices, const bool bIsPreview, const iiixrlab::math::Matrix4x4f& transform, const Gaussian* shCodebookGaussianOrNull) noexcept
 		: iiixrlab::graphics::IRenderable(createInfo)
 		, mGaussianInfo(gaussianInfo)
 		, mSphereVertices(std::move(sphereVertices))
+		, mShIndicesOffset(SH_INDICES_NONE)
+		, mShCoefficientsOffset(0)
+		, mShCodebookGaussianOrNull(shCodebookGaussianOrNull)
+		, mbIsPreview(bIsPreview)
+		, mBoundsMin({ std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() })
+		, mBoundsMax({ std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() })
+		, mTransforms({ transform })
+		, mPageBounds((gaussianInfo.NumPoints + POINTS_PER_PAGE - 1) / POINTS_PER_PAGE)
+		, mbArePagesDirty(mPageBounds.size(), 0)
+		, mDirtyPageIndices()
+		, mCompactedPagesCount(0)
+		, mbArePointsDeleted(gaussianInfo.NumPoints, 0)
+		, mFreePointIndices()
+		, mDeletedPointsCount(0)
+		, mEditsCount(0)
 	{
+		std::vector<uint32_t> pageIndices(mPageBounds.size());
+		std::iota(pageIndices.begin(), pageIndices.end(), 0);
+		updateBounds(pageIndices);
+
 		uint8_t* data = nullptr;
 		mDevice.MapMemory(*mStagingBuffer, reinterpret_cast<void**>(&data));
 		uint32_t offset = 0;
 		memcpy(data + offset, mSphereVertices.data(), mSphereVertices.size() * sizeof(iiixrlab::math::Vector3f));
 		offset += static_cast<uint32_t>(mSphereVertices.size() * sizeof(iiixrlab::math::Vector3f));
 
-		for (uint32_t i = 0; i < mGaussianInfo.NumPoints; ++i)
+		PackInstanceInfos(mGaussianInfo, 0, mGaussianInfo.NumPoints, reinterpret_cast<InstanceInfo*>(data + offset));
+		offset += mGaussianInfo.NumPoints * static_cast<uint32_t>(sizeof(InstanceInfo));
+
+		if (isShQuantized() == true)
 		{
-			const uint32_t indexBy3 = i * 3;
-			const uint32_t indexBy4 = i * 4;
-			// const uint32_t indexBy45 = i * 45;
+			mShIndicesOffset = offset;
+			memcpy(data + offset, mGaussianInfo.ShIndices.data(), mGaussianInfo.ShIndices.size() * sizeof(uint16_t));
+			offset += static_cast<uint32_t>((mGaussianInfo.ShIndices.size() + 1) / 2 * sizeof(uint32_t));
+		}
 
-			InstanceInfo instanceInfo =
-			{
-				.Position = iiixrlab::math::Vector3f{mGaussianInfo.Positions[indexBy3], mGaussianInfo.Positions[indexBy3 + 1], mGaussianInfo.Positions[indexBy3 + 2]},
-				.ScaleInLogScale = iiixrlab::math::Vector3f{mGaussianInfo.Scales[indexBy3], mGaussianInfo.Scales[indexBy3 + 1], mGaussianInfo.Scales[indexBy3 + 2]},
-				.Quaternion = iiixrlab::math::Vector4f{mGaussianInfo.Rotations[indexBy4], mGaussianInfo.Rotations[indexBy4 + 1], mGaussianInfo.Rotations[indexBy4 + 2], mGaussianInfo.Rotations[indexBy4 + 3]},
-				.ColorAsShDcComponentAndAlphaBeforeSigmoidActivision = iiixrlab::math::Vector4f{mGaussianInfo.Colors[indexBy3], mGaussianInfo.Colors[indexBy3 + 1], mGaussianInfo.Colors[indexBy3 + 2], mGaussianInfo.Alphas[i]},
-			};
-			// memcpy(instanceInfo.SphericalHarmonicsCoefficients.data(), &mGaussianInfo.SphericalHarmonics[indexBy45], sizeof(float) * 45);
-			memcpy(data + offset, &instanceInfo, sizeof(InstanceInfo));
-			offset += sizeof(InstanceInfo);
+		mShCoefficientsOffset = offset;
+		if (mShCodebookGaussianOrNull == nullptr)
+		{
+			const std::vector<float>& shCoefficients = mGaussianInfo.ShCodebook.empty() == true ? mGaussianInfo.SphericalHarmonics : mGaussianInfo.ShCodebook;
+			memcpy(data + offset, shCoefficients.data(), shCoefficients.size() * sizeof(float));
 		}
 	}
 } // namespace iiixrlab::scene
@@ -0,0 +1,219 @@
+#include "3dgs/scene/GaussianGenerator.h"
+
+#include "3dgs/Profiler.h"
+#include "3dgs/Random.h"
+#include "3dgs/ThreadPool.h"
+
+namespace iiixrlab::scene
+{
+	static constexpr const uint32_t POINTS_COUNT_PER_CHUNK = 1 << 16;
+	static constexpr const float SH_C0 = 0.28209479177387814f;
+
+	static void GenerateChunk(const GaussianGeneratorInfo& generatorInfo, const std::vector<float>& clusterCenters, const uint32_t chunkIndex, GaussianInfo& outGaussianInfo) noexcept
+	{
+		const uint32_t firstPointIndex = chunkIndex * POINTS_COUNT_PER_CHUNK;
+		const uint32_t lastPointIndex = std::min(firstPointIndex + POINTS_COUNT_PER_CHUNK, generatorInfo.PointsCount);
+		const uint32_t shCoefficientsCount = GetShCoefficientsCount(generatorInfo.ShDegree);
+
+		const float extent = generatorInfo.Extent;
+		const float clusterDeviation = extent * 0.25f / std::cbrt(static_cast<float>(std::max(generatorInfo.ClustersCount, 1u)));
+		const float logMeanScale = std::log(generatorInfo.MeanScale);
+		const float minOpacity = std::clamp(generatorInfo.MinOpacity, 1.0e-3f, 0.999f);
+		const float maxOpacity = std::clamp(generatorInfo.MaxOpacity, minOpacity, 0.999f);
+
+		Random random = { .State = generatorInfo.Seed ^ (static_cast<uint64_t>(chunkIndex + 1) * 0xd1b54a32d192ed03ull) };
+		for (uint32_t pointIndex = firstPointIndex; pointIndex < lastPointIndex; ++pointIndex)
+		{
+			float* position = &outGaussianInfo.Positions[static_cast<size_t>(pointIndex) * 3];
+			float* scale = &outGaussianInfo.Scales[static_cast<size_t>(pointIndex) * 3];
+			float* rotation = &outGaussianInfo.Rotations[static_cast<size_t>(pointIndex) * 4];
+
+			scale[0] = logMeanScale + generatorInfo.ScaleLogDeviation * random.NextNormal();
+			scale[1] = logMeanScale + generatorInfo.ScaleLogDeviation * random.NextNormal();
+			scale[2] = logMeanScale + generatorInfo.ScaleLogDeviation * random.NextNormal();
+
+			switch (generatorInfo.Distribution)
+			{
+			case eGaussianDistribution::UNIFORM:
+			case eGaussianDistribution::CLUSTERED:
+			{
+				if (generatorInfo.Distribution == eGaussianDistribution::UNIFORM)
+				{
+					position[0] = random.NextFloat(-extent, extent);
+					position[1] = random.NextFloat(-extent, extent);
+					position[2] = random.NextFloat(-extent, extent);
+				}
+				else
+				{
+					const size_t clusterIndex = static_cast<size_t>(random.Next() % (clusterCenters.size() / 3));
+					position[0] = clusterCenters[clusterIndex * 3] + clusterDeviation * random.NextNormal();
+					position[1] = clusterCenters[clusterIndex * 3 + 1] + clusterDeviation * random.NextNormal();
+					position[2] = clusterCenters[clusterIndex * 3 + 2] + clusterDeviation * random.NextNormal();
+				}
+
+				// normalized normal 4D samples are uniform rotations
+				float quaternion[4] = { random.NextNormal(), random.NextNormal(), random.NextNormal(), random.NextNormal() };
+				const float length = std::sqrt(quaternion[0] * quaternion[0] + quaternion[1] * quaternion[1] + quaternion[2] * quaternion[2] + quaternion[3] * quaternion[3]);
+				for (uint32_t componentIndex = 0; componentIndex < 4; ++componentIndex)
+				{
+					rotation[componentIndex] = length > 0.0f ? quaternion[componentIndex] / length : (componentIndex == 3 ? 1.0f : 0.0f);
+				}
+				break;
+			}
+			case eGaussianDistribution::SURFACE:
+			{
+				float normal[3] = { random.NextNormal(), random.NextNormal(), random.NextNormal() };
+				const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+				if (length > 0.0f)
+				{
+					normal[0] /= length;
+					normal[1] /= length;
+					normal[2] /= length;
+				}
+				else
+				{
+					normal[0] = 0.0f;
+					normal[1] = 0.0f;
+					normal[2] = 1.0f;
+				}
+
+				const float radius = extent * (1.0f + 0.005f * random.NextNormal());
+				position[0] = normal[0] * radius;
+				position[1] = normal[1] * radius;
+				position[2] = normal[2] * radius;
+
+				// flat along the local z axis, which is rotated onto the normal: q = (z x n, 1 + z . n)
+				scale[2] = std::min(scale[0], scale[1]) - std::log(10.0f);
+				const float halfway[4] = { -normal[1], normal[0], 0.0f, 1.0f + normal[2] };
+				const float halfwayLength = std::sqrt(halfway[0] * halfway[0] + halfway[1] * halfway[1] + halfway[3] * halfway[3]);
+				if (halfwayLength > 1.0e-6f)
+				{
+					rotation[0] = halfway[0] / halfwayLength;
+					rotation[1] = halfway[1] / halfwayLength;
+					rotation[2] = 0.0f;
+					rotation[3] = halfway[3] / halfwayLength;
+				}
+				else
+				{
+					// the normal is -z, half a turn around x
+					rotation[0] = 1.0f;
+					rotation[1] = 0.0f;
+					rotation[2] = 0.0f;
+					rotation[3] = 0.0f;
+				}
+				break;
+			}
+			default:
+				assert(false);
+				break;
+			}
+
+			const float opacity = random.NextFloat(minOpacity, maxOpacity);
+			outGaussianInfo.Alphas[pointIndex] = std::log(opacity / (1.0f - opacity));
+
+			float* color = &outGaussianInfo.Colors[static_cast<size_t>(pointIndex) * 3];
+			color[0] = (random.NextFloat() - 0.5f) / SH_C0;
+			color[1] = (random.NextFloat() - 0.5f) / SH_C0;
+			color[2] = (random.NextFloat() - 0.5f) / SH_C0;
+
+			// a little view dependence, higher orders fade out like in captured scenes
+			float* shCoefficients = outGaussianInfo.SphericalHarmonics.data() + static_cast<size_t>(pointIndex) * shCoefficientsCount;
+			for (uint32_t coefficientIndex = 0; coefficientIndex < shCoefficientsCount; ++coefficientIndex)
+			{
+				const uint32_t band = static_cast<uint32_t>(std::sqrt(static_cast<float>(coefficientIndex / 3 + 1)));
+				shCoefficients[coefficientIndex] = 0.1f * random.NextNormal() / static_cast<float>(band);
+			}
+		}
+	}
+
+	GaussianInfo GenerateGaussians(const GaussianGeneratorInfo& generatorInfo) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		assert(generatorInfo.ShDegree <= 3);
+		assert(generatorInfo.MeanScale > 0.0f);
+
+		const size_t pointsCount = generatorInfo.PointsCount;
+		const uint32_t shCoefficientsCount = GetShCoefficientsCount(generatorInfo.ShDegree);
+
+		GaussianInfo gaussianInfo;
+		gaussianInfo.NumPoints = generatorInfo.PointsCount;
+		gaussianInfo.ShDegree = generatorInfo.ShDegree;
+		gaussianInfo.isAntialiased = false;
+		gaussianInfo.Positions.resize(pointsCount * 3);
+		gaussianInfo.Scales.resize(pointsCount * 3);
+		gaussianInfo.Rotations.resize(pointsCount * 4);
+		gaussianInfo.Alphas.resize(pointsCount);
+		gaussianInfo.Colors.resize(pointsCount * 3);
+		gaussianInfo.SphericalHarmonics.resize(pointsCount * shCoefficientsCount);
+
+		// shared by every chunk, so they come from a stream of their own
+		std::vector<float> clusterCenters(static_cast<size_t>(std::max(generatorInfo.ClustersCount, 1u)) * 3);
+		Random clusterRandom = { .State = generatorInfo.Seed };
+		for (float& coordinate : clusterCenters)
+		{
+			coordinate = clusterRandom.NextFloat(-generatorInfo.Extent, generatorInfo.Extent);
+		}
+
+		const uint32_t chunksCount = (generatorInfo.PointsCount + POINTS_COUNT_PER_CHUNK - 1) / POINTS_COUNT_PER_CHUNK;
+		if (chunksCount <= 1)
+		{
+			for (uint32_t chunkIndex = 0; chunkIndex < chunksCount; ++chunkIndex)
+			{
+				GenerateChunk(generatorInfo, clusterCenters, chunkIndex, gaussianInfo);
+			}
+			return gaussianInfo;
+		}
+
+		const uint32_t threadsCount = generatorInfo.ThreadsCount > 0 ? generatorInfo.ThreadsCount : std::max(std::thread::hardware_concurrency(), 1u);
+		ThreadPool threadPool({ .ThreadsCount = std::min(threadsCount, chunksCount) });
+		for (uint32_t chunkIndex = 0; chunkIndex < chunksCount; ++chunkIndex)
+		{
+			threadPool.Submit([&generatorInfo, &clusterCenters, chunkIndex, &gaussianInfo]()
+			{
+				GenerateChunk(generatorInfo, clusterCenters, chunkIndex, gaussianInfo);
+			});
+		}
+		threadPool.Wait();
+
+		return gaussianInfo;
+	}
+
+	bool ParseGaussianDistribution(const char* name, eGaussianDistribution& outDistribution) noexcept
+	{
+		if (strcmp(name, "uniform") == 0)
+		{
+			outDistribution = eGaussianDistribution::UNIFORM;
+		}
+		else if (strcmp(name, "clustered") == 0)
+		{
+			outDistribution = eGaussianDistribution::CLUSTERED;
+		}
+		else if (strcmp(name, "surface") == 0)
+		{
+			outDistribution = eGaussianDistribution::SURFACE;
+		}
+		else
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	const char* GetGaussianDistributionName(const eGaussianDistribution distribution) noexcept
+	{
+		switch (distribution)
+		{
+		case eGaussianDistribution::UNIFORM:
+			return "uniform";
+		case eGaussianDistribution::CLUSTERED:
+			return "clustered";
+		case eGaussianDistribution::SURFACE:
+			return "surface";
+		default:
+			assert(false);
+			return "unknown";
+		}
+	}
+} // namespace iiixrlab::scene
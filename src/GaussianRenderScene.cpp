@@ -1,29 +1,94 @@
 #include "3dgs/graphics/GaussianRenderScene.h"
 
+#include "3dgs/graphics/BindlessDescriptorSet.h"
 #include "3dgs/graphics/CommandBuffer.h"
 #include "3dgs/graphics/DescriptorSet.h"
 #include "3dgs/graphics/Device.h"
+#include "3dgs/graphics/FrameResource.h"
 #include "3dgs/scene/Gaussian.h"
+
+#include "3dgs/Profiler.h"
+#include "3dgs/ThreadPool.h"
 #include "3dgs/graphics/IRenderScene.hpp"
+#include "3dgs/graphics/PhysicalDevice.h"
 #include "3dgs/graphics/Pipeline.h"
 #include "3dgs/graphics/Shader.h"
 #include "3dgs/graphics/ShaderManager.h"
 #include "3dgs/graphics/StagingBuffer.h"
+#include "3dgs/graphics/StorageBuffer.h"
+#include "3dgs/graphics/Uploader.h"
 #include "3dgs/graphics/VertexBuffer.h"
 
 namespace iiixrlab::graphics
 {
+	// Gaussian.slang reads the draw list and the instances at these sizes
+	static_assert(sizeof(iiixrlab::scene::Gaussian::ModelInfo) == 112);
+	static_assert(sizeof(iiixrlab::scene::Gaussian::SortedSplat) == 8);
+	static_assert(sizeof(iiixrlab::scene::Gaussian::InstanceInfo) == 56);
+
 	GaussianRenderScene::GaussianRenderScene(IRenderScene::CreateInfo& createInfo) noexcept
 		: TRenderScene<iiixrlab::scene::Gaussian>(createInfo)
+		, mDrawnSplatsCount(0)
+		, mVertexBuffers()
+		, mVertexBufferBindlessIndices()
+		, mRenderableVertexBufferIndices()
+		, mbIsLoadingComplete(true)
+		, mbIsCameraBound(false)
+		, mbIsSortWaited(false)
+		, mChunkStreamerOrNull()
+		, mModels()
+		, mModelIndices()
+		, mFreeModelIndices()
+		, mRetiredModelIndices()
+		, mModelsCount(0)
+		, mSphereVerticesCount(0)
+		, mSorter()
+		, mSortingModels()
+		, mSortingFirstKeyIndices()
+		, mSortingSplats()
+		, mbAreSortKeysDone(false)
+		, mbIsSortDone(false)
+		, mSortThreadPool(std::make_unique<ThreadPool>(ThreadPool::CreateInfo{ .ThreadsCount = 1 }))
+		, mbIsSorting(false)
+		, mSortIndex(0)
+		, mSortedIndex(0)
+		, mSortingView()
+		, mSortedSplats()
+		, mSortedSplatsVersion(0)
+		, mCompactThreadPool(std::make_unique<ThreadPool>(ThreadPool::CreateInfo{ .ThreadsCount = 1 }))
+		, mDrawLists(createInfo.FramesCount)
+		, mEditStagingBuffers(createInfo.FramesCount)
 	{
 	}
 
 	GaussianRenderScene::~GaussianRenderScene() noexcept
 	{
+		// the sorting and compacting threads read the models, they are done before any of them goes away
+		mCompactThreadPool.reset();
+		mSortThreadPool.reset();
+
+		for (DrawList& drawList : mDrawLists)
+		{
+			for (DrawListRange& drawListRange : drawList.Ranges)
+			{
+				if (drawListRange.StorageBuffer != nullptr)
+				{
+					mDevice.GetBindlessDescriptorSet().Unregister(BindlessDescriptorSet::eType::STORAGE_BUFFER, drawListRange.BindlessIndex);
+				}
+			}
+		}
+		mDrawLists.clear();
+
+		mChunkStreamerOrNull.reset();
+		for (uint32_t& bindlessIndex : mVertexBufferBindlessIndices)
+		{
+			mDevice.GetBindlessDescriptorSet().Unregister(BindlessDescriptorSet::eType::STORAGE_BUFFER, bindlessIndex);
+		}
+		mVertexBuffers.clear();
 	}
-	
+
 	void GaussianRenderScene::Render(CommandBuffer& commandBuffer) noexcept
-	{	
+	{
 		auto pipelineFindResult = mPipelines.find("GaussianPipeline");
 		if (pipelineFindResult == mPipelines.end())
 		{
@@ -33,37 +98,37 @@ namespace iiixrlab::graphics
 		}
 		Pipeline& pipeline = *pipelineFindResult->second;
 		commandBuffer.Bind(pipeline);
-		
-		for (const auto& renderable : GetRenderables())
+
+		const DrawList& drawList = mDrawLists[commandBuffer.GetFrameResource().GetFrameIndex()];
+		for (const DrawListRange& drawListRange : drawList.Ranges)
 		{
-			const std::vector<iiixrlab::math::Vector3f>& sphereVertices = renderable->GetSphereVertices();
-			const uint32_t sphereVerticesCount = static_cast<uint32_t>(sphereVertices.size());
-			const iiixrlab::scene::GaussianInfo& gaussianInfo = renderable->GetGaussianInfo();
-			std::vector<CommandBuffer::VertexBindingInfo> vertexBindingInfos;
-			vertexBindingInfos.push_back({ .BindingIndex = 0, .Stride = sphereVerticesCount * sizeof(iiixrlab::math::Vector3f) });
-			vertexBindingInfos.push_back({ .BindingIndex = 1, .Stride = gaussianInfo.NumPoints * 3 * sizeof(float) });
-			commandBuffer.Bind(*mVertexBuffer, vertexBindingInfos);
+			if (drawListRange.SortedSplatsCount == 0)
+			{
+				continue;
+			}
+
+			// the splats pull their sphere vertices and instances out of the vertex buffers, nothing is bound as vertex input
+			const iiixrlab::scene::Gaussian::PushConstants pushConstants =
+			{
+				.DrawListIndex = drawListRange.BindlessIndex,
+				.SortedSplatsOffset = drawList.ModelsCount * static_cast<uint32_t>(sizeof(iiixrlab::scene::Gaussian::ModelInfo)),
+			};
+			commandBuffer.PushConstants(&pushConstants, sizeof(pushConstants));
 
-			// commandBuffer.Draw(sphereVerticesCount, 1, 0, 0);
-			commandBuffer.Draw(sphereVerticesCount, gaussianInfo.NumPoints, 0, 0);
+			commandBuffer.Draw(mSphereVerticesCount, drawListRange.SortedSplatsCount, 0, 0);
+			mDrawnSplatsCount += drawListRange.SortedSplatsCount;
 		}
 	}
 
-	void GaussianRenderScene::updateInner(CommandBuffer& commandBuffer, [[maybe_unused]] const float deltaTime) noexcept
+	void GaussianRenderScene::updateInner([[maybe_unused]] CommandBuffer& commandBuffer, [[maybe_unused]] const float deltaTime) noexcept
 	{
-		if (mVertexBuffer == nullptr)
-		{
-			uint32_t vertexBufferSize = 0;
-			for (const auto& renderable : GetRenderables())
-			{
-				const std::vector<iiixrlab::math::Vector3f>& sphereVertices = renderable->GetSphereVertices();
-				vertexBufferSize += static_cast<uint32_t>(sphereVertices.size() * sizeof(iiixrlab::math::Vector3f));
+		IIIXRLAB_PROFILE_ZONE("GaussianRenderScene::updateInner");
 
-				const iiixrlab::scene::GaussianInfo& gaussianInfo = renderable->GetGaussianInfo();
-				vertexBufferSize += gaussianInfo.NumPoints * sizeof(iiixrlab::scene::Gaussian::InstanceInfo);
-			}
-			mVertexBuffer = mDevice.CreateVertexBuffer("GaussianVertexBuffer", vertexBufferSize);
+		// the streamer, the new renderables and the edits below may move the points the other threads still use
+		WaitForGaussians();
 
+		if (mbIsCameraBound == false)
+		{
 			auto pipelineFindResult = mPipelines.find("GaussianPipeline");
 			if (pipelineFindResult == mPipelines.end())
 			{
@@ -75,13 +140,685 @@ namespace iiixrlab::graphics
 			DescriptorSet& descriptorSet = pipeline.GetDescriptorSet(0);
 			const ConstantBuffer& cameraBuffer = mCamera->GetConstantBuffer();
 			descriptorSet.Bind(cameraBuffer);
+			mbIsCameraBound = true;
+		}
+
+		if (mChunkStreamerOrNull != nullptr)
+		{
+			mChunkStreamerOrNull->Update(*mCamera, commandBuffer.GetFrameResource().GetFramesCount());
 		}
 
-		for (const auto& renderable : GetRenderables())
+		// renderables are only ever appended, the ones added since the last update are the tail
+		const std::vector<std::unique_ptr<iiixrlab::scene::Gaussian>>& renderables = GetRenderables();
+		const size_t firstRenderableIndex = mRenderableVertexBufferIndices.size();
+		if (firstRenderableIndex < renderables.size())
 		{
-			[[maybe_unused]] const iiixrlab::scene::GaussianInfo& gaussianInfo = renderable->GetGaussianInfo();
-			StagingBuffer& stagingBuffer = renderable->GetStagingBuffer();
-			commandBuffer.CopyBuffer(stagingBuffer, *mVertexBuffer, { .srcOffset = 0, .dstOffset = 0, .size = stagingBuffer.GetTotalSize() });
+			// every renderable copies its whole staging buffer: sphere, instances and spherical harmonics. A vertex buffer
+			// takes as many of them as the range of its storage buffer descriptor holds, Gaussian::Create() keeps each within
+			const VkDeviceSize maxVertexBufferSize = mDevice.GetPhysicalDevice().GetPhysicalDeviceProperties().limits.maxStorageBufferRange;
+			Uploader& uploader = mDevice.GetUploader();
+			size_t renderableIndex = firstRenderableIndex;
+			while (renderableIndex < renderables.size())
+			{
+				size_t endRenderableIndex = renderableIndex;
+				VkDeviceSize vertexBufferSize = 0;
+				while (endRenderableIndex < renderables.size() && vertexBufferSize + renderables[endRenderableIndex]->GetStagingBuffer().GetTotalSize() <= maxVertexBufferSize)
+				{
+					vertexBufferSize += renderables[endRenderableIndex]->GetStagingBuffer().GetTotalSize();
+					++endRenderableIndex;
+				}
+				assert(endRenderableIndex > renderableIndex);
+
+				// maxStorageBufferRange is 32 bit, so is the size of a vertex buffer within it
+				assert(vertexBufferSize <= UINT32_MAX);
+				const uint32_t vertexBufferIndex = static_cast<uint32_t>(mVertexBuffers.size());
+				mVertexBuffers.push_back(mDevice.CreateVertexBuffer("GaussianVertexBuffer", static_cast<uint32_t>(vertexBufferSize)));
+				mVertexBufferBindlessIndices.push_back(mDevice.GetBindlessDescriptorSet().Register(*mVertexBuffers.back()));
+
+				// uploaded once on the transfer queue, each renderable owns the range starting at its destination offset
+				VkDeviceSize dstOffset = 0;
+				for (; renderableIndex < endRenderableIndex; ++renderableIndex)
+				{
+					const VkDeviceSize size = renderables[renderableIndex]->GetStagingBuffer().GetTotalSize();
+					renderables[renderableIndex]->Upload(uploader, *mVertexBuffers.back(), dstOffset);
+					mRenderableVertexBufferIndices.push_back(vertexBufferIndex);
+					dstOffset += size;
+				}
+			}
+		}
+
+		uploadEdits(commandBuffer);
+		gatherModels();
+		sort();
+		writeDrawList(commandBuffer);
+		compact();
+	}
+
+	void GaussianRenderScene::uploadEdits(CommandBuffer& commandBuffer) noexcept
+	{
+		IIIXRLAB_PROFILE_ZONE("GaussianRenderScene::uploadEdits");
+
+		struct EditedGaussian final
+		{
+			iiixrlab::scene::Gaussian* Gaussian;
+			VertexBuffer* VertexBuffer;
+			uint32_t PagesCount;
+		};
+
+		// a gaussian still uploading keeps its dirty pages, they are copied over its upload once it is acquired
+		const Uploader& uploader = mDevice.GetUploader();
+		std::vector<EditedGaussian> editedGaussians;
+		const auto addEditedGaussian = [&uploader, &editedGaussians](iiixrlab::scene::Gaussian& gaussian, VertexBuffer& vertexBuffer)
+		{
+			if (gaussian.GetDirtyPageIndices().empty() == false && gaussian.IsUploaded(uploader) == true)
+			{
+				editedGaussians.push_back({ .Gaussian = &gaussian, .VertexBuffer = &vertexBuffer, .PagesCount = 0 });
+			}
+		};
+
+		const std::vector<std::unique_ptr<iiixrlab::scene::Gaussian>>& renderables = GetRenderables();
+		for (size_t renderableIndex = 0; renderableIndex < renderables.size(); ++renderableIndex)
+		{
+			addEditedGaussian(*renderables[renderableIndex], *mVertexBuffers[mRenderableVertexBufferIndices[renderableIndex]]);
+		}
+		if (mChunkStreamerOrNull != nullptr)
+		{
+			for (const ChunkStreamer::ResidentChunk& residentChunk : mChunkStreamerOrNull->GetResidentChunks())
+			{
+				addEditedGaussian(*residentChunk.Gaussian, *residentChunk.VertexBuffer);
+			}
+		}
+
+		if (editedGaussians.empty() == true)
+		{
+			return;
+		}
+
+		// pages past the points left after compaction are not drawn, they are skipped
+		const auto getPagePointsCount = [](const iiixrlab::scene::Gaussian& gaussian, const uint32_t pageIndex)
+		{
+			const uint32_t firstPointIndex = pageIndex * iiixrlab::scene::Gaussian::POINTS_PER_PAGE;
+			const uint32_t pointsCount = gaussian.GetGaussianInfo().NumPoints;
+			return firstPointIndex < pointsCount ? std::min(iiixrlab::scene::Gaussian::POINTS_PER_PAGE, pointsCount - firstPointIndex) : 0u;
+		};
+		const auto getPageShSize = [](const iiixrlab::scene::Gaussian& gaussian, const uint32_t pagePointsCount)
+		{
+			return gaussian.GetShIndicesOffset() != iiixrlab::scene::Gaussian::SH_INDICES_NONE
+				? (pagePointsCount + 1) / 2 * static_cast<uint32_t>(sizeof(uint32_t))
+				: pagePointsCount * iiixrlab::scene::GetShCoefficientsCount(gaussian.GetGaussianInfo().ShDegree) * static_cast<uint32_t>(sizeof(float));
+		};
+
+		// the oldest dirty pages of each gaussian go first, the gaussians past the budget keep theirs. The pages compaction
+		// filled lead and are always taken, compact() kept them within the budget
+		std::stable_partition(editedGaussians.begin(), editedGaussians.end(), [](const EditedGaussian& editedGaussian) { return editedGaussian.Gaussian->GetCompactedPagesCount() > 0; });
+		uint32_t uploadedPagesCount = 0;
+		VkDeviceSize stagingSize = 0;
+		for (EditedGaussian& editedGaussian : editedGaussians)
+		{
+			const std::vector<uint32_t>& dirtyPageIndices = editedGaussian.Gaussian->GetDirtyPageIndices();
+			const uint32_t leftPagesCount = uploadedPagesCount < UPLOADED_PAGES_PER_UPDATE ? UPLOADED_PAGES_PER_UPDATE - uploadedPagesCount : 0;
+			editedGaussian.PagesCount = std::max(std::min(static_cast<uint32_t>(dirtyPageIndices.size()), leftPagesCount), editedGaussian.Gaussian->GetCompactedPagesCount());
+			for (uint32_t dirtyIndex = 0; dirtyIndex < editedGaussian.PagesCount; ++dirtyIndex)
+			{
+				const uint32_t pagePointsCount = getPagePointsCount(*editedGaussian.Gaussian, dirtyPageIndices[dirtyIndex]);
+				stagingSize += static_cast<VkDeviceSize>(pagePointsCount) * sizeof(iiixrlab::scene::Gaussian::InstanceInfo) + getPageShSize(*editedGaussian.Gaussian, pagePointsCount);
+			}
+			uploadedPagesCount += editedGaussian.PagesCount;
+		}
+		std::erase_if(editedGaussians, [](const EditedGaussian& editedGaussian) { return editedGaussian.PagesCount == 0; });
+
+		if (stagingSize == 0)
+		{
+			for (const EditedGaussian& editedGaussian : editedGaussians)
+			{
+				editedGaussian.Gaussian->ClearDirtyPages(editedGaussian.PagesCount);
+			}
+			return;
 		}
+
+		// the frame waited for its last submission, so are the copies out of its staging buffer
+		EditStagingBuffer& editStagingBuffer = mEditStagingBuffers[commandBuffer.GetFrameResource().GetFrameIndex()];
+		if (editStagingBuffer.StagingBuffer == nullptr || editStagingBuffer.StagingBuffer->GetTotalSize() < stagingSize)
+		{
+			// UPLOADED_PAGES_PER_UPDATE keeps it to megabytes, compaction included
+			assert(stagingSize + stagingSize / 4 <= UINT32_MAX);
+			editStagingBuffer.StagingBuffer = mDevice.CreateStagingBuffer("GaussianEditStagingBuffer", static_cast<uint32_t>(stagingSize + stagingSize / 4));
+			mDevice.MapMemory(*editStagingBuffer.StagingBuffer, reinterpret_cast<void**>(&editStagingBuffer.MappedData));
+		}
+
+		// the vertex shader of the frames in flight may still read the pages being overwritten
+		std::vector<VertexBuffer*> vertexBuffers;
+		for (const EditedGaussian& editedGaussian : editedGaussians)
+		{
+			vertexBuffers.push_back(editedGaussian.VertexBuffer);
+		}
+		std::sort(vertexBuffers.begin(), vertexBuffers.end());
+		vertexBuffers.erase(std::unique(vertexBuffers.begin(), vertexBuffers.end()), vertexBuffers.end());
+		for (VertexBuffer* vertexBuffer : vertexBuffers)
+		{
+			VkBufferMemoryBarrier vertexBufferMemoryBarrier =
+			{
+				.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+				.pNext = nullptr,
+				.srcAccessMask = 0,
+				.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+				.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+				.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+				.buffer = vertexBuffer->GetBuffer(),
+				.offset = 0,
+				.size = VK_WHOLE_SIZE,
+			};
+			commandBuffer.Barrier(VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, vertexBufferMemoryBarrier);
+		}
+
+		VkDeviceSize stagingOffset = 0;
+		for (const EditedGaussian& editedGaussian : editedGaussians)
+		{
+			const iiixrlab::scene::Gaussian& gaussian = *editedGaussian.Gaussian;
+			const iiixrlab::scene::GaussianInfo& gaussianInfo = gaussian.GetGaussianInfo();
+			const VkDeviceSize dstOffset = gaussian.GetDstOffset();
+			for (uint32_t dirtyIndex = 0; dirtyIndex < editedGaussian.PagesCount; ++dirtyIndex)
+			{
+				const uint32_t pageIndex = gaussian.GetDirtyPageIndices()[dirtyIndex];
+				const uint32_t pagePointsCount = getPagePointsCount(gaussian, pageIndex);
+				if (pagePointsCount == 0)
+				{
+					continue;
+				}
+
+				const uint32_t firstPointIndex = pageIndex * iiixrlab::scene::Gaussian::POINTS_PER_PAGE;
+				const uint32_t instancesSize = pagePointsCount * static_cast<uint32_t>(sizeof(iiixrlab::scene::Gaussian::InstanceInfo));
+				iiixrlab::scene::Gaussian::PackInstanceInfos(gaussianInfo, firstPointIndex, pagePointsCount, reinterpret_cast<iiixrlab::scene::Gaussian::InstanceInfo*>(editStagingBuffer.MappedData + stagingOffset));
+				commandBuffer.CopyBuffer(*editStagingBuffer.StagingBuffer, *editedGaussian.VertexBuffer,
+					{ .srcOffset = stagingOffset, .dstOffset = dstOffset + gaussian.GetInstancesOffset() + firstPointIndex * sizeof(iiixrlab::scene::Gaussian::InstanceInfo), .size = instancesSize });
+				stagingOffset += instancesSize;
+
+				// a page starts at a pair of spherical harmonics indices, the last pair of the points may be half used
+				const uint32_t shSize = getPageShSize(gaussian, pagePointsCount);
+				VkDeviceSize shDstOffset = 0;
+				if (gaussian.GetShIndicesOffset() != iiixrlab::scene::Gaussian::SH_INDICES_NONE)
+				{
+					memset(editStagingBuffer.MappedData + stagingOffset, 0, shSize);
+					memcpy(editStagingBuffer.MappedData + stagingOffset, &gaussianInfo.ShIndices[firstPointIndex], pagePointsCount * sizeof(uint16_t));
+					shDstOffset = dstOffset + gaussian.GetShIndicesOffset() + firstPointIndex * sizeof(uint16_t);
+				}
+				else if (shSize > 0)
+				{
+					memcpy(editStagingBuffer.MappedData + stagingOffset, &gaussianInfo.SphericalHarmonics[firstPointIndex * static_cast<size_t>(iiixrlab::scene::GetShCoefficientsCount(gaussianInfo.ShDegree))], shSize);
+					shDstOffset = dstOffset + gaussian.GetShCoefficientsOffset() + firstPointIndex * static_cast<VkDeviceSize>(shSize / pagePointsCount);
+				}
+				if (shSize > 0)
+				{
+					commandBuffer.CopyBuffer(*editStagingBuffer.StagingBuffer, *editedGaussian.VertexBuffer, { .srcOffset = stagingOffset, .dstOffset = shDstOffset, .size = shSize });
+					stagingOffset += shSize;
+				}
+			}
+			editedGaussian.Gaussian->ClearDirtyPages(editedGaussian.PagesCount);
+		}
+
+		for (VertexBuffer* vertexBuffer : vertexBuffers)
+		{
+			VkBufferMemoryBarrier vertexBufferMemoryBarrier =
+			{
+				.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+				.pNext = nullptr,
+				.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+				.dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+				.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+				.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+				.buffer = vertexBuffer->GetBuffer(),
+				.offset = 0,
+				.size = VK_WHOLE_SIZE,
+			};
+			commandBuffer.Barrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, vertexBufferMemoryBarrier);
+		}
+	}
+
+	void GaussianRenderScene::gatherModels() noexcept
+	{
+		const Uploader& uploader = mDevice.GetUploader();
+		const std::vector<std::unique_ptr<iiixrlab::scene::Gaussian>>& renderables = GetRenderables();
+
+		// a preview stands in for the rest of the scene until every part of it can be drawn
+		bool bArePreviewsHidden = mbIsLoadingComplete;
+		for (size_t renderableIndex = 0; renderableIndex < renderables.size() && bArePreviewsHidden == true; ++renderableIndex)
+		{
+			bArePreviewsHidden = renderables[renderableIndex]->IsPreview() == true || renderables[renderableIndex]->IsUploaded(uploader) == true;
+		}
+
+		const iiixrlab::scene::Camera::Info& cameraInfo = mCamera->GetInfo();
+		const iiixrlab::math::Matrix4x4f viewProjection = cameraInfo.View * cameraInfo.Projection;
+		mModels.clear();
+		// a placement far away covers few pixels, so it sorts and draws only a share of its points
+		uint64_t sortedSplatsCount = 0;
+		const auto addModels = [this, &viewProjection, &sortedSplatsCount](const iiixrlab::scene::Gaussian& gaussian, const uint32_t vertexBufferBindlessIndex, const uint32_t shCoefficientsBindlessIndex)
+		{
+			const uint64_t pointsCount = gaussian.GetGaussianInfo().NumPoints;
+			const std::vector<iiixrlab::math::Matrix4x4f>& transforms = gaussian.GetTransforms();
+			for (uint32_t transformIndex = 0; transformIndex < transforms.size(); ++transformIndex)
+			{
+				const iiixrlab::math::Matrix4x4f modelViewProjection = transforms[transformIndex] * viewProjection;
+				if (iiixrlab::scene::IsInFrustum(gaussian.GetBoundsMin(), gaussian.GetBoundsMax(), modelViewProjection) == false)
+				{
+					continue;
+				}
+
+				const float screenCoverage = iiixrlab::scene::GetScreenCoverage(gaussian.GetBoundsMin(), gaussian.GetBoundsMax(), modelViewProjection);
+				const uint64_t maxSortedSplatsCount = std::max(static_cast<uint64_t>(screenCoverage * static_cast<float>(SORTED_SPLATS_PER_SCREEN)), uint64_t{ 1 });
+				const uint32_t pointsStride = static_cast<uint32_t>(std::max((pointsCount + maxSortedSplatsCount - 1) / maxSortedSplatsCount, uint64_t{ 1 }));
+				mModels.push_back({ .Gaussian = &gaussian, .TransformIndex = transformIndex, .VertexBufferBindlessIndex = vertexBufferBindlessIndex, .ShCoefficientsBindlessIndex = shCoefficientsBindlessIndex, .ModelIndex = MODEL_INDEX_NONE, .PointsStride = pointsStride });
+				sortedSplatsCount += (pointsCount + pointsStride - 1) / pointsStride;
+			}
+		};
+
+		for (size_t renderableIndex = 0; renderableIndex < renderables.size(); ++renderableIndex)
+		{
+			const std::unique_ptr<iiixrlab::scene::Gaussian>& renderable = renderables[renderableIndex];
+
+			// the transfer queue may still be copying, the renderable shows up as soon as its upload is acquired
+			if (renderable->IsUploaded(uploader) == false || (renderable->IsPreview() == true && bArePreviewsHidden == true))
+			{
+				continue;
+			}
+
+			// a shared codebook is read from the vertex buffer of the renderable which uploaded it
+			const uint32_t vertexBufferBindlessIndex = mVertexBufferBindlessIndices[mRenderableVertexBufferIndices[renderableIndex]];
+			uint32_t shCoefficientsBindlessIndex = vertexBufferBindlessIndex;
+			const iiixrlab::scene::Gaussian* shCodebookGaussianOrNull = renderable->GetShCodebookGaussianOrNull();
+			if (shCodebookGaussianOrNull != nullptr)
+			{
+				const auto shCodebookRenderableIt = std::find_if(renderables.begin(), renderables.end(), [shCodebookGaussianOrNull](const std::unique_ptr<iiixrlab::scene::Gaussian>& other) { return other.get() == shCodebookGaussianOrNull; });
+				if (shCodebookRenderableIt == renderables.end() || shCodebookGaussianOrNull->IsUploaded(uploader) == false)
+				{
+					continue;
+				}
+				shCoefficientsBindlessIndex = mVertexBufferBindlessIndices[mRenderableVertexBufferIndices[shCodebookRenderableIt - renderables.begin()]];
+			}
+
+			addModels(*renderable, vertexBufferBindlessIndex, shCoefficientsBindlessIndex);
+		}
+
+		if (mChunkStreamerOrNull != nullptr)
+		{
+			for (const ChunkStreamer::ResidentChunk& residentChunk : mChunkStreamerOrNull->GetResidentChunks())
+			{
+				if (residentChunk.Gaussian->IsUploaded(uploader) == true)
+				{
+					addModels(*residentChunk.Gaussian, residentChunk.VertexBufferBindlessIndex, residentChunk.VertexBufferBindlessIndex);
+				}
+			}
+		}
+
+		// many placements filling the screen together would still overflow the sorter, every stride grows alike
+		if (sortedSplatsCount > MAX_SORTED_SPLATS_COUNT)
+		{
+			const uint64_t pointsStrideScale = (sortedSplatsCount + MAX_SORTED_SPLATS_COUNT - 1) / MAX_SORTED_SPLATS_COUNT;
+			for (Model& model : mModels)
+			{
+				model.PointsStride = static_cast<uint32_t>(std::min(model.PointsStride * pointsStrideScale, static_cast<uint64_t>(std::max(model.Gaussian->GetGaussianInfo().NumPoints, 1u))));
+			}
+		}
+
+		// models which went away, or were culled, keep their index until no drawn order refers to it, so another
+		// gaussian allocated where the old one was is not mistaken for it either
+		std::unordered_map<const iiixrlab::scene::Gaussian*, std::vector<uint32_t>> modelIndices;
+		modelIndices.reserve(mModelIndices.size());
+		for (Model& model : mModels)
+		{
+			std::vector<uint32_t>& gaussianModelIndices = modelIndices[model.Gaussian];
+			if (gaussianModelIndices.empty() == true)
+			{
+				gaussianModelIndices.resize(model.Gaussian->GetTransforms().size(), MODEL_INDEX_NONE);
+			}
+
+			auto modelIndicesFindResult = mModelIndices.find(model.Gaussian);
+			if (modelIndicesFindResult != mModelIndices.end() && model.TransformIndex < modelIndicesFindResult->second.size() && modelIndicesFindResult->second[model.TransformIndex] != MODEL_INDEX_NONE)
+			{
+				model.ModelIndex = modelIndicesFindResult->second[model.TransformIndex];
+				modelIndicesFindResult->second[model.TransformIndex] = MODEL_INDEX_NONE;
+			}
+			else if (mFreeModelIndices.empty() == false)
+			{
+				model.ModelIndex = mFreeModelIndices.back();
+				mFreeModelIndices.pop_back();
+			}
+			else
+			{
+				model.ModelIndex = mModelsCount++;
+			}
+			gaussianModelIndices[model.TransformIndex] = model.ModelIndex;
+		}
+
+		for (const auto& [gaussian, gaussianModelIndices] : mModelIndices)
+		{
+			for (const uint32_t modelIndex : gaussianModelIndices)
+			{
+				if (modelIndex != MODEL_INDEX_NONE)
+				{
+					mRetiredModelIndices.push_back({ .ModelIndex = modelIndex, .SortIndex = mSortIndex });
+				}
+			}
+		}
+		mModelIndices = std::move(modelIndices);
+
+		if (mModels.empty() == false)
+		{
+			mSphereVerticesCount = static_cast<uint32_t>(mModels.front().Gaussian->GetSphereVertices().size());
+		}
+	}
+
+	void GaussianRenderScene::WaitForGaussians() noexcept
+	{
+		if (mbIsSorting == true)
+		{
+			mbAreSortKeysDone.wait(false, std::memory_order_acquire);
+		}
+		mCompactThreadPool->Wait();
+	}
+
+	std::vector<uint32_t> GaussianRenderScene::SelectInBox(const iiixrlab::scene::Gaussian& gaussian, const std::array<float, 3>& boxMin, const std::array<float, 3>& boxMax) noexcept
+	{
+		WaitForGaussians();
+		return gaussian.SelectInBox(boxMin, boxMax);
+	}
+
+	void GaussianRenderScene::Delete(iiixrlab::scene::Gaussian& gaussian, const std::span<const uint32_t> pointIndices) noexcept
+	{
+		WaitForGaussians();
+		gaussian.Delete(pointIndices);
+	}
+
+	void GaussianRenderScene::Recolor(iiixrlab::scene::Gaussian& gaussian, const std::span<const uint32_t> pointIndices, const std::array<float, 3>& colorAsShDcComponent) noexcept
+	{
+		WaitForGaussians();
+		gaussian.Recolor(pointIndices, colorAsShDcComponent);
+	}
+
+	void GaussianRenderScene::Move(iiixrlab::scene::Gaussian& gaussian, const std::span<const uint32_t> pointIndices, const std::array<float, 3>& translation) noexcept
+	{
+		WaitForGaussians();
+		gaussian.Move(pointIndices, translation);
+	}
+
+	void GaussianRenderScene::sort() noexcept
+	{
+		IIIXRLAB_PROFILE_ZONE("GaussianRenderScene::sort");
+
+		const iiixrlab::math::Matrix4x4f& view = mCamera->GetInfo().View;
+		bool bIsSortStale = mSortIndex == 0 || view != mSortingView || mModels.size() != mSortingModels.size();
+		for (size_t modelIndex = 0; modelIndex < mModels.size() && bIsSortStale == false; ++modelIndex)
+		{
+			const Model& model = mModels[modelIndex];
+			bIsSortStale = model.ModelIndex != mSortingModels[modelIndex].ModelIndex || model.Gaussian->GetTransforms()[model.TransformIndex] != mSortingModels[modelIndex].Transform
+				|| model.Gaussian->GetEditsCount() != mSortingModels[modelIndex].EditsCount || model.PointsStride != mSortingModels[modelIndex].PointsStride;
+		}
+
+		if (mbIsSorting == true && (mbIsSortWaited == true && bIsSortStale == true))
+		{
+			mSortThreadPool->Wait();
+		}
+
+		if (mbIsSorting == true && mbIsSortDone.load(std::memory_order_acquire) == true)
+		{
+			mSortedSplats.swap(mSortingSplats);
+			mSortedIndex = mSortIndex;
+			++mSortedSplatsVersion;
+			mbIsSorting = false;
+
+			// the drawn order was sorted after these models went away
+			for (size_t retiredIndex = 0; retiredIndex < mRetiredModelIndices.size();)
+			{
+				if (mRetiredModelIndices[retiredIndex].SortIndex < mSortedIndex)
+				{
+					mFreeModelIndices.push_back(mRetiredModelIndices[retiredIndex].ModelIndex);
+					mRetiredModelIndices[retiredIndex] = mRetiredModelIndices.back();
+					mRetiredModelIndices.pop_back();
+				}
+				else
+				{
+					++retiredIndex;
+				}
+			}
+		}
+
+		if (mbIsSorting == true || bIsSortStale == false)
+		{
+			return;
+		}
+
+		// the transforms and the view are taken now, the positions are read by the sorting thread before the next update,
+		// which waits for the keys so the models are neither edited nor released meanwhile
+		mSortingModels.clear();
+		for (const Model& model : mModels)
+		{
+			mSortingModels.push_back({ .ModelIndex = model.ModelIndex, .Transform = model.Gaussian->GetTransforms()[model.TransformIndex], .EditsCount = model.Gaussian->GetEditsCount(), .GaussianInfo = &model.Gaussian->GetGaussianInfo(), .PointsStride = model.PointsStride });
+		}
+		mSortingView = view;
+		++mSortIndex;
+		mbIsSorting = true;
+		mbAreSortKeysDone.store(false, std::memory_order_relaxed);
+		mbIsSortDone.store(false, std::memory_order_relaxed);
+
+		mSortThreadPool->Submit([this]()
+		{
+			IIIXRLAB_PROFILE_ZONE("GaussianRenderScene::sort::Sort");
+
+			// placements of one gaussian read the same positions, each with its own transform
+			mSorter.Clear();
+			mSortingFirstKeyIndices.clear();
+			for (const SortedModel& sortingModel : mSortingModels)
+			{
+				mSortingFirstKeyIndices.push_back(static_cast<uint32_t>(mSorter.GetKeys().size()));
+				mSorter.AppendDepthKeys(*sortingModel.GaussianInfo, sortingModel.Transform * mSortingView, sortingModel.PointsStride);
+			}
+			mbAreSortKeysDone.store(true, std::memory_order_release);
+			mbAreSortKeysDone.notify_all();
+
+			mSorter.Sort();
+
+			// sorted indices run over the keys of every model, the model of each is found by its first key
+			const std::vector<uint32_t>& sortedIndices = mSorter.GetSortedIndices();
+			mSortingSplats.resize(sortedIndices.size());
+			for (size_t sortedIndex = 0; sortedIndex < sortedIndices.size(); ++sortedIndex)
+			{
+				const uint32_t keyIndex = sortedIndices[sortedIndex];
+				const size_t modelIndex = static_cast<size_t>(std::upper_bound(mSortingFirstKeyIndices.begin(), mSortingFirstKeyIndices.end(), keyIndex) - mSortingFirstKeyIndices.begin()) - 1;
+				mSortingSplats[sortedIndex] = { .ModelIndex = mSortingModels[modelIndex].ModelIndex, .PointIndex = (keyIndex - mSortingFirstKeyIndices[modelIndex]) * mSortingModels[modelIndex].PointsStride };
+			}
+			mbIsSortDone.store(true, std::memory_order_release);
+		});
+
+		// nothing is drawn before the first order
+		if (mbIsSortWaited == true || mSortedIndex == 0)
+		{
+			mSortThreadPool->Wait();
+			sort();
+		}
+	}
+
+	void GaussianRenderScene::writeDrawList(CommandBuffer& commandBuffer) noexcept
+	{
+		IIIXRLAB_PROFILE_ZONE("GaussianRenderScene::writeDrawList");
+
+		// the frame waited for its last submission, so its draw list is free to be rewritten
+		DrawList& drawList = mDrawLists[commandBuffer.GetFrameResource().GetFrameIndex()];
+		const VkDeviceSize modelsSize = static_cast<VkDeviceSize>(mModelsCount) * sizeof(iiixrlab::scene::Gaussian::ModelInfo);
+		if (mModelsCount == 0)
+		{
+			for (DrawListRange& drawListRange : drawList.Ranges)
+			{
+				drawListRange.SortedSplatsCount = 0;
+			}
+			drawList.ModelsCount = 0;
+			return;
+		}
+
+		// every range repeats the models, the sorted splats are split over as many ranges as the descriptors need
+		const VkDeviceSize maxStorageBufferRange = mDevice.GetPhysicalDevice().GetPhysicalDeviceProperties().limits.maxStorageBufferRange;
+		if (modelsSize + sizeof(iiixrlab::scene::Gaussian::SortedSplat) > maxStorageBufferRange)
+		{
+			std::cerr << "GaussianRenderScene: the " << mModelsCount << " models of the draw list need " << modelsSize
+				<< " bytes, they leave no room for splats within the storage buffer range of " << maxStorageBufferRange << " bytes.\n";
+			IIIXRLAB_DEBUG_BREAK();
+			for (DrawListRange& drawListRange : drawList.Ranges)
+			{
+				drawListRange.SortedSplatsCount = 0;
+			}
+			return;
+		}
+		const size_t rangeSortedSplatsCount = static_cast<size_t>((maxStorageBufferRange - modelsSize) / sizeof(iiixrlab::scene::Gaussian::SortedSplat));
+
+		// the order only changes with a finished sort, the lists of the other frames catch up as they come around
+		const bool bAreSortedSplatsCopied = drawList.SortedSplatsVersion != mSortedSplatsVersion || drawList.ModelsCount != mModelsCount;
+		if (bAreSortedSplatsCopied == true)
+		{
+			const size_t rangesCount = std::max((mSortedSplats.size() + rangeSortedSplatsCount - 1) / rangeSortedSplatsCount, size_t{ 1 });
+			for (size_t rangeIndex = rangesCount; rangeIndex < drawList.Ranges.size(); ++rangeIndex)
+			{
+				if (drawList.Ranges[rangeIndex].StorageBuffer != nullptr)
+				{
+					mDevice.GetBindlessDescriptorSet().Unregister(BindlessDescriptorSet::eType::STORAGE_BUFFER, drawList.Ranges[rangeIndex].BindlessIndex);
+				}
+			}
+			drawList.Ranges.resize(rangesCount);
+			for (size_t rangeIndex = 0; rangeIndex < rangesCount; ++rangeIndex)
+			{
+				const size_t firstSortedIndex = std::min(rangeIndex * rangeSortedSplatsCount, mSortedSplats.size());
+				drawList.Ranges[rangeIndex].SortedSplatsCount = static_cast<uint32_t>(std::min(rangeSortedSplatsCount, mSortedSplats.size() - firstSortedIndex));
+			}
+			drawList.SortedSplatsVersion = mSortedSplatsVersion;
+		}
+		drawList.ModelsCount = mModelsCount;
+
+		// models which went away stay in the list with no points, the order may still refer to them
+		std::vector<iiixrlab::scene::Gaussian::ModelInfo> modelInfos(mModelsCount, iiixrlab::scene::Gaussian::ModelInfo{ .PointsCount = 0 });
+		const iiixrlab::math::Matrix4x4f cameraTransform = iiixrlab::math::Matrix4x4f::InverseRigid(mCamera->GetInfo().View);
+		const iiixrlab::math::Vector4f cameraPosition{ cameraTransform(3, 0), cameraTransform(3, 1), cameraTransform(3, 2), 1.0f };
+		for (const Model& model : mModels)
+		{
+			const iiixrlab::scene::Gaussian& gaussian = *model.Gaussian;
+			const iiixrlab::math::Matrix4x4f& transform = gaussian.GetTransforms()[model.TransformIndex];
+			const iiixrlab::scene::Gaussian& shCoefficientsGaussian = gaussian.GetShCodebookGaussianOrNull() != nullptr ? *gaussian.GetShCodebookGaussianOrNull() : gaussian;
+			// every vertex buffer is within the range of a storage buffer descriptor, so are the offsets into it
+			assert(gaussian.GetDstOffset() < maxStorageBufferRange && shCoefficientsGaussian.GetDstOffset() < maxStorageBufferRange);
+			const uint32_t dstOffset = static_cast<uint32_t>(gaussian.GetDstOffset());
+			const iiixrlab::math::Vector4f modelCameraPosition = cameraPosition * iiixrlab::math::Matrix4x4f::Inverse(transform);
+			modelInfos[model.ModelIndex] =
+			{
+				.World = transform,
+				.CameraPosition = iiixrlab::math::Vector3f{ modelCameraPosition.GetX(), modelCameraPosition.GetY(), modelCameraPosition.GetZ() },
+				.PointsCount = gaussian.GetGaussianInfo().NumPoints,
+				.VertexBufferIndex = model.VertexBufferBindlessIndex,
+				.SphereVerticesOffset = dstOffset,
+				.InstancesOffset = dstOffset + gaussian.GetInstancesOffset(),
+				.ShIndicesOffset = gaussian.GetShIndicesOffset() == iiixrlab::scene::Gaussian::SH_INDICES_NONE ? iiixrlab::scene::Gaussian::SH_INDICES_NONE : dstOffset + gaussian.GetShIndicesOffset(),
+				.ShCoefficientsOffset = static_cast<uint32_t>(shCoefficientsGaussian.GetDstOffset()) + shCoefficientsGaussian.GetShCoefficientsOffset(),
+				.ShDegree = gaussian.GetGaussianInfo().ShDegree,
+				.ShCoefficientsBufferIndex = model.ShCoefficientsBindlessIndex,
+				.Padding = {},
+			};
+		}
+
+		for (size_t rangeIndex = 0; rangeIndex < drawList.Ranges.size(); ++rangeIndex)
+		{
+			DrawListRange& drawListRange = drawList.Ranges[rangeIndex];
+			const VkDeviceSize sortedSplatsSize = static_cast<VkDeviceSize>(drawListRange.SortedSplatsCount) * sizeof(iiixrlab::scene::Gaussian::SortedSplat);
+			bool bIsRangeCreated = false;
+			if (drawListRange.StagingBuffer == nullptr || drawListRange.StagingBuffer->GetTotalSize() < modelsSize + sortedSplatsSize)
+			{
+				if (drawListRange.StorageBuffer != nullptr)
+				{
+					mDevice.GetBindlessDescriptorSet().Unregister(BindlessDescriptorSet::eType::STORAGE_BUFFER, drawListRange.BindlessIndex);
+				}
+
+				// room for the scene to grow a bit before the buffers are created again
+				const VkDeviceSize size = std::min(modelsSize + sortedSplatsSize + (modelsSize + sortedSplatsSize) / 4, maxStorageBufferRange);
+				assert(size <= UINT32_MAX);
+				drawListRange.StagingBuffer = mDevice.CreateStagingBuffer("GaussianDrawListStagingBuffer", static_cast<uint32_t>(size));
+				mDevice.MapMemory(*drawListRange.StagingBuffer, reinterpret_cast<void**>(&drawListRange.MappedData));
+				drawListRange.StorageBuffer = mDevice.CreateStorageBuffer("GaussianDrawList", static_cast<uint32_t>(size));
+				drawListRange.BindlessIndex = mDevice.GetBindlessDescriptorSet().Register(*drawListRange.StorageBuffer);
+				bIsRangeCreated = true;
+			}
+
+			memcpy(drawListRange.MappedData, modelInfos.data(), modelsSize);
+			VkDeviceSize copySize = modelsSize;
+			if ((bAreSortedSplatsCopied == true || bIsRangeCreated == true) && sortedSplatsSize > 0)
+			{
+				memcpy(drawListRange.MappedData + modelsSize, mSortedSplats.data() + rangeIndex * rangeSortedSplatsCount, sortedSplatsSize);
+				copySize += sortedSplatsSize;
+			}
+
+			commandBuffer.CopyBuffer(*drawListRange.StagingBuffer, *drawListRange.StorageBuffer, { .srcOffset = 0, .dstOffset = 0, .size = copySize });
+			VkBufferMemoryBarrier drawListMemoryBarrier =
+			{
+				.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+				.pNext = nullptr,
+				.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+				.dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+				.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+				.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+				.buffer = drawListRange.StorageBuffer->GetBuffer(),
+				.offset = 0,
+				.size = copySize,
+			};
+			commandBuffer.Barrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, drawListMemoryBarrier);
+		}
+	}
+
+	void GaussianRenderScene::compact() noexcept
+	{
+		IIIXRLAB_PROFILE_ZONE("GaussianRenderScene::compact");
+
+		// the next update uploads every page a compaction fills, so a gaussian still uploading edits waits for it
+		const Uploader& uploader = mDevice.GetUploader();
+		std::vector<iiixrlab::scene::Gaussian*> compactedGaussians;
+		const auto addCompactedGaussian = [&uploader, &compactedGaussians](iiixrlab::scene::Gaussian& gaussian)
+		{
+			if (gaussian.GetDeletedPointsCount() > 0 && gaussian.GetDirtyPageIndices().empty() == true && gaussian.IsUploaded(uploader) == true)
+			{
+				compactedGaussians.push_back(&gaussian);
+			}
+		};
+
+		for (const std::unique_ptr<iiixrlab::scene::Gaussian>& renderable : GetRenderables())
+		{
+			addCompactedGaussian(*renderable);
+		}
+		if (mChunkStreamerOrNull != nullptr)
+		{
+			for (const ChunkStreamer::ResidentChunk& residentChunk : mChunkStreamerOrNull->GetResidentChunks())
+			{
+				addCompactedGaussian(*residentChunk.Gaussian);
+			}
+		}
+
+		if (compactedGaussians.empty() == true)
+		{
+			return;
+		}
+
+		// the sort started this update reads the positions compaction moves until it has the keys
+		const bool bIsSorting = mbIsSorting;
+		mCompactThreadPool->Submit([this, compactedGaussians = std::move(compactedGaussians), bIsSorting]()
+		{
+			IIIXRLAB_PROFILE_ZONE("GaussianRenderScene::compact::Compact");
+
+			if (bIsSorting == true)
+			{
+				mbAreSortKeysDone.wait(false, std::memory_order_acquire);
+			}
+
+			uint32_t compactedPagesCount = 0;
+			for (iiixrlab::scene::Gaussian* gaussian : compactedGaussians)
+			{
+				if (compactedPagesCount == UPLOADED_PAGES_PER_UPDATE)
+				{
+					break;
+				}
+				gaussian->Compact(COMPACTED_POINTS_PER_UPDATE, UPLOADED_PAGES_PER_UPDATE - compactedPagesCount);
+				compactedPagesCount += gaussian->GetCompactedPagesCount();
+			}
+		});
 	}
-} // namespace iiixrlab::graphics
\ No newline at end of file
+} // namespace iiixrlab::graphics
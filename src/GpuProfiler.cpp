@@ -0,0 +1,239 @@
+#include "3dgs/graphics/GpuProfiler.h"
+
+#include "3dgs/graphics/CommandBuffer.h"
+#include "3dgs/graphics/Device.h"
+
+#include "3dgs/Profiler.h"
+
+namespace iiixrlab::graphics
+{
+	GpuProfiler::GpuProfiler(const CreateInfo& createInfo) noexcept
+		: mDevice(createInfo.Device)
+		, mName(createInfo.Name)
+		, mQueryPool(createInfo.QueryPool)
+		, mMaxScopesCount(createInfo.MaxScopesCount)
+		, mTimestampPeriod(static_cast<double>(createInfo.TimestampPeriod))
+		, mTimestampMasks(createInfo.TimestampMasks)
+		, mbIsHostQueryResetEnabled(createInfo.bIsHostQueryResetEnabled)
+		, mSlotScopes(createInfo.SlotsCount)
+		, mCurrentSlotIndex(0)
+		, mHistories()
+		, mHistoryIndices()
+		, mbIsEnabled(true)
+		, mReportInterval(0)
+		, mResolvedSlotsCount(0)
+	{
+		assert(mQueryPool != VK_NULL_HANDLE);
+		assert(mMaxScopesCount > 0);
+		assert(mSlotScopes.empty() == false);
+
+		for (std::vector<Scope>& scopes : mSlotScopes)
+		{
+			scopes.reserve(mMaxScopesCount);
+		}
+	}
+
+	GpuProfiler::~GpuProfiler() noexcept
+	{
+		mDevice.DestroyQueryPool(mQueryPool);
+	}
+
+	void GpuProfiler::BeginSlot(const uint32_t slotIndex) noexcept
+	{
+		assert(slotIndex < mSlotScopes.size());
+		mCurrentSlotIndex = slotIndex;
+
+		std::vector<Scope>& scopes = mSlotScopes[slotIndex];
+		if (scopes.empty() == true)
+		{
+			return;
+		}
+
+		// pairs of { timestamp, availability } per query, queries of unsubmitted command buffers simply stay unavailable
+		const uint32_t firstQuery = slotIndex * mMaxScopesCount * 2;
+		const uint32_t queriesCount = static_cast<uint32_t>(scopes.size()) * 2;
+		std::vector<uint64_t> results(static_cast<size_t>(queriesCount) * 2, 0);
+		mDevice.GetQueryPoolResults(mQueryPool, firstQuery, queriesCount, results.size() * sizeof(uint64_t), results.data(), 2 * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+#if defined(IIIXRLAB_PROFILER)
+		// scopes join the CPU zones in the trace when both clocks can be related
+		uint64_t calibratedDeviceTimestamp = 0;
+		int64_t calibratedHostTimestamp = 0;
+		const bool bIsTracing = Profiler::GetInstance().IsRecording() == true && mDevice.GetCalibratedTimestamps(calibratedDeviceTimestamp, calibratedHostTimestamp) == true;
+#endif	// defined(IIIXRLAB_PROFILER)
+
+		for (uint32_t scopeIndex = 0; scopeIndex < static_cast<uint32_t>(scopes.size()); ++scopeIndex)
+		{
+			const uint64_t* beginResult = &results[scopeIndex * 4];
+			const uint64_t* endResult = &results[scopeIndex * 4 + 2];
+			if (beginResult[1] == 0 || endResult[1] == 0)
+			{
+				continue;
+			}
+
+			// the valid bits of the queue family may wrap around
+			const uint64_t ticks = (endResult[0] - beginResult[0]) & scopes[scopeIndex].TimestampMask;
+			addSample(scopes[scopeIndex].Name, static_cast<double>(ticks) * mTimestampPeriod * 1.0e-6);
+
+#if defined(IIIXRLAB_PROFILER)
+			if (bIsTracing == true)
+			{
+				// the scope completed before the calibration, so the masked difference never wraps negative
+				const uint64_t ticksBeforeCalibration = (calibratedDeviceTimestamp - beginResult[0]) & scopes[scopeIndex].TimestampMask;
+				const int64_t beginTimestamp = calibratedHostTimestamp - static_cast<int64_t>(static_cast<double>(ticksBeforeCalibration) * mTimestampPeriod);
+				Profiler::GetInstance().AddZone(scopes[scopeIndex].Name, beginTimestamp, beginTimestamp + static_cast<int64_t>(static_cast<double>(ticks) * mTimestampPeriod), mName);
+			}
+#endif	// defined(IIIXRLAB_PROFILER)
+		}
+
+		if (mbIsHostQueryResetEnabled == true)
+		{
+			mDevice.ResetQueryPool(mQueryPool, firstQuery, mMaxScopesCount * 2);
+		}
+		scopes.clear();
+
+		++mResolvedSlotsCount;
+		if (mReportInterval != 0 && mResolvedSlotsCount % mReportInterval == 0)
+		{
+			Print(std::cout);
+		}
+	}
+
+	uint32_t GpuProfiler::BeginScope(CommandBuffer& commandBuffer, const char* name) noexcept
+	{
+		assert(name != nullptr);
+
+		std::vector<Scope>& scopes = mSlotScopes[mCurrentSlotIndex];
+		const uint32_t queueFamilyIndex = commandBuffer.GetQueueFamilyIndex();
+		if (mbIsEnabled == false || scopes.size() >= mMaxScopesCount || queueFamilyIndex >= mTimestampMasks.size() || mTimestampMasks[queueFamilyIndex] == 0)
+		{
+			return INVALID_SCOPE_INDEX;
+		}
+		// queries cannot be reset within rendering
+		if (mbIsHostQueryResetEnabled == false && commandBuffer.IsRendering() == true)
+		{
+			return INVALID_SCOPE_INDEX;
+		}
+
+		const uint32_t scopeIndex = static_cast<uint32_t>(scopes.size());
+		const uint32_t firstQuery = (mCurrentSlotIndex * mMaxScopesCount + scopeIndex) * 2;
+		scopes.push_back(Scope{ .Name = name, .TimestampMask = mTimestampMasks[queueFamilyIndex] });
+		if (mbIsHostQueryResetEnabled == false)
+		{
+			commandBuffer.ResetQueryPool(mQueryPool, firstQuery, 2);
+		}
+		commandBuffer.WriteTimestamp(mQueryPool, firstQuery);
+		return scopeIndex;
+	}
+
+	void GpuProfiler::EndScope(CommandBuffer& commandBuffer, const uint32_t scopeIndex) noexcept
+	{
+		if (scopeIndex == INVALID_SCOPE_INDEX)
+		{
+			return;
+		}
+
+		assert(scopeIndex < mSlotScopes[mCurrentSlotIndex].size());
+		commandBuffer.WriteTimestamp(mQueryPool, (mCurrentSlotIndex * mMaxScopesCount + scopeIndex) * 2 + 1);
+	}
+
+	void GpuProfiler::ResetStatistics(const uint32_t samplesCount) noexcept
+	{
+		assert(samplesCount > 0);
+
+		mHistories.clear();
+		mHistoryIndices.clear();
+		mSamplesCount = samplesCount;
+	}
+
+	std::vector<GpuProfiler::Statistics> GpuProfiler::GetStatistics() const noexcept
+	{
+		std::vector<Statistics> statistics;
+		statistics.reserve(mHistories.size());
+
+		std::vector<double> sortedSamples;
+		for (const History& history : mHistories)
+		{
+			sortedSamples = history.Samples;
+			std::sort(sortedSamples.begin(), sortedSamples.end());
+
+			double sum = 0.0;
+			for (const double sample : sortedSamples)
+			{
+				sum += sample;
+			}
+
+			// nearest rank
+			const size_t samplesCount = sortedSamples.size();
+			const size_t p99Rank = (samplesCount * 99 + 99) / 100;
+			statistics.push_back(Statistics
+			{
+				.Name = history.Name,
+				.MinMilliseconds = sortedSamples.front(),
+				.AvgMilliseconds = sum / static_cast<double>(samplesCount),
+				.P99Milliseconds = sortedSamples[p99Rank - 1],
+				.SamplesCount = static_cast<uint32_t>(samplesCount),
+			});
+		}
+
+		return statistics;
+	}
+
+	void GpuProfiler::Print(std::ostream& os) const noexcept
+	{
+		const std::ios_base::fmtflags flags = os.flags();
+		const std::streamsize precision = os.precision(3);
+		os << std::fixed;
+		for (const Statistics& statistics : GetStatistics())
+		{
+			os << "[GPU] " << statistics.Name
+				<< ": min " << statistics.MinMilliseconds
+				<< " ms, avg " << statistics.AvgMilliseconds
+				<< " ms, p99 " << statistics.P99Milliseconds
+				<< " ms (" << statistics.SamplesCount << " samples)\n";
+		}
+		os.precision(precision);
+		os.flags(flags);
+	}
+
+	void GpuProfiler::WriteJson(std::ostream& os) const noexcept
+	{
+		const std::vector<Statistics> statistics = GetStatistics();
+
+		os << "[";
+		for (size_t statisticsIndex = 0; statisticsIndex < statistics.size(); ++statisticsIndex)
+		{
+			// scope names are identifiers chosen by the code, they need no escaping
+			const Statistics& scopeStatistics = statistics[statisticsIndex];
+			os << (statisticsIndex == 0 ? "\n" : ",\n")
+				<< "\t{ \"name\": \"" << scopeStatistics.Name
+				<< "\", \"min_ms\": " << scopeStatistics.MinMilliseconds
+				<< ", \"avg_ms\": " << scopeStatistics.AvgMilliseconds
+				<< ", \"p99_ms\": " << scopeStatistics.P99Milliseconds
+				<< ", \"samples\": " << scopeStatistics.SamplesCount << " }";
+		}
+		os << "\n]";
+	}
+
+	void GpuProfiler::addSample(const char* name, const double milliseconds) noexcept
+	{
+		auto historyIndexIt = mHistoryIndices.find(name);
+		if (historyIndexIt == mHistoryIndices.end())
+		{
+			historyIndexIt = mHistoryIndices.emplace(name, static_cast<uint32_t>(mHistories.size())).first;
+			mHistories.push_back(History{ .Name = name, .Samples = {}, .NextSampleIndex = 0 });
+			mHistories.back().Samples.reserve(mSamplesCount);
+		}
+
+		History& history = mHistories[historyIndexIt->second];
+		if (history.Samples.size() < mSamplesCount)
+		{
+			history.Samples.push_back(milliseconds);
+		}
+		else
+		{
+			history.Samples[history.NextSampleIndex] = milliseconds;
+		}
+		history.NextSampleIndex = (history.NextSampleIndex + 1) % mSamplesCount;
+	}
+} // namespace iiixrlab::graphics
@@ -1,17 +1,17 @@
 #include "3dgs/graphics/IRenderable.h"
 
 #include "3dgs/graphics/Buffer.h"
-#include "3dgs/graphics/CommandBuffer.h"
 #include "3dgs/graphics/Device.h"
-#include "3dgs/graphics/FrameResource.h"
 #include "3dgs/graphics/StagingBuffer.h"
+#include "3dgs/graphics/Uploader.h"
 
 namespace iiixrlab::graphics
 {
     IRenderable::IRenderable(IRenderable&& other) noexcept
         : mDevice(other.mDevice)
         , mStagingBuffer(std::move(other.mStagingBuffer))
-        , mUploadingFrameIndex(other.mUploadingFrameIndex)
+        , mUploadTimelineValue(other.mUploadTimelineValue)
+        , mDstOffset(other.mDstOffset)
     {
         other.mStagingBuffer.reset();
     }
@@ -24,17 +24,21 @@ namespace iiixrlab::graphics
         }
     }
 
-    void IRenderable::Update(CommandBuffer& commandBuffer, [[maybe_unused]] const float deltaTime) noexcept
+    void IRenderable::Upload(Uploader& uploader, Buffer& dstBuffer, const VkDeviceSize dstOffset) noexcept
     {
-        if (mUploadingFrameIndex == commandBuffer.GetFrameResource().GetFrameIndex())
+        if (mStagingBuffer == nullptr)
         {
-            mStagingBuffer.reset();
+            std::cerr << "The renderable is already uploaded.\n";
+            IIIXRLAB_DEBUG_BREAK();
+            return;
         }
+
+        mDstOffset = dstOffset;
+        mUploadTimelineValue = uploader.Upload(std::move(mStagingBuffer), dstBuffer, dstOffset);
     }
 
-    void IRenderable::Upload(CommandBuffer& commandBuffer, Buffer& dstBuffer) noexcept
+    bool IRenderable::IsUploaded(const Uploader& uploader) const noexcept
     {
-        commandBuffer.CopyBuffer(*mStagingBuffer, dstBuffer, { .srcOffset = 0, .dstOffset = 0, .size = mStagingBuffer->GetTotalSize() });
-        mUploadingFrameIndex = commandBuffer.GetFrameResource().GetFrameIndex();
+        return IsUploading() && uploader.IsAcquired(mUploadTimelineValue);
     }
 } // namespace iiixrlab::graphics
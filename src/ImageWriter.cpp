@@ -0,0 +1,89 @@
+#include "3dgs/ImageWriter.h"
+
+#include "zlib.h"
+
+#include "3dgs/Profiler.h"
+
+namespace iiixrlab
+{
+	static void AppendBigEndian(std::vector<uint8_t>& inoutBytes, const uint32_t value) noexcept
+	{
+		inoutBytes.push_back(static_cast<uint8_t>(value >> 24));
+		inoutBytes.push_back(static_cast<uint8_t>(value >> 16));
+		inoutBytes.push_back(static_cast<uint8_t>(value >> 8));
+		inoutBytes.push_back(static_cast<uint8_t>(value));
+	}
+
+	static void AppendChunk(std::vector<uint8_t>& inoutBytes, const char type[4], const uint8_t* data, const uint32_t size) noexcept
+	{
+		AppendBigEndian(inoutBytes, size);
+		const size_t typeOffset = inoutBytes.size();
+		inoutBytes.insert(inoutBytes.end(), type, type + 4);
+		if (size > 0)
+		{
+			inoutBytes.insert(inoutBytes.end(), data, data + size);
+		}
+
+		// the CRC covers the chunk type and its data
+		const uLong crc = crc32(0L, inoutBytes.data() + typeOffset, static_cast<uInt>(4 + size));
+		AppendBigEndian(inoutBytes, static_cast<uint32_t>(crc));
+	}
+
+	bool WritePng(const std::filesystem::path& filePath, const uint32_t width, const uint32_t height, const uint8_t* pixels) noexcept
+	{
+		IIIXRLAB_PROFILE_ZONE("WritePng");
+
+		if (pixels == nullptr || width == 0 || height == 0)
+		{
+			std::cerr << "Nothing to write to " << filePath << ".\n";
+			return false;
+		}
+
+		// every row is prefixed with its filter type, 0 stores the row as is
+		const size_t rowSize = static_cast<size_t>(width) * 4;
+		std::vector<uint8_t> filteredRows((rowSize + 1) * height);
+		for (uint32_t row = 0; row < height; ++row)
+		{
+			uint8_t* filteredRow = filteredRows.data() + row * (rowSize + 1);
+			filteredRow[0] = 0;
+			std::memcpy(filteredRow + 1, pixels + row * rowSize, rowSize);
+		}
+
+		uLongf compressedSize = compressBound(static_cast<uLong>(filteredRows.size()));
+		std::vector<uint8_t> compressedRows(compressedSize);
+		const int zr = compress2(compressedRows.data(), &compressedSize, filteredRows.data(), static_cast<uLong>(filteredRows.size()), Z_BEST_SPEED);
+		if (zr != Z_OK)
+		{
+			std::cerr << "Failed to compress " << filePath << ": " << zr << ".\n";
+			return false;
+		}
+
+		const uint8_t header[13] =
+		{
+			static_cast<uint8_t>(width >> 24), static_cast<uint8_t>(width >> 16), static_cast<uint8_t>(width >> 8), static_cast<uint8_t>(width),
+			static_cast<uint8_t>(height >> 24), static_cast<uint8_t>(height >> 16), static_cast<uint8_t>(height >> 8), static_cast<uint8_t>(height),
+			8,	// bit depth
+			6,	// color type: RGBA
+			0,	// compression: deflate
+			0,	// filter method
+			0,	// no interlacing
+		};
+
+		constexpr const uint8_t SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+		std::vector<uint8_t> bytes(SIGNATURE, SIGNATURE + sizeof(SIGNATURE));
+		bytes.reserve(sizeof(SIGNATURE) + 3 * 12 + sizeof(header) + compressedSize);
+		AppendChunk(bytes, "IHDR", header, sizeof(header));
+		AppendChunk(bytes, "IDAT", compressedRows.data(), static_cast<uint32_t>(compressedSize));
+		AppendChunk(bytes, "IEND", nullptr, 0);
+
+		std::ofstream file(filePath, std::ios::binary);
+		if (file.is_open() == false)
+		{
+			std::cerr << "Failed to open " << filePath << ".\n";
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+		return file.good();
+	}
+} // namespace iiixrlab
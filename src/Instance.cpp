@@ -243,6 +243,7 @@ namespace iiixrlab::graphics
 	Instance::Instance(const CreateInfo& createInfo) noexcept
 		: mInstance(VK_NULL_HANDLE)
 		, mApiVersion(0)
+		, mbIsHeadless(createInfo.bIsHeadless)
 		, mPhysicalDevice()
 #if defined(_DEBUG)
 		, mDebugReportCallback(VK_NULL_HANDLE)
@@ -328,12 +329,13 @@ namespace iiixrlab::graphics
 #endif	// defined(_DEBUG)
 		// instanceExtensionBuilder.AddExtension(VK_EXT_VALIDATION_FEATURES_EXTENSION_NAME);
 		// instanceExtensionBuilder.AddExtension(VK_EXT_VALIDATION_FLAGS_EXTENSION_NAME);
+		if (mbIsHeadless == false)
+		{
 #if defined(VK_USE_PLATFORM_WIN32_KHR)
-		instanceExtensionBuilder.AddExtension(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
-#else
-#error 0
-#endif
-		instanceExtensionBuilder.AddExtension(VK_KHR_SURFACE_EXTENSION_NAME);
+			instanceExtensionBuilder.AddExtension(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
+#endif	// defined(VK_USE_PLATFORM_WIN32_KHR)
+			instanceExtensionBuilder.AddExtension(VK_KHR_SURFACE_EXTENSION_NAME);
+		}
 
 		const std::vector<const char*>& extensionNamesToEnable = instanceExtensionBuilder.GetExtensionsToEnable();
 
@@ -397,8 +399,9 @@ namespace iiixrlab::graphics
 		}
 	}
 
-	SwapChain& Instance::InitializeSwapChain(const uint32_t framesCount, const iiixrlab::Window& window) noexcept
+	SwapChain& Instance::InitializeSwapChain(const uint32_t backBuffersCount, const iiixrlab::Window& window) noexcept
 	{
+		assert(mbIsHeadless == false);
 		VkResult vr = VK_SUCCESS;
 
 		VkPhysicalDevice& vkPhysicalDevice = mPhysicalDevice->mPhysicalDevice;
@@ -409,7 +412,7 @@ namespace iiixrlab::graphics
 		{
 			.Instance = *this,
 			.Device = *mPhysicalDevice->mDevice,
-			.FramesCount = framesCount,	
+			.FramesCount = backBuffersCount,
 		};
 
 #if defined(_WIN32)
@@ -423,7 +426,9 @@ namespace iiixrlab::graphics
 		};
 		vr = vkCreateWin32SurfaceKHR(mInstance, &surfaceCreateInfo, nullptr, &createInfo.Surface);
 #else	// NOT defined(_WIN32)
-#error 0
+		std::cerr << "Swap chains are only supported on Windows, create the renderer headless instead.\n";
+		IIIXRLAB_DEBUG_BREAK();
+		vr = VK_ERROR_EXTENSION_NOT_PRESENT;
 #endif	// NOT defined(_WIN32)
 		assert(vr == VK_SUCCESS && createInfo.Surface != VK_NULL_HANDLE);
 #if defined(_DEBUG)
@@ -491,11 +496,12 @@ namespace iiixrlab::graphics
 
 		std::vector<char> backBufferName(64);
 		std::vector<char> depthBufferName(64);
+		std::vector<char> renderFinishedSemaphoreName(64);
 
 		for (uint32_t frameIndex = 0; frameIndex < createInfo.FramesCount; ++frameIndex)
 		{
 #if defined(_DEBUG)
-			sprintf_s(backBufferName.data(), backBufferName.size(), "Back Buffer[%u]", frameIndex);
+			snprintf(backBufferName.data(), backBufferName.size(), "Back Buffer[%u]", frameIndex);
 #endif	// defined(_DEBUG)
 
 			TextureCreateInfo backBufferCreateInfo =
@@ -510,7 +516,7 @@ namespace iiixrlab::graphics
 			};
 
 #if defined(_DEBUG)
-			sprintf_s(depthBufferName.data(), depthBufferName.size(), "Depth Buffer[%u]", frameIndex);
+			snprintf(depthBufferName.data(), depthBufferName.size(), "Depth Buffer[%u]", frameIndex);
 #endif	// defined(_DEBUG)
 
 			TextureCreateInfo depthBufferCreateInfo =
@@ -523,11 +529,14 @@ namespace iiixrlab::graphics
 				.Extent = createInfo.FrameExtent,
 			};
 
+			snprintf(renderFinishedSemaphoreName.data(), renderFinishedSemaphoreName.size(), "Render Finished Semaphore[%u]", frameIndex);
+
 			createInfo.BackBuffers.push_back(
 				BackBuffer
 				{
 					.Color = device.CreateTexture(backBufferCreateInfo), 
 					.Depth = device.CreateTexture(depthBufferCreateInfo),
+					.RenderFinishedSemaphore = device.CreateSemaphore(renderFinishedSemaphoreName.data()),
 				}
 			);
 		}
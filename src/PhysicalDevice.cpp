@@ -39,21 +39,45 @@ namespace iiixrlab::graphics
         : mInstance(createInfo.Instance)
         , mPhysicalDevice(createInfo.PhysicalDevice)
         , mPhysicalDeviceMemoryProperties(createInfo.PhysicalDeviceMemoryProperties)
+        , mPhysicalDeviceProperties()
+        , mDescriptorIndexingProperties()
         , mQueueFamilyIndex(UINT32_MAX)
         , mQueueFamilyProperties()
+        , mTransferQueueFamilyIndex(UINT32_MAX)
+        , mComputeQueueFamilyIndex(UINT32_MAX)
+        , mQueueFamilyPropertiesList()
+		, mbIsCalibratedTimestampsEnabled(false)
+		, mbIsHostQueryResetEnabled(false)
 		, mDevice()
     {
         assert(mPhysicalDevice != VK_NULL_HANDLE);
 
-		std::vector<VkQueueFamilyProperties2> queueFamilyPropertiesList;
-		selectMainQueueFamilyIndex(queueFamilyPropertiesList, mQueueFamilyIndex, mPhysicalDevice, mInstance.GetApiVersion());
+		vkGetPhysicalDeviceProperties(mPhysicalDevice, &mPhysicalDeviceProperties);
+		mDescriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+		VkPhysicalDeviceProperties2 physicalDeviceProperties2 =
+		{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+			.pNext = &mDescriptorIndexingProperties,
+		};
+		vkGetPhysicalDeviceProperties2(mPhysicalDevice, &physicalDeviceProperties2);
+
+		std::vector<VkQueueFamilyProperties2>& queueFamilyPropertiesList = mQueueFamilyPropertiesList;
+		selectMainQueueFamilyIndex(queueFamilyPropertiesList, mQueueFamilyIndex, mPhysicalDevice, mInstance.GetApiVersion(), mInstance.IsHeadless());
 		mQueueFamilyProperties = queueFamilyPropertiesList[mQueueFamilyIndex];
+		mTransferQueueFamilyIndex = selectDedicatedQueueFamilyIndex(queueFamilyPropertiesList, VK_QUEUE_TRANSFER_BIT, mQueueFamilyIndex);
+		mComputeQueueFamilyIndex = selectDedicatedQueueFamilyIndex(queueFamilyPropertiesList, VK_QUEUE_COMPUTE_BIT, mQueueFamilyIndex);
 
 		Device::CreateInfo deviceCreateInfo =
 		{
 			.PhysicalDevice = *this,
 		};
-		deviceCreateInfo.Device = createDevice(mPhysicalDevice, mInstance.GetApiVersion(), queueFamilyPropertiesList);
+		deviceCreateInfo.Device = createDevice(mPhysicalDevice, mInstance.GetApiVersion(), queueFamilyPropertiesList, mInstance.IsHeadless(), mbIsCalibratedTimestampsEnabled, mbIsHostQueryResetEnabled);
+		if (deviceCreateInfo.Device == VK_NULL_HANDLE)
+		{
+			std::cerr << "Failed to create the device.\n";
+			IIIXRLAB_DEBUG_BREAK();
+			std::abort();
+		}
 		mDevice = std::make_unique<Device>(deviceCreateInfo);
     }
 
@@ -147,6 +171,9 @@ namespace iiixrlab::graphics
 		case 0x1C5C:
 			std::cout << "Microsoft" << '\n';
 			break;
+		case 0x10005:
+			std::cout << "Mesa" << '\n';
+			break;
 		default:
 			assert(false);
 			break;
@@ -175,7 +202,7 @@ namespace iiixrlab::graphics
 		};
 	}
 
-	VkDevice PhysicalDevice::createDevice(const VkPhysicalDevice physicalDevice, const uint32_t apiVersion, const std::vector<VkQueueFamilyProperties2>& queueFamilyPropertiesList) noexcept
+	VkDevice PhysicalDevice::createDevice(const VkPhysicalDevice physicalDevice, const uint32_t apiVersion, const std::vector<VkQueueFamilyProperties2>& queueFamilyPropertiesList, const bool bIsHeadless, bool& outbIsCalibratedTimestampsEnabled, bool& outbIsHostQueryResetEnabled) noexcept
 	{
 		VkDevice device = VK_NULL_HANDLE;
 
@@ -222,10 +249,43 @@ namespace iiixrlab::graphics
 		}
 		
 		VkPhysicalDeviceVulkan12Features physicalDeviceVulkan12Features = {};
+		outbIsHostQueryResetEnabled = false;
 		if (apiVersion >= VK_API_VERSION_1_2)
 		{
+			VkPhysicalDeviceVulkan12Features supportedVulkan12Features =
+			{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+				.pNext = nullptr,
+			};
+			VkPhysicalDeviceFeatures2 supportedFeatures2 =
+			{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+				.pNext = &supportedVulkan12Features,
+			};
+			vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedFeatures2);
+			if (isDescriptorIndexingSupported(supportedVulkan12Features) == false)
+			{
+				return VK_NULL_HANDLE;
+			}
+
 			physicalDeviceVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
 			physicalDeviceVulkan12Features.pNext = pNext;
+			// bindless descriptor set
+			physicalDeviceVulkan12Features.descriptorIndexing = VK_TRUE;
+			physicalDeviceVulkan12Features.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+			physicalDeviceVulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			physicalDeviceVulkan12Features.shaderStorageImageArrayNonUniformIndexing = VK_TRUE;
+			physicalDeviceVulkan12Features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+			physicalDeviceVulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			physicalDeviceVulkan12Features.descriptorBindingStorageImageUpdateAfterBind = VK_TRUE;
+			physicalDeviceVulkan12Features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+			physicalDeviceVulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+			physicalDeviceVulkan12Features.runtimeDescriptorArray = VK_TRUE;
+			// frame scheduling
+			physicalDeviceVulkan12Features.timelineSemaphore = VK_TRUE;
+			// gpu profiler, resolved queries are reset from the host without recording a command when supported
+			outbIsHostQueryResetEnabled = supportedVulkan12Features.hostQueryReset == VK_TRUE;
+			physicalDeviceVulkan12Features.hostQueryReset = supportedVulkan12Features.hostQueryReset;
 			pNext = &physicalDeviceVulkan12Features;
 		}
 		
@@ -295,7 +355,10 @@ namespace iiixrlab::graphics
 
 		// Extensions
 		DeviceExtensionBuilder deviceExtensionBuilder(physicalDevice);
-		deviceExtensionBuilder.AddExtension(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+		if (bIsHeadless == false)
+		{
+			deviceExtensionBuilder.AddExtension(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+		}
 
 		// VK_KHR_synchronization2
 		if (apiVersion < VK_API_VERSION_1_3)
@@ -333,6 +396,13 @@ namespace iiixrlab::graphics
 			deviceExtensionBuilder.AddExtension(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
 		}
 
+		// VK_EXT_calibrated_timestamps, optional: only needed to put gpu timings on the cpu profiler's timeline
+		outbIsCalibratedTimestampsEnabled = false;
+		if (deviceExtensionBuilder.IsExtensionAvailable(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME) == true && isCalibratedTimestampsSupported(physicalDevice) == true)
+		{
+			outbIsCalibratedTimestampsEnabled = deviceExtensionBuilder.AddExtension(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+		}
+
 		const std::vector<const char*>& extensionNamesToEnable = deviceExtensionBuilder.GetExtensionsToEnable();
 
 		VkDeviceCreateInfo deviceCreateInfo =
@@ -349,14 +419,63 @@ namespace iiixrlab::graphics
 			.pEnabledFeatures = nullptr,
 		};
 		VkResult vr = vkCreateDevice(physicalDevice, &deviceCreateInfo, nullptr, &device);
-		assert(vr == VK_SUCCESS);
+		if (vr != VK_SUCCESS)
+		{
+			std::cerr << "vkCreateDevice failed: " << vr << '\n';
+			IIIXRLAB_DEBUG_BREAK();
+			return VK_NULL_HANDLE;
+		}
 
 		volkLoadDevice(device);
 
 		return device;
 	}
 
-	void PhysicalDevice::logQueueFamilyProperties(const VkQueueFamilyProperties2& queueFamilyProperties2, const VkPhysicalDevice physicalDevice, const uint32_t queueFamilyIndex, const bool bIsSelected /*= false*/) noexcept
+	bool PhysicalDevice::isDescriptorIndexingSupported(const VkPhysicalDeviceVulkan12Features& supportedFeatures) noexcept
+	{
+		const std::pair<const char*, VkBool32> requiredFeatures[] =
+		{
+			{ "descriptorIndexing", supportedFeatures.descriptorIndexing },
+			{ "shaderStorageBufferArrayNonUniformIndexing", supportedFeatures.shaderStorageBufferArrayNonUniformIndexing },
+			{ "shaderSampledImageArrayNonUniformIndexing", supportedFeatures.shaderSampledImageArrayNonUniformIndexing },
+			{ "shaderStorageImageArrayNonUniformIndexing", supportedFeatures.shaderStorageImageArrayNonUniformIndexing },
+			{ "descriptorBindingStorageBufferUpdateAfterBind", supportedFeatures.descriptorBindingStorageBufferUpdateAfterBind },
+			{ "descriptorBindingSampledImageUpdateAfterBind", supportedFeatures.descriptorBindingSampledImageUpdateAfterBind },
+			{ "descriptorBindingStorageImageUpdateAfterBind", supportedFeatures.descriptorBindingStorageImageUpdateAfterBind },
+			{ "descriptorBindingUpdateUnusedWhilePending", supportedFeatures.descriptorBindingUpdateUnusedWhilePending },
+			{ "descriptorBindingPartiallyBound", supportedFeatures.descriptorBindingPartiallyBound },
+			{ "runtimeDescriptorArray", supportedFeatures.runtimeDescriptorArray },
+			{ "timelineSemaphore", supportedFeatures.timelineSemaphore },
+		};
+
+		bool bIsSupported = true;
+		for (const auto& [name, bIsFeatureSupported] : requiredFeatures)
+		{
+			if (bIsFeatureSupported == VK_FALSE)
+			{
+				std::cerr << "The device does not support " << name << ", which the bindless descriptor set and frame scheduling require.\n";
+				bIsSupported = false;
+			}
+		}
+		return bIsSupported;
+	}
+
+	bool PhysicalDevice::isCalibratedTimestampsSupported(const VkPhysicalDevice physicalDevice) noexcept
+	{
+		uint32_t timeDomainsCount = 0;
+		VkResult vr = vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(physicalDevice, &timeDomainsCount, nullptr);
+		assert(vr == VK_SUCCESS);
+
+		std::vector<VkTimeDomainEXT> timeDomains(timeDomainsCount);
+		vr = vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(physicalDevice, &timeDomainsCount, timeDomains.data());
+		assert(vr == VK_SUCCESS);
+
+		const bool bHasDeviceTimeDomain = std::find(timeDomains.begin(), timeDomains.end(), VK_TIME_DOMAIN_DEVICE_EXT) != timeDomains.end();
+		const bool bHasHostTimeDomain = std::find(timeDomains.begin(), timeDomains.end(), HOST_TIME_DOMAIN) != timeDomains.end();
+		return bHasDeviceTimeDomain == true && bHasHostTimeDomain == true;
+	}
+
+	void PhysicalDevice::logQueueFamilyProperties(const VkQueueFamilyProperties2& queueFamilyProperties2, const VkPhysicalDevice physicalDevice, const uint32_t queueFamilyIndex, const bool bIsHeadless, const bool bIsSelected /*= false*/) noexcept
 	{
 		const VkQueueFamilyProperties& queueFamilyProperties = queueFamilyProperties2.queueFamilyProperties;
 		std::cout << "Queue Family[" << queueFamilyIndex << "]: ";
@@ -386,14 +505,7 @@ namespace iiixrlab::graphics
 
 		std::cout << '\n';
 
-		bool bIsPresentationSupported = false;
-#if defined(_WIN32)
-		bIsPresentationSupported = vkGetPhysicalDeviceWin32PresentationSupportKHR(physicalDevice, queueFamilyIndex);
-#elif defined(__linux__)
-		bIsPresentationSupported = vkGetPhysicalDeviceXlibPresentationSupportKHR(physicalDevice, queueFamilyIndex, nullptr);
-#else
-		assert(false);
-#endif
+		const bool bIsPresentationSupported = bIsHeadless == false && isPresentationSupported(physicalDevice, queueFamilyIndex);
 		if (bIsPresentationSupported == true)
 		{
 			std::cout << "\tPresentation supported" << '\n';
@@ -403,7 +515,44 @@ namespace iiixrlab::graphics
 		<< "\tminImageTransferGranularity: " << queueFamilyProperties.minImageTransferGranularity.width << ", " << queueFamilyProperties.minImageTransferGranularity.height << ", " << queueFamilyProperties.minImageTransferGranularity.depth << '\n';
 	}
 
-	void PhysicalDevice::selectMainQueueFamilyIndex(std::vector<VkQueueFamilyProperties2>& outQueueFamilyProperties, uint32_t& outMainQueueFamilyPropertyIndex, const VkPhysicalDevice physicalDevice, const uint32_t apiVersion) noexcept
+	uint32_t PhysicalDevice::selectDedicatedQueueFamilyIndex(const std::vector<VkQueueFamilyProperties2>& queueFamilyPropertiesList, const VkQueueFlags requiredQueueFlags, const uint32_t mainQueueFamilyIndex) noexcept
+	{
+		// prefer the family with the fewest capabilities beyond the required ones, dedicated families usually map to separate hardware engines
+		constexpr const VkQueueFlags QUEUE_FLAGS_OF_INTEREST = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+		uint32_t selectedQueueFamilyIndex = mainQueueFamilyIndex;
+		int bestExtraCapabilitiesCount = INT32_MAX;
+
+		const uint32_t queueFamilyPropertiesCount = static_cast<uint32_t>(queueFamilyPropertiesList.size());
+		for (uint32_t queueFamilyIndex = 0; queueFamilyIndex < queueFamilyPropertiesCount; ++queueFamilyIndex)
+		{
+			const VkQueueFamilyProperties& queueFamilyProperties = queueFamilyPropertiesList[queueFamilyIndex].queueFamilyProperties;
+			if (queueFamilyIndex == mainQueueFamilyIndex || queueFamilyProperties.queueCount == 0 || (queueFamilyProperties.queueFlags & requiredQueueFlags) != requiredQueueFlags)
+			{
+				continue;
+			}
+
+			const int extraCapabilitiesCount = std::popcount(static_cast<uint32_t>(queueFamilyProperties.queueFlags & QUEUE_FLAGS_OF_INTEREST & ~requiredQueueFlags));
+			if (extraCapabilitiesCount < bestExtraCapabilitiesCount)
+			{
+				bestExtraCapabilitiesCount = extraCapabilitiesCount;
+				selectedQueueFamilyIndex = queueFamilyIndex;
+			}
+		}
+
+		return selectedQueueFamilyIndex;
+	}
+
+	bool PhysicalDevice::isPresentationSupported([[maybe_unused]] const VkPhysicalDevice physicalDevice, [[maybe_unused]] const uint32_t queueFamilyIndex) noexcept
+	{
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+		return vkGetPhysicalDeviceWin32PresentationSupportKHR(physicalDevice, queueFamilyIndex) == VK_TRUE;
+#else	// NOT defined(VK_USE_PLATFORM_WIN32_KHR)
+		// no window system integration outside of Windows, only headless rendering is supported there
+		return false;
+#endif	// NOT defined(VK_USE_PLATFORM_WIN32_KHR)
+	}
+
+	void PhysicalDevice::selectMainQueueFamilyIndex(std::vector<VkQueueFamilyProperties2>& outQueueFamilyProperties, uint32_t& outMainQueueFamilyPropertyIndex, const VkPhysicalDevice physicalDevice, const uint32_t apiVersion, const bool bIsHeadless) noexcept
 	{
 		uint32_t queueFamilyPropertyCount = 0;
 		PFN_vkGetPhysicalDeviceQueueFamilyProperties2 pfnVkGetPhysicalDeviceQueueFamilyProperties2 = nullptr;
@@ -430,20 +579,14 @@ namespace iiixrlab::graphics
 			const bool bIsComputeQueue = (queueFamilyProperties.queueFlags & VK_QUEUE_COMPUTE_BIT) != 0;
 			const bool bIsTransferQueue = (queueFamilyProperties.queueFlags & VK_QUEUE_TRANSFER_BIT) != 0;
 
-			bool bIsPresentationSupported = false;
-#if defined(_WIN32)
-			bIsPresentationSupported = vkGetPhysicalDeviceWin32PresentationSupportKHR(physicalDevice, queueFamilyPropertiesIndex);
-#elif defined(__linux__)
-			bIsPresentationSupported = vkGetPhysicalDeviceXlibPresentationSupportKHR(physicalDevice, queueFamilyPropertiesIndex, nullptr);
-#else
-			assert(false);
-#endif
+			// nothing is presented without a window, so any graphics family will do
+			const bool bIsPresentationSupported = bIsHeadless == true || isPresentationSupported(physicalDevice, queueFamilyPropertiesIndex);
 			if (outMainQueueFamilyPropertyIndex >= queueFamilyPropertyCount && bIsGraphicsQueue && bIsComputeQueue && bIsTransferQueue && bIsPresentationSupported)
 			{
 				outMainQueueFamilyPropertyIndex = queueFamilyPropertiesIndex;
 			}
 
-			logQueueFamilyProperties(queueFamilyProperties2, physicalDevice, queueFamilyPropertiesIndex, queueFamilyPropertiesIndex == outMainQueueFamilyPropertyIndex);
+			logQueueFamilyProperties(queueFamilyProperties2, physicalDevice, queueFamilyPropertiesIndex, bIsHeadless, queueFamilyPropertiesIndex == outMainQueueFamilyPropertyIndex);
 		}
 		assert(outMainQueueFamilyPropertyIndex < queueFamilyPropertyCount);
 	}
@@ -9,6 +9,7 @@ namespace iiixrlab::graphics
     Pipeline::Pipeline(CreateInfo& createInfo) noexcept
         : mDevice(createInfo.Device)
         , mName(createInfo.Name)
+        , mBindPoint(createInfo.BindPoint)
         , mPipelineLayout(createInfo.PipelineLayout)
         , mPipeline(createInfo.Pipeline)
         , mDescriptorSetLayouts(std::move(createInfo.DescriptorSetLayouts))
@@ -24,6 +25,7 @@ namespace iiixrlab::graphics
     Pipeline::Pipeline(Pipeline&& other) noexcept
         : mDevice(other.mDevice)
         , mName(std::move(other.mName))
+        , mBindPoint(other.mBindPoint)
         , mPipelineLayout(other.mPipelineLayout)
         , mPipeline(other.mPipeline)
         , mDescriptorSetLayouts(std::move(other.mDescriptorSetLayouts))
@@ -0,0 +1,208 @@
+#include "3dgs/Profiler.h"
+
+namespace iiixrlab
+{
+	void WriteJsonString(std::ostream& os, const std::string_view string) noexcept
+	{
+		os << '"';
+		for (const char character : string)
+		{
+			if (character == '"' || character == '\\')
+			{
+				os << '\\';
+			}
+			os << character;
+		}
+		os << '"';
+	}
+
+	// Chrome trace timestamps are microseconds
+	static void WriteMicroseconds(std::ostream& os, const int64_t nanoseconds) noexcept
+	{
+		os << nanoseconds / 1000 << '.' << static_cast<char>('0' + (nanoseconds / 100) % 10) << static_cast<char>('0' + (nanoseconds / 10) % 10) << static_cast<char>('0' + nanoseconds % 10);
+	}
+
+	Profiler& Profiler::GetInstance() noexcept
+	{
+		static Profiler instance;
+		return instance;
+	}
+
+	Profiler::Profiler() noexcept
+		: mbIsRecording(false)
+		, mStartingTimestamp(-1)
+		, mThreadBuffersMutex()
+		, mThreadBuffers()
+	{
+	}
+
+	Profiler::~Profiler() noexcept
+	{
+		mbIsRecording.store(false, std::memory_order_relaxed);
+	}
+
+	void Profiler::Start() noexcept
+	{
+		if (mStartingTimestamp < 0)
+		{
+			mStartingTimestamp = GetTimestamp();
+		}
+		mbIsRecording.store(true, std::memory_order_relaxed);
+	}
+
+	void Profiler::Stop() noexcept
+	{
+		mbIsRecording.store(false, std::memory_order_relaxed);
+	}
+
+	void Profiler::AddZone(const char* name, const int64_t beginTimestamp, const int64_t endTimestamp, const char* trackNameOrNull) noexcept
+	{
+		assert(name != nullptr);
+
+		ThreadBuffer& threadBuffer = getThreadBuffer();
+		const uint64_t writtenEventsCount = threadBuffer.WrittenEventsCount.load(std::memory_order_relaxed);
+		// an exporter which copies any of the fields below then also reads the count stored by the last event
+		std::atomic_thread_fence(std::memory_order_release);
+		EventSlot& eventSlot = threadBuffer.Events[writtenEventsCount & (EVENTS_COUNT_PER_THREAD - 1)];
+		eventSlot.Name.store(name, std::memory_order_relaxed);
+		eventSlot.TrackNameOrNull.store(trackNameOrNull, std::memory_order_relaxed);
+		eventSlot.BeginTimestamp.store(beginTimestamp, std::memory_order_relaxed);
+		eventSlot.EndTimestamp.store(endTimestamp, std::memory_order_relaxed);
+		// publishes the event to WriteChromeTrace()
+		threadBuffer.WrittenEventsCount.store(writtenEventsCount + 1, std::memory_order_release);
+	}
+
+	void Profiler::SetThreadName(const char* name) noexcept
+	{
+		assert(name != nullptr);
+
+		ThreadBuffer& threadBuffer = getThreadBuffer();
+		std::lock_guard<std::mutex> lock(mThreadBuffersMutex);
+		threadBuffer.Name = name;
+	}
+
+	void Profiler::WriteChromeTrace(std::ostream& os) const noexcept
+	{
+		constexpr uint32_t CPU_PROCESS_ID = 0;
+		constexpr uint32_t TRACKS_PROCESS_ID = 1;
+
+		std::lock_guard<std::mutex> lock(mThreadBuffersMutex);
+
+		bool bIsFirstEvent = true;
+		const auto beginEvent = [&os, &bIsFirstEvent]()
+		{
+			os << (bIsFirstEvent == true ? "\n\t" : ",\n\t");
+			bIsFirstEvent = false;
+		};
+
+		os << "{\n\"displayTimeUnit\": \"ms\",\n\"traceEvents\": [";
+
+		beginEvent();
+		os << "{ \"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << CPU_PROCESS_ID << ", \"args\": { \"name\": \"CPU\" } }";
+		beginEvent();
+		os << "{ \"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << TRACKS_PROCESS_ID << ", \"args\": { \"name\": \"GPU\" } }";
+
+		// tracks are numbered in order of appearance, their names are compared by content
+		std::vector<const char*> trackNames;
+		std::vector<Event> events;
+		for (const std::unique_ptr<ThreadBuffer>& threadBuffer : mThreadBuffers)
+		{
+			beginEvent();
+			os << "{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << CPU_PROCESS_ID << ", \"tid\": " << threadBuffer->ThreadIndex << ", \"args\": { \"name\": ";
+			WriteJsonString(os, threadBuffer->Name);
+			os << " } }";
+
+			const uint64_t writtenEventsCount = threadBuffer->WrittenEventsCount.load(std::memory_order_acquire);
+			const uint64_t firstEventIndex = writtenEventsCount > EVENTS_COUNT_PER_THREAD ? writtenEventsCount - EVENTS_COUNT_PER_THREAD : 0;
+			events.clear();
+			for (uint64_t eventIndex = firstEventIndex; eventIndex < writtenEventsCount; ++eventIndex)
+			{
+				const EventSlot& eventSlot = threadBuffer->Events[eventIndex & (EVENTS_COUNT_PER_THREAD - 1)];
+				events.push_back(Event
+				{
+					.Name = eventSlot.Name.load(std::memory_order_relaxed),
+					.TrackNameOrNull = eventSlot.TrackNameOrNull.load(std::memory_order_relaxed),
+					.BeginTimestamp = eventSlot.BeginTimestamp.load(std::memory_order_relaxed),
+					.EndTimestamp = eventSlot.EndTimestamp.load(std::memory_order_relaxed),
+				});
+			}
+
+			// the owning thread may have kept recording while copying, drop whatever it overwrote meanwhile
+			// including the slot of the event it may be writing right now. The fence pairs with the one of AddZone():
+			// a copied field of a later event implies a count at least as recent as the event before it
+			std::atomic_thread_fence(std::memory_order_acquire);
+			const uint64_t rewrittenEventsCount = threadBuffer->WrittenEventsCount.load(std::memory_order_relaxed) + 1;
+			const uint64_t overwrittenEventsCount = rewrittenEventsCount > EVENTS_COUNT_PER_THREAD + firstEventIndex ? std::min<uint64_t>(rewrittenEventsCount - EVENTS_COUNT_PER_THREAD - firstEventIndex, events.size()) : 0;
+
+			for (size_t eventIndex = static_cast<size_t>(overwrittenEventsCount); eventIndex < events.size(); ++eventIndex)
+			{
+				const Event& event = events[eventIndex];
+				if (event.EndTimestamp < mStartingTimestamp)
+				{
+					continue;
+				}
+
+				uint32_t processId = CPU_PROCESS_ID;
+				uint32_t trackIndex = threadBuffer->ThreadIndex;
+				if (event.TrackNameOrNull != nullptr)
+				{
+					auto trackNameIt = std::find_if(trackNames.begin(), trackNames.end(), [&event](const char* trackName) { return strcmp(trackName, event.TrackNameOrNull) == 0; });
+					if (trackNameIt == trackNames.end())
+					{
+						trackNameIt = trackNames.insert(trackNames.end(), event.TrackNameOrNull);
+						beginEvent();
+						os << "{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << TRACKS_PROCESS_ID << ", \"tid\": " << trackNames.size() - 1 << ", \"args\": { \"name\": ";
+						WriteJsonString(os, event.TrackNameOrNull);
+						os << " } }";
+					}
+					processId = TRACKS_PROCESS_ID;
+					trackIndex = static_cast<uint32_t>(trackNameIt - trackNames.begin());
+				}
+
+				beginEvent();
+				os << "{ \"name\": ";
+				WriteJsonString(os, event.Name);
+				os << ", \"ph\": \"X\", \"pid\": " << processId << ", \"tid\": " << trackIndex << ", \"ts\": ";
+				WriteMicroseconds(os, std::max<int64_t>(event.BeginTimestamp - mStartingTimestamp, 0));
+				os << ", \"dur\": ";
+				WriteMicroseconds(os, std::max<int64_t>(event.EndTimestamp - std::max(event.BeginTimestamp, mStartingTimestamp), 0));
+				os << " }";
+			}
+		}
+
+		os << "\n]\n}\n";
+	}
+
+	bool Profiler::WriteChromeTrace(const std::filesystem::path& path) const noexcept
+	{
+		std::ofstream file(path);
+		if (file.is_open() == false)
+		{
+			std::cerr << "Failed to open " << path << " for the trace.\n";
+			return false;
+		}
+
+		WriteChromeTrace(file);
+		return file.good();
+	}
+
+	Profiler::ThreadBuffer& Profiler::getThreadBuffer() noexcept
+	{
+		// buffers are owned by the profiler, so the zones of threads that already exited are still exported
+		thread_local ThreadBuffer* threadBufferOrNull = nullptr;
+		if (threadBufferOrNull != nullptr)
+		{
+			return *threadBufferOrNull;
+		}
+
+		std::lock_guard<std::mutex> lock(mThreadBuffersMutex);
+		std::unique_ptr<ThreadBuffer> threadBuffer = std::make_unique<ThreadBuffer>();
+		threadBuffer->ThreadIndex = static_cast<uint32_t>(mThreadBuffers.size());
+		threadBuffer->Name = "Thread " + std::to_string(threadBuffer->ThreadIndex);
+		threadBuffer->Events = std::make_unique<EventSlot[]>(EVENTS_COUNT_PER_THREAD);
+		threadBuffer->WrittenEventsCount.store(0, std::memory_order_relaxed);
+		threadBufferOrNull = threadBuffer.get();
+		mThreadBuffers.push_back(std::move(threadBuffer));
+		return *threadBufferOrNull;
+	}
+} // namespace iiixrlab
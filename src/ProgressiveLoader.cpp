@@ -0,0 +1,186 @@
+#include "3dgs/scene/ProgressiveLoader.h"
+
+#include "3dgs/Profiler.h"
+#include "3dgs/scene/Scene.h"
+#include "3dgs/scene/SceneCache.h"
+#include "3dgs/scene/SpatialReorder.h"
+
+namespace iiixrlab::scene
+{
+	// Points [firstPointIndex, firstPointIndex + pointsCount), along with the whole codebook when quantized unless an earlier
+	// batch already carries it.
+	static std::unique_ptr<GaussianInfo> CopyGaussians(const GaussianInfo& gaussianInfo, const uint32_t firstPointIndex, const uint32_t pointsCount, const bool bCopiesShCodebook) noexcept
+	{
+		const auto copyRange = [firstPointIndex, pointsCount]<typename T>(const std::vector<T>& elements, const size_t elementsCount, std::vector<T>& outElements)
+		{
+			if (elements.empty() == false)
+			{
+				outElements.assign(elements.begin() + firstPointIndex * elementsCount, elements.begin() + (firstPointIndex + static_cast<size_t>(pointsCount)) * elementsCount);
+			}
+		};
+
+		std::unique_ptr<GaussianInfo> rangeGaussianInfo = std::make_unique<GaussianInfo>();
+		rangeGaussianInfo->NumPoints = pointsCount;
+		rangeGaussianInfo->ShDegree = gaussianInfo.ShDegree;
+		rangeGaussianInfo->isAntialiased = gaussianInfo.isAntialiased;
+		copyRange(gaussianInfo.Positions, 3, rangeGaussianInfo->Positions);
+		copyRange(gaussianInfo.Scales, 3, rangeGaussianInfo->Scales);
+		copyRange(gaussianInfo.Rotations, 4, rangeGaussianInfo->Rotations);
+		copyRange(gaussianInfo.Alphas, 1, rangeGaussianInfo->Alphas);
+		copyRange(gaussianInfo.Colors, 3, rangeGaussianInfo->Colors);
+		copyRange(gaussianInfo.SphericalHarmonics, GetShCoefficientsCount(gaussianInfo.ShDegree), rangeGaussianInfo->SphericalHarmonics);
+		copyRange(gaussianInfo.ShIndices, 1, rangeGaussianInfo->ShIndices);
+		if (bCopiesShCodebook == true)
+		{
+			rangeGaussianInfo->ShCodebook = gaussianInfo.ShCodebook;
+		}
+		return rangeGaussianInfo;
+	}
+
+	ProgressiveLoader::ProgressiveLoader(const CreateInfo& createInfo) noexcept
+		: mCreateInfo(createInfo)
+		, mMutex()
+		, mBatches()
+		, mbIsStopping(false)
+		, mbIsLoaded(false)
+		, mThread()
+	{
+		mThread = std::thread(&ProgressiveLoader::load, this);
+	}
+
+	ProgressiveLoader::~ProgressiveLoader() noexcept
+	{
+		mbIsStopping = true;
+		if (mThread.joinable() == true)
+		{
+			mThread.join();
+		}
+	}
+
+	bool ProgressiveLoader::IsLoading() const noexcept
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mbIsLoaded == false || mBatches.empty() == false;
+	}
+
+	bool ProgressiveLoader::TryPop(Batch& outBatch) noexcept
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mBatches.empty() == true)
+		{
+			return false;
+		}
+
+		outBatch = std::move(mBatches.front());
+		mBatches.pop_front();
+		return true;
+	}
+
+	void ProgressiveLoader::load() noexcept
+	{
+		IIIXRLAB_PROFILE_THREAD("ProgressiveLoader");
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		const uint32_t chunkPointsCount = std::max(mCreateInfo.ChunkPointsCount, 1u);
+
+		// a cache written with a preview is read range by range, nothing else has to be loaded first
+		if (mCreateInfo.SyntheticSceneInfo.PointsCount == 0 && mCreateInfo.ModelPath.extension() == SCENE_CACHE_EXTENSION)
+		{
+			SceneCacheReader reader(mCreateInfo.ModelPath, mCreateInfo.FileReadInfo);
+			if (reader.IsOpen() == true && reader.GetPreviewPointsCount() > 0)
+			{
+				// the codebook is read and uploaded once, with the first batch
+				bool bIsShCodebookPushed = false;
+				std::unique_ptr<GaussianInfo> previewGaussianInfo = std::make_unique<GaussianInfo>();
+				if (reader.Read(0, reader.GetPreviewPointsCount(), *previewGaussianInfo) == true)
+				{
+					GrowPreviewScales(*previewGaussianInfo, static_cast<float>(reader.GetPointsCount()) / static_cast<float>(reader.GetPreviewPointsCount()));
+					bIsShCodebookPushed = previewGaussianInfo->ShCodebook.empty() == false;
+					push(std::move(previewGaussianInfo), true);
+				}
+
+				for (uint32_t firstPointIndex = 0; firstPointIndex < reader.GetPointsCount() && mbIsStopping == false; firstPointIndex += chunkPointsCount)
+				{
+					std::unique_ptr<GaussianInfo> chunkGaussianInfo = std::make_unique<GaussianInfo>();
+					if (reader.Read(firstPointIndex, std::min(chunkPointsCount, reader.GetPointsCount() - firstPointIndex), *chunkGaussianInfo, bIsShCodebookPushed == false) == false)
+					{
+						break;
+					}
+					bIsShCodebookPushed = bIsShCodebookPushed == true || chunkGaussianInfo->ShCodebook.empty() == false;
+					push(std::move(chunkGaussianInfo), false);
+				}
+
+				mbIsLoaded = true;
+				return;
+			}
+		}
+
+		Scene scene = mCreateInfo.SyntheticSceneInfo.PointsCount > 0 ? Scene(GenerateGaussians(mCreateInfo.SyntheticSceneInfo)) : Scene(mCreateInfo.ModelPath, mCreateInfo.FileReadInfo);
+		GaussianInfo& gaussianInfo = scene.GetGaussianInfo();
+		const uint32_t pointsCount = gaussianInfo.NumPoints;
+		if (pointsCount > 0 && mbIsStopping == false)
+		{
+			const uint32_t previewStride = GetPreviewStride(pointsCount, mCreateInfo.PreviewStride, mCreateInfo.MaxPreviewPointsCount);
+			PermuteGaussians(gaussianInfo, ComputeProgressiveOrder(gaussianInfo, previewStride, { .Curve = mCreateInfo.Curve, .ThreadsCount = mCreateInfo.ThreadsCount }), mCreateInfo.ThreadsCount);
+
+			const uint32_t previewPointsCount = (pointsCount + previewStride - 1) / previewStride;
+			std::unique_ptr<GaussianInfo> previewGaussianInfo = CopyGaussians(gaussianInfo, 0, previewPointsCount, true);
+			GrowPreviewScales(*previewGaussianInfo, static_cast<float>(pointsCount) / static_cast<float>(previewPointsCount));
+			push(std::move(previewGaussianInfo), true);
+
+			for (uint32_t firstPointIndex = 0; firstPointIndex < pointsCount && mbIsStopping == false; firstPointIndex += chunkPointsCount)
+			{
+				push(CopyGaussians(gaussianInfo, firstPointIndex, std::min(chunkPointsCount, pointsCount - firstPointIndex), false), false);
+			}
+		}
+
+		mbIsLoaded = true;
+	}
+
+	void ProgressiveLoader::push(std::unique_ptr<GaussianInfo>&& gaussianInfo, const bool bIsPreview) noexcept
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		// quantized without a codebook of its own
+		const bool bSharesShCodebook = gaussianInfo->ShIndices.empty() == false && gaussianInfo->ShCodebook.empty() == true;
+		mBatches.push_back({ .GaussianInfo = std::move(gaussianInfo), .bIsPreview = bIsPreview, .bSharesShCodebook = bSharesShCodebook });
+	}
+
+	uint32_t GetPreviewStride(const uint32_t pointsCount, const uint32_t previewStride, const uint32_t maxPreviewPointsCount) noexcept
+	{
+		const uint32_t minPreviewStride = static_cast<uint32_t>((static_cast<uint64_t>(pointsCount) + maxPreviewPointsCount - 1) / std::max(maxPreviewPointsCount, 1u));
+		return std::max({ previewStride, minPreviewStride, 1u });
+	}
+
+	std::vector<uint32_t> ComputeProgressiveOrder(const GaussianInfo& gaussianInfo, const uint32_t previewStride, const SpatialReorderInfo& reorderInfo) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		const std::vector<uint32_t> spatialOrder = ComputeSpatialOrder(gaussianInfo, reorderInfo);
+		const uint32_t stride = std::max(previewStride, 1u);
+		std::vector<uint32_t> order;
+		order.reserve(spatialOrder.size());
+		for (size_t pointIndex = 0; pointIndex < spatialOrder.size(); pointIndex += stride)
+		{
+			order.push_back(spatialOrder[pointIndex]);
+		}
+		for (size_t pointIndex = 0; pointIndex < spatialOrder.size(); ++pointIndex)
+		{
+			if (pointIndex % stride != 0)
+			{
+				order.push_back(spatialOrder[pointIndex]);
+			}
+		}
+
+		return order;
+	}
+
+	void GrowPreviewScales(GaussianInfo& inoutGaussianInfo, const float previewStride) noexcept
+	{
+		// scales are stored as logarithms
+		const float logScaleGrowth = std::log(std::max(previewStride, 1.0f)) / 3.0f;
+		for (float& scale : inoutGaussianInfo.Scales)
+		{
+			scale += logScaleGrowth;
+		}
+	}
+} // namespace iiixrlab::scene
@@ -0,0 +1,445 @@
+#include "3dgs/scene/Pruning.h"
+
+#include "3dgs/Profiler.h"
+#include "3dgs/ThreadPool.h"
+#include "3dgs/scene/SpatialReorder.h"
+#include "3dgs/scene/SplatSorter.h"
+
+namespace iiixrlab::scene
+{
+	static constexpr const uint32_t POINTS_COUNT_PER_CHUNK = 1 << 16;
+	static constexpr const uint32_t ROWS_COUNT_PER_BAND = 16;
+	static constexpr const float SH_C0 = 0.28209479177387814f;
+	static constexpr const float NEAR_DEPTH = 0.2f;
+	static constexpr const float LOW_PASS_VARIANCE = 0.3f;		// in pixels, keeps every splat at least about a pixel wide
+	static constexpr const float MIN_ALPHA = 1.0f / 255.0f;
+	static constexpr const float MAX_ALPHA = 0.99f;
+	static constexpr const float MIN_TRANSMITTANCE = 1.0e-4f;
+
+	// A gaussian projected onto the pixels of a view, culled when its opacity is 0.
+	struct ProjectedSplat final
+	{
+		float X;
+		float Y;
+		float ConicA;							// inverse of the 2D covariance, a b / b c
+		float ConicB;
+		float ConicC;
+		float Opacity;
+		float Color[3];
+		int32_t MinX;							// inclusive pixel bounds of three standard deviations
+		int32_t MaxX;
+		int32_t MinY;
+		int32_t MaxY;
+	};
+
+	// Buffers kept between the views.
+	struct RasterizerScratch final
+	{
+		std::vector<ProjectedSplat> Splats;
+		SplatSorter Sorter;
+		std::vector<std::vector<uint32_t>> BandSplatIndices;	// front to back
+		std::vector<std::vector<float>> BandContributions;		// along BandSplatIndices
+		std::vector<double> BandSquaredErrors;
+	};
+
+	static ProjectedSplat ProjectSplat(const GaussianInfo& gaussianInfo, const uint32_t pointIndex, const Camera::Info& view, const uint32_t width, const uint32_t height) noexcept
+	{
+		ProjectedSplat splat = {};
+
+		// row vectors, the view space coordinate j of p is the dot product of p with the column j
+		const math::Matrix4x4f& viewMatrix = view.View;
+		const math::Matrix4x4f& projection = view.Projection;
+		const float* position = &gaussianInfo.Positions[static_cast<size_t>(pointIndex) * 3];
+		float viewPosition[3];
+		for (uint8_t columnIndex = 0; columnIndex < 3; ++columnIndex)
+		{
+			viewPosition[columnIndex] = position[0] * viewMatrix(0, columnIndex) + position[1] * viewMatrix(1, columnIndex) + position[2] * viewMatrix(2, columnIndex) + viewMatrix(3, columnIndex);
+		}
+		if (viewPosition[2] < NEAR_DEPTH)
+		{
+			return splat;
+		}
+
+		float clipPosition[4];
+		for (uint8_t columnIndex = 0; columnIndex < 4; ++columnIndex)
+		{
+			clipPosition[columnIndex] = viewPosition[0] * projection(0, columnIndex) + viewPosition[1] * projection(1, columnIndex) + viewPosition[2] * projection(2, columnIndex) + projection(3, columnIndex);
+		}
+		splat.X = (clipPosition[0] / clipPosition[3] * 0.5f + 0.5f) * static_cast<float>(width) - 0.5f;
+		splat.Y = (clipPosition[1] / clipPosition[3] * 0.5f + 0.5f) * static_cast<float>(height) - 0.5f;
+
+		// world space covariance R S S^T R^T, the quaternion is x y z w
+		const float* rotation = &gaussianInfo.Rotations[static_cast<size_t>(pointIndex) * 4];
+		const float rotationLength = std::sqrt(rotation[0] * rotation[0] + rotation[1] * rotation[1] + rotation[2] * rotation[2] + rotation[3] * rotation[3]);
+		if (rotationLength <= 0.0f)
+		{
+			return splat;
+		}
+		const float qx = rotation[0] / rotationLength;
+		const float qy = rotation[1] / rotationLength;
+		const float qz = rotation[2] / rotationLength;
+		const float qw = rotation[3] / rotationLength;
+		const float rotationMatrix[3][3] =
+		{
+			{ 1.0f - 2.0f * (qy * qy + qz * qz), 2.0f * (qx * qy - qw * qz), 2.0f * (qx * qz + qw * qy) },
+			{ 2.0f * (qx * qy + qw * qz), 1.0f - 2.0f * (qx * qx + qz * qz), 2.0f * (qy * qz - qw * qx) },
+			{ 2.0f * (qx * qz - qw * qy), 2.0f * (qy * qz + qw * qx), 1.0f - 2.0f * (qx * qx + qy * qy) },
+		};
+		const float* scale = &gaussianInfo.Scales[static_cast<size_t>(pointIndex) * 3];
+		float scaledRotation[3][3];
+		for (uint32_t rowIndex = 0; rowIndex < 3; ++rowIndex)
+		{
+			for (uint32_t columnIndex = 0; columnIndex < 3; ++columnIndex)
+			{
+				scaledRotation[rowIndex][columnIndex] = rotationMatrix[rowIndex][columnIndex] * std::exp(scale[columnIndex]);
+			}
+		}
+
+		// Jacobian of the perspective divide at the center, with the view directions clamped like the reference does for
+		// splats far off screen
+		const float focalX = projection(0, 0) * 0.5f * static_cast<float>(width);
+		const float focalY = projection(1, 1) * 0.5f * static_cast<float>(height);
+		const float limitX = 1.3f / projection(0, 0);
+		const float limitY = 1.3f / projection(1, 1);
+		const float depth = viewPosition[2];
+		const float directionX = std::clamp(viewPosition[0] / depth, -limitX, limitX);
+		const float directionY = std::clamp(viewPosition[1] / depth, -limitY, limitY);
+		const float jacobian[2][3] =
+		{
+			{ focalX / depth, 0.0f, -focalX * directionX / depth },
+			{ 0.0f, focalY / depth, -focalY * directionY / depth },
+		};
+
+		// T = J W, W maps world directions to view ones, then the 2D covariance is (T M)(T M)^T with M = R S
+		float transform[2][3];
+		for (uint32_t rowIndex = 0; rowIndex < 2; ++rowIndex)
+		{
+			for (uint8_t columnIndex = 0; columnIndex < 3; ++columnIndex)
+			{
+				transform[rowIndex][columnIndex] = jacobian[rowIndex][0] * viewMatrix(columnIndex, 0) + jacobian[rowIndex][1] * viewMatrix(columnIndex, 1) + jacobian[rowIndex][2] * viewMatrix(columnIndex, 2);
+			}
+		}
+		float projectedAxes[2][3];
+		for (uint32_t rowIndex = 0; rowIndex < 2; ++rowIndex)
+		{
+			for (uint32_t columnIndex = 0; columnIndex < 3; ++columnIndex)
+			{
+				projectedAxes[rowIndex][columnIndex] = transform[rowIndex][0] * scaledRotation[0][columnIndex] + transform[rowIndex][1] * scaledRotation[1][columnIndex] + transform[rowIndex][2] * scaledRotation[2][columnIndex];
+			}
+		}
+		const float covarianceA = projectedAxes[0][0] * projectedAxes[0][0] + projectedAxes[0][1] * projectedAxes[0][1] + projectedAxes[0][2] * projectedAxes[0][2] + LOW_PASS_VARIANCE;
+		const float covarianceB = projectedAxes[0][0] * projectedAxes[1][0] + projectedAxes[0][1] * projectedAxes[1][1] + projectedAxes[0][2] * projectedAxes[1][2];
+		const float covarianceC = projectedAxes[1][0] * projectedAxes[1][0] + projectedAxes[1][1] * projectedAxes[1][1] + projectedAxes[1][2] * projectedAxes[1][2] + LOW_PASS_VARIANCE;
+		const float determinant = covarianceA * covarianceC - covarianceB * covarianceB;
+		if (determinant <= 0.0f)
+		{
+			return splat;
+		}
+
+		const float middle = 0.5f * (covarianceA + covarianceC);
+		const float radius = std::ceil(3.0f * std::sqrt(middle + std::sqrt(std::max(middle * middle - determinant, 0.1f))));
+		if (splat.X + radius < 0.0f || splat.X - radius > static_cast<float>(width) || splat.Y + radius < 0.0f || splat.Y - radius > static_cast<float>(height))
+		{
+			return splat;
+		}
+		splat.MinX = std::max(static_cast<int32_t>(std::floor(splat.X - radius)), 0);
+		splat.MaxX = std::min(static_cast<int32_t>(std::ceil(splat.X + radius)), static_cast<int32_t>(width) - 1);
+		splat.MinY = std::max(static_cast<int32_t>(std::floor(splat.Y - radius)), 0);
+		splat.MaxY = std::min(static_cast<int32_t>(std::ceil(splat.Y + radius)), static_cast<int32_t>(height) - 1);
+		if (splat.MinX > splat.MaxX || splat.MinY > splat.MaxY)
+		{
+			return splat;
+		}
+
+		splat.ConicA = covarianceC / determinant;
+		splat.ConicB = -covarianceB / determinant;
+		splat.ConicC = covarianceA / determinant;
+		for (uint32_t channelIndex = 0; channelIndex < 3; ++channelIndex)
+		{
+			splat.Color[channelIndex] = std::max(0.5f + SH_C0 * gaussianInfo.Colors[static_cast<size_t>(pointIndex) * 3 + channelIndex], 0.0f);
+		}
+		splat.Opacity = 1.0f / (1.0f + std::exp(-gaussianInfo.Alphas[pointIndex]));
+		return splat;
+	}
+
+	// Blends the view front to back over a black background, one band of rows per task. The blending weights of every
+	// splat are added to the contributions when they are given. With the kept flags the kept splats are blended into a
+	// second image on the way, whose squared error against the full one is returned.
+	static double RasterizeView(const GaussianInfo& gaussianInfo, const Camera::Info& view, const uint32_t width, const uint32_t height, ThreadPool& threadPool, RasterizerScratch& scratch, const std::vector<uint8_t>* keptOrNull, std::vector<float>* contributionsOrNull) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		const uint32_t pointsCount = gaussianInfo.NumPoints;
+		scratch.Splats.resize(pointsCount);
+		for (uint32_t firstPointIndex = 0; firstPointIndex < pointsCount; firstPointIndex += POINTS_COUNT_PER_CHUNK)
+		{
+			const uint32_t lastPointIndex = std::min(firstPointIndex + POINTS_COUNT_PER_CHUNK, pointsCount);
+			threadPool.Submit([&gaussianInfo, &view, width, height, &scratch, firstPointIndex, lastPointIndex]()
+			{
+				for (uint32_t pointIndex = firstPointIndex; pointIndex < lastPointIndex; ++pointIndex)
+				{
+					scratch.Splats[pointIndex] = ProjectSplat(gaussianInfo, pointIndex, view, width, height);
+				}
+			});
+		}
+		threadPool.Wait();
+
+		scratch.Sorter.ComputeDepthKeys(gaussianInfo, view.View);
+		scratch.Sorter.Sort();
+
+		const uint32_t bandsCount = (height + ROWS_COUNT_PER_BAND - 1) / ROWS_COUNT_PER_BAND;
+		scratch.BandSplatIndices.resize(bandsCount);
+		scratch.BandContributions.resize(bandsCount);
+		scratch.BandSquaredErrors.assign(bandsCount, 0.0);
+		for (std::vector<uint32_t>& splatIndices : scratch.BandSplatIndices)
+		{
+			splatIndices.clear();
+		}
+		const std::vector<uint32_t>& sortedIndices = scratch.Sorter.GetSortedIndices();
+		for (auto iterator = sortedIndices.rbegin(); iterator != sortedIndices.rend(); ++iterator)
+		{
+			const ProjectedSplat& splat = scratch.Splats[*iterator];
+			if (splat.Opacity <= 0.0f)
+			{
+				continue;
+			}
+			for (int32_t bandIndex = splat.MinY / static_cast<int32_t>(ROWS_COUNT_PER_BAND); bandIndex <= splat.MaxY / static_cast<int32_t>(ROWS_COUNT_PER_BAND); ++bandIndex)
+			{
+				scratch.BandSplatIndices[bandIndex].push_back(*iterator);
+			}
+		}
+
+		for (uint32_t bandIndex = 0; bandIndex < bandsCount; ++bandIndex)
+		{
+			threadPool.Submit([width, height, &scratch, keptOrNull, contributionsOrNull, bandIndex]()
+			{
+				const int32_t firstRow = static_cast<int32_t>(bandIndex * ROWS_COUNT_PER_BAND);
+				const int32_t lastRow = std::min(firstRow + static_cast<int32_t>(ROWS_COUNT_PER_BAND), static_cast<int32_t>(height)) - 1;
+				const size_t pixelsCount = static_cast<size_t>(lastRow - firstRow + 1) * width;
+				std::vector<float> transmittances(pixelsCount, 1.0f);
+				std::vector<float> colors(pixelsCount * 3, 0.0f);
+				std::vector<float> keptTransmittances(keptOrNull != nullptr ? pixelsCount : 0, 1.0f);
+				std::vector<float> keptColors(keptOrNull != nullptr ? pixelsCount * 3 : 0, 0.0f);
+
+				const std::vector<uint32_t>& splatIndices = scratch.BandSplatIndices[bandIndex];
+				std::vector<float>& contributions = scratch.BandContributions[bandIndex];
+				contributions.assign(contributionsOrNull != nullptr ? splatIndices.size() : 0, 0.0f);
+				for (size_t splatIndex = 0; splatIndex < splatIndices.size(); ++splatIndex)
+				{
+					const ProjectedSplat& splat = scratch.Splats[splatIndices[splatIndex]];
+					const bool bIsKept = keptOrNull != nullptr && (*keptOrNull)[splatIndices[splatIndex]] != 0;
+					// below it alpha is under MIN_ALPHA, which skips the exponential for most of the bounds
+					const float minPower = std::log(MIN_ALPHA / splat.Opacity);
+					float contribution = 0.0f;
+					for (int32_t row = std::max(splat.MinY, firstRow); row <= std::min(splat.MaxY, lastRow); ++row)
+					{
+						const float deltaY = static_cast<float>(row) - splat.Y;
+						for (int32_t column = splat.MinX; column <= splat.MaxX; ++column)
+						{
+							const float deltaX = static_cast<float>(column) - splat.X;
+							const float power = -0.5f * (splat.ConicA * deltaX * deltaX + splat.ConicC * deltaY * deltaY) - splat.ConicB * deltaX * deltaY;
+							if (power > 0.0f || power < minPower)
+							{
+								continue;
+							}
+							const float alpha = std::min(splat.Opacity * std::exp(power), MAX_ALPHA);
+							if (alpha < MIN_ALPHA)
+							{
+								continue;
+							}
+
+							const size_t pixelIndex = static_cast<size_t>(row - firstRow) * width + static_cast<size_t>(column);
+							const float transmittance = transmittances[pixelIndex];
+							if (transmittance >= MIN_TRANSMITTANCE)
+							{
+								const float weight = alpha * transmittance;
+								contribution += weight;
+								for (uint32_t channelIndex = 0; channelIndex < 3; ++channelIndex)
+								{
+									colors[pixelIndex * 3 + channelIndex] += weight * splat.Color[channelIndex];
+								}
+								transmittances[pixelIndex] = transmittance * (1.0f - alpha);
+							}
+
+							if (bIsKept == true && keptTransmittances[pixelIndex] >= MIN_TRANSMITTANCE)
+							{
+								const float weight = alpha * keptTransmittances[pixelIndex];
+								for (uint32_t channelIndex = 0; channelIndex < 3; ++channelIndex)
+								{
+									keptColors[pixelIndex * 3 + channelIndex] += weight * splat.Color[channelIndex];
+								}
+								keptTransmittances[pixelIndex] *= 1.0f - alpha;
+							}
+						}
+					}
+
+					if (contributionsOrNull != nullptr)
+					{
+						contributions[splatIndex] = contribution;
+					}
+				}
+
+				if (keptOrNull != nullptr)
+				{
+					double squaredError = 0.0;
+					for (size_t channelIndex = 0; channelIndex < colors.size(); ++channelIndex)
+					{
+						const double difference = std::min(colors[channelIndex], 1.0f) - std::min(keptColors[channelIndex], 1.0f);
+						squaredError += difference * difference;
+					}
+					scratch.BandSquaredErrors[bandIndex] = squaredError;
+				}
+			});
+		}
+		threadPool.Wait();
+
+		// in band order so the sums do not depend on the threads count
+		double squaredError = 0.0;
+		for (uint32_t bandIndex = 0; bandIndex < bandsCount; ++bandIndex)
+		{
+			if (contributionsOrNull != nullptr)
+			{
+				const std::vector<uint32_t>& splatIndices = scratch.BandSplatIndices[bandIndex];
+				const std::vector<float>& contributions = scratch.BandContributions[bandIndex];
+				for (size_t splatIndex = 0; splatIndex < splatIndices.size(); ++splatIndex)
+				{
+					(*contributionsOrNull)[splatIndices[splatIndex]] += contributions[splatIndex];
+				}
+			}
+			squaredError += scratch.BandSquaredErrors[bandIndex];
+		}
+
+		return squaredError;
+	}
+
+	static void GetRenderExtent(const uint32_t width, const uint32_t height, const uint32_t maxRenderExtent, uint32_t& outWidth, uint32_t& outHeight) noexcept
+	{
+		const float scale = std::min(static_cast<float>(std::max(maxRenderExtent, 1u)) / static_cast<float>(std::max({ width, height, 1u })), 1.0f);
+		outWidth = std::max(static_cast<uint32_t>(std::lround(static_cast<float>(width) * scale)), 1u);
+		outHeight = std::max(static_cast<uint32_t>(std::lround(static_cast<float>(height) * scale)), 1u);
+	}
+
+	static uint32_t GetThreadsCount(const uint32_t threadsCount) noexcept
+	{
+		return threadsCount > 0 ? threadsCount : std::max(std::thread::hardware_concurrency(), 1u);
+	}
+
+	std::vector<float> ComputeContributions(const GaussianInfo& gaussianInfo, const std::vector<Camera::Info>& views, const uint32_t width, const uint32_t height, const PruneInfo& pruneInfo) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		std::vector<float> contributions(gaussianInfo.NumPoints, 0.0f);
+		if (views.empty() == true)
+		{
+			return contributions;
+		}
+
+		uint32_t renderWidth = 0;
+		uint32_t renderHeight = 0;
+		GetRenderExtent(width, height, pruneInfo.MaxRenderExtent, renderWidth, renderHeight);
+
+		ThreadPool threadPool({ .ThreadsCount = GetThreadsCount(pruneInfo.ThreadsCount) });
+		RasterizerScratch scratch;
+		for (const Camera::Info& view : views)
+		{
+			RasterizeView(gaussianInfo, view, renderWidth, renderHeight, threadPool, scratch, nullptr, &contributions);
+		}
+
+		const float scale = static_cast<float>(width) * static_cast<float>(height) / (static_cast<float>(renderWidth) * static_cast<float>(renderHeight) * static_cast<float>(views.size()));
+		for (float& contribution : contributions)
+		{
+			contribution *= scale;
+		}
+
+		return contributions;
+	}
+
+	bool PruneGaussians(GaussianInfo& inoutGaussianInfo, const PruneInfo& pruneInfo, const std::vector<Camera::Info>& views, const uint32_t width, const uint32_t height, PruneStatistics& outStatistics) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		const uint32_t pointsCount = inoutGaussianInfo.NumPoints;
+		outStatistics =
+		{
+			.PointsCount = pointsCount,
+			.OpacityPrunedCount = 0,
+			.ExtentPrunedCount = 0,
+			.ContributionPrunedCount = 0,
+			.RemovedContributionFraction = 0.0f,
+			.Psnr = std::numeric_limits<float>::infinity(),
+		};
+
+		const bool bIsContributionTested = pruneInfo.MinContribution > 0.0f && views.empty() == false;
+		const std::vector<float> contributions = views.empty() == false ? ComputeContributions(inoutGaussianInfo, views, width, height, pruneInfo) : std::vector<float>();
+
+		const float minAlpha = pruneInfo.MinOpacity > 0.0f ? std::log(pruneInfo.MinOpacity / std::max(1.0f - pruneInfo.MinOpacity, 1.0e-7f)) : -std::numeric_limits<float>::infinity();
+		const float minLogScale = pruneInfo.MinExtent > 0.0f ? std::log(pruneInfo.MinExtent) : -std::numeric_limits<float>::infinity();
+		std::vector<uint8_t> kept(pointsCount, 0);
+		std::vector<uint32_t> order;
+		order.reserve(pointsCount);
+		double totalContribution = 0.0;
+		double removedContribution = 0.0;
+		for (uint32_t pointIndex = 0; pointIndex < pointsCount; ++pointIndex)
+		{
+			const float* scale = &inoutGaussianInfo.Scales[static_cast<size_t>(pointIndex) * 3];
+			const float contribution = contributions.empty() == false ? contributions[pointIndex] : 0.0f;
+			totalContribution += contribution;
+			if (inoutGaussianInfo.Alphas[pointIndex] < minAlpha)
+			{
+				++outStatistics.OpacityPrunedCount;
+			}
+			else if (std::max({ scale[0], scale[1], scale[2] }) < minLogScale)
+			{
+				++outStatistics.ExtentPrunedCount;
+			}
+			else if (bIsContributionTested == true && contribution < pruneInfo.MinContribution)
+			{
+				++outStatistics.ContributionPrunedCount;
+			}
+			else
+			{
+				kept[pointIndex] = 1;
+				order.push_back(pointIndex);
+				continue;
+			}
+			removedContribution += contribution;
+		}
+
+		if (order.size() == pointsCount)
+		{
+			return false;
+		}
+
+		// an empty scene has nothing to upload or draw
+		if (order.empty() == true)
+		{
+			std::cerr << "The thresholds prune every gaussian, the scene is kept unpruned.\n";
+			outStatistics.OpacityPrunedCount = 0;
+			outStatistics.ExtentPrunedCount = 0;
+			outStatistics.ContributionPrunedCount = 0;
+			return false;
+		}
+
+		if (views.empty() == false)
+		{
+			outStatistics.RemovedContributionFraction = totalContribution > 0.0 ? static_cast<float>(removedContribution / totalContribution) : 0.0f;
+
+			uint32_t renderWidth = 0;
+			uint32_t renderHeight = 0;
+			GetRenderExtent(width, height, pruneInfo.MaxRenderExtent, renderWidth, renderHeight);
+
+			ThreadPool threadPool({ .ThreadsCount = GetThreadsCount(pruneInfo.ThreadsCount) });
+			RasterizerScratch scratch;
+			double squaredError = 0.0;
+			for (const Camera::Info& view : views)
+			{
+				squaredError += RasterizeView(inoutGaussianInfo, view, renderWidth, renderHeight, threadPool, scratch, &kept, nullptr);
+			}
+			const double meanSquaredError = squaredError / (static_cast<double>(renderWidth) * renderHeight * 3 * views.size());
+			outStatistics.Psnr = meanSquaredError > 0.0 ? static_cast<float>(-10.0 * std::log10(meanSquaredError)) : std::numeric_limits<float>::infinity();
+		}
+
+		PermuteGaussians(inoutGaussianInfo, order, pruneInfo.ThreadsCount);
+		return true;
+	}
+} // namespace iiixrlab::scene
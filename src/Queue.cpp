@@ -23,7 +23,7 @@ namespace iiixrlab::graphics
     void Queue::Present(SwapChain& swapChain, FrameResource& frameResource) noexcept
     {
         VkSemaphore semaphore = frameResource.GetRenderFinishedSemaphore();
-        uint32_t frameIndex = frameResource.GetFrameIndex();
+        uint32_t backBufferIndex = frameResource.GetBackBufferIndex();
         VkPresentInfoKHR presentInfo =
         {
             .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
@@ -32,7 +32,7 @@ namespace iiixrlab::graphics
             .pWaitSemaphores = &semaphore,
             .swapchainCount = 1,
             .pSwapchains = &swapChain.mSwapChain,
-            .pImageIndices = &frameIndex,
+            .pImageIndices = &backBufferIndex,
             .pResults = nullptr,
         };
         VkResult vr = vkQueuePresentKHR(mQueue, &presentInfo);
@@ -47,30 +47,77 @@ namespace iiixrlab::graphics
         }
     }
 
-    void Queue::Submit(FrameResource& frameResource) noexcept
+    void Queue::Submit(CommandBuffer& commandBuffer, const std::vector<VkSemaphoreSubmitInfo>& waitSemaphoreSubmitInfos, const std::vector<VkSemaphoreSubmitInfo>& signalSemaphoreSubmitInfos) noexcept
     {
-        VkSemaphore waitSemaphore = frameResource.GetPresentCompleteSemaphore();
-        VkSemaphore signalSemaphore = frameResource.GetRenderFinishedSemaphore();
-        VkFence fence = frameResource.GetWaitFence();
-        VkPipelineStageFlags waitDstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-        CommandBuffer& commandBuffer = frameResource.GetCommandBuffer();
+        VkCommandBufferSubmitInfo commandBufferSubmitInfo =
+        {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+            .pNext = nullptr,
+            .commandBuffer = commandBuffer.mCommandBuffer,
+            .deviceMask = 0,
+        };
 
-        VkSubmitInfo submitInfo =
+        VkSubmitInfo2 submitInfo =
         {
-            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
             .pNext = nullptr,
-            .waitSemaphoreCount = 1,
-            .pWaitSemaphores = &waitSemaphore,
-            .pWaitDstStageMask = &waitDstStageMask,
-            .commandBufferCount = 1,
-            .pCommandBuffers = &commandBuffer.mCommandBuffer,
-            .signalSemaphoreCount = 1,
-            .pSignalSemaphores = &signalSemaphore,
+            .flags = 0,
+            .waitSemaphoreInfoCount = static_cast<uint32_t>(waitSemaphoreSubmitInfos.size()),
+            .pWaitSemaphoreInfos = waitSemaphoreSubmitInfos.data(),
+            .commandBufferInfoCount = 1,
+            .pCommandBufferInfos = &commandBufferSubmitInfo,
+            .signalSemaphoreInfoCount = static_cast<uint32_t>(signalSemaphoreSubmitInfos.size()),
+            .pSignalSemaphoreInfos = signalSemaphoreSubmitInfos.data(),
         };
-        VkResult vr = vkQueueSubmit(mQueue, 1, &submitInfo, fence);
+        VkResult vr = vkQueueSubmit2(mQueue, 1, &submitInfo, VK_NULL_HANDLE);
         assert(vr == VK_SUCCESS);
     }
 
+    void Queue::Submit(FrameResource& frameResource) noexcept
+    {
+        // extra waits (e.g. finished uploads) come first, the present semaphore gates the color attachment output
+        std::vector<VkSemaphoreSubmitInfo> waitSemaphoreSubmitInfos = frameResource.GetWaitSemaphoreSubmitInfos();
+
+        // the timeline value recycles the frame resource, the binary semaphore gates presentation
+        std::vector<VkSemaphoreSubmitInfo> signalSemaphoreSubmitInfos =
+        {
+            {
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                .pNext = nullptr,
+                .semaphore = frameResource.GetTimelineSemaphore(),
+                .value = frameResource.GetTimelineValue(),
+                .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                .deviceIndex = 0,
+            },
+        };
+
+        // a headless frame neither acquires nor presents an image
+        if (frameResource.IsHeadless() == false)
+        {
+            waitSemaphoreSubmitInfos.push_back(
+            {
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                .pNext = nullptr,
+                .semaphore = frameResource.GetPresentCompleteSemaphore(),
+                .value = 0,
+                .stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                .deviceIndex = 0,
+            });
+
+            signalSemaphoreSubmitInfos.push_back(
+            {
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                .pNext = nullptr,
+                .semaphore = frameResource.GetRenderFinishedSemaphore(),
+                .value = 0,
+                .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                .deviceIndex = 0,
+            });
+        }
+
+        Submit(frameResource.GetCommandBuffer(), waitSemaphoreSubmitInfos, signalSemaphoreSubmitInfos);
+    }
+
     void Queue::Wait() noexcept
     {
         vkQueueWaitIdle(mQueue);
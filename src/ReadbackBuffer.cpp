@@ -0,0 +1,14 @@
+#include "3dgs/graphics/ReadbackBuffer.h"
+
+#include "3dgs/graphics/Device.h"
+
+namespace iiixrlab::graphics
+{
+	ReadbackBuffer::ReadbackBuffer(const CreateInfo& createInfo, const bool bIsCoherent) noexcept
+		: Buffer(createInfo)
+		, mMappedData(nullptr)
+		, mbIsCoherent(bIsCoherent)
+	{
+		mDevice.MapMemory(*this, reinterpret_cast<void**>(&mMappedData));
+	}
+} // namespace iiixrlab::graphics
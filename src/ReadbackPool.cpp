@@ -0,0 +1,152 @@
+#include "3dgs/graphics/ReadbackPool.h"
+
+#include "3dgs/graphics/Device.h"
+#include "3dgs/graphics/ReadbackBuffer.h"
+
+namespace iiixrlab::graphics
+{
+	ReadbackView::ReadbackView(ReadbackPool& pool, ReadbackBuffer& buffer, const VkExtent2D extent, const uint64_t timelineValue) noexcept
+		: mPoolOrNull(&pool)
+		, mBufferOrNull(&buffer)
+		, mExtent(extent)
+		, mTimelineValue(timelineValue)
+	{
+	}
+
+	ReadbackView::ReadbackView(ReadbackView&& other) noexcept
+		: mPoolOrNull(other.mPoolOrNull)
+		, mBufferOrNull(other.mBufferOrNull)
+		, mExtent(other.mExtent)
+		, mTimelineValue(other.mTimelineValue)
+	{
+		other.mPoolOrNull = nullptr;
+		other.mBufferOrNull = nullptr;
+	}
+
+	ReadbackView& ReadbackView::operator=(ReadbackView&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			mPoolOrNull = other.mPoolOrNull;
+			mBufferOrNull = other.mBufferOrNull;
+			mExtent = other.mExtent;
+			mTimelineValue = other.mTimelineValue;
+			other.mPoolOrNull = nullptr;
+			other.mBufferOrNull = nullptr;
+		}
+
+		return *this;
+	}
+
+	ReadbackView::~ReadbackView() noexcept
+	{
+		release();
+	}
+
+	const uint8_t* ReadbackView::GetData() const noexcept
+	{
+		return mBufferOrNull != nullptr ? mBufferOrNull->GetMappedData() : nullptr;
+	}
+
+	void ReadbackView::release() noexcept
+	{
+		if (mBufferOrNull == nullptr)
+		{
+			return;
+		}
+
+		mPoolOrNull->release(*mBufferOrNull);
+		mPoolOrNull = nullptr;
+		mBufferOrNull = nullptr;
+	}
+
+	ReadbackPool::ReadbackPool(const CreateInfo& createInfo) noexcept
+		: mDevice(createInfo.Device)
+		, mBufferSize(createInfo.BufferSize)
+		, mMutex()
+		, mBuffers()
+		, mFreeBuffers()
+		, mPendingReadbacks()
+	{
+		assert(mBufferSize > 0);
+
+		mBuffers.reserve(createInfo.InitialBuffersCount);
+		mFreeBuffers.reserve(createInfo.InitialBuffersCount);
+		for (uint32_t bufferIndex = 0; bufferIndex < createInfo.InitialBuffersCount; ++bufferIndex)
+		{
+			mBuffers.push_back(mDevice.CreateReadbackBuffer("Readback Buffer", mBufferSize));
+			mFreeBuffers.push_back(mBuffers.back().get());
+		}
+	}
+
+	ReadbackPool::~ReadbackPool() noexcept
+	{
+		assert(mFreeBuffers.size() + mPendingReadbacks.size() == mBuffers.size());
+		mPendingReadbacks.clear();
+		mFreeBuffers.clear();
+		mBuffers.clear();
+	}
+
+	ReadbackBuffer& ReadbackPool::Acquire(const VkSemaphore timelineSemaphore, const uint64_t timelineValue, const VkExtent2D extent) noexcept
+	{
+		assert(static_cast<size_t>(extent.width) * extent.height * 4 <= mBufferSize);
+
+		ReadbackBuffer* bufferOrNull = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			if (mFreeBuffers.empty() == true)
+			{
+				// consumers still hold every buffer, the pool settles at the depth they need
+				mBuffers.push_back(mDevice.CreateReadbackBuffer("Readback Buffer", mBufferSize));
+				mFreeBuffers.push_back(mBuffers.back().get());
+			}
+
+			bufferOrNull = mFreeBuffers.back();
+			mFreeBuffers.pop_back();
+		}
+
+		mPendingReadbacks.push_back(PendingReadback
+		{
+			.Buffer = bufferOrNull,
+			.TimelineSemaphore = timelineSemaphore,
+			.TimelineValue = timelineValue,
+			.Extent = extent,
+		});
+
+		return *bufferOrNull;
+	}
+
+	ReadbackView ReadbackPool::Pop(const bool bWait) noexcept
+	{
+		if (mPendingReadbacks.empty() == true)
+		{
+			return ReadbackView();
+		}
+
+		const PendingReadback pendingReadback = mPendingReadbacks.front();
+		if (bWait == true)
+		{
+			mDevice.WaitForSemaphore(pendingReadback.TimelineSemaphore, pendingReadback.TimelineValue);
+		}
+		else if (mDevice.GetSemaphoreCounterValue(pendingReadback.TimelineSemaphore) < pendingReadback.TimelineValue)
+		{
+			return ReadbackView();
+		}
+		mPendingReadbacks.pop_front();
+
+		// cached memory is not necessarily coherent, the device writes have to be made visible to the host
+		if (pendingReadback.Buffer->IsCoherent() == false)
+		{
+			mDevice.InvalidateMappedMemory(*pendingReadback.Buffer);
+		}
+
+		return ReadbackView(*this, *pendingReadback.Buffer, pendingReadback.Extent, pendingReadback.TimelineValue);
+	}
+
+	void ReadbackPool::release(ReadbackBuffer& buffer) noexcept
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mFreeBuffers.push_back(&buffer);
+	}
+} // namespace iiixrlab::graphics
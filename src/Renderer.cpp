@@ -4,52 +4,134 @@
 #include "3dgs/graphics/CommandPool.h"
 #include "3dgs/graphics/Device.h"
 #include "3dgs/graphics/FrameResource.h"
+#include "3dgs/graphics/GpuProfiler.h"
 #include "3dgs/graphics/Instance.h"
 #include "3dgs/graphics/IRenderScene.hpp"
 #include "3dgs/graphics/PhysicalDevice.h"
 #include "3dgs/graphics/Queue.h"
+#include "3dgs/graphics/ReadbackPool.h"
 #include "3dgs/graphics/Shader.h"
 #include "3dgs/graphics/ShaderManager.h"
 #include "3dgs/graphics/SwapChain.h"
 #include "3dgs/graphics/Texture.h"
+#include "3dgs/graphics/Uploader.h"
 
 #include "3dgs/scene/Camera.h"
 
+#include "3dgs/Profiler.h"
 #include "3dgs/Window.h"
 
 namespace iiixrlab::graphics
 {
 	Renderer::Renderer(const RendererCreateInfo& createInfo) noexcept
 		: mRenderScene()
-		, mInstance(std::make_unique<Instance>(Instance::CreateInfo{.ApplicationInfo = createInfo.ApplicationInfo, .EngineInfo = createInfo.EngineInfo}))
+		, mInstance(std::make_unique<Instance>(Instance::CreateInfo{.ApplicationInfo = createInfo.ApplicationInfo, .EngineInfo = createInfo.EngineInfo, .bIsHeadless = createInfo.WindowOrNull == nullptr}))
 		, mFrameResources()
 		, mCurrentFrameIndex(0)
+		, mFrameTimelineSemaphore(VK_NULL_HANDLE)
+		, mFrameTimelineValue(0)
+		, mComputeCommandPool()
+		, mComputeTimelineSemaphore(VK_NULL_HANDLE)
+		, mComputeTimelineValue(0)
+		, mReadbackPoolOrNull()
+		, mReadbackCallback()
+		, mGpuProfiler()
+		, mFrameScopeIndex(GpuProfiler::INVALID_SCOPE_INDEX)
 	{
+		assert(createInfo.FramesCount > 0);
+
 		Device& device = mInstance->GetPhysicalDevice().GetDevice();
-		SwapChain& swapChain = mInstance->InitializeSwapChain(createInfo.FramesCount, createInfo.Window);
+		SwapChain* swapChainOrNull = nullptr;
+		if (createInfo.WindowOrNull != nullptr)
+		{
+			swapChainOrNull = &mInstance->InitializeSwapChain(createInfo.BackBuffersCount, *createInfo.WindowOrNull);
+		}
+		else
+		{
+			assert(createInfo.HeadlessExtent.width > 0 && createInfo.HeadlessExtent.height > 0);
+		}
+
 		CommandPool& commandPool = mInstance->GetPhysicalDevice().GetDevice().InitializeCommandPool();
-		const uint32_t framesCount = swapChain.GetFramesCount();
+		const uint32_t framesCount = createInfo.FramesCount;
 		commandPool.AllocateCommandBuffers("CommandBuffer", framesCount);
 
-		for (uint32_t frameBufferIndex = 0; frameBufferIndex < framesCount; ++frameBufferIndex)
+		mFrameTimelineSemaphore = device.CreateTimelineSemaphore("Frame Timeline Semaphore");
+
+		mComputeCommandPool = device.CreateCommandPool("Compute Command Pool", mInstance->GetPhysicalDevice().GetComputeQueueFamilyIndex());
+		mComputeCommandPool->AllocateCommandBuffers("ComputeCommandBuffer", framesCount);
+		mComputeTimelineSemaphore = device.CreateTimelineSemaphore("Compute Timeline Semaphore");
+
+		mGpuProfiler = device.CreateGpuProfiler("Frame GPU Profiler", framesCount);
+
+		std::vector<char> offscreenColorName(64);
+		std::vector<char> offscreenDepthName(64);
+		for (uint32_t frameIndex = 0; frameIndex < framesCount; ++frameIndex)
 		{			
 			FrameResource::CreateInfo frameResourceCreateInfo =
 			{
 				.Device = device,
-				.SwapChain = swapChain,
-				.CommandBuffer = commandPool.GetCommandBuffer(frameBufferIndex),
-				.BackBuffer = *swapChain.GetBackBuffer(frameBufferIndex).Color,
-				.DepthBuffer = *swapChain.GetBackBuffer(frameBufferIndex).Depth,
-				.FrameIndex = frameBufferIndex,
+				.SwapChainOrNull = swapChainOrNull,
+				.CommandBuffer = commandPool.GetCommandBuffer(frameIndex),
+				.ComputeCommandBuffer = mComputeCommandPool->GetCommandBuffer(frameIndex),
+				.TimelineSemaphore = mFrameTimelineSemaphore,
+				.FrameIndex = frameIndex,
 				.FramesCount = framesCount,
 			};
+
+			if (swapChainOrNull == nullptr)
+			{
+				// one target per frame in flight, so a frame's image stays readable until the frame is recycled
+				const VkExtent3D extent = { .width = createInfo.HeadlessExtent.width, .height = createInfo.HeadlessExtent.height, .depth = 1 };
+
+#if defined(_DEBUG)
+				snprintf(offscreenColorName.data(), offscreenColorName.size(), "Offscreen Color[%u]", frameIndex);
+#endif	// defined(_DEBUG)
+				TextureCreateInfo offscreenColorCreateInfo =
+				{
+#if defined(_DEBUG)
+					.Name = offscreenColorName.data(),
+#endif	// defined(_DEBUG)
+					.Format = VK_FORMAT_R8G8B8A8_SRGB,
+					.Usage = static_cast<uint8_t>(Texture::eUsageType::COLOR_ATTACHMENT) | static_cast<uint8_t>(Texture::eUsageType::TRANSFER_SRC),
+					.Extent = extent,
+				};
+				frameResourceCreateInfo.OffscreenColorOrNull = device.CreateTexture(offscreenColorCreateInfo);
+
+#if defined(_DEBUG)
+				snprintf(offscreenDepthName.data(), offscreenDepthName.size(), "Offscreen Depth[%u]", frameIndex);
+#endif	// defined(_DEBUG)
+				TextureCreateInfo offscreenDepthCreateInfo =
+				{
+#if defined(_DEBUG)
+					.Name = offscreenDepthName.data(),
+#endif	// defined(_DEBUG)
+					.Format = VK_FORMAT_D32_SFLOAT,
+					.Usage = static_cast<uint8_t>(Texture::eUsageType::DEPTH_STENCIL),
+					.Extent = extent,
+				};
+				frameResourceCreateInfo.OffscreenDepthOrNull = device.CreateTexture(offscreenDepthCreateInfo);
+			}
+
 			mFrameResources.push_back(std::make_unique<FrameResource>(frameResourceCreateInfo));
 		}
+
+		if (swapChainOrNull == nullptr && createInfo.bIsReadbackEnabled == true)
+		{
+			// one buffer per frame in flight to begin with, the pool grows while consumers hold on to views
+			ReadbackPool::CreateInfo readbackPoolCreateInfo =
+			{
+				.Device = device,
+				.BufferSize = createInfo.HeadlessExtent.width * createInfo.HeadlessExtent.height * 4,
+				.InitialBuffersCount = framesCount,
+			};
+			mReadbackPoolOrNull = std::make_unique<ReadbackPool>(readbackPoolCreateInfo);
+		}
 	}
 
 	Renderer::~Renderer() noexcept
 	{
 		Device& device = mInstance->GetPhysicalDevice().GetDevice();
+		device.GetComputeQueue().Wait();
 		device.GetQueue().Wait();
 		
 		if (mRenderScene != nullptr)
@@ -62,44 +144,179 @@ namespace iiixrlab::graphics
 			frameResource.reset();
 		}
 		mFrameResources.clear();
+		mReadbackCallback = nullptr;
+		mReadbackPoolOrNull.reset();
+		mGpuProfiler.reset();
+		device.DestroySemaphore(mFrameTimelineSemaphore);
+		mComputeCommandPool.reset();
+		device.DestroySemaphore(mComputeTimelineSemaphore);
 		mInstance.reset();
 	}
 
+	void Renderer::Flush() noexcept
+	{
+		IIIXRLAB_PROFILE_ZONE("Renderer::Flush");
+
+		// the frame at the current index is the oldest submission, timings are resolved oldest first as well
+		const uint32_t framesCount = GetFramesCount();
+		for (uint32_t offset = 0; offset < framesCount; ++offset)
+		{
+			const uint32_t frameIndex = (mCurrentFrameIndex + offset) % framesCount;
+			mFrameResources[frameIndex]->Wait();
+			mGpuProfiler->BeginSlot(frameIndex);
+		}
+
+		readBack();
+	}
+
 	void Renderer::Render() noexcept
 	{
+		IIIXRLAB_PROFILE_ZONE("Renderer::Render");
+
 		FrameResource& currentFrameResource = *mFrameResources[mCurrentFrameIndex];
 		Device& device = mInstance->GetPhysicalDevice().GetDevice();
-		SwapChain& swapChain = mInstance->GetSwapChain();
 		
 		CommandBuffer& commandBuffer = currentFrameResource.GetCommandBuffer();
 
+		// begun outside of rendering, where the profiler can reset its queries without hostQueryReset
+		const uint32_t drawScopeIndex = mGpuProfiler->BeginScope(commandBuffer, "Draw");
 		commandBuffer.BeginRender();
 		
 		mRenderScene->Render(commandBuffer);
+		mGpuProfiler->EndScope(commandBuffer, drawScopeIndex);
+		mGpuProfiler->EndScope(commandBuffer, mFrameScopeIndex);
+
+		currentFrameResource.SetTimelineValue(++mFrameTimelineValue);
+		if (mReadbackPoolOrNull != nullptr)
+		{
+			// the copy completes with the frame's submission, so the pool tracks it by the frame's timeline value
+			currentFrameResource.SetReadbackBuffer(&mReadbackPoolOrNull->Acquire(mFrameTimelineSemaphore, mFrameTimelineValue, currentFrameResource.GetExtent()));
+		}
 
 		currentFrameResource.End();
 
 		Queue& queue = device.GetQueue();
 		queue.Submit(currentFrameResource);
-		queue.Present(swapChain, currentFrameResource);
-		mCurrentFrameIndex = (mCurrentFrameIndex + 1) % swapChain.GetFramesCount();
+		if (mInstance->IsHeadless() == false)
+		{
+			queue.Present(mInstance->GetSwapChain(), currentFrameResource);
+		}
+		mCurrentFrameIndex = (mCurrentFrameIndex + 1) % static_cast<uint32_t>(mFrameResources.size());
 	}
 
 	void Renderer::Update(const float deltaTime) noexcept
 	{
+		IIIXRLAB_PROFILE_ZONE("Renderer::Update");
+
+		// waits only for the submission that last used this frame's resources
 		FrameResource& currentFrameResource = *mFrameResources[mCurrentFrameIndex];
-		currentFrameResource.Wait();
+		{
+			IIIXRLAB_PROFILE_ZONE("WaitForFrame");
+			currentFrameResource.Wait();
+		}
+		readBack();
+		mGpuProfiler->BeginSlot(mCurrentFrameIndex);
 
+		// images may come back in any order, the frame simply renders into whichever one is acquired
 		Device& device = mInstance->GetPhysicalDevice().GetDevice();
-		SwapChain& swapChain = mInstance->GetSwapChain();
-		uint32_t imageIndex = device.AcquireNextImage(swapChain, currentFrameResource.GetPresentCompleteSemaphore(), VK_NULL_HANDLE);
-		assert(mCurrentFrameIndex == imageIndex);
-		mCurrentFrameIndex = imageIndex;
+		uint32_t imageIndex = 0;
+		if (mInstance->IsHeadless() == false)
+		{
+			imageIndex = device.AcquireNextImage(mInstance->GetSwapChain(), currentFrameResource.GetPresentCompleteSemaphore(), VK_NULL_HANDLE);
+		}
+
+		currentFrameResource.Begin(imageIndex);
 
-		currentFrameResource.Begin();
+		// adopt the uploads that finished since the last frame before the scene records anything reading them
+		Uploader& uploader = device.GetUploader();
+		uploader.Acquire(currentFrameResource);
 
 		CommandBuffer& commandBuffer = currentFrameResource.GetCommandBuffer();
+		mFrameScopeIndex = mGpuProfiler->BeginScope(commandBuffer, "Frame");
 
 		mRenderScene->Update(commandBuffer, deltaTime);
+
+		preprocess(currentFrameResource);
+
+		uploader.Flush();
+	}
+
+	const Texture& Renderer::GetColorAttachment() const noexcept
+	{
+		return (mInstance->IsHeadless() == true) ? mFrameResources[0]->GetBackBuffer() : *mInstance->GetSwapChain().GetBackBuffer(0).Color;
+	}
+
+	const Texture& Renderer::GetDepthAttachment() const noexcept
+	{
+		return (mInstance->IsHeadless() == true) ? mFrameResources[0]->GetDepthBuffer() : *mInstance->GetSwapChain().GetBackBuffer(0).Depth;
+	}
+
+	VkExtent2D Renderer::GetExtent() const noexcept
+	{
+		return (mInstance->IsHeadless() == true) ? mFrameResources[0]->GetExtent() : mInstance->GetSwapChain().GetExtent();
+	}
+
+	void Renderer::preprocess(FrameResource& frameResource) noexcept
+	{
+		if (mRenderScene->HasPreprocess() == false)
+		{
+			return;
+		}
+
+		frameResource.BeginCompute();
+		CommandBuffer& computeCommandBuffer = frameResource.GetComputeCommandBuffer();
+		const uint32_t preprocessScopeIndex = mGpuProfiler->BeginScope(computeCommandBuffer, "Preprocess");
+		mRenderScene->Preprocess(computeCommandBuffer);
+		mGpuProfiler->EndScope(computeCommandBuffer, preprocessScopeIndex);
+		frameResource.EndCompute();
+
+		// submitted right away so it runs on the compute queue while the previous frame is still rasterizing
+		Device& device = mInstance->GetPhysicalDevice().GetDevice();
+		const Uploader& uploader = device.GetUploader();
+		std::vector<VkSemaphoreSubmitInfo> waitSemaphoreSubmitInfos;
+		if (uploader.GetAcquiredTimelineValue() > 0)
+		{
+			waitSemaphoreSubmitInfos.push_back(
+			{
+				.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+				.pNext = nullptr,
+				.semaphore = uploader.GetTimelineSemaphore(),
+				.value = uploader.GetAcquiredTimelineValue(),
+				.stageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+				.deviceIndex = 0,
+			});
+		}
+
+		++mComputeTimelineValue;
+		const VkSemaphoreSubmitInfo signalSemaphoreSubmitInfo =
+		{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+			.pNext = nullptr,
+			.semaphore = mComputeTimelineSemaphore,
+			.value = mComputeTimelineValue,
+			.stageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+			.deviceIndex = 0,
+		};
+		device.GetComputeQueue().Submit(computeCommandBuffer, waitSemaphoreSubmitInfos, { signalSemaphoreSubmitInfo });
+
+		// the frame's own timeline value then also covers its compute work when the frame resource is recycled
+		frameResource.AddWaitSemaphore(mComputeTimelineSemaphore, mComputeTimelineValue, VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+	}
+
+	void Renderer::readBack() noexcept
+	{
+		if (mReadbackPoolOrNull == nullptr)
+		{
+			return;
+		}
+
+		// every completed readback is handed over, including frames that finished ahead of the one being recycled
+		for (ReadbackView readbackView = mReadbackPoolOrNull->Pop(); readbackView.IsValid() == true; readbackView = mReadbackPoolOrNull->Pop())
+		{
+			if (mReadbackCallback)
+			{
+				mReadbackCallback(std::move(readbackView));
+			}
+		}
 	}
-}
\ No newline at end of file
+}
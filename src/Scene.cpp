@@ -1,9 +1,15 @@
 #include "3dgs/scene/Scene.h"
 
+#include "3dgs/scene/SceneCache.h"
+
+#include "3dgs/Profiler.h"
+
 namespace iiixrlab::scene
 {
-    Scene::Scene(const std::filesystem::path& modelPath) noexcept
+    Scene::Scene(const std::filesystem::path& modelPath, const FileReadInfo& fileReadInfo) noexcept
     {
+        IIIXRLAB_PROFILE_ZONE("Scene::Scene");
+
         std::ifstream modelFile(modelPath);
         if (modelFile.is_open() == false)
         {
@@ -23,7 +29,14 @@ namespace iiixrlab::scene
 		else if (extension == ".spz")
 		{
 			std::cout << "Loading spz file " << modelPath << "!!" << '\n';
-			spz::GaussianCloud gaussianCloud = spz::loadSpz(modelPath.string());
+			// the file is read with many reads in flight before spz decompresses it
+			std::vector<uint8_t> spzData;
+			if (AsyncFileReader(modelPath, fileReadInfo).ReadAll(spzData) == false)
+			{
+				assert(false);
+				return;
+			}
+			spz::GaussianCloud gaussianCloud = spz::loadSpz(spzData);
 	
 			mGaussianInfo.NumPoints = gaussianCloud.numPoints;
 			mGaussianInfo.ShDegree = gaussianCloud.shDegree;
@@ -37,8 +50,23 @@ namespace iiixrlab::scene
 	
 			return;
 		}
+		else if (extension == SCENE_CACHE_EXTENSION)
+		{
+			std::cout << "Loading scene cache " << modelPath << "!!" << '\n';
+			if (LoadSceneCache(modelPath, mGaussianInfo, fileReadInfo) == false)
+			{
+				assert(false);
+			}
+
+			return;
+		}
 	
 		std::cout << "Invalid file extension " << extension << "!!" << std::endl;
 		assert(false);
     }
+
+    Scene::Scene(GaussianInfo&& gaussianInfo) noexcept
+        : mGaussianInfo(std::move(gaussianInfo))
+    {
+    }
 }
\ No newline at end of file
@@ -0,0 +1,267 @@
+#include "3dgs/scene/SceneCache.h"
+
+#include "3dgs/Profiler.h"
+
+namespace iiixrlab::scene
+{
+	static constexpr const char MAGIC[4] = { '3', 'D', 'G', 'S' };
+	static constexpr const uint32_t VERSION = 3;
+	static constexpr const uint32_t ANTIALIASED_FLAG = 1u << 0;
+
+	struct SceneCacheHeader final
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint32_t PointsCount;
+		uint32_t ShDegree;
+		uint32_t ShCodebookEntriesCount;	// 0 when the spherical harmonics are not quantized
+		uint32_t PreviewPointsCount;		// 0 when the points are not ordered for progressive loading
+		uint32_t ChunksCount;
+		uint32_t Flags;
+	};
+
+	// Every array is prefixed with its elements count.
+	template <typename T>
+	static void WriteArray(std::ofstream& file, const std::vector<T>& elements) noexcept
+	{
+		const uint64_t elementsCount = elements.size();
+		file.write(reinterpret_cast<const char*>(&elementsCount), sizeof(elementsCount));
+		file.write(reinterpret_cast<const char*>(elements.data()), static_cast<std::streamsize>(elements.size() * sizeof(T)));
+	}
+
+	// Sizes the elements to be read into by the range, so every array of a read goes out at once.
+	template <typename T>
+	static FileReadRange GetElementsRange(const uint64_t offset, const uint64_t elementsCount, std::vector<T>& outElements) noexcept
+	{
+		outElements.resize(elementsCount);
+		return { .Offset = offset, .Size = elementsCount * sizeof(T), .Destination = outElements.data() };
+	}
+
+	SceneCacheReader::SceneCacheReader(const std::filesystem::path& path, const FileReadInfo& fileReadInfo) noexcept
+		: mPath(path)
+		, mFile(path, fileReadInfo)
+		, mbIsOpen(false)
+		, mPointsCount(0)
+		, mShDegree(0)
+		, mShCodebookEntriesCount(0)
+		, mPreviewPointsCount(0)
+		, mbIsAntialiased(false)
+		, mArrayOffsets()
+		, mChunks()
+	{
+		if (mFile.IsOpen() == false)
+		{
+			std::cerr << "Unable to open scene cache " << path << ".\n";
+			return;
+		}
+
+		SceneCacheHeader header = {};
+		const FileReadRange headerRange = { .Offset = 0, .Size = sizeof(header), .Destination = &header };
+		if (mFile.GetFileSize() < sizeof(header) || mFile.Read(std::span<const FileReadRange>(&headerRange, 1)) == false || memcmp(header.Magic, MAGIC, sizeof(MAGIC)) != 0 || header.Version != VERSION || header.ShDegree > 3 || header.PreviewPointsCount > header.PointsCount)
+		{
+			std::cerr << path << " is not a scene cache of version " << VERSION << ".\n";
+			return;
+		}
+
+		const uint64_t pointsCount = header.PointsCount;
+		const uint64_t shCoefficientsCount = GetShCoefficientsCount(header.ShDegree);
+		const bool bIsQuantized = header.ShCodebookEntriesCount > 0;
+		const std::array<uint64_t, eArray::COUNT> elementsCounts =
+		{
+			pointsCount * 3,
+			pointsCount * 3,
+			pointsCount * 4,
+			pointsCount,
+			pointsCount * 3,
+			bIsQuantized == true ? 0 : pointsCount * shCoefficientsCount,
+			header.ShCodebookEntriesCount * shCoefficientsCount,
+			bIsQuantized == true ? pointsCount : 0,
+			header.ChunksCount,
+		};
+		static constexpr const std::array<uint64_t, eArray::COUNT> ELEMENT_SIZES =
+		{
+			sizeof(float), sizeof(float), sizeof(float), sizeof(float), sizeof(float), sizeof(float), sizeof(float), sizeof(uint16_t), sizeof(SceneChunk),
+		};
+
+		// the arrays follow each other, so the offsets are found by skipping over them
+		uint64_t offset = sizeof(header);
+		bool bAreArraysValid = true;
+		for (uint32_t arrayIndex = 0; arrayIndex < eArray::COUNT; ++arrayIndex)
+		{
+			uint64_t elementsCount = 0;
+			const FileReadRange elementsCountRange = { .Offset = offset, .Size = sizeof(elementsCount), .Destination = &elementsCount };
+			if (offset + sizeof(elementsCount) > mFile.GetFileSize() || mFile.Read(std::span<const FileReadRange>(&elementsCountRange, 1)) == false || elementsCount != elementsCounts[arrayIndex])
+			{
+				bAreArraysValid = false;
+				break;
+			}
+
+			mArrayOffsets[arrayIndex] = offset + sizeof(elementsCount);
+			offset = mArrayOffsets[arrayIndex] + elementsCount * ELEMENT_SIZES[arrayIndex];
+		}
+
+		if (bAreArraysValid == false || mFile.GetFileSize() < offset)
+		{
+			std::cerr << "Scene cache " << path << " is truncated or does not match its header.\n";
+			return;
+		}
+
+		const FileReadRange chunksRange = GetElementsRange(mArrayOffsets[eArray::CHUNKS], header.ChunksCount, mChunks);
+		if (mFile.Read(std::span<const FileReadRange>(&chunksRange, 1)) == false)
+		{
+			std::cerr << "Failed to read the chunks of scene cache " << path << ".\n";
+			mChunks.clear();
+			return;
+		}
+		for (const SceneChunk& chunk : mChunks)
+		{
+			if (chunk.FirstPointIndex > header.PointsCount || chunk.PointsCount > header.PointsCount - chunk.FirstPointIndex)
+			{
+				std::cerr << "Scene cache " << path << " has a chunk past its points.\n";
+				mChunks.clear();
+				return;
+			}
+		}
+
+		mPointsCount = header.PointsCount;
+		mShDegree = header.ShDegree;
+		mShCodebookEntriesCount = header.ShCodebookEntriesCount;
+		mPreviewPointsCount = header.PreviewPointsCount;
+		mbIsAntialiased = (header.Flags & ANTIALIASED_FLAG) != 0;
+		mbIsOpen = true;
+	}
+
+	bool SceneCacheReader::Read(const uint32_t firstPointIndex, const uint32_t pointsCount, GaussianInfo& outGaussianInfo, const bool bReadsShCodebook) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		if (IsOpen() == false || firstPointIndex > mPointsCount || pointsCount > mPointsCount - firstPointIndex)
+		{
+			std::cerr << "Points " << firstPointIndex << " to " << static_cast<uint64_t>(firstPointIndex) + pointsCount << " are not in scene cache " << mPath << ".\n";
+			IIIXRLAB_DEBUG_BREAK();
+			return false;
+		}
+
+		const uint64_t shCoefficientsCount = mShCodebookEntriesCount > 0 ? 0 : GetShCoefficientsCount(mShDegree);
+		GaussianInfo gaussianInfo;
+		gaussianInfo.NumPoints = pointsCount;
+		gaussianInfo.ShDegree = mShDegree;
+		gaussianInfo.isAntialiased = mbIsAntialiased;
+		const std::array<FileReadRange, 8> ranges =
+		{
+			GetElementsRange(mArrayOffsets[eArray::POSITIONS] + firstPointIndex * 3ull * sizeof(float), pointsCount * 3ull, gaussianInfo.Positions),
+			GetElementsRange(mArrayOffsets[eArray::SCALES] + firstPointIndex * 3ull * sizeof(float), pointsCount * 3ull, gaussianInfo.Scales),
+			GetElementsRange(mArrayOffsets[eArray::ROTATIONS] + firstPointIndex * 4ull * sizeof(float), pointsCount * 4ull, gaussianInfo.Rotations),
+			GetElementsRange(mArrayOffsets[eArray::ALPHAS] + firstPointIndex * sizeof(float), pointsCount, gaussianInfo.Alphas),
+			GetElementsRange(mArrayOffsets[eArray::COLORS] + firstPointIndex * 3ull * sizeof(float), pointsCount * 3ull, gaussianInfo.Colors),
+			GetElementsRange(mArrayOffsets[eArray::SPHERICAL_HARMONICS] + firstPointIndex * shCoefficientsCount * sizeof(float), pointsCount * shCoefficientsCount, gaussianInfo.SphericalHarmonics),
+			GetElementsRange(mArrayOffsets[eArray::SH_CODEBOOK], bReadsShCodebook == true ? mShCodebookEntriesCount * static_cast<uint64_t>(GetShCoefficientsCount(mShDegree)) : 0, gaussianInfo.ShCodebook),
+			GetElementsRange(mArrayOffsets[eArray::SH_INDICES] + firstPointIndex * sizeof(uint16_t), mShCodebookEntriesCount > 0 ? pointsCount : 0, gaussianInfo.ShIndices),
+		};
+		if (mFile.Read(ranges) == false)
+		{
+			std::cerr << "Failed to read scene cache " << mPath << ".\n";
+			return false;
+		}
+
+		for (const uint16_t shIndex : gaussianInfo.ShIndices)
+		{
+			if (shIndex >= mShCodebookEntriesCount)
+			{
+				std::cerr << "Scene cache " << mPath << " indexes past its codebook of " << mShCodebookEntriesCount << " entries.\n";
+				return false;
+			}
+		}
+
+		outGaussianInfo = std::move(gaussianInfo);
+		return true;
+	}
+
+	bool SaveSceneCache(const std::filesystem::path& path, const GaussianInfo& gaussianInfo, const uint32_t previewPointsCount, const uint32_t chunkPointsCount) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		const std::vector<SceneChunk> chunks = ComputeSceneChunks(gaussianInfo, std::min(previewPointsCount, gaussianInfo.NumPoints), chunkPointsCount);
+
+		std::ofstream file(path, std::ios::binary);
+		if (file.is_open() == false)
+		{
+			std::cerr << "Failed to open " << path << " for the scene cache.\n";
+			return false;
+		}
+
+		const SceneCacheHeader header =
+		{
+			.Magic = { MAGIC[0], MAGIC[1], MAGIC[2], MAGIC[3] },
+			.Version = VERSION,
+			.PointsCount = gaussianInfo.NumPoints,
+			.ShDegree = gaussianInfo.ShDegree,
+			.ShCodebookEntriesCount = static_cast<uint32_t>(gaussianInfo.ShCodebook.size() / std::max(GetShCoefficientsCount(gaussianInfo.ShDegree), 1u)),
+			.PreviewPointsCount = std::min(previewPointsCount, gaussianInfo.NumPoints),
+			.ChunksCount = static_cast<uint32_t>(chunks.size()),
+			.Flags = gaussianInfo.isAntialiased == true ? ANTIALIASED_FLAG : 0,
+		};
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		WriteArray(file, gaussianInfo.Positions);
+		WriteArray(file, gaussianInfo.Scales);
+		WriteArray(file, gaussianInfo.Rotations);
+		WriteArray(file, gaussianInfo.Alphas);
+		WriteArray(file, gaussianInfo.Colors);
+		WriteArray(file, gaussianInfo.SphericalHarmonics);
+		WriteArray(file, gaussianInfo.ShCodebook);
+		WriteArray(file, gaussianInfo.ShIndices);
+		WriteArray(file, chunks);
+
+		return file.good();
+	}
+
+	std::vector<SceneChunk> ComputeSceneChunks(const GaussianInfo& gaussianInfo, const uint32_t previewPointsCount, const uint32_t chunkPointsCount) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		const auto computeChunk = [&gaussianInfo](const uint32_t firstPointIndex, const uint32_t pointsCount)
+		{
+			SceneChunk chunk =
+			{
+				.FirstPointIndex = firstPointIndex,
+				.PointsCount = pointsCount,
+				.BoundsMin = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() },
+				.BoundsMax = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() },
+			};
+			for (size_t pointIndex = firstPointIndex; pointIndex < firstPointIndex + static_cast<size_t>(pointsCount); ++pointIndex)
+			{
+				// scales are stored as logarithms
+				const float radius = 3.0f * std::exp(std::max({ gaussianInfo.Scales[pointIndex * 3], gaussianInfo.Scales[pointIndex * 3 + 1], gaussianInfo.Scales[pointIndex * 3 + 2] }));
+				for (uint32_t axis = 0; axis < 3; ++axis)
+				{
+					chunk.BoundsMin[axis] = std::min(chunk.BoundsMin[axis], gaussianInfo.Positions[pointIndex * 3 + axis] - radius);
+					chunk.BoundsMax[axis] = std::max(chunk.BoundsMax[axis], gaussianInfo.Positions[pointIndex * 3 + axis] + radius);
+				}
+			}
+			return chunk;
+		};
+
+		std::vector<SceneChunk> chunks;
+		if (previewPointsCount > 0)
+		{
+			chunks.push_back(computeChunk(0, previewPointsCount));
+		}
+
+		const uint32_t stride = std::max(chunkPointsCount, 1u);
+		for (uint32_t firstPointIndex = previewPointsCount; firstPointIndex < gaussianInfo.NumPoints; firstPointIndex += stride)
+		{
+			chunks.push_back(computeChunk(firstPointIndex, std::min(stride, gaussianInfo.NumPoints - firstPointIndex)));
+		}
+
+		return chunks;
+	}
+
+	bool LoadSceneCache(const std::filesystem::path& path, GaussianInfo& outGaussianInfo, const FileReadInfo& fileReadInfo) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		SceneCacheReader reader(path, fileReadInfo);
+		return reader.IsOpen() == true && reader.Read(0, reader.GetPointsCount(), outGaussianInfo) == true;
+	}
+} // namespace iiixrlab::scene
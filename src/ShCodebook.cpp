@@ -0,0 +1,347 @@
+#include "3dgs/scene/ShCodebook.h"
+
+#include "3dgs/Profiler.h"
+#include "3dgs/Random.h"
+#include "3dgs/ThreadPool.h"
+
+namespace iiixrlab::scene
+{
+	static constexpr const uint32_t MAX_ENTRIES_COUNT = 1u << 16;
+	static constexpr const uint32_t POINTS_COUNT_PER_CHUNK = 1 << 16;
+	static constexpr const uint32_t PSNR_DIRECTIONS_COUNT = 16;
+
+	static constexpr const uint32_t CENTROIDS_COUNT_PER_BLOCK = 8;
+	static constexpr const float PADDING_COORDINATE = 1.0e18f;
+
+	// Centroids in blocks of eight stored dimension by dimension, so the distances to a whole block vectorize.
+	// The last block is padded with centroids far away from every vector.
+	static void TransposeCentroids(const float* centroids, const uint32_t centroidsCount, const uint32_t dimensionsCount, std::vector<float>& outTransposedCentroids) noexcept
+	{
+		const uint32_t blocksCount = (centroidsCount + CENTROIDS_COUNT_PER_BLOCK - 1) / CENTROIDS_COUNT_PER_BLOCK;
+		outTransposedCentroids.resize(static_cast<size_t>(blocksCount) * dimensionsCount * CENTROIDS_COUNT_PER_BLOCK);
+		for (uint32_t centroidIndex = 0; centroidIndex < blocksCount * CENTROIDS_COUNT_PER_BLOCK; ++centroidIndex)
+		{
+			const uint32_t blockIndex = centroidIndex / CENTROIDS_COUNT_PER_BLOCK;
+			const uint32_t laneIndex = centroidIndex % CENTROIDS_COUNT_PER_BLOCK;
+			float* block = &outTransposedCentroids[static_cast<size_t>(blockIndex) * dimensionsCount * CENTROIDS_COUNT_PER_BLOCK];
+			for (uint32_t dimensionIndex = 0; dimensionIndex < dimensionsCount; ++dimensionIndex)
+			{
+				block[dimensionIndex * CENTROIDS_COUNT_PER_BLOCK + laneIndex] = centroidIndex < centroidsCount ? centroids[static_cast<size_t>(centroidIndex) * dimensionsCount + dimensionIndex] : PADDING_COORDINATE;
+			}
+		}
+	}
+
+	static uint32_t FindNearestCentroid(const float* vector, const std::vector<float>& transposedCentroids, const uint32_t dimensionsCount) noexcept
+	{
+		const size_t blockSize = static_cast<size_t>(dimensionsCount) * CENTROIDS_COUNT_PER_BLOCK;
+		uint32_t nearestIndex = 0;
+		float nearestDistance = std::numeric_limits<float>::max();
+		for (size_t blockOffset = 0; blockOffset < transposedCentroids.size(); blockOffset += blockSize)
+		{
+			const float* block = &transposedCentroids[blockOffset];
+			math::simd::Float4 lowDistances = math::simd::Set1(0.0f);
+			math::simd::Float4 highDistances = math::simd::Set1(0.0f);
+			for (uint32_t dimensionIndex = 0; dimensionIndex < dimensionsCount; ++dimensionIndex)
+			{
+				const math::simd::Float4 coordinate = math::simd::Set1(vector[dimensionIndex]);
+				const math::simd::Float4 lowDifferences = math::simd::Subtract(coordinate, math::simd::Load4(block + dimensionIndex * CENTROIDS_COUNT_PER_BLOCK));
+				const math::simd::Float4 highDifferences = math::simd::Subtract(coordinate, math::simd::Load4(block + dimensionIndex * CENTROIDS_COUNT_PER_BLOCK + 4));
+				lowDistances = math::simd::MultiplyAdd(lowDifferences, lowDifferences, lowDistances);
+				highDistances = math::simd::MultiplyAdd(highDifferences, highDifferences, highDistances);
+			}
+
+			float distances[CENTROIDS_COUNT_PER_BLOCK];
+			math::simd::Store4(distances, lowDistances);
+			math::simd::Store4(distances + 4, highDistances);
+			for (uint32_t laneIndex = 0; laneIndex < CENTROIDS_COUNT_PER_BLOCK; ++laneIndex)
+			{
+				if (distances[laneIndex] < nearestDistance)
+				{
+					nearestDistance = distances[laneIndex];
+					nearestIndex = static_cast<uint32_t>(blockOffset / dimensionsCount) + laneIndex;
+				}
+			}
+		}
+		return nearestIndex;
+	}
+
+	// Lloyd's algorithm over the given rows, seeded with distinct random rows. Centroids left without rows move to a
+	// random row so none of the entries goes to waste.
+	static void RunKMeans(const float* vectors, const uint32_t dimensionsCount, const std::vector<uint32_t>& rowIndices, const uint32_t centroidsCount, const uint32_t iterationsCount, Random& random, float* outCentroids) noexcept
+	{
+		assert(rowIndices.empty() == false && centroidsCount > 0);
+
+		const size_t rowsCount = rowIndices.size();
+		std::vector<uint32_t> seeds = rowIndices;
+		for (uint32_t centroidIndex = 0; centroidIndex < centroidsCount; ++centroidIndex)
+		{
+			if (centroidIndex < rowsCount)
+			{
+				std::swap(seeds[centroidIndex], seeds[centroidIndex + random.Next() % (rowsCount - centroidIndex)]);
+			}
+			const float* seed = vectors + static_cast<size_t>(seeds[centroidIndex % rowsCount]) * dimensionsCount;
+			memcpy(outCentroids + static_cast<size_t>(centroidIndex) * dimensionsCount, seed, sizeof(float) * dimensionsCount);
+		}
+
+		std::vector<float> transposedCentroids;
+		std::vector<double> sums(static_cast<size_t>(centroidsCount) * dimensionsCount);
+		std::vector<uint32_t> counts(centroidsCount);
+		for (uint32_t iterationIndex = 0; iterationIndex < iterationsCount; ++iterationIndex)
+		{
+			TransposeCentroids(outCentroids, centroidsCount, dimensionsCount, transposedCentroids);
+			std::fill(sums.begin(), sums.end(), 0.0);
+			std::fill(counts.begin(), counts.end(), 0);
+			for (const uint32_t rowIndex : rowIndices)
+			{
+				const float* vector = vectors + static_cast<size_t>(rowIndex) * dimensionsCount;
+				const uint32_t centroidIndex = FindNearestCentroid(vector, transposedCentroids, dimensionsCount);
+				double* sum = &sums[static_cast<size_t>(centroidIndex) * dimensionsCount];
+				for (uint32_t dimensionIndex = 0; dimensionIndex < dimensionsCount; ++dimensionIndex)
+				{
+					sum[dimensionIndex] += vector[dimensionIndex];
+				}
+				++counts[centroidIndex];
+			}
+
+			for (uint32_t centroidIndex = 0; centroidIndex < centroidsCount; ++centroidIndex)
+			{
+				float* centroid = outCentroids + static_cast<size_t>(centroidIndex) * dimensionsCount;
+				if (counts[centroidIndex] == 0)
+				{
+					const float* seed = vectors + static_cast<size_t>(rowIndices[random.Next() % rowsCount]) * dimensionsCount;
+					memcpy(centroid, seed, sizeof(float) * dimensionsCount);
+					continue;
+				}
+
+				const double* sum = &sums[static_cast<size_t>(centroidIndex) * dimensionsCount];
+				for (uint32_t dimensionIndex = 0; dimensionIndex < dimensionsCount; ++dimensionIndex)
+				{
+					centroid[dimensionIndex] = static_cast<float>(sum[dimensionIndex] / counts[centroidIndex]);
+				}
+			}
+		}
+	}
+
+	// Random subset of the rows to train on, all of them when there are few enough.
+	static std::vector<uint32_t> SampleRows(const std::vector<uint32_t>& rowIndices, const size_t maxRowsCount, Random& random) noexcept
+	{
+		if (rowIndices.size() <= maxRowsCount)
+		{
+			return rowIndices;
+		}
+
+		std::vector<uint32_t> samples(maxRowsCount);
+		for (uint32_t& sample : samples)
+		{
+			sample = rowIndices[random.Next() % rowIndices.size()];
+		}
+		return samples;
+	}
+
+	bool QuantizeSphericalHarmonics(GaussianInfo& inoutGaussianInfo, const ShCodebookInfo& codebookInfo) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		const uint32_t pointsCount = inoutGaussianInfo.NumPoints;
+		const uint32_t dimensionsCount = GetShCoefficientsCount(inoutGaussianInfo.ShDegree);
+		if (pointsCount == 0 || dimensionsCount == 0 || inoutGaussianInfo.ShCodebook.empty() == false)
+		{
+			return false;
+		}
+		if (inoutGaussianInfo.SphericalHarmonics.size() != static_cast<size_t>(pointsCount) * dimensionsCount)
+		{
+			std::cerr << "Expected " << dimensionsCount << " spherical harmonics coefficients per point, got " << inoutGaussianInfo.SphericalHarmonics.size() << " for " << pointsCount << " points.\n";
+			IIIXRLAB_DEBUG_BREAK();
+			return false;
+		}
+
+		// sqrt(K) coarse clusters of sqrt(K) entries each, which keeps both levels as cheap as a single K / sqrt(K) one
+		const uint32_t entriesCount = std::min({ std::max(codebookInfo.EntriesCount, 1u), MAX_ENTRIES_COUNT, pointsCount });
+		const uint32_t coarseEntriesCount = std::max(static_cast<uint32_t>(std::sqrt(static_cast<double>(entriesCount))), 1u);
+		const uint32_t fineEntriesCount = entriesCount / coarseEntriesCount;
+		const size_t trainingPointsPerEntry = std::max(codebookInfo.TrainingPointsPerEntry, 1u);
+		const float* vectors = inoutGaussianInfo.SphericalHarmonics.data();
+
+		std::vector<uint32_t> pointIndices(pointsCount);
+		std::iota(pointIndices.begin(), pointIndices.end(), 0);
+
+		std::vector<float> coarseCentroids(static_cast<size_t>(coarseEntriesCount) * dimensionsCount);
+		{
+			Random random = { .State = codebookInfo.Seed };
+			const std::vector<uint32_t> trainingPointIndices = SampleRows(pointIndices, coarseEntriesCount * trainingPointsPerEntry, random);
+			RunKMeans(vectors, dimensionsCount, trainingPointIndices, coarseEntriesCount, codebookInfo.IterationsCount, random, coarseCentroids.data());
+		}
+
+		const uint32_t chunksCount = (pointsCount + POINTS_COUNT_PER_CHUNK - 1) / POINTS_COUNT_PER_CHUNK;
+		const uint32_t threadsCount = codebookInfo.ThreadsCount > 0 ? codebookInfo.ThreadsCount : std::max(std::thread::hardware_concurrency(), 1u);
+		ThreadPool threadPool({ .ThreadsCount = std::min(threadsCount, std::max(chunksCount, coarseEntriesCount)) });
+
+		std::vector<float> transposedCoarseCentroids;
+		TransposeCentroids(coarseCentroids.data(), coarseEntriesCount, dimensionsCount, transposedCoarseCentroids);
+		std::vector<uint32_t> coarseIndices(pointsCount);
+		for (uint32_t chunkIndex = 0; chunkIndex < chunksCount; ++chunkIndex)
+		{
+			threadPool.Submit([vectors, dimensionsCount, pointsCount, chunkIndex, &transposedCoarseCentroids, &coarseIndices]()
+			{
+				const uint32_t lastPointIndex = std::min((chunkIndex + 1) * POINTS_COUNT_PER_CHUNK, pointsCount);
+				for (uint32_t pointIndex = chunkIndex * POINTS_COUNT_PER_CHUNK; pointIndex < lastPointIndex; ++pointIndex)
+				{
+					coarseIndices[pointIndex] = FindNearestCentroid(vectors + static_cast<size_t>(pointIndex) * dimensionsCount, transposedCoarseCentroids, dimensionsCount);
+				}
+			});
+		}
+		threadPool.Wait();
+
+		std::vector<std::vector<uint32_t>> clusterPointIndices(coarseEntriesCount);
+		for (uint32_t pointIndex = 0; pointIndex < pointsCount; ++pointIndex)
+		{
+			clusterPointIndices[coarseIndices[pointIndex]].push_back(pointIndex);
+		}
+
+		std::vector<float> codebook(static_cast<size_t>(coarseEntriesCount) * fineEntriesCount * dimensionsCount);
+		std::vector<uint16_t> indices(pointsCount);
+		for (uint32_t clusterIndex = 0; clusterIndex < coarseEntriesCount; ++clusterIndex)
+		{
+			threadPool.Submit([vectors, dimensionsCount, clusterIndex, fineEntriesCount, trainingPointsPerEntry, &codebookInfo, &clusterPointIndices, &coarseCentroids, &codebook, &indices]()
+			{
+				const std::vector<uint32_t>& memberIndices = clusterPointIndices[clusterIndex];
+				float* centroids = &codebook[static_cast<size_t>(clusterIndex) * fineEntriesCount * dimensionsCount];
+				if (memberIndices.empty() == true)
+				{
+					for (uint32_t entryIndex = 0; entryIndex < fineEntriesCount; ++entryIndex)
+					{
+						memcpy(centroids + static_cast<size_t>(entryIndex) * dimensionsCount, &coarseCentroids[static_cast<size_t>(clusterIndex) * dimensionsCount], sizeof(float) * dimensionsCount);
+					}
+					return;
+				}
+
+				Random random = { .State = codebookInfo.Seed + 0x632be59bd9b4e019ull * (clusterIndex + 1) };
+				const std::vector<uint32_t> trainingPointIndices = SampleRows(memberIndices, fineEntriesCount * trainingPointsPerEntry, random);
+				RunKMeans(vectors, dimensionsCount, trainingPointIndices, fineEntriesCount, codebookInfo.IterationsCount, random, centroids);
+
+				std::vector<float> transposedCentroids;
+				TransposeCentroids(centroids, fineEntriesCount, dimensionsCount, transposedCentroids);
+				for (const uint32_t pointIndex : memberIndices)
+				{
+					const uint32_t entryIndex = FindNearestCentroid(vectors + static_cast<size_t>(pointIndex) * dimensionsCount, transposedCentroids, dimensionsCount);
+					indices[pointIndex] = static_cast<uint16_t>(clusterIndex * fineEntriesCount + entryIndex);
+				}
+			});
+		}
+		threadPool.Wait();
+
+		inoutGaussianInfo.ShCodebook = std::move(codebook);
+		inoutGaussianInfo.ShIndices = std::move(indices);
+		inoutGaussianInfo.SphericalHarmonics.clear();
+		inoutGaussianInfo.SphericalHarmonics.shrink_to_fit();
+		return true;
+	}
+
+	std::vector<float> DecodeSphericalHarmonics(const GaussianInfo& gaussianInfo) noexcept
+	{
+		if (gaussianInfo.ShCodebook.empty() == true)
+		{
+			return gaussianInfo.SphericalHarmonics;
+		}
+
+		const size_t dimensionsCount = GetShCoefficientsCount(gaussianInfo.ShDegree);
+		std::vector<float> sphericalHarmonics(gaussianInfo.ShIndices.size() * dimensionsCount);
+		for (size_t pointIndex = 0; pointIndex < gaussianInfo.ShIndices.size(); ++pointIndex)
+		{
+			memcpy(&sphericalHarmonics[pointIndex * dimensionsCount], &gaussianInfo.ShCodebook[gaussianInfo.ShIndices[pointIndex] * dimensionsCount], sizeof(float) * dimensionsCount);
+		}
+		return sphericalHarmonics;
+	}
+
+	size_t GetShMemorySize(const GaussianInfo& gaussianInfo) noexcept
+	{
+		return gaussianInfo.SphericalHarmonics.size() * sizeof(float) + gaussianInfo.ShCodebook.size() * sizeof(float) + gaussianInfo.ShIndices.size() * sizeof(uint16_t);
+	}
+
+	// Color of one point seen along the direction, as Gaussian.slang evaluates it.
+	static void EvaluateShColor(const float* dc, const float* coefficients, const uint32_t shDegree, const float direction[3], float outColor[3]) noexcept
+	{
+		constexpr const float SH_C0 = 0.28209479177387814f;
+		constexpr const float SH_C1 = 0.4886025119029199f;
+		constexpr const float SH_C2[5] = { 1.0925484305920792f, -1.0925484305920792f, 0.31539156525252005f, -1.0925484305920792f, 0.5462742152960396f };
+		constexpr const float SH_C3[7] = { -0.5900435899266435f, 2.890611442640554f, -0.4570457994644658f, 0.3731763325901154f, -0.4570457994644658f, 1.445305721320277f, -0.5900435899266435f };
+
+		const float x = direction[0];
+		const float y = direction[1];
+		const float z = direction[2];
+		const float xx = x * x;
+		const float yy = y * y;
+		const float zz = z * z;
+		const float basis[15] =
+		{
+			-SH_C1 * y, SH_C1 * z, -SH_C1 * x,
+			SH_C2[0] * x * y, SH_C2[1] * y * z, SH_C2[2] * (2.0f * zz - xx - yy), SH_C2[3] * x * z, SH_C2[4] * (xx - yy),
+			SH_C3[0] * y * (3.0f * xx - yy), SH_C3[1] * x * y * z, SH_C3[2] * y * (4.0f * zz - xx - yy), SH_C3[3] * z * (2.0f * zz - 3.0f * xx - 3.0f * yy),
+			SH_C3[4] * x * (4.0f * zz - xx - yy), SH_C3[5] * z * (xx - yy), SH_C3[6] * x * (xx - 3.0f * yy),
+		};
+
+		const uint32_t basesCount = (shDegree + 1) * (shDegree + 1) - 1;
+		for (uint32_t channelIndex = 0; channelIndex < 3; ++channelIndex)
+		{
+			float color = 0.5f + SH_C0 * dc[channelIndex];
+			for (uint32_t basisIndex = 0; basisIndex < basesCount; ++basisIndex)
+			{
+				color += basis[basisIndex] * coefficients[basisIndex * 3 + channelIndex];
+			}
+			outColor[channelIndex] = std::clamp(color, 0.0f, 1.0f);
+		}
+	}
+
+	float ComputeShColorPsnr(const GaussianInfo& gaussianInfo, const std::vector<float>& referenceSphericalHarmonics) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		const uint32_t dimensionsCount = GetShCoefficientsCount(gaussianInfo.ShDegree);
+		if (gaussianInfo.NumPoints == 0 || referenceSphericalHarmonics.size() != static_cast<size_t>(gaussianInfo.NumPoints) * dimensionsCount)
+		{
+			return std::numeric_limits<float>::infinity();
+		}
+
+		// Fibonacci sphere, evenly spread view directions
+		float directions[PSNR_DIRECTIONS_COUNT][3];
+		for (uint32_t directionIndex = 0; directionIndex < PSNR_DIRECTIONS_COUNT; ++directionIndex)
+		{
+			const float y = 1.0f - 2.0f * (static_cast<float>(directionIndex) + 0.5f) / static_cast<float>(PSNR_DIRECTIONS_COUNT);
+			const float radius = std::sqrt(1.0f - y * y);
+			const float angle = static_cast<float>(directionIndex) * std::numbers::pi_v<float> * (3.0f - std::sqrt(5.0f));
+			directions[directionIndex][0] = radius * std::cos(angle);
+			directions[directionIndex][1] = y;
+			directions[directionIndex][2] = radius * std::sin(angle);
+		}
+
+		const bool bIsQuantized = gaussianInfo.ShCodebook.empty() == false;
+		double squaredErrorsSum = 0.0;
+		for (uint32_t pointIndex = 0; pointIndex < gaussianInfo.NumPoints; ++pointIndex)
+		{
+			const float* dc = &gaussianInfo.Colors[static_cast<size_t>(pointIndex) * 3];
+			const float* referenceCoefficients = &referenceSphericalHarmonics[static_cast<size_t>(pointIndex) * dimensionsCount];
+			const float* coefficients = bIsQuantized == true
+				? &gaussianInfo.ShCodebook[static_cast<size_t>(gaussianInfo.ShIndices[pointIndex]) * dimensionsCount]
+				: &gaussianInfo.SphericalHarmonics[static_cast<size_t>(pointIndex) * dimensionsCount];
+			for (const float* direction : directions)
+			{
+				float referenceColor[3];
+				float color[3];
+				EvaluateShColor(dc, referenceCoefficients, gaussianInfo.ShDegree, direction, referenceColor);
+				EvaluateShColor(dc, coefficients, gaussianInfo.ShDegree, direction, color);
+				for (uint32_t channelIndex = 0; channelIndex < 3; ++channelIndex)
+				{
+					const double difference = static_cast<double>(color[channelIndex]) - referenceColor[channelIndex];
+					squaredErrorsSum += difference * difference;
+				}
+			}
+		}
+
+		const double meanSquaredError = squaredErrorsSum / (static_cast<double>(gaussianInfo.NumPoints) * PSNR_DIRECTIONS_COUNT * 3);
+		if (meanSquaredError == 0.0)
+		{
+			return std::numeric_limits<float>::infinity();
+		}
+		return static_cast<float>(-10.0 * std::log10(meanSquaredError));
+	}
+} // namespace iiixrlab::scene
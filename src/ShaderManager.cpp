@@ -1,5 +1,7 @@
 #include "3dgs/graphics/ShaderManager.h"
 
+#include "3dgs/Profiler.h"
+
 namespace iiixrlab::graphics
 {
 	ShaderManager& ShaderManager::GetInstance() noexcept
@@ -27,6 +29,8 @@ namespace iiixrlab::graphics
 
 	void ShaderManager::AddShaders(std::vector<Shader::CreateInfo>& createInfos) noexcept
 	{
+		IIIXRLAB_PROFILE_ZONE("ShaderManager::AddShaders");
+
 		if (createInfos.empty() == true)
 		{
 			return;
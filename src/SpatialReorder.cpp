@@ -0,0 +1,297 @@
+#include "3dgs/scene/SpatialReorder.h"
+
+#include "3dgs/Profiler.h"
+#include "3dgs/ThreadPool.h"
+
+namespace iiixrlab::scene
+{
+	static constexpr const uint32_t POINTS_COUNT_PER_CHUNK = 1 << 16;
+	static constexpr const uint32_t COORDINATE_BITS_COUNT = 21;
+	static constexpr const uint32_t RADIX_BITS_COUNT = 11;
+	static constexpr const uint32_t RADIX_SIZE = 1 << RADIX_BITS_COUNT;
+	static constexpr const uint32_t DIGITS_COUNT = (3 * COORDINATE_BITS_COUNT + RADIX_BITS_COUNT - 1) / RADIX_BITS_COUNT;
+	static constexpr const float FLOAT_MAX = std::numeric_limits<float>::max();
+
+	// Runs the function on [first, last) ranges of the points, on the pool when there is more than one.
+	template<typename Function>
+	static void ForEachChunk(ThreadPool& threadPool, const uint32_t pointsCount, Function&& function) noexcept
+	{
+		const uint32_t chunksCount = (pointsCount + POINTS_COUNT_PER_CHUNK - 1) / POINTS_COUNT_PER_CHUNK;
+		for (uint32_t chunkIndex = 0; chunkIndex < chunksCount; ++chunkIndex)
+		{
+			const uint32_t firstPointIndex = chunkIndex * POINTS_COUNT_PER_CHUNK;
+			const uint32_t lastPointIndex = std::min(firstPointIndex + POINTS_COUNT_PER_CHUNK, pointsCount);
+			if (chunksCount == 1)
+			{
+				function(chunkIndex, firstPointIndex, lastPointIndex);
+				break;
+			}
+			threadPool.Submit([&function, chunkIndex, firstPointIndex, lastPointIndex]()
+			{
+				function(chunkIndex, firstPointIndex, lastPointIndex);
+			});
+		}
+		threadPool.Wait();
+	}
+
+	static uint32_t GetThreadsCount(const uint32_t threadsCount, const uint32_t pointsCount) noexcept
+	{
+		const uint32_t chunksCount = std::max((pointsCount + POINTS_COUNT_PER_CHUNK - 1) / POINTS_COUNT_PER_CHUNK, 1u);
+		return std::min(threadsCount > 0 ? threadsCount : std::max(std::thread::hardware_concurrency(), 1u), chunksCount);
+	}
+
+	// Spreads the 21 low bits apart so two zero bits follow each of them.
+	static IIIXRLAB_INLINE constexpr uint64_t SpreadBits(const uint32_t value) noexcept
+	{
+		uint64_t bits = value & 0x1fffff;
+		bits = (bits | (bits << 32)) & 0x001f00000000ffffull;
+		bits = (bits | (bits << 16)) & 0x001f0000ff0000ffull;
+		bits = (bits | (bits << 8)) & 0x100f00f00f00f00full;
+		bits = (bits | (bits << 4)) & 0x10c30c30c30c30c3ull;
+		bits = (bits | (bits << 2)) & 0x1249249249249249ull;
+		return bits;
+	}
+
+	static IIIXRLAB_INLINE constexpr uint64_t GetMortonCode(const uint32_t x, const uint32_t y, const uint32_t z) noexcept
+	{
+		return (SpreadBits(x) << 2) | (SpreadBits(y) << 1) | SpreadBits(z);
+	}
+
+	// Inverts the low bits of x when the bit of the coordinate is set, exchanges them between x and the coordinate otherwise.
+	// The branches are masks, the bits are random enough across points to mispredict half of them otherwise.
+	static IIIXRLAB_INLINE constexpr void ExchangeLowBits(const uint32_t bit, uint32_t& inoutX, uint32_t& inoutCoordinate) noexcept
+	{
+		const uint32_t lowerBits = bit - 1;
+		const uint32_t setMask = 0u - ((inoutCoordinate & bit) >> std::countr_zero(bit));
+		const uint32_t swappedBits = (inoutX ^ inoutCoordinate) & lowerBits & ~setMask;
+		inoutX ^= (lowerBits & setMask) | swappedBits;
+		inoutCoordinate ^= swappedBits;
+	}
+
+	// Skilling's transform of the coordinates into the transposed Hilbert index, whose interleaved bits are the index.
+	static IIIXRLAB_INLINE constexpr uint64_t GetHilbertCode(uint32_t x, uint32_t y, uint32_t z) noexcept
+	{
+		for (uint32_t bit = 1u << (COORDINATE_BITS_COUNT - 1); bit > 1; bit >>= 1)
+		{
+			x ^= (bit - 1) & (0u - ((x & bit) >> std::countr_zero(bit)));
+			ExchangeLowBits(bit, x, y);
+			ExchangeLowBits(bit, x, z);
+		}
+
+		y ^= x;
+		z ^= y;
+		uint32_t grayBits = 0;
+		for (uint32_t bit = 1u << (COORDINATE_BITS_COUNT - 1); bit > 1; bit >>= 1)
+		{
+			grayBits ^= (bit - 1) & (0u - ((z & bit) >> std::countr_zero(bit)));
+		}
+
+		return GetMortonCode(x ^ grayBits, y ^ grayBits, z ^ grayBits);
+	}
+
+	std::vector<uint32_t> ComputeSpatialOrder(const GaussianInfo& gaussianInfo, const SpatialReorderInfo& reorderInfo) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		const uint32_t pointsCount = static_cast<uint32_t>(std::min(static_cast<size_t>(gaussianInfo.NumPoints), gaussianInfo.Positions.size() / 3));
+		const uint32_t chunksCount = (pointsCount + POINTS_COUNT_PER_CHUNK - 1) / POINTS_COUNT_PER_CHUNK;
+		ThreadPool threadPool({ .ThreadsCount = GetThreadsCount(reorderInfo.ThreadsCount, pointsCount) });
+
+		// bounds of every chunk, merged afterwards
+		std::vector<std::array<float, 6>> chunkBounds(chunksCount);
+		ForEachChunk(threadPool, pointsCount, [&gaussianInfo, &chunkBounds](const uint32_t chunkIndex, const uint32_t firstPointIndex, const uint32_t lastPointIndex)
+		{
+			std::array<float, 6> bounds = { FLOAT_MAX, FLOAT_MAX, FLOAT_MAX, -FLOAT_MAX, -FLOAT_MAX, -FLOAT_MAX };
+			for (uint32_t pointIndex = firstPointIndex; pointIndex < lastPointIndex; ++pointIndex)
+			{
+				for (uint32_t axisIndex = 0; axisIndex < 3; ++axisIndex)
+				{
+					const float coordinate = gaussianInfo.Positions[static_cast<size_t>(pointIndex) * 3 + axisIndex];
+					bounds[axisIndex] = std::min(bounds[axisIndex], coordinate);
+					bounds[axisIndex + 3] = std::max(bounds[axisIndex + 3], coordinate);
+				}
+			}
+			chunkBounds[chunkIndex] = bounds;
+		});
+
+		float minimum[3] = { FLOAT_MAX, FLOAT_MAX, FLOAT_MAX };
+		float extent = 0.0f;
+		{
+			float maximum[3] = { -FLOAT_MAX, -FLOAT_MAX, -FLOAT_MAX };
+			for (const std::array<float, 6>& bounds : chunkBounds)
+			{
+				for (uint32_t axisIndex = 0; axisIndex < 3; ++axisIndex)
+				{
+					minimum[axisIndex] = std::min(minimum[axisIndex], bounds[axisIndex]);
+					maximum[axisIndex] = std::max(maximum[axisIndex], bounds[axisIndex + 3]);
+				}
+			}
+			for (uint32_t axisIndex = 0; axisIndex < 3; ++axisIndex)
+			{
+				extent = std::max(extent, maximum[axisIndex] - minimum[axisIndex]);
+			}
+		}
+
+		// cubic cells, so the curve is as local along every axis
+		const float scale = extent > 0.0f ? static_cast<float>((1u << COORDINATE_BITS_COUNT) - 1) / extent : 0.0f;
+		std::vector<uint64_t> codes(pointsCount);
+		const eSpaceFillingCurve curve = reorderInfo.Curve;
+		ForEachChunk(threadPool, pointsCount, [&gaussianInfo, &minimum, scale, curve, &codes](const uint32_t, const uint32_t firstPointIndex, const uint32_t lastPointIndex)
+		{
+			for (uint32_t pointIndex = firstPointIndex; pointIndex < lastPointIndex; ++pointIndex)
+			{
+				uint32_t coordinates[3];
+				for (uint32_t axisIndex = 0; axisIndex < 3; ++axisIndex)
+				{
+					const float cell = (gaussianInfo.Positions[static_cast<size_t>(pointIndex) * 3 + axisIndex] - minimum[axisIndex]) * scale;
+					coordinates[axisIndex] = static_cast<uint32_t>(std::clamp(cell, 0.0f, static_cast<float>((1u << COORDINATE_BITS_COUNT) - 1)));
+				}
+				codes[pointIndex] = curve == eSpaceFillingCurve::HILBERT
+					? GetHilbertCode(coordinates[0], coordinates[1], coordinates[2])
+					: GetMortonCode(coordinates[0], coordinates[1], coordinates[2]);
+			}
+		});
+
+		// LSD radix sort, every chunk scatters its keys to the offsets the histograms of the chunks before it leave,
+		// which keeps it stable
+		std::vector<uint32_t> order(pointsCount);
+		std::iota(order.begin(), order.end(), 0);
+		std::vector<uint64_t> scratchCodes(pointsCount);
+		std::vector<uint32_t> scratchOrder(pointsCount);
+		std::vector<std::array<uint32_t, RADIX_SIZE>> chunkHistograms(chunksCount);
+		for (uint32_t digitIndex = 0; digitIndex < DIGITS_COUNT; ++digitIndex)
+		{
+			const uint32_t shift = digitIndex * RADIX_BITS_COUNT;
+			ForEachChunk(threadPool, pointsCount, [&codes, &chunkHistograms, shift](const uint32_t chunkIndex, const uint32_t firstPointIndex, const uint32_t lastPointIndex)
+			{
+				std::array<uint32_t, RADIX_SIZE>& histogram = chunkHistograms[chunkIndex];
+				histogram.fill(0);
+				for (uint32_t pointIndex = firstPointIndex; pointIndex < lastPointIndex; ++pointIndex)
+				{
+					++histogram[(codes[pointIndex] >> shift) & (RADIX_SIZE - 1)];
+				}
+			});
+
+			// every code shares this digit, e.g. the high bits of a flat scene
+			if (pointsCount == 0)
+			{
+				break;
+			}
+			uint32_t sharedDigitsCount = 0;
+			for (const std::array<uint32_t, RADIX_SIZE>& histogram : chunkHistograms)
+			{
+				sharedDigitsCount += histogram[(codes[0] >> shift) & (RADIX_SIZE - 1)];
+			}
+			if (sharedDigitsCount == pointsCount)
+			{
+				continue;
+			}
+
+			uint32_t offset = 0;
+			for (uint32_t digit = 0; digit < RADIX_SIZE; ++digit)
+			{
+				for (std::array<uint32_t, RADIX_SIZE>& histogram : chunkHistograms)
+				{
+					const uint32_t digitCount = histogram[digit];
+					histogram[digit] = offset;
+					offset += digitCount;
+				}
+			}
+
+			ForEachChunk(threadPool, pointsCount, [&codes, &order, &scratchCodes, &scratchOrder, &chunkHistograms, shift](const uint32_t chunkIndex, const uint32_t firstPointIndex, const uint32_t lastPointIndex)
+			{
+				std::array<uint32_t, RADIX_SIZE>& offsets = chunkHistograms[chunkIndex];
+				for (uint32_t pointIndex = firstPointIndex; pointIndex < lastPointIndex; ++pointIndex)
+				{
+					const uint64_t code = codes[pointIndex];
+					const uint32_t destinationIndex = offsets[(code >> shift) & (RADIX_SIZE - 1)]++;
+					scratchCodes[destinationIndex] = code;
+					scratchOrder[destinationIndex] = order[pointIndex];
+				}
+			});
+
+			codes.swap(scratchCodes);
+			order.swap(scratchOrder);
+		}
+
+		return order;
+	}
+
+	// Gathers the elements of every point of the order into a new array, elementsCount per point.
+	template<typename T>
+	static void PermuteElements(ThreadPool& threadPool, const std::vector<uint32_t>& order, const size_t elementsCount, std::vector<T>& inoutElements) noexcept
+	{
+		// degree 0 scenes have no spherical harmonics coefficients to gather
+		if (elementsCount == 0 || inoutElements.empty() == true || inoutElements.size() < order.size() * elementsCount)
+		{
+			return;
+		}
+
+		std::vector<T> elements(order.size() * elementsCount);
+		ForEachChunk(threadPool, static_cast<uint32_t>(order.size()), [&order, elementsCount, &inoutElements, &elements](const uint32_t, const uint32_t firstPointIndex, const uint32_t lastPointIndex)
+		{
+			for (uint32_t pointIndex = firstPointIndex; pointIndex < lastPointIndex; ++pointIndex)
+			{
+				memcpy(&elements[pointIndex * elementsCount], &inoutElements[order[pointIndex] * elementsCount], sizeof(T) * elementsCount);
+			}
+		});
+		inoutElements = std::move(elements);
+	}
+
+	void PermuteGaussians(GaussianInfo& inoutGaussianInfo, const std::vector<uint32_t>& order, const uint32_t threadsCount) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		assert(order.size() <= inoutGaussianInfo.NumPoints);
+
+		ThreadPool threadPool({ .ThreadsCount = GetThreadsCount(threadsCount, static_cast<uint32_t>(order.size())) });
+		PermuteElements(threadPool, order, 3, inoutGaussianInfo.Positions);
+		PermuteElements(threadPool, order, 3, inoutGaussianInfo.Scales);
+		PermuteElements(threadPool, order, 4, inoutGaussianInfo.Rotations);
+		PermuteElements(threadPool, order, 1, inoutGaussianInfo.Alphas);
+		PermuteElements(threadPool, order, 3, inoutGaussianInfo.Colors);
+		PermuteElements(threadPool, order, GetShCoefficientsCount(inoutGaussianInfo.ShDegree), inoutGaussianInfo.SphericalHarmonics);
+		PermuteElements(threadPool, order, 1, inoutGaussianInfo.ShIndices);
+		inoutGaussianInfo.NumPoints = static_cast<uint32_t>(order.size());
+	}
+
+	void ReorderGaussians(GaussianInfo& inoutGaussianInfo, const SpatialReorderInfo& reorderInfo) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		const std::vector<uint32_t> order = ComputeSpatialOrder(inoutGaussianInfo, reorderInfo);
+		PermuteGaussians(inoutGaussianInfo, order, reorderInfo.ThreadsCount);
+	}
+
+	bool ParseSpaceFillingCurve(const char* name, eSpaceFillingCurve& outCurve) noexcept
+	{
+		if (strcmp(name, "morton") == 0)
+		{
+			outCurve = eSpaceFillingCurve::MORTON;
+		}
+		else if (strcmp(name, "hilbert") == 0)
+		{
+			outCurve = eSpaceFillingCurve::HILBERT;
+		}
+		else
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	const char* GetSpaceFillingCurveName(const eSpaceFillingCurve curve) noexcept
+	{
+		switch (curve)
+		{
+		case eSpaceFillingCurve::MORTON:
+			return "morton";
+		case eSpaceFillingCurve::HILBERT:
+			return "hilbert";
+		default:
+			assert(false);
+			return "unknown";
+		}
+	}
+} // namespace iiixrlab::scene
@@ -0,0 +1,101 @@
+#include "3dgs/scene/SplatSorter.h"
+
+#include "3dgs/Profiler.h"
+#include "3dgs/math/BatchMath.h"
+
+namespace iiixrlab::scene
+{
+	static constexpr const uint32_t RADIX_BITS_COUNT = 8;
+	static constexpr const uint32_t RADIX_SIZE = 1 << RADIX_BITS_COUNT;
+
+	void SplatSorter::ComputeDepthKeys(const GaussianInfo& gaussianInfo, const iiixrlab::math::Matrix4x4f& view) noexcept
+	{
+		Clear();
+		AppendDepthKeys(gaussianInfo, view);
+	}
+
+	void SplatSorter::AppendDepthKeys(const GaussianInfo& gaussianInfo, const iiixrlab::math::Matrix4x4f& view, const uint32_t pointsStride) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		const size_t pointsCount = std::min(static_cast<size_t>(gaussianInfo.NumPoints), gaussianInfo.Positions.size() / 3);
+		const size_t firstKeyIndex = mKeys.size();
+		if (pointsStride > 1)
+		{
+			// the strided positions are not contiguous, the depth of each is the dot product with the third column
+			const size_t keysCount = (pointsCount + pointsStride - 1) / pointsStride;
+			mKeys.resize(firstKeyIndex + keysCount);
+			for (size_t keyIndex = 0; keyIndex < keysCount; ++keyIndex)
+			{
+				const float* position = &gaussianInfo.Positions[keyIndex * pointsStride * 3];
+				const float depth = position[0] * view(0, 2) + position[1] * view(1, 2) + position[2] * view(2, 2) + view(3, 2);
+				mKeys[firstKeyIndex + keyIndex] = GetDepthKey(depth);
+			}
+			return;
+		}
+
+		mDepths.resize(pointsCount);
+		mKeys.resize(firstKeyIndex + pointsCount);
+
+		iiixrlab::math::ComputeViewDepths(std::span<const float>(gaussianInfo.Positions.data(), pointsCount * 3), view, mDepths);
+		for (size_t pointIndex = 0; pointIndex < pointsCount; ++pointIndex)
+		{
+			mKeys[firstKeyIndex + pointIndex] = GetDepthKey(mDepths[pointIndex]);
+		}
+	}
+
+	void SplatSorter::Sort() noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		const size_t keysCount = mKeys.size();
+		mIndices.resize(keysCount);
+		for (size_t keyIndex = 0; keyIndex < keysCount; ++keyIndex)
+		{
+			mIndices[keyIndex] = static_cast<uint32_t>(keyIndex);
+		}
+		mScratchKeys.resize(keysCount);
+		mScratchIndices.resize(keysCount);
+
+		// one read for the histograms of every digit
+		std::array<std::array<uint32_t, RADIX_SIZE>, 32 / RADIX_BITS_COUNT> histograms = {};
+		for (const uint32_t key : mKeys)
+		{
+			for (uint32_t digitIndex = 0; digitIndex < histograms.size(); ++digitIndex)
+			{
+				++histograms[digitIndex][(key >> (digitIndex * RADIX_BITS_COUNT)) & (RADIX_SIZE - 1)];
+			}
+		}
+
+		for (uint32_t digitIndex = 0; digitIndex < histograms.size(); ++digitIndex)
+		{
+			std::array<uint32_t, RADIX_SIZE>& histogram = histograms[digitIndex];
+			const uint32_t shift = digitIndex * RADIX_BITS_COUNT;
+
+			// every key shares this digit, e.g. the sign and exponent bits of depths in a narrow range
+			if (keysCount == 0 || histogram[(mKeys[0] >> shift) & (RADIX_SIZE - 1)] == keysCount)
+			{
+				continue;
+			}
+
+			uint32_t offset = 0;
+			for (uint32_t& count : histogram)
+			{
+				const uint32_t digitCount = count;
+				count = offset;
+				offset += digitCount;
+			}
+
+			for (size_t keyIndex = 0; keyIndex < keysCount; ++keyIndex)
+			{
+				const uint32_t key = mKeys[keyIndex];
+				const uint32_t destinationIndex = histogram[(key >> shift) & (RADIX_SIZE - 1)]++;
+				mScratchKeys[destinationIndex] = key;
+				mScratchIndices[destinationIndex] = mIndices[keyIndex];
+			}
+
+			mKeys.swap(mScratchKeys);
+			mIndices.swap(mScratchIndices);
+		}
+	}
+} // namespace iiixrlab::scene
@@ -0,0 +1,254 @@
+#include "3dgs/scene/SpzWriter.h"
+
+#include "zlib.h"
+
+#include "3dgs/Profiler.h"
+#include "3dgs/ThreadPool.h"
+
+namespace iiixrlab::scene
+{
+	// PackedGaussiansHeader of spz
+	struct SpzHeader final
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t PointsCount;
+		uint8_t ShDegree;
+		uint8_t FractionalBits;
+		uint8_t Flags;
+		uint8_t Reserved;
+	};
+	static_assert(sizeof(SpzHeader) == 16);
+
+	static constexpr const uint32_t SPZ_MAGIC = 0x5053474e;	// NGSP
+	static constexpr const uint32_t SPZ_VERSION = 2;
+	static constexpr const uint8_t SPZ_ANTIALIASED_FLAG = 0x1;
+	static constexpr const float SPZ_COLOR_SCALE = 0.15f;
+
+	static constexpr const uint32_t POINTS_COUNT_PER_CHUNK = 1 << 16;
+	static constexpr const size_t DEFLATE_BLOCK_SIZE = 1 << 20;
+	static constexpr const size_t DEFLATE_DICTIONARY_SIZE = 1 << 15;
+
+	// Byte offsets of the attribute arrays, spz stores every attribute of all points one after the other.
+	struct SpzLayout final
+	{
+		size_t PositionsOffset;
+		size_t AlphasOffset;
+		size_t ColorsOffset;
+		size_t ScalesOffset;
+		size_t RotationsOffset;
+		size_t ShOffset;
+		size_t TotalSize;
+	};
+
+	static IIIXRLAB_INLINE uint8_t ToUint8(const float value) noexcept
+	{
+		return static_cast<uint8_t>(std::clamp(std::round(value), 0.0f, 255.0f));
+	}
+
+	// 8 bit coefficient rounded to the bucket of its band
+	static IIIXRLAB_INLINE uint8_t QuantizeSh(const float value, const int32_t bucketSize) noexcept
+	{
+		int32_t quantized = static_cast<int32_t>(std::round(value * 128.0f)) + 128;
+		quantized = (quantized + bucketSize / 2) / bucketSize * bucketSize;
+		return static_cast<uint8_t>(std::clamp(quantized, 0, 255));
+	}
+
+	static void PackPoints(const GaussianInfo& gaussianInfo, const SpzWriteInfo& writeInfo, const SpzLayout& layout, const uint32_t shDegree, const uint32_t firstPointIndex, const uint32_t lastPointIndex, uint8_t* outBytes) noexcept
+	{
+		const float positionScale = static_cast<float>(1u << writeInfo.PositionFractionalBits);
+		const uint32_t srcShCoefficientsCount = GetShCoefficientsCount(gaussianInfo.ShDegree);
+		const uint32_t shCoefficientsCount = GetShCoefficientsCount(shDegree);
+		const int32_t sh1BucketSize = 1 << (8 - std::clamp(writeInfo.Sh1Bits, 1u, 8u));
+		const int32_t shRestBucketSize = 1 << (8 - std::clamp(writeInfo.ShRestBits, 1u, 8u));
+		const bool bIsQuantized = gaussianInfo.ShCodebook.empty() == false;
+
+		for (uint32_t pointIndex = firstPointIndex; pointIndex < lastPointIndex; ++pointIndex)
+		{
+			const size_t indexBy3 = static_cast<size_t>(pointIndex) * 3;
+
+			// 24 bit two's complement fixed point, little endian
+			uint8_t* position = outBytes + layout.PositionsOffset + indexBy3 * 3;
+			for (uint32_t axisIndex = 0; axisIndex < 3; ++axisIndex)
+			{
+				const int32_t fixedPoint = static_cast<int32_t>(std::lround(gaussianInfo.Positions[indexBy3 + axisIndex] * positionScale));
+				position[axisIndex * 3] = static_cast<uint8_t>(fixedPoint & 0xff);
+				position[axisIndex * 3 + 1] = static_cast<uint8_t>((fixedPoint >> 8) & 0xff);
+				position[axisIndex * 3 + 2] = static_cast<uint8_t>((fixedPoint >> 16) & 0xff);
+			}
+
+			outBytes[layout.AlphasOffset + pointIndex] = ToUint8(255.0f / (1.0f + std::exp(-gaussianInfo.Alphas[pointIndex])));
+
+			for (uint32_t channelIndex = 0; channelIndex < 3; ++channelIndex)
+			{
+				outBytes[layout.ColorsOffset + indexBy3 + channelIndex] = ToUint8(gaussianInfo.Colors[indexBy3 + channelIndex] * (SPZ_COLOR_SCALE * 255.0f) + 0.5f * 255.0f);
+				outBytes[layout.ScalesOffset + indexBy3 + channelIndex] = ToUint8((gaussianInfo.Scales[indexBy3 + channelIndex] + 10.0f) * 16.0f);
+			}
+
+			// x, y and z of the normalized quaternion with a positive w, which is implied
+			const float* rotation = &gaussianInfo.Rotations[static_cast<size_t>(pointIndex) * 4];
+			const float length = std::sqrt(rotation[0] * rotation[0] + rotation[1] * rotation[1] + rotation[2] * rotation[2] + rotation[3] * rotation[3]);
+			const float rotationScale = length > 0.0f ? (rotation[3] < 0.0f ? -127.5f : 127.5f) / length : 0.0f;
+			for (uint32_t componentIndex = 0; componentIndex < 3; ++componentIndex)
+			{
+				outBytes[layout.RotationsOffset + indexBy3 + componentIndex] = ToUint8(rotation[componentIndex] * rotationScale + 127.5f);
+			}
+
+			// the lower bands come first, dropping bands keeps a prefix of the coefficients
+			const float* shCoefficients = bIsQuantized == true
+				? &gaussianInfo.ShCodebook[static_cast<size_t>(gaussianInfo.ShIndices[pointIndex]) * srcShCoefficientsCount]
+				: &gaussianInfo.SphericalHarmonics[static_cast<size_t>(pointIndex) * srcShCoefficientsCount];
+			uint8_t* sh = outBytes + layout.ShOffset + static_cast<size_t>(pointIndex) * shCoefficientsCount;
+			for (uint32_t coefficientIndex = 0; coefficientIndex < shCoefficientsCount; ++coefficientIndex)
+			{
+				sh[coefficientIndex] = QuantizeSh(shCoefficients[coefficientIndex], coefficientIndex < 9 ? sh1BucketSize : shRestBucketSize);
+			}
+		}
+	}
+
+	// Raw deflate of one block ending on a byte boundary, so the blocks concatenate into one stream. The last block
+	// finishes the stream.
+	static bool DeflateBlock(const uint8_t* dictionary, const size_t dictionarySize, const uint8_t* bytes, const size_t size, const int32_t compressionLevel, const bool bIsLastBlock, std::vector<uint8_t>& outCompressedBytes) noexcept
+	{
+		z_stream stream = {};
+		if (deflateInit2(&stream, compressionLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		{
+			return false;
+		}
+
+		if (dictionarySize > 0)
+		{
+			deflateSetDictionary(&stream, dictionary, static_cast<uInt>(dictionarySize));
+		}
+
+		// room for the sync flush marker on top of the bound
+		outCompressedBytes.resize(deflateBound(&stream, static_cast<uLong>(size)) + 16);
+		stream.next_in = const_cast<Bytef*>(bytes);
+		stream.avail_in = static_cast<uInt>(size);
+		stream.next_out = outCompressedBytes.data();
+		stream.avail_out = static_cast<uInt>(outCompressedBytes.size());
+		const int zr = deflate(&stream, bIsLastBlock == true ? Z_FINISH : Z_SYNC_FLUSH);
+		const bool bIsDeflated = bIsLastBlock == true ? zr == Z_STREAM_END : (zr == Z_OK && stream.avail_in == 0 && stream.avail_out > 0);
+		outCompressedBytes.resize(stream.total_out);
+		deflateEnd(&stream);
+
+		return bIsDeflated;
+	}
+
+	static void AppendLittleEndian(std::vector<uint8_t>& inoutBytes, const uint32_t value) noexcept
+	{
+		inoutBytes.push_back(static_cast<uint8_t>(value));
+		inoutBytes.push_back(static_cast<uint8_t>(value >> 8));
+		inoutBytes.push_back(static_cast<uint8_t>(value >> 16));
+		inoutBytes.push_back(static_cast<uint8_t>(value >> 24));
+	}
+
+	bool WriteSpz(const std::filesystem::path& path, const GaussianInfo& gaussianInfo, const SpzWriteInfo& writeInfo) noexcept
+	{
+		IIIXRLAB_PROFILE_FUNCTION();
+
+		const uint32_t pointsCount = gaussianInfo.NumPoints;
+		const uint32_t shDegree = std::min(gaussianInfo.ShDegree, writeInfo.MaxShDegree);
+		const size_t shCoefficientsCount = GetShCoefficientsCount(shDegree);
+		const bool bHasSh = gaussianInfo.ShCodebook.empty() == false || gaussianInfo.SphericalHarmonics.size() == static_cast<size_t>(pointsCount) * GetShCoefficientsCount(gaussianInfo.ShDegree);
+		if (bHasSh == false || writeInfo.PositionFractionalBits > 23 || writeInfo.CompressionLevel < 0 || writeInfo.CompressionLevel > 9)
+		{
+			std::cerr << "Unable to write " << path << ", the spherical harmonics do not match the degree or the write info is out of range.\n";
+			IIIXRLAB_DEBUG_BREAK();
+			return false;
+		}
+
+		SpzLayout layout = {};
+		layout.PositionsOffset = sizeof(SpzHeader);
+		layout.AlphasOffset = layout.PositionsOffset + static_cast<size_t>(pointsCount) * 9;
+		layout.ColorsOffset = layout.AlphasOffset + pointsCount;
+		layout.ScalesOffset = layout.ColorsOffset + static_cast<size_t>(pointsCount) * 3;
+		layout.RotationsOffset = layout.ScalesOffset + static_cast<size_t>(pointsCount) * 3;
+		layout.ShOffset = layout.RotationsOffset + static_cast<size_t>(pointsCount) * 3;
+		layout.TotalSize = layout.ShOffset + pointsCount * shCoefficientsCount;
+
+		std::vector<uint8_t> bytes(layout.TotalSize);
+		const SpzHeader header =
+		{
+			.Magic = SPZ_MAGIC,
+			.Version = SPZ_VERSION,
+			.PointsCount = pointsCount,
+			.ShDegree = static_cast<uint8_t>(shDegree),
+			.FractionalBits = static_cast<uint8_t>(writeInfo.PositionFractionalBits),
+			.Flags = gaussianInfo.isAntialiased == true ? SPZ_ANTIALIASED_FLAG : uint8_t(0),
+			.Reserved = 0,
+		};
+		memcpy(bytes.data(), &header, sizeof(header));
+
+		const uint32_t chunksCount = (pointsCount + POINTS_COUNT_PER_CHUNK - 1) / POINTS_COUNT_PER_CHUNK;
+		const uint32_t blocksCount = static_cast<uint32_t>((bytes.size() + DEFLATE_BLOCK_SIZE - 1) / DEFLATE_BLOCK_SIZE);
+		const uint32_t threadsCount = writeInfo.ThreadsCount > 0 ? writeInfo.ThreadsCount : std::max(std::thread::hardware_concurrency(), 1u);
+		ThreadPool threadPool({ .ThreadsCount = std::min(threadsCount, std::max(chunksCount, blocksCount)) });
+
+		{
+			IIIXRLAB_PROFILE_ZONE("WriteSpz::Pack");
+			for (uint32_t chunkIndex = 0; chunkIndex < chunksCount; ++chunkIndex)
+			{
+				threadPool.Submit([&gaussianInfo, &writeInfo, &layout, shDegree, pointsCount, chunkIndex, &bytes]()
+				{
+					const uint32_t firstPointIndex = chunkIndex * POINTS_COUNT_PER_CHUNK;
+					PackPoints(gaussianInfo, writeInfo, layout, shDegree, firstPointIndex, std::min(firstPointIndex + POINTS_COUNT_PER_CHUNK, pointsCount), bytes.data());
+				});
+			}
+			threadPool.Wait();
+		}
+
+		std::vector<std::vector<uint8_t>> compressedBlocks(blocksCount);
+		std::vector<uLong> blockCrcs(blocksCount);
+		std::atomic<uint32_t> failedBlocksCount = 0;
+		{
+			IIIXRLAB_PROFILE_ZONE("WriteSpz::Deflate");
+			for (uint32_t blockIndex = 0; blockIndex < blocksCount; ++blockIndex)
+			{
+				threadPool.Submit([&writeInfo, blockIndex, blocksCount, &bytes, &compressedBlocks, &blockCrcs, &failedBlocksCount]()
+				{
+					const size_t offset = blockIndex * DEFLATE_BLOCK_SIZE;
+					const size_t size = std::min(DEFLATE_BLOCK_SIZE, bytes.size() - offset);
+					const size_t dictionarySize = std::min(DEFLATE_DICTIONARY_SIZE, offset);
+					if (DeflateBlock(bytes.data() + offset - dictionarySize, dictionarySize, bytes.data() + offset, size, writeInfo.CompressionLevel, blockIndex + 1 == blocksCount, compressedBlocks[blockIndex]) == false)
+					{
+						++failedBlocksCount;
+					}
+					blockCrcs[blockIndex] = crc32(0L, bytes.data() + offset, static_cast<uInt>(size));
+				});
+			}
+			threadPool.Wait();
+		}
+
+		if (failedBlocksCount > 0)
+		{
+			std::cerr << "Failed to compress " << path << ".\n";
+			return false;
+		}
+
+		// gzip member around the concatenated blocks: no name, no timestamp, unknown OS
+		std::vector<uint8_t> gzipBytes = { 0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0, 0, 0xff };
+		uLong crc = blockCrcs[0];
+		for (uint32_t blockIndex = 0; blockIndex < blocksCount; ++blockIndex)
+		{
+			gzipBytes.insert(gzipBytes.end(), compressedBlocks[blockIndex].begin(), compressedBlocks[blockIndex].end());
+			if (blockIndex > 0)
+			{
+				const size_t size = std::min(DEFLATE_BLOCK_SIZE, bytes.size() - blockIndex * DEFLATE_BLOCK_SIZE);
+				crc = crc32_combine(crc, blockCrcs[blockIndex], static_cast<z_off_t>(size));
+			}
+		}
+		AppendLittleEndian(gzipBytes, static_cast<uint32_t>(crc));
+		AppendLittleEndian(gzipBytes, static_cast<uint32_t>(bytes.size()));
+
+		std::ofstream file(path, std::ios::binary);
+		if (file.is_open() == false)
+		{
+			std::cerr << "Failed to open " << path << ".\n";
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(gzipBytes.data()), static_cast<std::streamsize>(gzipBytes.size()));
+
+		return file.good();
+	}
+} // namespace iiixrlab::scene
@@ -22,6 +22,10 @@ namespace iiixrlab::graphics
 
     SwapChain::~SwapChain() noexcept
     {
+        for (BackBuffer& backBuffer : mBackBuffers)
+        {
+            mDevice.DestroySemaphore(backBuffer.RenderFinishedSemaphore);
+        }
         mBackBuffers.clear();
         mDevice.DestroySwapChain(mSwapChain);
         mInstance.DestroySurface(mSurface);
@@ -9,6 +9,7 @@ namespace iiixrlab::graphics
 		: mDevice(other.mDevice)
 		, mImage(other.mImage)
 		, mFormat(other.mFormat)
+		, mExtent(other.mExtent)
 		, mDeviceMemory(other.mDeviceMemory)
 		, mSampledViewOrNull(other.mSampledViewOrNull)
 		, mStorageViewOrNull(other.mStorageViewOrNull)
@@ -18,6 +19,7 @@ namespace iiixrlab::graphics
 	{
 		other.mImage = VK_NULL_HANDLE;
 		other.mFormat = VK_FORMAT_UNDEFINED;
+		other.mExtent = {};
 		other.mDeviceMemory = VK_NULL_HANDLE;
 		other.mSampledViewOrNull = VK_NULL_HANDLE;
 		other.mStorageViewOrNull = VK_NULL_HANDLE;
@@ -30,6 +32,7 @@ namespace iiixrlab::graphics
 		: mDevice(createInfo.Device)
 		, mImage(createInfo.Image)
 		, mFormat(createInfo.Format)
+		, mExtent(createInfo.Extent)
 		, mDeviceMemory(createInfo.DeviceMemory)
 		, mSampledViewOrNull(createInfo.SampledViewOrNull)
 		, mStorageViewOrNull(createInfo.StorageViewOrNull)
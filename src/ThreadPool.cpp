@@ -0,0 +1,96 @@
+#include "3dgs/ThreadPool.h"
+
+#include "3dgs/Profiler.h"
+
+namespace iiixrlab
+{
+	ThreadPool::ThreadPool(const CreateInfo& createInfo) noexcept
+		: mThreads()
+		, mTasks()
+		, mMaxPendingTasksCount(std::max(createInfo.MaxPendingTasksCount, 1u))
+		, mRunningTasksCount(0)
+		, mbIsStopping(false)
+		, mMutex()
+		, mTaskSubmitted()
+		, mTaskTaken()
+		, mTasksDone()
+	{
+		const uint32_t threadsCount = std::max(createInfo.ThreadsCount, 1u);
+		mThreads.reserve(threadsCount);
+		for (uint32_t threadIndex = 0; threadIndex < threadsCount; ++threadIndex)
+		{
+			mThreads.emplace_back(&ThreadPool::work, this);
+		}
+	}
+
+	ThreadPool::~ThreadPool() noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mbIsStopping = true;
+		}
+		mTaskSubmitted.notify_all();
+
+		for (std::thread& thread : mThreads)
+		{
+			thread.join();
+		}
+		mThreads.clear();
+	}
+
+	void ThreadPool::Submit(std::function<void()>&& task) noexcept
+	{
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mTaskTaken.wait(lock, [this]() { return mTasks.size() < mMaxPendingTasksCount; });
+			mTasks.push_back(std::move(task));
+		}
+		mTaskSubmitted.notify_one();
+	}
+
+	void ThreadPool::Wait() noexcept
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mTasksDone.wait(lock, [this]() { return mTasks.empty() == true && mRunningTasksCount == 0; });
+	}
+
+	void ThreadPool::work() noexcept
+	{
+		IIIXRLAB_PROFILE_THREAD("Worker");
+
+		for (;;)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				// pending tasks are drained even when stopping, nothing submitted is dropped
+				mTaskSubmitted.wait(lock, [this]() { return mbIsStopping == true || mTasks.empty() == false; });
+				if (mTasks.empty() == true)
+				{
+					return;
+				}
+
+				task = std::move(mTasks.front());
+				mTasks.pop_front();
+				++mRunningTasksCount;
+			}
+			mTaskTaken.notify_one();
+
+			{
+				IIIXRLAB_PROFILE_ZONE("Task");
+				task();
+			}
+			// whatever the task captured is released before Wait() may return
+			task = nullptr;
+
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				--mRunningTasksCount;
+				if (mTasks.empty() == true && mRunningTasksCount == 0)
+				{
+					mTasksDone.notify_all();
+				}
+			}
+		}
+	}
+} // namespace iiixrlab
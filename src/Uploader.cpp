@@ -0,0 +1,219 @@
+#include "3dgs/graphics/Uploader.h"
+
+#include "3dgs/graphics/Buffer.h"
+#include "3dgs/graphics/CommandBuffer.h"
+#include "3dgs/graphics/CommandPool.h"
+#include "3dgs/graphics/Device.h"
+#include "3dgs/graphics/FrameResource.h"
+#include "3dgs/graphics/GpuProfiler.h"
+#include "3dgs/graphics/Queue.h"
+#include "3dgs/graphics/StagingBuffer.h"
+
+#include "3dgs/Profiler.h"
+
+namespace iiixrlab::graphics
+{
+	Uploader::Uploader(CreateInfo& createInfo) noexcept
+		: mDevice(createInfo.Device)
+		, mQueue(createInfo.Queue)
+		, mCommandPool(std::move(createInfo.CommandPool))
+		, mGpuProfiler(std::move(createInfo.GpuProfiler))
+		, mTimelineSemaphore(createInfo.TimelineSemaphore)
+		, mSrcQueueFamilyIndex(createInfo.SrcQueueFamilyIndex)
+		, mDstQueueFamilyIndex(createInfo.DstQueueFamilyIndex)
+		, mCommandBufferTimelineValues(DEFAULT_FRAMES_COUNT, 0)
+		, mCommandBufferIndex(0)
+		, mPendingRequests()
+		, mSubmittedRequests()
+		, mSubmittedTimelineValue(0)
+		, mAcquiredTimelineValue(0)
+		, mUploadedBytesCount(0)
+	{
+		assert(mCommandPool != nullptr);
+		assert(mGpuProfiler != nullptr);
+		assert(mTimelineSemaphore != VK_NULL_HANDLE);
+
+		mCommandPool->AllocateCommandBuffers("Upload Command Buffer", static_cast<uint32_t>(mCommandBufferTimelineValues.size()));
+	}
+
+	Uploader::Uploader(Uploader&& other) noexcept
+		: mDevice(other.mDevice)
+		, mQueue(other.mQueue)
+		, mCommandPool(std::move(other.mCommandPool))
+		, mGpuProfiler(std::move(other.mGpuProfiler))
+		, mTimelineSemaphore(other.mTimelineSemaphore)
+		, mSrcQueueFamilyIndex(other.mSrcQueueFamilyIndex)
+		, mDstQueueFamilyIndex(other.mDstQueueFamilyIndex)
+		, mCommandBufferTimelineValues(std::move(other.mCommandBufferTimelineValues))
+		, mCommandBufferIndex(other.mCommandBufferIndex)
+		, mPendingRequests(std::move(other.mPendingRequests))
+		, mSubmittedRequests(std::move(other.mSubmittedRequests))
+		, mSubmittedTimelineValue(other.mSubmittedTimelineValue)
+		, mAcquiredTimelineValue(other.mAcquiredTimelineValue)
+		, mUploadedBytesCount(other.mUploadedBytesCount)
+	{
+		other.mTimelineSemaphore = VK_NULL_HANDLE;
+	}
+
+	Uploader::~Uploader() noexcept
+	{
+		if (mTimelineSemaphore == VK_NULL_HANDLE)
+		{
+			return;
+		}
+
+		Wait();
+		mPendingRequests.clear();
+		mSubmittedRequests.clear();
+		mGpuProfiler.reset();
+		mCommandPool.reset();
+		mDevice.DestroySemaphore(mTimelineSemaphore);
+	}
+
+	uint64_t Uploader::Upload(std::unique_ptr<StagingBuffer>&& stagingBuffer, Buffer& dstBuffer, const VkDeviceSize dstOffset) noexcept
+	{
+		if (stagingBuffer == nullptr)
+		{
+			std::cerr << "Staging buffer is nullptr.\n";
+			IIIXRLAB_DEBUG_BREAK();
+			return UINT64_MAX;
+		}
+
+		if (dstOffset + stagingBuffer->GetTotalSize() > dstBuffer.GetTotalSize())
+		{
+			std::cerr << "The upload exceeds the destination buffer.\n";
+			IIIXRLAB_DEBUG_BREAK();
+			return UINT64_MAX;
+		}
+
+		// every pending request is submitted together by the next Flush()
+		const uint64_t timelineValue = mSubmittedTimelineValue + 1;
+		mPendingRequests.push_back(Request
+		{
+			.StagingBuffer = std::move(stagingBuffer),
+			.DstBuffer = &dstBuffer,
+			.DstOffset = dstOffset,
+			.TimelineValue = timelineValue,
+		});
+
+		return timelineValue;
+	}
+
+	void Uploader::Flush() noexcept
+	{
+		if (mPendingRequests.empty() == true)
+		{
+			return;
+		}
+
+		IIIXRLAB_PROFILE_ZONE("Uploader::Flush");
+
+		const uint64_t timelineValue = mSubmittedTimelineValue + 1;
+
+		// the command buffer of this slot may still be executing a previous flush
+		CommandBuffer& commandBuffer = mCommandPool->GetCommandBuffer(mCommandBufferIndex);
+		mDevice.WaitForSemaphore(mTimelineSemaphore, mCommandBufferTimelineValues[mCommandBufferIndex]);
+		mGpuProfiler->BeginSlot(mCommandBufferIndex);
+
+		commandBuffer.Reset();
+		commandBuffer.Begin();
+		const uint32_t uploadScopeIndex = mGpuProfiler->BeginScope(commandBuffer, "Upload");
+		for (const Request& request : mPendingRequests)
+		{
+			const VkDeviceSize size = request.StagingBuffer->GetTotalSize();
+			commandBuffer.CopyBuffer(*request.StagingBuffer, *request.DstBuffer, { .srcOffset = 0, .dstOffset = request.DstOffset, .size = size });
+			mUploadedBytesCount += size;
+
+			if (mSrcQueueFamilyIndex != mDstQueueFamilyIndex && request.DstBuffer->IsConcurrent() == false)
+			{
+				// release half of the queue family ownership transfer, the acquire half is recorded by Acquire()
+				VkBufferMemoryBarrier releaseBarrier =
+				{
+					.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+					.pNext = nullptr,
+					.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+					.dstAccessMask = 0,
+					.srcQueueFamilyIndex = mSrcQueueFamilyIndex,
+					.dstQueueFamilyIndex = mDstQueueFamilyIndex,
+					.buffer = request.DstBuffer->GetBuffer(),
+					.offset = request.DstOffset,
+					.size = size,
+				};
+				commandBuffer.Barrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, releaseBarrier);
+			}
+		}
+		mGpuProfiler->EndScope(commandBuffer, uploadScopeIndex);
+		commandBuffer.End();
+
+		const VkSemaphoreSubmitInfo signalSemaphoreSubmitInfo =
+		{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+			.pNext = nullptr,
+			.semaphore = mTimelineSemaphore,
+			.value = timelineValue,
+			.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+			.deviceIndex = 0,
+		};
+		mQueue.Submit(commandBuffer, {}, { signalSemaphoreSubmitInfo });
+
+		mCommandBufferTimelineValues[mCommandBufferIndex] = timelineValue;
+		mCommandBufferIndex = (mCommandBufferIndex + 1) % static_cast<uint32_t>(mCommandBufferTimelineValues.size());
+		mSubmittedTimelineValue = timelineValue;
+
+		for (Request& request : mPendingRequests)
+		{
+			mSubmittedRequests.push_back(std::move(request));
+		}
+		mPendingRequests.clear();
+	}
+
+	void Uploader::Acquire(FrameResource& frameResource) noexcept
+	{
+		if (mSubmittedRequests.empty() == true)
+		{
+			return;
+		}
+
+		// only uploads that already finished are adopted, the frame never waits for the transfer queue
+		const uint64_t completedTimelineValue = mDevice.GetSemaphoreCounterValue(mTimelineSemaphore);
+		CommandBuffer& commandBuffer = frameResource.GetCommandBuffer();
+		uint64_t acquiredTimelineValue = 0;
+		while (mSubmittedRequests.empty() == false && mSubmittedRequests.front().TimelineValue <= completedTimelineValue)
+		{
+			const Request& request = mSubmittedRequests.front();
+			if (mSrcQueueFamilyIndex != mDstQueueFamilyIndex && request.DstBuffer->IsConcurrent() == false)
+			{
+				VkBufferMemoryBarrier acquireBarrier =
+				{
+					.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+					.pNext = nullptr,
+					.srcAccessMask = 0,
+					.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_SHADER_READ_BIT,
+					.srcQueueFamilyIndex = mSrcQueueFamilyIndex,
+					.dstQueueFamilyIndex = mDstQueueFamilyIndex,
+					.buffer = request.DstBuffer->GetBuffer(),
+					.offset = request.DstOffset,
+					.size = request.StagingBuffer->GetTotalSize(),
+				};
+				commandBuffer.Barrier(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, acquireBarrier);
+			}
+
+			acquiredTimelineValue = request.TimelineValue;
+			mSubmittedRequests.pop_front();
+		}
+
+		if (acquiredTimelineValue == 0)
+		{
+			return;
+		}
+
+		// already signaled, the wait only carries the memory dependency into the frame's submission
+		frameResource.AddWaitSemaphore(mTimelineSemaphore, acquiredTimelineValue, VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+		mAcquiredTimelineValue = acquiredTimelineValue;
+	}
+
+	void Uploader::Wait() noexcept
+	{
+		mDevice.WaitForSemaphore(mTimelineSemaphore, mSubmittedTimelineValue);
+	}
+} // namespace iiixrlab::graphics
@@ -257,7 +257,9 @@ namespace iiixrlab
 			}
 			IIIXRLAB_DEBUG_BREAK();
 		}
-#endif  // defined(_WIN32)
+#else	// NOT defined(_WIN32)
+		std::cerr << "Windowed mode is only supported on Windows, run with -headless instead.\n";
+#endif  // NOT defined(_WIN32)
 	}
 
 	bool Window::HandleEvents(bool& outQuitApplication) noexcept
@@ -273,8 +275,9 @@ namespace iiixrlab
 
 		outQuitApplication = msg.message == WM_QUIT;
 		return bHasMessage == TRUE;
-#else
-#error 0;
-#endif  // defined(_WIN32)
+#else	// NOT defined(_WIN32)
+		outQuitApplication = true;
+		return false;
+#endif  // NOT defined(_WIN32)
 	}
 } // namespace iiixrlab
@@ -1,20 +1,30 @@
 #include "pch.h"
 
+#include "3dgs/graphics/ChunkStreamer.h"
 #include "3dgs/graphics/Device.h"
 #include "3dgs/graphics/GaussianRenderScene.h"
+#include "3dgs/graphics/GpuProfiler.h"
 #include "3dgs/graphics/Instance.h"
 #include "3dgs/graphics/IRenderScene.hpp"
 #include "3dgs/graphics/Pipeline.h"
 #include "3dgs/graphics/PhysicalDevice.h"
+#include "3dgs/graphics/ReadbackPool.h"
 #include "3dgs/graphics/Renderer.h"
 #include "3dgs/graphics/Shader.h"
 #include "3dgs/graphics/ShaderManager.h"
-#include "3dgs/graphics/SwapChain.h"
+#include "3dgs/graphics/Uploader.h"
 
+#include "3dgs/scene/Camera.h"
+#include "3dgs/scene/CameraPath.h"
+#include "3dgs/scene/CameraTrajectory.h"
 #include "3dgs/scene/Gaussian.h"
 #include "3dgs/scene/Scene.h"
+#include "3dgs/scene/SceneCache.h"
 
+#include "3dgs/ImageWriter.h"
 #include "3dgs/InputManager.h"
+#include "3dgs/Profiler.h"
+#include "3dgs/ThreadPool.h"
 #include "3dgs/Window.h"
 
 namespace iiixrlab
@@ -28,6 +38,131 @@ namespace iiixrlab
 			{
 				outApplicationInfo.ModelPath = (std::filesystem::current_path() / arguments[++argumentIndex]).generic_string();
 			}
+			else if (strcmp(argument, "-synthetic") == 0)
+			{
+				outApplicationInfo.SyntheticSceneInfo.PointsCount = std::atoi(arguments[++argumentIndex]);
+			}
+			else if (strcmp(argument, "-synthetic-distribution") == 0)
+			{
+				const char* distributionName = arguments[++argumentIndex];
+				if (scene::ParseGaussianDistribution(distributionName, outApplicationInfo.SyntheticSceneInfo.Distribution) == false)
+				{
+					std::cerr << "Unknown distribution " << distributionName << ", expected uniform, clustered or surface.\n";
+				}
+			}
+			else if (strcmp(argument, "-synthetic-sh") == 0)
+			{
+				outApplicationInfo.SyntheticSceneInfo.ShDegree = std::min(static_cast<uint32_t>(std::atoi(arguments[++argumentIndex])), 3u);
+			}
+			else if (strcmp(argument, "-seed") == 0)
+			{
+				outApplicationInfo.SyntheticSceneInfo.Seed = std::strtoull(arguments[++argumentIndex], nullptr, 10);
+			}
+			else if (strcmp(argument, "-prune-opacity") == 0)
+			{
+				outApplicationInfo.PruneInfo.MinOpacity = static_cast<float>(std::atof(arguments[++argumentIndex]));
+			}
+			else if (strcmp(argument, "-prune-extent") == 0)
+			{
+				outApplicationInfo.PruneInfo.MinExtent = static_cast<float>(std::atof(arguments[++argumentIndex]));
+			}
+			else if (strcmp(argument, "-prune-contribution") == 0)
+			{
+				outApplicationInfo.PruneInfo.MinContribution = static_cast<float>(std::atof(arguments[++argumentIndex]));
+			}
+			else if (strcmp(argument, "-prune-views") == 0)
+			{
+				outApplicationInfo.PruneViewsPath = (std::filesystem::current_path() / arguments[++argumentIndex]).generic_string();
+			}
+			else if (strcmp(argument, "-reorder") == 0)
+			{
+				const char* curveName = arguments[++argumentIndex];
+				outApplicationInfo.bIsSpatiallyReordered = scene::ParseSpaceFillingCurve(curveName, outApplicationInfo.SpatialReorderInfo.Curve);
+				if (outApplicationInfo.bIsSpatiallyReordered == false)
+				{
+					std::cerr << "Unknown curve " << curveName << ", expected morton or hilbert.\n";
+				}
+			}
+			else if (strcmp(argument, "-sh-codebook") == 0)
+			{
+				outApplicationInfo.ShCodebookInfo.EntriesCount = std::atoi(arguments[++argumentIndex]);
+			}
+			else if (strcmp(argument, "-progressive") == 0)
+			{
+				outApplicationInfo.bIsProgressivelyLoaded = true;
+			}
+			else if (strcmp(argument, "-preview-stride") == 0)
+			{
+				outApplicationInfo.PreviewStride = std::max(std::atoi(arguments[++argumentIndex]), 1);
+			}
+			else if (strcmp(argument, "-stream") == 0)
+			{
+				outApplicationInfo.StreamingBudget = static_cast<uint64_t>(std::max(std::atoll(arguments[++argumentIndex]), 0ll)) << 20;
+			}
+			else if (strcmp(argument, "-place") == 0)
+			{
+				// uniformly scaled, then translated. The same file placed again reuses the gaussians of the first placement
+				const std::filesystem::path path = std::filesystem::current_path() / arguments[++argumentIndex];
+				const float x = static_cast<float>(std::atof(arguments[++argumentIndex]));
+				const float y = static_cast<float>(std::atof(arguments[++argumentIndex]));
+				const float z = static_cast<float>(std::atof(arguments[++argumentIndex]));
+				const float scale = static_cast<float>(std::atof(arguments[++argumentIndex]));
+				outApplicationInfo.PlacedModels.push_back({ .Path = path, .Transform = math::Matrix4x4f({ scale, 0.0f, 0.0f, 0.0f, 0.0f, scale, 0.0f, 0.0f, 0.0f, 0.0f, scale, 0.0f, x, y, z, 1.0f }) });
+			}
+			else if (strcmp(argument, "-delete-box") == 0)
+			{
+				BoxInfo boxInfo;
+				for (float& bound : boxInfo.Min)
+				{
+					bound = static_cast<float>(std::atof(arguments[++argumentIndex]));
+				}
+				for (float& bound : boxInfo.Max)
+				{
+					bound = static_cast<float>(std::atof(arguments[++argumentIndex]));
+				}
+				outApplicationInfo.DeletedBoxes.push_back(boxInfo);
+			}
+			else if (strcmp(argument, "-io") == 0)
+			{
+				const char* backendName = arguments[++argumentIndex];
+				if (ParseFileReadBackend(backendName, outApplicationInfo.FileReadInfo.Backend) == false)
+				{
+					std::cerr << "Unknown file read backend " << backendName << ", expected auto, io_uring or threads.\n";
+				}
+			}
+			else if (strcmp(argument, "-io-depth") == 0)
+			{
+				outApplicationInfo.FileReadInfo.QueueDepth = std::max(std::atoi(arguments[++argumentIndex]), 1);
+			}
+			else if (strcmp(argument, "-io-direct") == 0)
+			{
+				outApplicationInfo.FileReadInfo.bIsDirect = true;
+			}
+			else if (strcmp(argument, "-save-cache") == 0)
+			{
+				outApplicationInfo.SceneCachePath = (std::filesystem::current_path() / arguments[++argumentIndex]).generic_string();
+			}
+			else if (strcmp(argument, "-export-spz") == 0)
+			{
+				outApplicationInfo.SpzExportPath = (std::filesystem::current_path() / arguments[++argumentIndex]).generic_string();
+			}
+			else if (strcmp(argument, "-spz-compression") == 0)
+			{
+				outApplicationInfo.SpzWriteInfo.CompressionLevel = std::clamp(std::atoi(arguments[++argumentIndex]), 0, 9);
+			}
+			else if (strcmp(argument, "-spz-position-bits") == 0)
+			{
+				outApplicationInfo.SpzWriteInfo.PositionFractionalBits = std::min(static_cast<uint32_t>(std::atoi(arguments[++argumentIndex])), 23u);
+			}
+			else if (strcmp(argument, "-spz-sh-bits") == 0)
+			{
+				outApplicationInfo.SpzWriteInfo.Sh1Bits = std::clamp(std::atoi(arguments[++argumentIndex]), 1, 8);
+				outApplicationInfo.SpzWriteInfo.ShRestBits = std::clamp(std::atoi(arguments[++argumentIndex]), 1, 8);
+			}
+			else if (strcmp(argument, "-spz-sh-degree") == 0)
+			{
+				outApplicationInfo.SpzWriteInfo.MaxShDegree = std::min(static_cast<uint32_t>(std::atoi(arguments[++argumentIndex])), 3u);
+			}
 			else if (strcmp(argument, "-w") == 0)
 			{
 				outApplicationInfo.Width = std::atoi(arguments[++argumentIndex]);
@@ -36,7 +171,325 @@ namespace iiixrlab
 			{
 				outApplicationInfo.Height = std::atoi(arguments[++argumentIndex]);
 			}
+			else if (strcmp(argument, "-headless") == 0)
+			{
+				outApplicationInfo.bIsHeadless = true;
+			}
+			else if (strcmp(argument, "-frames") == 0)
+			{
+				outApplicationInfo.HeadlessFramesCount = std::atoi(arguments[++argumentIndex]);
+			}
+			else if (strcmp(argument, "-trajectory") == 0)
+			{
+				outApplicationInfo.TrajectoryPath = (std::filesystem::current_path() / arguments[++argumentIndex]).generic_string();
+			}
+			else if (strcmp(argument, "-o") == 0)
+			{
+				outApplicationInfo.OutputPath = (std::filesystem::current_path() / arguments[++argumentIndex]).generic_string();
+			}
+			else if (strcmp(argument, "-threads") == 0)
+			{
+				outApplicationInfo.IoThreadsCount = std::atoi(arguments[++argumentIndex]);
+			}
+			else if (strcmp(argument, "-gpu-profile") == 0)
+			{
+				outApplicationInfo.GpuProfileInterval = std::atoi(arguments[++argumentIndex]);
+			}
+			else if (strcmp(argument, "-gpu-profile-json") == 0)
+			{
+				outApplicationInfo.GpuProfilePath = (std::filesystem::current_path() / arguments[++argumentIndex]).generic_string();
+			}
+			else if (strcmp(argument, "-trace") == 0)
+			{
+				outApplicationInfo.TracePath = (std::filesystem::current_path() / arguments[++argumentIndex]).generic_string();
+			}
+			else if (strcmp(argument, "-benchmark") == 0)
+			{
+				outApplicationInfo.BenchmarkCameraPath = arguments[++argumentIndex];
+			}
+			else if (strcmp(argument, "-benchmark-frames") == 0)
+			{
+				outApplicationInfo.BenchmarkFramesCount = std::atoi(arguments[++argumentIndex]);
+			}
+			else if (strcmp(argument, "-warmup") == 0)
+			{
+				outApplicationInfo.BenchmarkWarmupFramesCount = std::atoi(arguments[++argumentIndex]);
+			}
+			else if (strcmp(argument, "-benchmark-json") == 0)
+			{
+				outApplicationInfo.BenchmarkReportPath = (std::filesystem::current_path() / arguments[++argumentIndex]).generic_string();
+			}
+			else if (strcmp(argument, "-record-path") == 0)
+			{
+				outApplicationInfo.RecordedCameraPath = (std::filesystem::current_path() / arguments[++argumentIndex]).generic_string();
+			}
+		}
+	}
+
+	void WriteProfiles(const graphics::Renderer& renderer, const ApplicationInfo& applicationInfo)
+	{
+		if (applicationInfo.TracePath.empty() == false)
+		{
+			Profiler::GetInstance().Stop();
+			Profiler::GetInstance().WriteChromeTrace(applicationInfo.TracePath);
+		}
+
+		if (applicationInfo.GpuProfilePath.empty() == true)
+		{
+			return;
+		}
+
+		const std::filesystem::path& path = applicationInfo.GpuProfilePath;
+		std::ofstream file(path);
+		if (file.is_open() == false)
+		{
+			std::cerr << "Failed to open " << path << " for the GPU profile.\n";
+			return;
+		}
+
+		file << "{\n\"frame\": ";
+		renderer.GetGpuProfiler().WriteJson(file);
+		file << ",\n\"upload\": ";
+		renderer.GetInstance().GetPhysicalDevice().GetDevice().GetUploader().GetGpuProfiler().WriteJson(file);
+		file << "\n}\n";
+	}
+
+	// nearest rank of the sorted values
+	static double GetPercentile(const std::vector<double>& sortedValues, const uint32_t percentile) noexcept
+	{
+		assert(sortedValues.empty() == false && percentile <= 100);
+
+		const size_t rank = std::max<size_t>((sortedValues.size() * percentile + 99) / 100, 1);
+		return sortedValues[rank - 1];
+	}
+
+	// Replays the camera path with a fixed time step so every run renders the same views, then reports the timings of
+	// the measured frames as JSON. Frame times are the CPU time of Update() and Render(), which includes waiting for the
+	// frame in flight to come around again, so they track the GPU once it is the bottleneck.
+	int RunBenchmark(graphics::Renderer& renderer, graphics::GaussianRenderScene& renderScene, const scene::CameraPath& cameraPath, const ApplicationInfo& applicationInfo, const float shColorPsnr)
+	{
+		constexpr const float DELTA_TIME = 1.0f / 60.0f;
+
+		graphics::Uploader& uploader = renderer.GetInstance().GetPhysicalDevice().GetDevice().GetUploader();
+		graphics::GpuProfiler& gpuProfiler = renderer.GetGpuProfiler();
+
+		// the first frame issues the scene uploads, the warm-up starts once they have landed
+		renderer.Update(DELTA_TIME);
+		renderer.Render();
+		uploader.Wait();
+
+		renderScene.SetCameraPath(&cameraPath);
+		for (uint32_t frameIndex = 0; frameIndex < applicationInfo.BenchmarkWarmupFramesCount; ++frameIndex)
+		{
+			renderer.Update(DELTA_TIME);
+			renderer.Render();
+		}
+		renderer.Flush();
+
+		// the measured frames start over from the first pose
+		renderScene.SetCameraPath(&cameraPath);
+		gpuProfiler.ResetStatistics(applicationInfo.BenchmarkFramesCount);
+		uploader.GetGpuProfiler().ResetStatistics(applicationInfo.BenchmarkFramesCount);
+		const uint64_t startingDrawnSplatsCount = renderScene.GetDrawnSplatsCount();
+		const uint64_t startingUploadedBytesCount = uploader.GetUploadedBytesCount();
+
+		std::vector<double> frameTimes;
+		frameTimes.reserve(applicationInfo.BenchmarkFramesCount);
+		const std::chrono::steady_clock::time_point startingTime = std::chrono::steady_clock::now();
+		std::chrono::steady_clock::time_point frameStartingTime = startingTime;
+		for (uint32_t frameIndex = 0; frameIndex < applicationInfo.BenchmarkFramesCount; ++frameIndex)
+		{
+			renderer.Update(DELTA_TIME);
+			renderer.Render();
+
+			const std::chrono::steady_clock::time_point frameEndingTime = std::chrono::steady_clock::now();
+			frameTimes.push_back(std::chrono::duration<double, std::milli>(frameEndingTime - frameStartingTime).count());
+			frameStartingTime = frameEndingTime;
+		}
+		renderer.Flush();
+		const double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startingTime).count();
+
+		renderScene.SetCameraPath(nullptr);
+
+		const uint64_t drawnSplatsCount = renderScene.GetDrawnSplatsCount() - startingDrawnSplatsCount;
+		const uint64_t uploadedBytesCount = uploader.GetUploadedBytesCount() - startingUploadedBytesCount;
+
+		std::vector<double> sortedFrameTimes = frameTimes;
+		std::sort(sortedFrameTimes.begin(), sortedFrameTimes.end());
+		double frameTimesSum = 0.0;
+		for (const double frameTime : sortedFrameTimes)
+		{
+			frameTimesSum += frameTime;
+		}
+
+		std::ofstream reportFile;
+		if (applicationInfo.BenchmarkReportPath.empty() == false)
+		{
+			reportFile.open(applicationInfo.BenchmarkReportPath);
+			if (reportFile.is_open() == false)
+			{
+				std::cerr << "Failed to open " << applicationInfo.BenchmarkReportPath << " for the benchmark report.\n";
+				return -1;
+			}
 		}
+		std::ostream& report = reportFile.is_open() == true ? static_cast<std::ostream&>(reportFile) : std::cout;
+
+		const VkExtent2D extent = renderer.GetExtent();
+		uint32_t pointsCount = 0;
+		size_t shMemorySize = 0;
+		size_t shCodebookEntriesCount = 0;
+		renderScene.WaitForGaussians();
+		for (const std::unique_ptr<scene::Gaussian>& gaussian : renderScene.GetRenderables())
+		{
+			const scene::GaussianInfo& gaussianInfo = gaussian->GetGaussianInfo();
+			pointsCount += gaussianInfo.NumPoints;
+			shMemorySize += scene::GetShMemorySize(gaussianInfo);
+			shCodebookEntriesCount += gaussianInfo.ShCodebook.size() / std::max(scene::GetShCoefficientsCount(gaussianInfo.ShDegree), 1u);
+		}
+
+		report << "{\n\"model\": ";
+		WriteJsonString(report, applicationInfo.SyntheticSceneInfo.PointsCount > 0 ? std::string("synthetic") : applicationInfo.ModelPath.generic_string());
+		report << ",\n\"points\": " << pointsCount;
+		if (applicationInfo.SyntheticSceneInfo.PointsCount > 0)
+		{
+			const scene::GaussianGeneratorInfo& syntheticSceneInfo = applicationInfo.SyntheticSceneInfo;
+			report << ",\n\"synthetic\": { \"distribution\": \"" << scene::GetGaussianDistributionName(syntheticSceneInfo.Distribution)
+				<< "\", \"sh_degree\": " << syntheticSceneInfo.ShDegree
+				<< ", \"seed\": " << syntheticSceneInfo.Seed << " }";
+		}
+		// the PSNR compares the quantized colors with the ones of the loaded coefficients, null when nothing was quantized
+		report << ",\n\"sh\": { \"bytes\": " << shMemorySize << ", \"codebook_entries\": " << shCodebookEntriesCount << ", \"color_psnr_db\": ";
+		if (std::isfinite(shColorPsnr) == true)
+		{
+			report << shColorPsnr << " }";
+		}
+		else
+		{
+			report << "null }";
+		}
+		report << ",\n\"camera_path\": ";
+		WriteJsonString(report, applicationInfo.BenchmarkCameraPath);
+		report << ",\n\"width\": " << extent.width
+			<< ",\n\"height\": " << extent.height
+			<< ",\n\"frames\": " << applicationInfo.BenchmarkFramesCount
+			<< ",\n\"warmup_frames\": " << applicationInfo.BenchmarkWarmupFramesCount
+			<< ",\n\"delta_time_s\": " << DELTA_TIME
+			<< ",\n\"elapsed_s\": " << elapsedSeconds
+			<< ",\n\"fps\": " << static_cast<double>(applicationInfo.BenchmarkFramesCount) / elapsedSeconds
+			<< ",\n\"frame_time_ms\": { \"min\": " << sortedFrameTimes.front()
+			<< ", \"avg\": " << frameTimesSum / static_cast<double>(sortedFrameTimes.size())
+			<< ", \"p50\": " << GetPercentile(sortedFrameTimes, 50)
+			<< ", \"p90\": " << GetPercentile(sortedFrameTimes, 90)
+			<< ", \"p95\": " << GetPercentile(sortedFrameTimes, 95)
+			<< ", \"p99\": " << GetPercentile(sortedFrameTimes, 99)
+			<< ", \"max\": " << sortedFrameTimes.back() << " }"
+			<< ",\n\"splats_drawn\": " << drawnSplatsCount
+			<< ",\n\"splats_drawn_per_frame\": " << static_cast<double>(drawnSplatsCount) / static_cast<double>(applicationInfo.BenchmarkFramesCount)
+			<< ",\n\"bytes_uploaded\": " << uploadedBytesCount
+			<< ",\n\"gpu\": {\n\"frame\": ";
+		gpuProfiler.WriteJson(report);
+		report << ",\n\"upload\": ";
+		uploader.GetGpuProfiler().WriteJson(report);
+		report << "\n}\n}\n";
+
+		if (reportFile.is_open() == true)
+		{
+			std::cout << "Benchmarked " << applicationInfo.BenchmarkFramesCount << " frames in " << elapsedSeconds << " s, results written to " << applicationInfo.BenchmarkReportPath << ".\n";
+			return reportFile.good() == true ? 0 : -1;
+		}
+
+		return 0;
+	}
+
+	// Renders every view of the trajectory and writes them as PNG files while the next views are rendering.
+	// The GPU only waits for a frame when its resources come around again, encoding and writing happen
+	// on the thread pool straight out of the mapped readback buffers.
+	int RenderTrajectory(graphics::Renderer& renderer, const scene::CameraTrajectory& trajectory, const ApplicationInfo& applicationInfo)
+	{
+		std::error_code errorCode;
+		std::filesystem::create_directories(applicationInfo.OutputPath, errorCode);
+		if (errorCode)
+		{
+			std::cerr << "Unable to create the output directory " << applicationInfo.OutputPath << ": " << errorCode.message() << '\n';
+			return -1;
+		}
+
+		// the first frame issues the scene uploads, the views are rendered once they have landed
+		renderer.Update(0.0f);
+		renderer.Render();
+		renderer.GetInstance().GetPhysicalDevice().GetDevice().GetUploader().Wait();
+		renderer.Flush();
+
+		const uint32_t threadsCount = applicationInfo.IoThreadsCount > 0 ? applicationInfo.IoThreadsCount : std::max(std::thread::hardware_concurrency(), 1u);
+		// a couple of images per encoder may queue up, more would only hold memory while the GPU outpaces the disk
+		ThreadPool threadPool({ .ThreadsCount = threadsCount, .MaxPendingTasksCount = 2 * threadsCount });
+
+		// views keep the directories of their file paths, views of the same name in different directories would
+		// overwrite each other otherwise. Paths leaving the output directory are kept inside of it
+		const std::vector<scene::CameraTrajectory::View>& views = trajectory.GetViews();
+		std::vector<std::filesystem::path> outputFilePaths;
+		outputFilePaths.reserve(views.size());
+		for (const scene::CameraTrajectory::View& view : views)
+		{
+			std::filesystem::path relativeFilePath;
+			for (const std::filesystem::path& component : view.FilePath.lexically_normal().relative_path())
+			{
+				if (component != ".." && component != ".")
+				{
+					relativeFilePath /= component;
+				}
+			}
+			relativeFilePath.replace_extension(".png");
+			outputFilePaths.push_back(applicationInfo.OutputPath / relativeFilePath);
+
+			std::filesystem::create_directories(outputFilePaths.back().parent_path(), errorCode);
+			if (errorCode)
+			{
+				std::cerr << "Unable to create the output directory " << outputFilePaths.back().parent_path() << ": " << errorCode.message() << '\n';
+				return -1;
+			}
+		}
+
+		// frames are read back in submission order, which is the order of the views
+		size_t readbackViewIndex = 0;
+		std::atomic<uint32_t> failedWritesCount = 0;
+		renderer.SetReadbackCallback([&outputFilePaths, &readbackViewIndex, &threadPool, &failedWritesCount](graphics::ReadbackView&& readbackView)
+		{
+			const std::filesystem::path& filePath = outputFilePaths[readbackViewIndex++];
+
+			// the view keeps its buffer out of the pool until the image is written, tasks have to be copyable so it is shared
+			std::shared_ptr<graphics::ReadbackView> sharedReadbackView = std::make_shared<graphics::ReadbackView>(std::move(readbackView));
+			threadPool.Submit([filePath, sharedReadbackView, &failedWritesCount]()
+			{
+				const VkExtent2D extent = sharedReadbackView->GetExtent();
+				if (WritePng(filePath, extent.width, extent.height, sharedReadbackView->GetData()) == false)
+				{
+					++failedWritesCount;
+				}
+			});
+		});
+
+		const std::chrono::steady_clock::time_point startingTime = std::chrono::steady_clock::now();
+		for (const scene::CameraTrajectory::View& view : views)
+		{
+			renderer.GetRenderScene().GetCamera().SetInfo(view.Info);
+			renderer.Update(0.0f);
+			renderer.Render();
+		}
+		renderer.Flush();
+		threadPool.Wait();
+		const float elapsedSeconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - startingTime).count();
+
+		renderer.SetReadbackCallback(nullptr);
+
+		std::cout << "Rendered " << views.size() << " views in " << elapsedSeconds << " s (" << static_cast<float>(views.size()) / elapsedSeconds << " views/s) to " << applicationInfo.OutputPath << ".\n";
+		if (failedWritesCount > 0)
+		{
+			std::cerr << failedWritesCount << " views could not be written.\n";
+			return -1;
+		}
+
+		return 0;
 	}
 }
 
@@ -48,18 +501,127 @@ int main(int argc, char** argv)
 		{
 			.Name = "3D Gaussian Splatting Renderer",
 			.Version = IIIXRLAB_MAKE_API_VERSION(0, 0, 1, 0),
-		}
+		},
+		.Width = 1280,
+		.Height = 720,
+		.SyntheticSceneInfo = { .PointsCount = 0 },
+		.bIsProgressivelyLoaded = false,
+		.PreviewStride = 64,
+		.StreamingBudget = 0,
+		.FileReadInfo = {},
+		.PruneInfo = {},
+		.PruneViewsPath = {},
+		.bIsSpatiallyReordered = false,
+		.SpatialReorderInfo = {},
+		.ShCodebookInfo = { .EntriesCount = 0 },
+		.SceneCachePath = {},
+		.SpzWriteInfo = {},
+		.SpzExportPath = {},
+#if defined(_WIN32)
+		.bIsHeadless = false,
+#else	// NOT defined(_WIN32)
+		.bIsHeadless = true,	// no window system integration outside of Windows
+#endif	// NOT defined(_WIN32)
+		.HeadlessFramesCount = 1,
+		.TrajectoryPath = {},
+		.OutputPath = std::filesystem::current_path() / "output",
+		.IoThreadsCount = 0,
+		.GpuProfileInterval = 0,
+		.GpuProfilePath = {},
+		.TracePath = {},
+		.BenchmarkCameraPath = {},
+		.BenchmarkFramesCount = 600,
+		.BenchmarkWarmupFramesCount = 60,
+		.BenchmarkReportPath = {},
+		.RecordedCameraPath = {},
 	};
 
 	iiixrlab::ParseCommandlineArguments(applicationInfo, argc, argv);
-	if (applicationInfo.ModelPath.empty() == true)
+	if (applicationInfo.TracePath.empty() == false)
 	{
-		std::cout << "Model path is empty!! Please provide a model path with -m <file-path>!!" << std::endl;
+#if defined(IIIXRLAB_PROFILER)
+		IIIXRLAB_PROFILE_THREAD("Main");
+		iiixrlab::Profiler::GetInstance().Start();
+#else	// NOT defined(IIIXRLAB_PROFILER)
+		std::cerr << "Profiler zones are compiled out, configure with -DIIIXRLAB_ENABLE_PROFILER=ON to record a trace.\n";
+#endif	// NOT defined(IIIXRLAB_PROFILER)
+	}
+	if (applicationInfo.ModelPath.empty() == true && applicationInfo.SyntheticSceneInfo.PointsCount == 0)
+	{
+		std::cout << "Model path is empty!! Please provide a model path with -m <file-path> or generate a scene with -synthetic <points-count>!!" << std::endl;
 		assert(false);
 		return -1;
 	}
 
-	iiixrlab::Window window(applicationInfo);
+	std::unique_ptr<iiixrlab::scene::CameraTrajectory> trajectoryOrNull = nullptr;
+	if (applicationInfo.TrajectoryPath.empty() == false)
+	{
+		// offline rendering never opens a window and renders at the resolution of the trajectory
+		trajectoryOrNull = std::make_unique<iiixrlab::scene::CameraTrajectory>(applicationInfo.TrajectoryPath, applicationInfo.Width, applicationInfo.Height);
+		if (trajectoryOrNull->GetViews().empty() == true)
+		{
+			std::cout << "Trajectory " << applicationInfo.TrajectoryPath << " has no views to render!!" << std::endl;
+			return -1;
+		}
+
+		applicationInfo.bIsHeadless = true;
+		applicationInfo.Width = trajectoryOrNull->GetWidth();
+		applicationInfo.Height = trajectoryOrNull->GetHeight();
+	}
+
+	if (applicationInfo.BenchmarkCameraPath.empty() == false)
+	{
+		if (applicationInfo.BenchmarkFramesCount == 0)
+		{
+			std::cout << "The benchmark needs at least one frame!!" << std::endl;
+			return -1;
+		}
+
+		// a window would tie the frame rate to the compositor
+		applicationInfo.bIsHeadless = true;
+	}
+
+	const iiixrlab::scene::PruneInfo& pruneInfo = applicationInfo.PruneInfo;
+	const bool bIsSceneProcessed = pruneInfo.MinOpacity > 0.0f || pruneInfo.MinExtent > 0.0f || pruneInfo.MinContribution > 0.0f || applicationInfo.bIsSpatiallyReordered == true
+		|| applicationInfo.ShCodebookInfo.EntriesCount > 0 || applicationInfo.SceneCachePath.empty() == false || applicationInfo.SpzExportPath.empty() == false;
+	if (applicationInfo.StreamingBudget > 0)
+	{
+		if (applicationInfo.SyntheticSceneInfo.PointsCount > 0 || applicationInfo.ModelPath.extension() != iiixrlab::scene::SCENE_CACHE_EXTENSION)
+		{
+			std::cout << "Only scene caches are streamed, write one with -save-cache first!!" << std::endl;
+			return -1;
+		}
+		if (trajectoryOrNull != nullptr || applicationInfo.BenchmarkCameraPath.empty() == false || bIsSceneProcessed == true)
+		{
+			std::cout << "Trajectories, benchmarks and processing need the whole scene, which is not streamed!!" << std::endl;
+			return -1;
+		}
+		if (applicationInfo.bIsProgressivelyLoaded == true)
+		{
+			std::cout << "Streamed scenes arrive chunk by chunk already, progressive loading is disabled.\n";
+			applicationInfo.bIsProgressivelyLoaded = false;
+		}
+	}
+
+	if (applicationInfo.bIsProgressivelyLoaded == true)
+	{
+		if (trajectoryOrNull != nullptr || applicationInfo.BenchmarkCameraPath.empty() == false)
+		{
+			std::cout << "Trajectories and benchmarks render the whole scene, progressive loading is disabled.\n";
+			applicationInfo.bIsProgressivelyLoaded = false;
+		}
+		else if (bIsSceneProcessed == true)
+		{
+			std::cout << "Processing the scene needs all of it at once, progressive loading is disabled.\n";
+			applicationInfo.bIsProgressivelyLoaded = false;
+		}
+	}
+
+	std::unique_ptr<iiixrlab::Window> windowOrNull = nullptr;
+	if (applicationInfo.bIsHeadless == false)
+	{
+		windowOrNull = std::make_unique<iiixrlab::Window>(applicationInfo);
+	}
 
 	iiixrlab::ProjectInfo engineInfo =
 	{
@@ -67,21 +629,116 @@ int main(int argc, char** argv)
 		.Version = IIIXRLAB_MAKE_API_VERSION(0, 0, 1, 0),
 	};
 
+	// the renderables keep referring to the gaussians of these scenes, which outlive the renderer and its render scene.
+	// A progressively loaded or streamed scene arrives in batches once the renderer is up
+	const bool bIsSceneDeferred = applicationInfo.bIsProgressivelyLoaded == true || applicationInfo.StreamingBudget > 0;
+	iiixrlab::scene::Scene scene = bIsSceneDeferred == true ? iiixrlab::scene::Scene(iiixrlab::scene::GaussianInfo())
+		: applicationInfo.SyntheticSceneInfo.PointsCount > 0 ? iiixrlab::scene::Scene(iiixrlab::scene::GenerateGaussians(applicationInfo.SyntheticSceneInfo))
+		: iiixrlab::scene::Scene(applicationInfo.ModelPath, applicationInfo.FileReadInfo);
+	std::vector<std::unique_ptr<iiixrlab::scene::Scene>> placedScenes;
+	std::vector<std::unique_ptr<iiixrlab::scene::GaussianInfo>> loadedGaussianInfos;	// the batches of the progressive loader
+
 	iiixrlab::graphics::RendererCreateInfo createInfo =
 	{
 		.ApplicationInfo = applicationInfo.Info,
 		.EngineInfo = engineInfo,
 		.FramesCount = 3,
-		.Window = window,
+		.WindowOrNull = windowOrNull.get(),
+		.HeadlessExtent = VkExtent2D{ .width = applicationInfo.Width, .height = applicationInfo.Height },
+		.bIsReadbackEnabled = trajectoryOrNull != nullptr,
 	};
 
 	iiixrlab::graphics::Renderer renderer(createInfo);
 	iiixrlab::graphics::Instance& instance = renderer.GetInstance();
-	iiixrlab::graphics::SwapChain& swapChain = instance.GetSwapChain();
 	iiixrlab::graphics::PhysicalDevice& physicalDevice = instance.GetPhysicalDevice();
 	iiixrlab::graphics::Device& device = physicalDevice.GetDevice();
 
-	iiixrlab::scene::Scene scene(applicationInfo.ModelPath);
+	if (pruneInfo.MinOpacity > 0.0f || pruneInfo.MinExtent > 0.0f || pruneInfo.MinContribution > 0.0f)
+	{
+		std::vector<iiixrlab::scene::Camera::Info> pruneViews;
+		uint32_t pruneViewsWidth = applicationInfo.Width;
+		uint32_t pruneViewsHeight = applicationInfo.Height;
+		if (applicationInfo.PruneViewsPath.empty() == false)
+		{
+			const iiixrlab::scene::CameraTrajectory pruneTrajectory(applicationInfo.PruneViewsPath, applicationInfo.Width, applicationInfo.Height);
+			for (const iiixrlab::scene::CameraTrajectory::View& view : pruneTrajectory.GetViews())
+			{
+				pruneViews.push_back(view.Info);
+			}
+			pruneViewsWidth = pruneTrajectory.GetWidth();
+			pruneViewsHeight = pruneTrajectory.GetHeight();
+		}
+		if (pruneInfo.MinContribution > 0.0f && pruneViews.empty() == true)
+		{
+			std::cerr << "The contribution threshold needs the views of -prune-views, it is ignored.\n";
+		}
+
+		iiixrlab::scene::PruneStatistics pruneStatistics;
+		const std::chrono::steady_clock::time_point startingTime = std::chrono::steady_clock::now();
+		const bool bIsPruned = iiixrlab::scene::PruneGaussians(scene.GetGaussianInfo(), pruneInfo, pruneViews, pruneViewsWidth, pruneViewsHeight, pruneStatistics);
+		const float elapsedSeconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - startingTime).count();
+		std::cout << "Pruned " << pruneStatistics.PointsCount << " -> " << scene.GetGaussianInfo().NumPoints << " gaussians in " << elapsedSeconds << " s: "
+			<< pruneStatistics.OpacityPrunedCount << " by opacity, " << pruneStatistics.ExtentPrunedCount << " by extent, " << pruneStatistics.ContributionPrunedCount << " by contribution";
+		if (bIsPruned == true && pruneViews.empty() == false)
+		{
+			std::cout << ", " << pruneStatistics.RemovedContributionFraction * 100.0f << "% of the contributions removed, PSNR " << pruneStatistics.Psnr << " dB over " << pruneViews.size() << " views";
+		}
+		std::cout << ".\n";
+	}
+
+	if (applicationInfo.bIsSpatiallyReordered == true)
+	{
+		iiixrlab::scene::GaussianInfo& gaussianInfo = scene.GetGaussianInfo();
+		const std::chrono::steady_clock::time_point startingTime = std::chrono::steady_clock::now();
+		iiixrlab::scene::ReorderGaussians(gaussianInfo, applicationInfo.SpatialReorderInfo);
+		const float elapsedSeconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - startingTime).count();
+		std::cout << "Reordered " << gaussianInfo.NumPoints << " gaussians along the " << iiixrlab::scene::GetSpaceFillingCurveName(applicationInfo.SpatialReorderInfo.Curve) << " curve in " << elapsedSeconds << " s.\n";
+	}
+
+	float shColorPsnr = std::numeric_limits<float>::infinity();
+	if (applicationInfo.ShCodebookInfo.EntriesCount > 0)
+	{
+		iiixrlab::scene::GaussianInfo& gaussianInfo = scene.GetGaussianInfo();
+		const std::vector<float> referenceSphericalHarmonics = gaussianInfo.SphericalHarmonics;
+		const size_t shMemorySize = iiixrlab::scene::GetShMemorySize(gaussianInfo);
+
+		const std::chrono::steady_clock::time_point startingTime = std::chrono::steady_clock::now();
+		if (iiixrlab::scene::QuantizeSphericalHarmonics(gaussianInfo, applicationInfo.ShCodebookInfo) == true)
+		{
+			const float elapsedSeconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - startingTime).count();
+			shColorPsnr = iiixrlab::scene::ComputeShColorPsnr(gaussianInfo, referenceSphericalHarmonics);
+			std::cout << "Quantized the spherical harmonics of " << gaussianInfo.NumPoints << " gaussians into " << gaussianInfo.ShCodebook.size() / iiixrlab::scene::GetShCoefficientsCount(gaussianInfo.ShDegree)
+				<< " entries in " << elapsedSeconds << " s: " << shMemorySize << " -> " << iiixrlab::scene::GetShMemorySize(gaussianInfo) << " bytes, color PSNR " << shColorPsnr << " dB.\n";
+		}
+		else
+		{
+			std::cout << "The spherical harmonics were not quantized, the scene has none or they already are.\n";
+		}
+	}
+
+	if (applicationInfo.SceneCachePath.empty() == false)
+	{
+		// the cache is laid out for progressive loading: an even sample of the scene first, the rest along the curve of -reorder
+		iiixrlab::scene::GaussianInfo& gaussianInfo = scene.GetGaussianInfo();
+		const uint32_t previewStride = iiixrlab::scene::GetPreviewStride(gaussianInfo.NumPoints, applicationInfo.PreviewStride, iiixrlab::scene::DEFAULT_MAX_PREVIEW_POINTS_COUNT);
+		iiixrlab::scene::PermuteGaussians(gaussianInfo, iiixrlab::scene::ComputeProgressiveOrder(gaussianInfo, previewStride, applicationInfo.SpatialReorderInfo), applicationInfo.SpatialReorderInfo.ThreadsCount);
+		if (iiixrlab::scene::SaveSceneCache(applicationInfo.SceneCachePath, gaussianInfo, (gaussianInfo.NumPoints + previewStride - 1) / previewStride) == false)
+		{
+			return -1;
+		}
+		std::cout << "Scene cache written to " << applicationInfo.SceneCachePath << ".\n";
+	}
+
+	if (applicationInfo.SpzExportPath.empty() == false)
+	{
+		const std::chrono::steady_clock::time_point startingTime = std::chrono::steady_clock::now();
+		if (iiixrlab::scene::WriteSpz(applicationInfo.SpzExportPath, scene.GetGaussianInfo(), applicationInfo.SpzWriteInfo) == false)
+		{
+			return -1;
+		}
+		const float elapsedSeconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - startingTime).count();
+		std::cout << "Exported " << applicationInfo.SpzExportPath << " (" << std::filesystem::file_size(applicationInfo.SpzExportPath) << " bytes) in " << elapsedSeconds << " s.\n";
+	}
 
 	iiixrlab::graphics::ShaderManager& shaderManager = iiixrlab::graphics::ShaderManager::GetInstance();
 
@@ -109,57 +766,14 @@ int main(int argc, char** argv)
 		iiixrlab::graphics::PipelineCreateInfo pipelineCreateInfo =
 		{
 			.Name = "GaussianPipeline",
-			.VertexInputBindingDescriptions =
-			{
-				{
-					.binding = 0,
-					.stride = 3 * sizeof(float),
-					.inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
-				},
-				{
-					.binding = 1,
-					.stride = sizeof(iiixrlab::scene::Gaussian::InstanceInfo),
-					.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE,
-				},
-			},
-			.VertexInputAttributeDescriptions =
-			{
-				{
-					.location = 0,
-					.binding = 0,
-					.format = VK_FORMAT_R32G32B32_SFLOAT,
-					.offset = 0,
-				},
-				{
-					.location = 1,
-					.binding = 1,
-					.format = VK_FORMAT_R32G32B32_SFLOAT,
-					.offset = 0,
-				},
-				{
-					.location = 2,
-					.binding = 1,
-					.format = VK_FORMAT_R8G8B8_UNORM,
-					.offset = 0,
-				},
-				{
-					.location = 3,
-					.binding = 1,
-					.format = VK_FORMAT_R8G8B8A8_UNORM,
-					.offset = 0,
-				},
-				{
-					.location = 4,
-					.binding = 1,
-					.format = VK_FORMAT_R8G8B8A8_UNORM,
-					.offset = 0,
-				},
-			},
+			// the vertex shader pulls the sphere vertices and the splats out of the bindless vertex buffers
+			.VertexInputBindingDescriptions = {},
+			.VertexInputAttributeDescriptions = {},
 			.DescriptorSetLayoutBindings =
 			{
 				{
 					.binding = 0,
-					.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+					.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
 					.descriptorCount = 1,
 					.stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
 					.pImmutableSamplers = nullptr,
@@ -167,8 +781,8 @@ int main(int argc, char** argv)
 			},
 			.ShaderNames = {"Gaussian_VSMain", "Gaussian_PSMain"},
 			.PipelineLayout = VK_NULL_HANDLE,
-			.ColorAttachment = *swapChain.GetBackBuffer(0).Color,
-			.DepthAttachment = *swapChain.GetBackBuffer(0).Depth,
+			.ColorAttachment = renderer.GetColorAttachment(),
+			.DepthAttachment = renderer.GetDepthAttachment(),
 		};
 		
 		pipeline = device.CreatePipeline(pipelineCreateInfo);
@@ -182,52 +796,251 @@ int main(int argc, char** argv)
 	{
 		.Device = device,
 		.Pipelines = std::move(pipelines),
-		.Width = static_cast<float>(swapChain.GetExtent().width),
-		.Height = static_cast<float>(swapChain.GetExtent().height),
+		.Width = static_cast<float>(renderer.GetExtent().width),
+		.Height = static_cast<float>(renderer.GetExtent().height),
+		.FramesCount = renderer.GetFramesCount(),
 	};
 	std::unique_ptr<iiixrlab::graphics::GaussianRenderScene> gaussianRenderScene = std::make_unique<iiixrlab::graphics::GaussianRenderScene>(renderSceneCreateInfo);
+	iiixrlab::graphics::GaussianRenderScene& renderScene = *gaussianRenderScene;
 
 	iiixrlab::scene::Gaussian::CreateInfo gaussianCreateInfo =
 	{
 		.Device = renderer.GetInstance().GetPhysicalDevice().GetDevice(),
 		.GaussianInfo = scene.GetGaussianInfo(),
 	};
-	std::unique_ptr<iiixrlab::scene::Gaussian> gaussian = iiixrlab::scene::Gaussian::Create(gaussianCreateInfo);
-	gaussianRenderScene->AddRenderable(std::move(gaussian));
+	if (bIsSceneDeferred == false)
+	{
+		std::unique_ptr<iiixrlab::scene::Gaussian> gaussian = iiixrlab::scene::Gaussian::Create(gaussianCreateInfo);
+		if (gaussian == nullptr)
+		{
+			return -1;
+		}
+		// the render scene uploads the pages the edits touched and compacts the deleted gaussians away over the first updates
+		for (const iiixrlab::BoxInfo& deletedBoxInfo : applicationInfo.DeletedBoxes)
+		{
+			const std::vector<uint32_t> deletedPointIndices = renderScene.SelectInBox(*gaussian, deletedBoxInfo.Min, deletedBoxInfo.Max);
+			renderScene.Delete(*gaussian, deletedPointIndices);
+			std::cout << "Deleted " << deletedPointIndices.size() << " gaussians in the box" << std::endl;
+		}
+		gaussianRenderScene->AddRenderable(std::move(gaussian));
+	}
+
+	// a model placed several times is loaded and uploaded once, each further placement only adds a transform to its renderable
+	std::unordered_map<std::string, iiixrlab::scene::Gaussian*> placedGaussians;
+	for (const iiixrlab::PlacedModelInfo& placedModelInfo : applicationInfo.PlacedModels)
+	{
+		auto placedGaussianFindResult = placedGaussians.find(placedModelInfo.Path.generic_string());
+		if (placedGaussianFindResult != placedGaussians.end())
+		{
+			placedGaussianFindResult->second->AddTransform(placedModelInfo.Transform);
+			continue;
+		}
+
+		placedScenes.push_back(std::make_unique<iiixrlab::scene::Scene>(placedModelInfo.Path, applicationInfo.FileReadInfo));
+		if (placedScenes.back()->GetGaussianInfo().NumPoints == 0)
+		{
+			std::cout << "Placed model " << placedModelInfo.Path << " has no gaussians!!" << std::endl;
+			return -1;
+		}
+
+		iiixrlab::scene::Gaussian::CreateInfo placedCreateInfo =
+		{
+			.Device = device,
+			.GaussianInfo = placedScenes.back()->GetGaussianInfo(),
+			.Transform = placedModelInfo.Transform,
+		};
+		std::unique_ptr<iiixrlab::scene::Gaussian> placedGaussian = iiixrlab::scene::Gaussian::Create(placedCreateInfo);
+		if (placedGaussian == nullptr)
+		{
+			return -1;
+		}
+		placedGaussians.emplace(placedModelInfo.Path.generic_string(), placedGaussian.get());
+		gaussianRenderScene->AddRenderable(std::move(placedGaussian));
+	}
+
+	if (applicationInfo.StreamingBudget > 0)
+	{
+		iiixrlab::graphics::ChunkStreamer::CreateInfo chunkStreamerCreateInfo =
+		{
+			.Device = device,
+			.Path = applicationInfo.ModelPath,
+			.Budget = applicationInfo.StreamingBudget,
+			.FileReadInfo = applicationInfo.FileReadInfo,
+		};
+		std::unique_ptr<iiixrlab::graphics::ChunkStreamer> chunkStreamer = std::make_unique<iiixrlab::graphics::ChunkStreamer>(chunkStreamerCreateInfo);
+		if (chunkStreamer->IsOpen() == false)
+		{
+			return -1;
+		}
+		gaussianRenderScene->SetChunkStreamer(std::move(chunkStreamer));
+	}
 
 	renderer.SetRenderScene(std::move(gaussianRenderScene));
 
-	LARGE_INTEGER startingTime;
-	LARGE_INTEGER endingTime;
-	LARGE_INTEGER elapsedMicroseconds;
-	LARGE_INTEGER frequency;
+	renderer.GetGpuProfiler().SetReportInterval(applicationInfo.GpuProfileInterval);
+	renderer.GetInstance().GetPhysicalDevice().GetDevice().GetUploader().GetGpuProfiler().SetReportInterval(applicationInfo.GpuProfileInterval);
 
-	QueryPerformanceFrequency(&frequency);
-	QueryPerformanceCounter(&startingTime);
+	if (trajectoryOrNull != nullptr)
+	{
+		// every view is rendered once, so it has to be drawn in its own order
+		renderScene.SetSortWaited(true);
+		const int result = iiixrlab::RenderTrajectory(renderer, *trajectoryOrNull, applicationInfo);
+		iiixrlab::WriteProfiles(renderer, applicationInfo);
+		return result;
+	}
+
+	if (applicationInfo.BenchmarkCameraPath.empty() == false)
+	{
+		const iiixrlab::scene::GaussianInfo& gaussianInfo = scene.GetGaussianInfo();
+		const iiixrlab::scene::CameraPath cameraPath =
+			applicationInfo.BenchmarkCameraPath == "orbit" ? iiixrlab::scene::CameraPath::CreateOrbit(gaussianInfo, applicationInfo.BenchmarkFramesCount)
+			: applicationInfo.BenchmarkCameraPath == "flythrough" ? iiixrlab::scene::CameraPath::CreateFlyThrough(gaussianInfo, applicationInfo.BenchmarkFramesCount)
+			: iiixrlab::scene::CameraPath(std::filesystem::path(applicationInfo.BenchmarkCameraPath));
+		if (cameraPath.GetPoses().empty() == true)
+		{
+			std::cout << "Camera path " << applicationInfo.BenchmarkCameraPath << " has no poses to replay!!" << std::endl;
+			return -1;
+		}
+
+		const int result = iiixrlab::RunBenchmark(renderer, renderScene, cameraPath, applicationInfo, shColorPsnr);
+		iiixrlab::WriteProfiles(renderer, applicationInfo);
+		return result;
+	}
+
+	// poses of every frame, e.g. to benchmark the same flight later
+	std::vector<iiixrlab::scene::CameraPath::Pose> recordedPoses;
+
+	std::chrono::steady_clock::time_point startingTime = std::chrono::steady_clock::now();
+	uint32_t renderedFramesCount = 0;
+
+	std::unique_ptr<iiixrlab::scene::ProgressiveLoader> progressiveLoaderOrNull = nullptr;
+	const iiixrlab::scene::Gaussian* shCodebookGaussianOrNull = nullptr;	// the batch which uploads the codebook the later ones share
+	const std::chrono::steady_clock::time_point loadingStartingTime = startingTime;
+	bool bIsFirstImageRendered = false;
+	if (applicationInfo.bIsProgressivelyLoaded == true)
+	{
+		const iiixrlab::scene::ProgressiveLoader::CreateInfo progressiveLoaderCreateInfo =
+		{
+			.ModelPath = applicationInfo.ModelPath,
+			.SyntheticSceneInfo = applicationInfo.SyntheticSceneInfo,
+			.PreviewStride = applicationInfo.PreviewStride,
+			.Curve = applicationInfo.SpatialReorderInfo.Curve,
+			.ThreadsCount = applicationInfo.SpatialReorderInfo.ThreadsCount,
+			.FileReadInfo = applicationInfo.FileReadInfo,
+		};
+		progressiveLoaderOrNull = std::make_unique<iiixrlab::scene::ProgressiveLoader>(progressiveLoaderCreateInfo);
+		renderScene.SetLoadingComplete(false);
+	}
 
 	bool bQuitApplication = false;
 	while (bQuitApplication == false)
 	{
-		const bool bHasEvents = window.HandleEvents(bQuitApplication);
-		if (bHasEvents == false)
-		{
-			// Update our time
-			QueryPerformanceCounter(&endingTime);
-			elapsedMicroseconds.QuadPart = endingTime.QuadPart - startingTime.QuadPart;
-			elapsedMicroseconds.QuadPart *= 1000000;
-			elapsedMicroseconds.QuadPart /= frequency.QuadPart;
-			QueryPerformanceFrequency(&frequency);
-			QueryPerformanceCounter(&startingTime);
-
-			const float deltaTime = static_cast<float>(elapsedMicroseconds.QuadPart) / 1000000.0f;
-			
-			iiixrlab::InputManager& inputManager = iiixrlab::InputManager::GetInstance();
-			inputManager.Update();
-			renderer.Update(deltaTime);
-			renderer.Render();
-			inputManager.PostUpdate();
+		if (windowOrNull != nullptr)
+		{
+			const bool bHasEvents = windowOrNull->HandleEvents(bQuitApplication);
+			if (bHasEvents == true || bQuitApplication == true)
+			{
+				continue;
+			}
 		}
+
+		// Update our time
+		const std::chrono::steady_clock::time_point endingTime = std::chrono::steady_clock::now();
+		const float deltaTime = std::chrono::duration<float>(endingTime - startingTime).count();
+		startingTime = endingTime;
+
+		if (progressiveLoaderOrNull != nullptr)
+		{
+			const bool bIsLoading = progressiveLoaderOrNull->IsLoading();
+			iiixrlab::scene::ProgressiveLoader::Batch batch;
+			while (progressiveLoaderOrNull->TryPop(batch) == true)
+			{
+				assert(batch.bSharesShCodebook == false || shCodebookGaussianOrNull != nullptr);
+				iiixrlab::scene::Gaussian::CreateInfo batchCreateInfo =
+				{
+					.Device = device,
+					.GaussianInfo = *batch.GaussianInfo,
+					.bIsPreview = batch.bIsPreview,
+					.ShCodebookGaussianOrNull = batch.bSharesShCodebook == true ? shCodebookGaussianOrNull : nullptr,
+				};
+				std::unique_ptr<iiixrlab::scene::Gaussian> batchGaussian = iiixrlab::scene::Gaussian::Create(batchCreateInfo);
+				if (batchGaussian == nullptr)
+				{
+					return -1;
+				}
+				if (batch.GaussianInfo->ShCodebook.empty() == false)
+				{
+					shCodebookGaussianOrNull = batchGaussian.get();
+				}
+				renderScene.AddRenderable(std::move(batchGaussian));
+				loadedGaussianInfos.push_back(std::move(batch.GaussianInfo));
+			}
+			renderScene.SetLoadingComplete(bIsLoading == false);
+		}
+
+		iiixrlab::InputManager& inputManager = iiixrlab::InputManager::GetInstance();
+		inputManager.Update();
+		renderer.Update(deltaTime);
+		renderer.Render();
+		inputManager.PostUpdate();
+
+		if (progressiveLoaderOrNull != nullptr)
+		{
+			const iiixrlab::graphics::Uploader& uploader = device.GetUploader();
+			bool bIsAnyUploaded = false;
+			bool bAreAllUploaded = true;
+			for (const std::unique_ptr<iiixrlab::scene::Gaussian>& gaussian : renderScene.GetRenderables())
+			{
+				const bool bIsUploaded = gaussian->IsUploaded(uploader);
+				bIsAnyUploaded = bIsAnyUploaded || bIsUploaded;
+				bAreAllUploaded = bAreAllUploaded && bIsUploaded;
+			}
+
+			const float loadingSeconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - loadingStartingTime).count();
+			if (bIsFirstImageRendered == false && bIsAnyUploaded == true)
+			{
+				std::cout << "First image of the scene after " << loadingSeconds << " s.\n";
+				bIsFirstImageRendered = true;
+			}
+			if (progressiveLoaderOrNull->IsLoading() == false && bAreAllUploaded == true)
+			{
+				uint64_t pointsCount = 0;
+				for (const std::unique_ptr<iiixrlab::scene::Gaussian>& gaussian : renderScene.GetRenderables())
+				{
+					pointsCount += gaussian->IsPreview() == true ? 0 : gaussian->GetGaussianInfo().NumPoints;
+				}
+				std::cout << "Loaded " << pointsCount << " gaussians in " << renderScene.GetRenderables().size() << " batches after " << loadingSeconds << " s.\n";
+				progressiveLoaderOrNull.reset();
+			}
+		}
+
+		if (applicationInfo.RecordedCameraPath.empty() == false)
+		{
+			const iiixrlab::scene::Camera& camera = renderScene.GetCamera();
+			recordedPoses.push_back({ .Position = camera.GetPosition(), .PitchYawRoll = camera.GetPitchYawRoll() });
+		}
+
+		++renderedFramesCount;
+		// a headless run keeps rendering until the progressively loaded scene is complete
+		if (windowOrNull == nullptr && renderedFramesCount >= applicationInfo.HeadlessFramesCount && progressiveLoaderOrNull == nullptr)
+		{
+			bQuitApplication = true;
+		}
+	}
+
+	if (applicationInfo.RecordedCameraPath.empty() == false)
+	{
+		iiixrlab::scene::CameraPath(std::move(recordedPoses)).Save(applicationInfo.RecordedCameraPath);
 	}
 
+	const iiixrlab::graphics::ChunkStreamer* chunkStreamerOrNull = renderScene.GetChunkStreamerOrNull();
+	if (chunkStreamerOrNull != nullptr)
+	{
+		std::cout << "Streamed " << chunkStreamerOrNull->GetUploadedChunksCount() << " chunks in and " << chunkStreamerOrNull->GetEvictedChunksCount() << " out, at most "
+			<< (chunkStreamerOrNull->GetPeakResidentSize() >> 20) << " of " << (chunkStreamerOrNull->GetBudget() >> 20) << " MiB resident.\n";
+	}
+
+	iiixrlab::WriteProfiles(renderer, applicationInfo);
+
 	return 0;
 }